@@ -22,7 +22,10 @@
 #include <scxsystemlib/scxostypeinfo.h>
 #include <scxsystemlib/scxsysteminfo.h>
 
+#include "support/commandpool.h"
 #include "support/metaprovider.h"
+#include "support/providerstatistics.h"
+#include "support/scopingkeys.h"
 #include "support/scxcimutils.h"
 
 #include "buildversion.h"
@@ -182,9 +185,31 @@ static void EnumerateOneInstance(
                                StrAppend(L"Can't read logical processor count because ", e.What()),
                                e.Where()));
         }
+
+        //
+        // Populate the call statistics of the providers, the counters of the RunAs command pool,
+        // and the number of refreshes of the scoping keys
+        //
+        std::vector<std::string> statistics;
+        SCXCore::g_ProviderStatistics.Format(statistics);
+        statistics.push_back(SCXCore::g_CommandPool.Format());
+        statistics.push_back(SCXCore::g_ScopingKeys.Format());
+        if (!statistics.empty())
+        {
+            std::vector<mi::String> statisticsArray;
+            statisticsArray.reserve(statistics.size());
+            for (std::vector<std::string>::const_iterator iter = statistics.begin();
+                 iter != statistics.end(); ++iter)
+            {
+                statisticsArray.push_back(iter->c_str());
+            }
+            mi::StringA props(&statisticsArray[0], static_cast<MI_Uint32>(statisticsArray.size()));
+            inst.ProviderStatistics_value(props);
+        }
     }
 
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_Agent_Class_Provider::SCX_Agent_Class_Provider(
@@ -244,8 +269,11 @@ void SCX_Agent_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_Agent", "EnumerateInstances");
+
         // Global lock for MetaProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::MetaProvider::Lock"));
+        timer.LockAcquired();
 
         SCX_Agent_Class inst;
         EnumerateOneInstance( context, inst, keysOnly );
@@ -264,8 +292,11 @@ void SCX_Agent_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_Agent", "GetInstance");
+
         // Global lock for MetaProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::MetaProvider::Lock"));
+        timer.LockAcquired();
 
         // SCX_Agent has one fixed key: Name=scx
         if ( !instanceName.Name_exists() )
@@ -17,6 +17,7 @@
 #include <scxcorelib/scxlog.h>
 #include "support/appserver/appserverenumeration.h"
 #include "support/appserver/appserverprovider.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
 #include "support/startuplog.h"
 #include "SCX_Application_Server_Class_Provider.h"
@@ -116,7 +117,10 @@ void SCX_Application_Server_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_Application_Server", "EnumerateInstances");
+
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::AppServerProvider::Lock"));
+        timer.LockAcquired();
         SCXCoreLib::SCXHandle<SCXSystemLib::AppServerEnumeration> appServers = SCXCore::g_AppServerProvider.GetAppServers();
 
         // Update instances (doing full update if enumerating values - not just keys)
@@ -130,6 +134,7 @@ void SCX_Application_Server_Class_Provider::EnumerateInstances(
             SCX_Application_Server_Class inst;
             EnumerateOneInstance( context, inst, keysOnly, appServers->GetInstance(i) );
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
         }
         context.Post(MI_RESULT_OK);
     }
@@ -148,6 +153,8 @@ void SCX_Application_Server_Class_Provider::GetInstance(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_Application_Server", "GetInstance");
+
         if ( !instanceName.Name_exists() )
         {
             context.Post(MI_RESULT_INVALID_PARAMETER);
@@ -156,6 +163,7 @@ void SCX_Application_Server_Class_Provider::GetInstance(
 
         // Global lock for AppServerProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::AppServerProvider::Lock"));
+        timer.LockAcquired();
         SCX_LOGTRACE(log, L"SCX_Application_Server_Class_Provider::GetInstance");
 
         SCXCoreLib::SCXHandle<SCXSystemLib::AppServerEnumeration> appServers = SCXCore::g_AppServerProvider.GetAppServers();
@@ -175,6 +183,7 @@ void SCX_Application_Server_Class_Provider::GetInstance(
         SCX_Application_Server_Class inst;
         EnumerateOneInstance( context, inst, false, appInst );
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted();
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_Application_Server_Class_Provider::GetInstances", log );
@@ -215,8 +224,11 @@ void SCX_Application_Server_Class_Provider::Invoke_SetDeepMonitoring(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_Application_Server", "Invoke_SetDeepMonitoring");
+
         // Global lock for AppServerProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::AppServerProvider::Lock"));
+        timer.LockAcquired();
         SCX_LOGTRACE(log, L"SCX_Application_Server_Class_Provider::Invoke_SetDeepMonitoring");
 
         // Get the arguments:
@@ -230,6 +242,7 @@ void SCX_Application_Server_Class_Provider::Invoke_SetDeepMonitoring(
         {
             inst.MIReturn_value( false );
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_INVALID_PARAMETER);
             return;
         }
@@ -260,12 +273,14 @@ void SCX_Application_Server_Class_Provider::Invoke_SetDeepMonitoring(
         {
             inst.MIReturn_value( fDeepResult );
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_NOT_FOUND);
             return;
         }
         
         inst.MIReturn_value( fDeepResult );
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted();
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_Application_Server_Class_Provider::Invoke_SetDeepMonitoring", log );
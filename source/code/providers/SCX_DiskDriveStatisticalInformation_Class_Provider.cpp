@@ -17,11 +17,10 @@
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxnameresolver.h>
 #include "support/diskprovider.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
-
-# define QLENGTH 1000
 
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
@@ -33,11 +32,11 @@ static void EnumerateOneInstance(
     Context& context,
     SCX_DiskDriveStatisticalInformation_Class& inst,
     bool keysOnly,
-    SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> diskinst)
+    const SCXCore::DiskStatisticsSnapshotInstance& diskinst)
 {
     // Populate the key values
     std::wstring name;
-    if (diskinst->GetDiskName(name))
+    if (diskinst.GetDiskName(name))
     {
         inst.Name_value(StrToMultibyte(name).c_str());
     }
@@ -53,62 +52,63 @@ static void EnumerateOneInstance(
         double ddata2;
         bool healthy;
 
-        if (diskinst->GetHealthState(healthy))
+        if (diskinst.GetHealthState(healthy))
         {
             inst.IsOnline_value(healthy);
         }
 
-        inst.IsAggregate_value(diskinst->IsTotal());
+        inst.IsAggregate_value(diskinst.IsTotal());
 
-        if (diskinst->GetIOPercentageTotal(data1))
+        if (diskinst.GetIOPercentageTotal(data1))
         {
             inst.PercentBusyTime_value((unsigned char) data1);
             inst.PercentIdleTime_value((unsigned char) (100-data1));
         }
 
-        if (diskinst->GetBytesPerSecondTotal(data1))
+        if (diskinst.GetBytesPerSecondTotal(data1))
         {
             inst.BytesPerSecond_value(data1);
         }
 
-        if (diskinst->GetBytesPerSecond(data1, data2))
+        if (diskinst.GetBytesPerSecond(data1, data2))
         {
             inst.ReadBytesPerSecond_value(data1);
             inst.WriteBytesPerSecond_value(data2);
         }
 
-        if (diskinst->GetTransfersPerSecond(data1))
+        if (diskinst.GetTransfersPerSecond(data1))
         {
             inst.TransfersPerSecond_value(data1);
         }
 
-        if (diskinst->GetReadsPerSecond(data1))
+        if (diskinst.GetReadsPerSecond(data1))
         {
             inst.ReadsPerSecond_value(data1);
         }
 
-        if (diskinst->GetWritesPerSecond(data1))
+        if (diskinst.GetWritesPerSecond(data1))
         {
             inst.WritesPerSecond_value(data1);
         }
 
-        if (diskinst->GetIOTimesTotal(ddata1))
+        if (diskinst.GetIOTimesTotal(ddata1))
         {
             inst.AverageTransferTime_value(ddata1);
         }
 
-        if (diskinst->GetIOTimes(ddata1, ddata2))
+        if (diskinst.GetIOTimes(ddata1, ddata2))
         {
             inst.AverageReadTime_value(ddata1);
             inst.AverageWriteTime_value(ddata2);
         }
 
-        if (diskinst->GetDiskQueueLength(ddata1))
+        if (diskinst.GetDiskQueueLength(ddata1))
         {
             inst.AverageDiskQueueLength_value(ddata1);
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_DiskDriveStatisticalInformation_Class_Provider::SCX_DiskDriveStatisticalInformation_Class_Provider(
@@ -168,67 +168,58 @@ void SCX_DiskDriveStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
-
-        //  Prepare Disk Drive Enumeration
-        // (Note: Only do full update if we're not enumerating keys)
-
-        wstring diskName=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDriveStatisticalInformation Provider Filter Set with Expression: ",*expr));
-
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
+        SCXCore::ProviderCallTimer timer("SCX_DiskDriveStatisticalInformation", "EnumerateInstances");
 
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_DiskDriveStatisticalInformation where Name=%name");
+        // Statistics are read from an immutable snapshot, without holding any lock
+        // (only its refresh is serialized, see DiskProvider::GetStatisticsSnapshot())
 
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+        // Names the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDriveStatisticalInformation Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Name", names);
+            if (targeted)
             {
-                diskName=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"DiskDriveStatisticalInformation Provider Enum Requested for mount point: ",diskName));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDriveStatisticalInformation Provider Enum Requested for disks, count: ", names.size()));
             }
         }
 
-        SCXCoreLib::SCXHandle<SCXSystemLib::StatisticalPhysicalDiskEnumeration> diskEnum = SCXCore::g_DiskProvider.getEnumstatisticalPhysicalDisks();
-        diskName != L"" && diskName != L"_Total"?diskEnum->UpdateSpecific(!keysOnly, diskName, &instancePos):diskEnum->Update(!keysOnly);
-
-        if (instancePos != (size_t)-1) {
-            SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> diskInst = diskEnum->GetInstance(instancePos);
-            SCX_DiskDriveStatisticalInformation_Class inst;
-            EnumerateOneInstance(context, inst, keysOnly, diskInst);
+        if (targeted)
+        {
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                // The total instance is only part of the complete snapshot
+                SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = *it == L"_Total" ?
+                    SCXCore::g_DiskProvider.GetStatisticsSnapshot() : SCXCore::g_DiskProvider.GetStatisticsSnapshot(*it);
+
+                const SCXCore::DiskStatisticsSnapshotInstance* diskInst = snapshot->GetInstance(*it);
+                if (diskInst != NULL)
+                {
+                    SCX_DiskDriveStatisticalInformation_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, *diskInst);
+                }
+            }
         }
-        else {
-            for(size_t i = 0; i < diskEnum->Size(); i++)
+        else
+        {
+            SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = SCXCore::g_DiskProvider.GetStatisticsSnapshot();
+            for(size_t i = 0; i < snapshot->Size(); i++)
             {
                 SCX_DiskDriveStatisticalInformation_Class inst;
-                SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> diskInst = diskEnum->GetInstance(i);
-                EnumerateOneInstance(context, inst, keysOnly, diskInst);
+                EnumerateOneInstance(context, inst, keysOnly, snapshot->GetInstance(i));
             }
 
             // Enumerate Total instance
-            SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> totalInst= diskEnum->GetTotalInstance();
+            const SCXCore::DiskStatisticsSnapshotInstance* totalInst = snapshot->GetTotalInstance();
             if (totalInst != NULL)
             {
                 // There will always be one total instance
                 SCX_DiskDriveStatisticalInformation_Class inst;
-                EnumerateOneInstance(context, inst, keysOnly, totalInst);
+                EnumerateOneInstance(context, inst, keysOnly, *totalInst);
             }
         }
 
@@ -247,11 +238,7 @@ void SCX_DiskDriveStatisticalInformation_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
-
-        SCXHandle<SCXSystemLib::StatisticalPhysicalDiskEnumeration> diskEnum = SCXCore::g_DiskProvider.getEnumstatisticalPhysicalDisks();
-        diskEnum->Update(true);
+        SCXCore::ProviderCallTimer timer("SCX_DiskDriveStatisticalInformation", "GetInstance");
 
         const std::string name = instanceName.Name_value().Str();
         if (name.size() == 0)
@@ -260,8 +247,9 @@ void SCX_DiskDriveStatisticalInformation_Class_Provider::GetInstance(
             return;
         }
 
-        SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> diskInst;
-        diskInst = diskEnum->GetInstance(StrFromUTF8(name));
+        // Read from an immutable snapshot, without holding any lock
+        SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = SCXCore::g_DiskProvider.GetStatisticsSnapshot();
+        const SCXCore::DiskStatisticsSnapshotInstance* diskInst = snapshot->GetInstance(StrFromUTF8(name));
 
         if (diskInst == NULL)
         {
@@ -270,7 +258,7 @@ void SCX_DiskDriveStatisticalInformation_Class_Provider::GetInstance(
         }
 
         SCX_DiskDriveStatisticalInformation_Class inst;
-        EnumerateOneInstance(context, inst, false, diskInst);
+        EnumerateOneInstance(context, inst, false, *diskInst);
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_DiskDriveStatisticalInformation_Class_Provider::GetInstance",
@@ -15,13 +15,12 @@
 #include "SCX_DiskDrive_Class_Provider.h"
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/stringaid.h>
-#include <scxcorelib/scxnameresolver.h>
 #include "support/diskprovider.h"
+#include "support/providerstatistics.h"
+#include "support/scopingkeys.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
-
-# define QLENGTH 1000
 
 
 using namespace SCXCoreLib;
@@ -33,11 +32,9 @@ static void EnumerateOneInstance(
     Context& context,
     SCX_DiskDrive_Class& inst,
     bool keysOnly,
+    const SCXCore::RequestedProperties& requested,
     SCXHandle<SCXSystemLib::StaticPhysicalDiskInstance> diskInst)
 {
-    SCXCoreLib::NameResolver nr;
-    std::wstring hostname = nr.GetHostDomainname();
-
     diskInst->Update();
                         
     // Populate the key values
@@ -49,15 +46,26 @@ static void EnumerateOneInstance(
     {
         inst.DeviceID_value(StrToMultibyte(deviceId).c_str());
     }
-    inst.SystemName_value(StrToMultibyte(hostname).c_str());
+    std::string hostname;
+    if (SCXCore::g_ScopingKeys.GetCSName(hostname))
+    {
+        inst.SystemName_value(hostname.c_str());
+    }
 
     if (!keysOnly) 
     {
-        //populate caption and descriptions
-        inst.Caption_value("Disk drive information");
-        inst.Description_value("Information pertaining to a physical unit of secondary storage");
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Caption"))
+        {
+            inst.Caption_value("Disk drive information");
+        }
+
+        if (requested.IsRequested("Description"))
+        {
+            inst.Description_value("Information pertaining to a physical unit of secondary storage");
+        }
         
-        if (deviceId.size() > 0)
+        if (requested.IsRequested("Name") && deviceId.size() > 0)
         {
             inst.Name_value(StrToMultibyte(deviceId).c_str());
         }
@@ -66,13 +74,13 @@ static void EnumerateOneInstance(
         std::wstring sdata;
         bool healthy;
 
-        if (diskInst->GetHealthState(healthy)) 
+        if (requested.IsRequested("IsOnline") && diskInst->GetHealthState(healthy)) 
         {
             inst.IsOnline_value();
         }
 
         DiskInterfaceType ifcType;
-        if (diskInst->GetInterfaceType(ifcType)) 
+        if (requested.IsRequested("InterfaceType") && diskInst->GetInterfaceType(ifcType)) 
         {
             std::string interfaceTypeStringValue ;
             switch (ifcType) 
@@ -99,37 +107,38 @@ static void EnumerateOneInstance(
             inst.InterfaceType_value(interfaceTypeStringValue.c_str());
         }
 
-        if (diskInst->GetManufacturer(sdata)) 
+        if (requested.IsRequested("Manufacturer") && diskInst->GetManufacturer(sdata)) 
         {
             inst.Manufacturer_value(StrToMultibyte(sdata).c_str());
         }
 
-        if (diskInst->GetModel(sdata)) 
+        if (requested.IsRequested("Model") && diskInst->GetModel(sdata)) 
         {
             inst.Model_value(StrToMultibyte(sdata).c_str());
         }
 
-        if (diskInst->GetSizeInBytes(data)) 
+        if (requested.IsRequested("MaxMediaSize") && diskInst->GetSizeInBytes(data)) 
         {
             inst.MaxMediaSize_value(data);
         }
 
-        if (diskInst->GetTotalCylinders(data)) 
+        if (requested.IsRequested("TotalCylinders") && diskInst->GetTotalCylinders(data)) 
         {
             inst.TotalCylinders_value(data);
         }
 
-        if (diskInst->GetTotalHeads(data)) 
+        if (requested.IsRequested("TotalHeads") && diskInst->GetTotalHeads(data)) 
         {
             inst.TotalHeads_value(data);
         }
 
-        if (diskInst->GetTotalSectors(data)) 
+        if (requested.IsRequested("TotalSectors") && diskInst->GetTotalSectors(data)) 
         {
             inst.TotalSectors_value(data);
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_DiskDrive_Class_Provider::SCX_DiskDrive_Class_Provider(
@@ -189,57 +198,53 @@ void SCX_DiskDrive_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_DiskDrive", "EnumerateInstances");
+
         // Global lock for DiskProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        timer.LockAcquired();
         
-        wstring diskName=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDrive Provider Filter Set with Expression: ",*expr));
+        // Keys the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDrive Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_DiskDrive where DeviceID=%name");
-
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
-
-            bool status=patterenfinder.Match(filterQuery, id, param);
-
-
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"DeviceID", names);
+            if (targeted)
             {
-                diskName=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"DiskDrive Provider Enum Requested for disk: ",diskName));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"DiskDrive Provider Enum Requested for disks, count: ", names.size()));
             }
         }
 
         //  Prepare Disk Drive Enumeration
         // (Note: Only do full update if we're not enumerating keys)
         SCXHandle<SCXSystemLib::StaticPhysicalDiskEnumeration> diskEnum = SCXCore::g_DiskProvider.getEnumstaticPhysicalDisks();
-        diskName != L""?diskEnum->UpdateSpecific(diskName, &instancePos):diskEnum->Update(!keysOnly);
-        
-        if (instancePos != (size_t)-1) {
-	    SCXHandle<SCXSystemLib::StaticPhysicalDiskInstance> diskInst = diskEnum->GetInstance(instancePos);
-	    SCX_DiskDrive_Class inst;
-	    EnumerateOneInstance(context, inst, keysOnly, diskInst);
+        SCXCore::RequestedProperties requested = CIMUtils::GetRequestedProperties(propertySet, filter);
+
+        if (targeted)
+        {
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                size_t instancePos = (size_t)-1;
+                diskEnum->UpdateSpecific(*it, &instancePos);
+                if (instancePos != (size_t)-1)
+                {
+                    SCXHandle<SCXSystemLib::StaticPhysicalDiskInstance> diskInst = diskEnum->GetInstance(instancePos);
+                    SCX_DiskDrive_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, requested, diskInst);
+                }
+            }
         }
         else {
+            diskEnum->Update(!keysOnly);
             for(size_t i = 0; i < diskEnum->Size(); i++) 
             {
                 SCX_DiskDrive_Class inst;
                 SCXHandle<SCXSystemLib::StaticPhysicalDiskInstance> diskInst = diskEnum->GetInstance(i);
-                EnumerateOneInstance(context, inst, keysOnly, diskInst);
+                EnumerateOneInstance(context, inst, keysOnly, requested, diskInst);
             }
         }
 
@@ -258,8 +263,11 @@ void SCX_DiskDrive_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_DiskDrive", "GetInstance");
+
         // Global lock for DiskProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        timer.LockAcquired();
 
         // We have 4-part key:
         //   [Key] SystemCreationClassName=SCX_ComputerSystem
@@ -275,14 +283,7 @@ void SCX_DiskDrive_Class_Provider::GetInstance(
         }
 
         std::string csName;
-        try {
-            NameResolver mi;
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e) {
-            SCX_LOGWARNING(SCXCore::g_DiskProvider.GetLogHandle(), StrAppend(
-                               StrAppend(L"Can't read host/domainname because ", e.What()),
-                               e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
         // Now compare (case insensitive for the class names, case sensitive for the others)
         if ( 0 != strcasecmp("SCX_ComputerSystem", instanceName.SystemCreationClassName_value().Str())
@@ -314,7 +315,7 @@ void SCX_DiskDrive_Class_Provider::GetInstance(
         }
 
         SCX_DiskDrive_Class inst;
-        EnumerateOneInstance(context, inst, false, diskInst);
+        EnumerateOneInstance(context, inst, false, CIMUtils::GetRequestedProperties(propertySet), diskInst);
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_DiskDrive_Class_Provider::GetInstance",
@@ -435,8 +436,11 @@ void SCX_DiskDrive_Class_Provider::Invoke_RemoveByName(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_DiskDrive", "Invoke_RemoveByName");
+
         // Global lock for DiskProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        timer.LockAcquired();
         
         SCXHandle<SCXSystemLib::StaticPhysicalDiskEnumeration> diskEnum = SCXCore::g_DiskProvider.getEnumstaticPhysicalDisks();
         diskEnum->Update(true);
@@ -446,6 +450,7 @@ void SCX_DiskDrive_Class_Provider::Invoke_RemoveByName(
         {
             inst.MIReturn_value(0);
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_INVALID_PARAMETER);
             return;
         }
@@ -456,18 +461,20 @@ void SCX_DiskDrive_Class_Provider::Invoke_RemoveByName(
         {
             inst.MIReturn_value(0);
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_NOT_FOUND);
             return;
         }
 
         SCX_DiskDrive_Class ddInst;
-        EnumerateOneInstance(context, ddInst, false, diskInst);
+        EnumerateOneInstance(context, ddInst, false, SCXCore::RequestedProperties(), diskInst);
 
-        bool cmdok = SCXCore::g_DiskProvider.getEnumstatisticalPhysicalDisks()->RemoveInstanceById(name) && 
+        bool cmdok = SCXCore::g_DiskProvider.RemoveStatisticalInstance(name) && 
                              SCXCore::g_DiskProvider.getEnumstaticPhysicalDisks()->RemoveInstanceById(name);
 
         inst.MIReturn_value(cmdok);
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted();
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_DiskDrive_Class_Provider::Invoke_RemoveByName", SCXCore::g_DiskProvider.GetLogHandle() );
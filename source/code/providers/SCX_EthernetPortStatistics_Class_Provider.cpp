@@ -20,12 +20,11 @@
 #include <scxcorelib/scxthreadlock.h>
 #include <scxsystemlib/networkinterfaceenumeration.h>
 #include "support/networkprovider.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <sstream>
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
-
-# define QLENGTH 1000
 
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
@@ -64,6 +63,7 @@ static void EnumerateOneInstance(Context& context,
         inst.TotalCollisions_value(intf->GetCollisions(ulong) ? ulong : 0);
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_EthernetPortStatistics_Class_Provider::SCX_EthernetPortStatistics_Class_Provider(
@@ -124,47 +124,47 @@ void SCX_EthernetPortStatistics_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_EthernetPortStatistics", "EnumerateInstances");
+
         // Global lock for NetworkProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::NetworkProvider::Lock"));
+        timer.LockAcquired();
     
         // Update network PAL instance. This is both update of number of interfaces and
         // current statistics for each interfaces.
         SCXHandle<SCXCore::NetworkProviderDependencies> deps = SCXCore::g_NetworkProvider.getDependencies();
-        wstring interfaceString=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"EthernetPortStatistics Provider Filter Set with Expression: ",*expr));
-
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
-
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_EthernetPortStatistics where InstanceID=%name");
-
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
-
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        // Interfaces the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"EthernetPortStatistics Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"InstanceID", names);
+            if (targeted)
             {
-                interfaceString=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"EthernetPortStatistics Provider Enum Requested for Interface: ",interfaceString));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"EthernetPortStatistics Provider Enum Requested for Interfaces, count: ", names.size()));
             }
         }
 
-        deps->UpdateIntf(false, interfaceString, interfaceString==L""?NULL:&instancePos);
-
-        if (interfaceString == L""){
+        if (targeted)
+        {
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                size_t instancePos = (size_t)-1;
+                deps->UpdateIntf(false, *it, &instancePos);
+                if (instancePos != (size_t)-1)
+                {
+                    SCXCoreLib::SCXHandle<SCXSystemLib::NetworkInterfaceInstance> intf = deps->GetIntf(instancePos);
+                    SCX_EthernetPortStatistics_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, intf);
+                }
+            }
+        }
+        else
+        {
+            deps->UpdateIntf(false);
             SCX_LOGTRACE(log, StrAppend(L"Number of interfaces = ", deps->IntfCount()));
             for(size_t i = 0; i < deps->IntfCount(); i++)
             {
@@ -173,11 +173,6 @@ void SCX_EthernetPortStatistics_Class_Provider::EnumerateInstances(
                 EnumerateOneInstance(context, inst, keysOnly, intf);
             }
         }
-        else if (instancePos != (size_t)-1){
-            SCXCoreLib::SCXHandle<SCXSystemLib::NetworkInterfaceInstance> intf = deps->GetIntf(instancePos);
-            SCX_EthernetPortStatistics_Class inst;
-            EnumerateOneInstance(context, inst, keysOnly, intf);
-        }
 
         context.Post(MI_RESULT_OK);
     }
@@ -194,8 +189,11 @@ void SCX_EthernetPortStatistics_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_EthernetPortStatistics", "GetInstance");
+
         // Global lock for NetworkProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::NetworkProvider::Lock"));
+        timer.LockAcquired();
 
         SCX_LOGTRACE(SCXCore::g_NetworkProvider.GetLogHandle(), L"EthernetPortStatistics Provider GetInstances");
 
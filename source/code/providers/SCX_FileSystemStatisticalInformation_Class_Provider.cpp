@@ -18,11 +18,10 @@
 #include <scxcorelib/scxnameresolver.h>
 #include <scxcorelib/scxmath.h>
 #include "support/filesystemprovider.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
-
-# define QLENGTH 1000
 
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
@@ -33,13 +32,11 @@ static void EnumerateOneInstance(
     Context& context,
     SCX_FileSystemStatisticalInformation_Class& inst,
     bool keysOnly,
-    SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> diskinst)
+    const SCXCore::DiskStatisticsSnapshotInstance& diskinst)
 {
-    diskinst->Update();
-
     // Populate the key values
     std::wstring name;
-    if (diskinst->GetDiskName(name))
+    if (diskinst.GetDiskName(name))
     {
         inst.Name_value(StrToMultibyte(name).c_str());
     }
@@ -54,51 +51,51 @@ static void EnumerateOneInstance(
         double ddata1;
         bool healthy;
 
-        if (diskinst->GetHealthState(healthy))
+        if (diskinst.GetHealthState(healthy))
         {
             inst.IsOnline_value(healthy);
         }
 
-        inst.IsAggregate_value(diskinst->IsTotal());
+        inst.IsAggregate_value(diskinst.IsTotal());
 
-        if (diskinst->GetIOPercentageTotal(data1))
+        if (diskinst.GetIOPercentageTotal(data1))
         {
             inst.PercentBusyTime_value((unsigned char) data1);
             inst.PercentIdleTime_value((unsigned char) (100-data1));
         }
 
-        if (diskinst->GetBytesPerSecondTotal(data1))
+        if (diskinst.GetBytesPerSecondTotal(data1))
         {
             inst.BytesPerSecond_value(data1);
         }
 
-        if (diskinst->GetBytesPerSecond(data1, data2))
+        if (diskinst.GetBytesPerSecond(data1, data2))
         {
             inst.ReadBytesPerSecond_value(data1);
             inst.WriteBytesPerSecond_value(data2);
         }
 
-        if (diskinst->GetTransfersPerSecond(data1))
+        if (diskinst.GetTransfersPerSecond(data1))
         {
             inst.TransfersPerSecond_value(data1);
         }
 
-        if (diskinst->GetReadsPerSecond(data1))
+        if (diskinst.GetReadsPerSecond(data1))
         {
             inst.ReadsPerSecond_value(data1);
         }
 
-        if (diskinst->GetWritesPerSecond(data1))
+        if (diskinst.GetWritesPerSecond(data1))
         {
             inst.WritesPerSecond_value(data1);
         }
 
-        if (diskinst->GetIOTimesTotal(ddata1))
+        if (diskinst.GetIOTimesTotal(ddata1))
         {
             inst.AverageTransferTime_value(ddata1);
         }
 
-        if (diskinst->GetDiskSize(data1, data2))
+        if (diskinst.GetDiskSize(data1, data2))
         {
             inst.FreeMegabytes_value(data2);
             inst.UsedMegabytes_value(data1);
@@ -115,7 +112,7 @@ static void EnumerateOneInstance(
 
         // Report percentages for inodes even if inode data is not known
         {
-            if (!diskinst->GetInodeUsage(data1, data2))
+            if (!diskinst.GetInodeUsage(data1, data2))
             {
                 data1 = data2 = 0;
             }
@@ -132,12 +129,13 @@ static void EnumerateOneInstance(
             inst.PercentUsedInodes_value(usedInodes);
         }
 
-        if (diskinst->GetDiskQueueLength(ddata1))
+        if (diskinst.GetDiskQueueLength(ddata1))
         {
             inst.AverageDiskQueueLength_value(ddata1);
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_FileSystemStatisticalInformation_Class_Provider::SCX_FileSystemStatisticalInformation_Class_Provider(
@@ -155,8 +153,8 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::Load(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
         SCXCore::g_FileSystemProvider.Load();
 
         // Notify that we don't wish to unload
@@ -177,8 +175,8 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::Unload(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
         SCXCore::g_FileSystemProvider.UnLoad();
         context.Post(MI_RESULT_OK);
     }
@@ -197,68 +195,58 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
-
-        // Prepare File System Enumeration
-        // (Note: Only do full update if we're not enumerating keys)
-
-        wstring mountPoint=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystemStatisticalInformation Provider Filter Set with Expression: ",*expr));
+        SCXCore::ProviderCallTimer timer("SCX_FileSystemStatisticalInformation", "EnumerateInstances");
 
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
+        // Statistics are read from an immutable snapshot, without holding any lock
+        // (only its refresh is serialized, see FileSystemProvider::GetStatisticsSnapshot())
 
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_FileSystemStatisticalInformation where Name=%name");
+        // Names the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystemStatisticalInformation Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
-
-
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Name", names);
+            if (targeted)
             {
-                mountPoint=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"FileSystemStatisticalInformation Provider Enum Requested for mount point: ",mountPoint));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystemStatisticalInformation Provider Enum Requested for mount points, count: ", names.size()));
             }
         }
 
-        SCXHandle<SCXSystemLib::StatisticalLogicalDiskEnumeration> diskEnum = SCXCore::g_FileSystemProvider.getEnumstatisticalLogicalDisks();
-
-        mountPoint != L"" && mountPoint != L"_Total"?diskEnum->UpdateSpecific(mountPoint, &instancePos):diskEnum->Update(!keysOnly); 
-        if (instancePos != (size_t)-1)
+        if (targeted)
         {
-            SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> diskInst = diskEnum->GetInstance(instancePos);
-            SCX_FileSystemStatisticalInformation_Class inst;
-            EnumerateOneInstance(context, inst, keysOnly, diskInst);
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                // The total instance is only part of the complete snapshot
+                SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = *it == L"_Total" ?
+                    SCXCore::g_FileSystemProvider.GetStatisticsSnapshot() : SCXCore::g_FileSystemProvider.GetStatisticsSnapshot(*it);
+
+                const SCXCore::DiskStatisticsSnapshotInstance* diskInst = snapshot->GetInstance(*it);
+                if (diskInst != NULL)
+                {
+                    SCX_FileSystemStatisticalInformation_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, *diskInst);
+                }
+            }
         }
         else
         {
-            for(size_t i = 0; i < diskEnum->Size(); i++)
+            SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+            for(size_t i = 0; i < snapshot->Size(); i++)
             {
-                SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> diskInst = diskEnum->GetInstance(i);
                 SCX_FileSystemStatisticalInformation_Class inst;
-                EnumerateOneInstance(context, inst, keysOnly, diskInst);
+                EnumerateOneInstance(context, inst, keysOnly, snapshot->GetInstance(i));
             }
 
-            SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> totalInst= diskEnum->GetTotalInstance();
+            // Enumerate Total instance
+            const SCXCore::DiskStatisticsSnapshotInstance* totalInst = snapshot->GetTotalInstance();
             if (totalInst != NULL)
             {
-            	// There will always be one total instance
-            	SCX_FileSystemStatisticalInformation_Class inst;
-            	EnumerateOneInstance(context, inst, keysOnly, totalInst);
+                // There will always be one total instance
+                SCX_FileSystemStatisticalInformation_Class inst;
+                EnumerateOneInstance(context, inst, keysOnly, *totalInst);
             }
         }
 
@@ -277,11 +265,7 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
-
-        SCXHandle<SCXSystemLib::StatisticalLogicalDiskEnumeration> diskEnum = SCXCore::g_FileSystemProvider.getEnumstatisticalLogicalDisks();
-        diskEnum->Update(true);
+        SCXCore::ProviderCallTimer timer("SCX_FileSystemStatisticalInformation", "GetInstance");
 
         const std::string name = instanceName.Name_value().Str();
 
@@ -291,8 +275,9 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::GetInstance(
             return;
         }
 
-        SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> diskInst;
-        diskInst = diskEnum->GetInstance(StrFromUTF8(name));
+        // Read from an immutable snapshot, without holding any lock
+        SCXHandle<SCXCore::DiskStatisticsSnapshot> snapshot = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        const SCXCore::DiskStatisticsSnapshotInstance* diskInst = snapshot->GetInstance(StrFromUTF8(name));
 
         if (diskInst == NULL)
         {
@@ -301,7 +286,7 @@ void SCX_FileSystemStatisticalInformation_Class_Provider::GetInstance(
         }
 
         SCX_FileSystemStatisticalInformation_Class inst;
-        EnumerateOneInstance(context, inst, false, diskInst);
+        EnumerateOneInstance(context, inst, false, *diskInst);
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_FileSystemStatisticalInformation_Class_Provider::GetInstance", 
@@ -17,29 +17,76 @@
 #include <scxcorelib/scxexception.h>
 #include <scxcorelib/scxassert.h>
 #include <scxcorelib/stringaid.h>
-#include <scxcorelib/scxnameresolver.h>
 #include "support/filesystemprovider.h"
+#include "support/providerstatistics.h"
+#include "support/scopingkeys.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
 
-# define QLENGTH 1000
+#include <vector>
 
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
 
 MI_BEGIN_NAMESPACE
 
+//! CIM_ManagedSystemElement.OperationalStatus value of a file system not responding ("Lost Communication")
+static const Uint16 cOperationalStatusLostCommunication = 13;
+
+/*----------------------------------------------------------------------------*/
+/**
+    Mark a file system whose mount point doesn't respond (see MountProbe)
+
+    \param[out]    inst       Instance of the file system
+    \param[in]     requested  Properties requested by the client
+    \param[in]     status     State of the mount point
+*/
+static void SetUnavailable(
+    SCX_FileSystem_Class& inst,
+    const SCXCore::RequestedProperties& requested,
+    SCXCore::MountProbe::Status status)
+{
+    if (requested.IsRequested("IsOnline"))
+    {
+        inst.IsOnline_value(false);
+    }
+
+    if (requested.IsRequested("Status"))
+    {
+        inst.Status_value("Lost Comm");
+    }
+
+    if (requested.IsRequested("OperationalStatus"))
+    {
+        Uint16A operationalStatus(&cOperationalStatusLostCommunication, 1);
+        inst.OperationalStatus_value(operationalStatus);
+    }
+
+    if (requested.IsRequested("StatusDescriptions"))
+    {
+        String description(SCXCore::MountProbe::eQuarantined == status ?
+                           "Mount point repeatedly did not respond in time, not probed for now" :
+                           "Mount point did not respond in time");
+        StringA descriptions(&description, 1);
+        inst.StatusDescriptions_value(descriptions);
+    }
+}
+
 static void EnumerateOneInstance(
     Context& context,
     SCX_FileSystem_Class& inst,
     bool keysOnly,
-    SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> diskinst)
+    const SCXCore::RequestedProperties& requested,
+    SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> diskinst,
+    SCXCore::MountProbe::Status status)
 {
-    SCXCoreLib::NameResolver nr;
-    std::wstring hostname = nr.GetHostDomainname();
-
-    diskinst->Update();
+    // A file system whose mount point doesn't respond can't be updated without blocking
+    bool available = SCXCore::MountProbe::eAvailable == status;
+    if (available)
+    {
+        diskinst->Update();
+    }
 
     std::wstring name;
     if (diskinst->GetDeviceName(name)) 
@@ -49,82 +96,104 @@ static void EnumerateOneInstance(
 
     inst.CreationClassName_value("SCX_FileSystem");
     inst.CSCreationClassName_value("SCX_ComputerSystem");
-    inst.CSName_value(StrToMultibyte(hostname).c_str());
+    std::string hostname;
+    if (SCXCore::g_ScopingKeys.GetCSName(hostname))
+    {
+        inst.CSName_value(hostname.c_str());
+    }
 
     if (!keysOnly) 
     {
-        inst.Caption_value("File system information");
-        inst.Description_value("Information about a logical unit of secondary storage");
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Caption"))
+        {
+            inst.Caption_value("File system information");
+        }
+
+        if (requested.IsRequested("Description"))
+        {
+            inst.Description_value("Information about a logical unit of secondary storage");
+        }
 
         scxulong data;
         std::wstring sdata;
         bool bdata;
 
-        if (diskinst->GetHealthState(bdata)) 
+        if (requested.IsRequested("Root") && diskinst->GetMountpoint(sdata)) 
         {
-            inst.IsOnline_value(bdata);
+            inst.Root_value(StrToMultibyte(sdata).c_str());
         }
 
-        if (diskinst->GetMountpoint(sdata)) 
+        if (requested.IsRequested("FileSystemType") && diskinst->GetFileSystemType(sdata)) 
         {
-            inst.Root_value(StrToMultibyte(sdata).c_str());
+            inst.FileSystemType_value(StrToMultibyte(sdata).c_str());
         }
 
-        if (diskinst->GetFileSystemType(sdata)) 
+        if (!available)
         {
-            inst.FileSystemType_value(StrToMultibyte(sdata).c_str());
+            // Only what is known without updating the file system is posted
+            SetUnavailable(inst, requested, status);
+            context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
+            return;
+        }
+
+        if (requested.IsRequested("IsOnline") && diskinst->GetHealthState(bdata)) 
+        {
+            inst.IsOnline_value(bdata);
         }
 
-        if (diskinst->GetSizeInBytes(data)) 
+        if (requested.IsRequested("FileSystemSize") && diskinst->GetSizeInBytes(data)) 
         {
             inst.FileSystemSize_value(data);
         }
 
-        if (diskinst->GetCompressionMethod(sdata)) 
+        if (requested.IsRequested("CompressionMethod") && diskinst->GetCompressionMethod(sdata)) 
         {
             inst.CompressionMethod_value(StrToMultibyte(sdata).c_str());
         }
 
-        if (diskinst->GetIsReadOnly(bdata)) 
+        if (requested.IsRequested("ReadOnly") && diskinst->GetIsReadOnly(bdata)) 
         {
             inst.ReadOnly_value(bdata);
         }
 
-        if (diskinst->GetEncryptionMethod(sdata)) 
+        if (requested.IsRequested("EncryptionMethod") && diskinst->GetEncryptionMethod(sdata)) 
         {
             inst.EncryptionMethod_value(StrToMultibyte(sdata).c_str());
         }
 
         int idata;
-        if (diskinst->GetPersistenceType(idata)) 
+        if (requested.IsRequested("PersistenceType") && diskinst->GetPersistenceType(idata)) 
         {
             inst.PersistenceType_value(static_cast<unsigned short>(idata));
         }
 
-        if (diskinst->GetBlockSize(data)) 
+        if (requested.IsRequested("BlockSize") && diskinst->GetBlockSize(data)) 
         {
             inst.BlockSize_value(data);
         }
 
-        if (diskinst->GetAvailableSpaceInBytes(data)) 
+        if (requested.IsRequested("AvailableSpace") && diskinst->GetAvailableSpaceInBytes(data)) 
         {
             inst.AvailableSpace_value(data);
         }
                          
         scxulong inodesTotal, inodesFree;
-        if (diskinst->GetTotalInodes(inodesTotal) && diskinst->GetAvailableInodes(inodesFree)) 
+        if ((requested.IsAnyRequested("TotalInodes", "FreeInodes") || requested.IsRequested("NumberOfFiles"))
+            && diskinst->GetTotalInodes(inodesTotal) && diskinst->GetAvailableInodes(inodesFree))
         {
             inst.TotalInodes_value(inodesTotal);
             inst.FreeInodes_value(inodesFree);
             inst.NumberOfFiles_value(inodesTotal - inodesFree);
         }
 
-        if (diskinst->GetIsCaseSensitive(bdata)) 
+        if (requested.IsRequested("CaseSensitive") && diskinst->GetIsCaseSensitive(bdata)) 
         {
             inst.CaseSensitive_value(bdata);
         }
 
-        if (diskinst->GetIsCasePreserved(bdata)) 
+        if (requested.IsRequested("CasePreserved") && diskinst->GetIsCasePreserved(bdata)) 
         {
             inst.CasePreserved_value(bdata);
         }
@@ -138,12 +207,49 @@ static void EnumerateOneInstance(
           }
         */
 
-        if (diskinst->GetMaxFilenameLen(data)) 
+        if (requested.IsRequested("MaxFileNameLength") && diskinst->GetMaxFilenameLen(data)) 
         {
             inst.MaxFileNameLength_value(static_cast<unsigned int>(data));
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+    Post file systems, probing all their mount points at once first
+
+    A request waits at most for one probe timeout, however many mount points
+    don't respond (see MountProbe); those are posted without being updated.
+
+    \param[in]     context    Context of the request
+    \param[in]     keysOnly   Only post the keys?
+    \param[in]     requested  Properties requested by the client
+    \param[in]     disks      File systems to post (not updated yet)
+*/
+static void EnumerateDisks(
+    Context& context,
+    bool keysOnly,
+    const SCXCore::RequestedProperties& requested,
+    const std::vector<SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> >& disks)
+{
+    std::vector<std::wstring> mountPoints;
+    for (size_t i = 0; i < disks.size(); i++)
+    {
+        std::wstring mountPoint;
+        disks[i]->GetMountpoint(mountPoint);
+        mountPoints.push_back(mountPoint);
+    }
+
+    std::vector<SCXCore::MountProbe::Status> statuses;
+    SCXCore::g_FileSystemProvider.GetMountProbe().Probe(mountPoints, statuses);
+
+    for (size_t i = 0; i < disks.size(); i++)
+    {
+        SCX_FileSystem_Class inst;
+        EnumerateOneInstance(context, inst, keysOnly, requested, disks[i], statuses[i]);
+    }
 }
 
 SCX_FileSystem_Class_Provider::SCX_FileSystem_Class_Provider(
@@ -161,8 +267,8 @@ void SCX_FileSystem_Class_Provider::Load(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
         SCXCore::g_FileSystemProvider.Load();
 
         // Notify that we don't wish to unload
@@ -183,8 +289,8 @@ void SCX_FileSystem_Class_Provider::Unload(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
         SCXCore::g_FileSystemProvider.UnLoad();
         context.Post(MI_RESULT_OK);
     }
@@ -203,60 +309,54 @@ void SCX_FileSystem_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
-
-        wstring mountPoint=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystem Provider Filter Set with Expression: ",*expr));
-
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
+        SCXCore::ProviderCallTimer timer("SCX_FileSystem", "EnumerateInstances");
 
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_FileSystem where Name=%name");
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
+        timer.LockAcquired();
 
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+        // Keys the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystem Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Name", names);
+            if (targeted)
             {
-                mountPoint=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"FileSystem Provider Enum Requested for mount point: ",mountPoint));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"FileSystem Provider Enum Requested for mount points, count: ", names.size()));
             }
         }
 
-        // (Note: Only do full update if we're not enumerating keys) 
+        // (Note: The file systems are only found here; each one is updated once its mount point responded)
         SCXHandle<SCXSystemLib::StaticLogicalDiskEnumeration> staticLogicalDisksEnum = SCXCore::g_FileSystemProvider.getEnumstaticLogicalDisks();
-        mountPoint != L""?staticLogicalDisksEnum->UpdateSpecific(!keysOnly,mountPoint,&instancePos):staticLogicalDisksEnum->Update(!keysOnly);
+        SCXCore::RequestedProperties requested = CIMUtils::GetRequestedProperties(propertySet, filter);
+        std::vector<SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> > disks;
 
-        if (instancePos != (size_t)-1)
+        if (targeted)
         {
-            SCX_FileSystem_Class inst;
-            SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> diskinst = staticLogicalDisksEnum->GetInstance(instancePos);
-            EnumerateOneInstance(context, inst, keysOnly, diskinst);
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                size_t instancePos = (size_t)-1;
+                staticLogicalDisksEnum->UpdateSpecific(false, *it, &instancePos);
+                if (instancePos != (size_t)-1)
+                {
+                    disks.push_back(staticLogicalDisksEnum->GetInstance(instancePos));
+                }
+            }
         }
         else {
+            staticLogicalDisksEnum->Update(false);
             for(size_t i = 0; i < staticLogicalDisksEnum->Size(); i++) 
             {
-                SCX_FileSystem_Class inst;
-                SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> diskinst = staticLogicalDisksEnum->GetInstance(i);
-                EnumerateOneInstance(context, inst, keysOnly, diskinst);
+                disks.push_back(staticLogicalDisksEnum->GetInstance(i));
             }
         }
 
+        EnumerateDisks(context, keysOnly, requested, disks);
+
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_FileSystem_Class_Provider::EnumerateInstances", log );
@@ -272,8 +372,11 @@ void SCX_FileSystem_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        SCXCore::ProviderCallTimer timer("SCX_FileSystem", "GetInstance");
+
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
+        timer.LockAcquired();
 
         // We have 4-part key:
         //   [Key] Name=/boot
@@ -289,14 +392,7 @@ void SCX_FileSystem_Class_Provider::GetInstance(
         }
 
         std::string csName;
-        try {
-            NameResolver mi;
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e) {
-            SCX_LOGWARNING(SCXCore::g_FileSystemProvider.GetLogHandle(), StrAppend(
-                               StrAppend(L"Can't read host/domainname because ", e.What()),
-                               e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
         // Now compare (case insensitive for the class names, case sensitive for the others)
         if ( 0 != strcasecmp("SCX_ComputerSystem", instanceName.CSCreationClassName_value().Str())
@@ -308,7 +404,7 @@ void SCX_FileSystem_Class_Provider::GetInstance(
         }
 
         SCXHandle<SCXSystemLib::StaticLogicalDiskEnumeration> staticLogicalDisksEnum = SCXCore::g_FileSystemProvider.getEnumstaticLogicalDisks();
-        staticLogicalDisksEnum->Update(true);
+        staticLogicalDisksEnum->Update(false);
 
         const std::string name = (instanceName.Name_value()).Str();
         if (name.size() == 0)
@@ -326,8 +422,8 @@ void SCX_FileSystem_Class_Provider::GetInstance(
             return;
         }
 
-        SCX_FileSystem_Class inst;
-        EnumerateOneInstance(context, inst, false, diskinst);
+        std::vector<SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> > disks(1, diskinst);
+        EnumerateDisks(context, false, CIMUtils::GetRequestedProperties(propertySet), disks);
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_FileSystem_Class_Provider::GetInstance",
@@ -376,17 +472,21 @@ void SCX_FileSystem_Class_Provider::Invoke_RemoveByName(
 {
     SCX_PEX_BEGIN
         {
-        // Global lock for DiskProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::DiskProvider::Lock"));
+        SCXCore::ProviderCallTimer timer("SCX_FileSystem", "Invoke_RemoveByName");
+
+        // Global lock for FileSystemProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::FileSystemProvider::Lock"));
+        timer.LockAcquired();
         
         SCXHandle<SCXSystemLib::StaticLogicalDiskEnumeration> staticLogicalDisksEnum = SCXCore::g_FileSystemProvider.getEnumstaticLogicalDisks();
-        staticLogicalDisksEnum->Update(true);
+        staticLogicalDisksEnum->Update(false);
 
         SCX_FileSystem_RemoveByName_Class inst;
         if (!in.Name_exists() || strlen(in.Name_value().Str()) == 0)
         {
             inst.MIReturn_value(0);
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_INVALID_PARAMETER);
             return;
         }
@@ -397,18 +497,20 @@ void SCX_FileSystem_Class_Provider::Invoke_RemoveByName(
         {
             inst.MIReturn_value(0);
             context.Post(inst);
+            SCXCore::ProviderCallTimer::InstancePosted();
             context.Post(MI_RESULT_NOT_FOUND);
             return;
         }
 
-        SCX_FileSystem_Class fsInst;
-        EnumerateOneInstance(context, fsInst, false, diskinst);
+        std::vector<SCXHandle<SCXSystemLib::StaticLogicalDiskInstance> > disks(1, diskinst);
+        EnumerateDisks(context, false, SCXCore::RequestedProperties(), disks);
 
-        bool cmdok = SCXCore::g_FileSystemProvider.getEnumstatisticalLogicalDisks()->RemoveInstanceById(name) && 
+        bool cmdok = SCXCore::g_FileSystemProvider.RemoveStatisticalInstance(name) && 
                              SCXCore::g_FileSystemProvider.getEnumstaticLogicalDisks()->RemoveInstanceById(name);
 
         inst.MIReturn_value(cmdok);
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted();
         context.Post(MI_RESULT_OK);
         }
         SCX_PEX_END( L"SCX_FileSystem_Class_Provider::Invoke_RemoveByName", SCXCore::g_FileSystemProvider.GetLogHandle() );
@@ -18,15 +18,15 @@
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxthreadlock.h>
-#include <scxcorelib/scxnameresolver.h>
 #include <scxsystemlib/networkinterfaceenumeration.h>
 #include "support/networkprovider.h"
+#include "support/providerstatistics.h"
+#include "support/scopingkeys.h"
 #include "support/scxcimutils.h"
+#include "support/wqlfiltercache.h"
 #include <sstream>
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
 
-# define QLENGTH 1000
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
 using namespace SCXCore;
@@ -43,8 +43,11 @@ static void EnumerateOneInstance(Context& context,
 
     // Add the scoping systems keys.
     inst.SystemCreationClassName_value("SCX_ComputerSystem");
-    SCXCoreLib::NameResolver mi;
-    inst.SystemName_value(StrToMultibyte(mi.GetHostDomainname()).c_str());
+    std::string hostname;
+    if (SCXCore::g_ScopingKeys.GetCSName(hostname))
+    {
+        inst.SystemName_value(hostname.c_str());
+    }
     if (!keysOnly)
     {
         inst.InstanceID_value(StrToMultibyte(intf->GetName()).c_str());
@@ -62,6 +65,7 @@ static void EnumerateOneInstance(Context& context,
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_LANEndpoint_Class_Provider::SCX_LANEndpoint_Class_Provider(
@@ -122,49 +126,50 @@ void SCX_LANEndpoint_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_LANEndpoint", "EnumerateInstances");
+
         // Global lock for NetworkProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::NetworkProvider::Lock"));
+        timer.LockAcquired();
 
-        // Update network PAL instance. If filter parameter provided then "interfaceString" will be not blank.
-        // If "interfaceString" is blank this will update both number of interfaces and returns current statistics for
-        // each interfaces else update the instance for the interface given as parameter and return statistics of that interface.
+        // Update network PAL instance. If the filter names the interfaces wanted, only those are
+        // updated and returned; otherwise this updates both the number of interfaces and the
+        // current statistics for each interface.
 
         SCXHandle<SCXCore::NetworkProviderDependencies> deps = SCXCore::g_NetworkProvider.getDependencies();
 
-	wstring interfaceString=L"";
-        size_t instancePos=(size_t)-1;
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"LANEndpoint Provider Filter Set with Expression: ",*expr));
-
-	    std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
-
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_LANEndpoint where Name=%name");
-
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+        // Interfaces the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"LANEndpoint Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            if ( status && param.end() != param.find(L"name") && id == s_patternID )
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Name", names);
+            if (targeted)
             {
-                interfaceString=param.find(L"name")->second;
-                SCX_LOGTRACE(log,  SCXCoreLib::StrAppend(L"LANEndpoint Provider Enum Requested for Interface: ",interfaceString));
+                SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"LANEndpoint Provider Enum Requested for Interfaces, count: ", names.size()));
             }
         }
 
-        deps->UpdateIntf(false, interfaceString, interfaceString==L""?NULL:&instancePos);
-
-        if (interfaceString == L""){
+        if (targeted)
+        {
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                size_t instancePos = (size_t)-1;
+                deps->UpdateIntf(false, *it, &instancePos);
+                if (instancePos != (size_t)-1)
+                {
+                    SCXCoreLib::SCXHandle<SCXSystemLib::NetworkInterfaceInstance> intf = deps->GetIntf(instancePos);
+                    SCX_LANEndpoint_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, intf);
+                }
+            }
+        }
+        else
+        {
+            deps->UpdateIntf(false);
             SCX_LOGTRACE(log, StrAppend(L"Number of interfaces = ", deps->IntfCount()));
             for(size_t i = 0; i < deps->IntfCount(); i++)
             {
@@ -173,11 +178,6 @@ void SCX_LANEndpoint_Class_Provider::EnumerateInstances(
                 EnumerateOneInstance(context, inst, keysOnly, intf);
             }
         }
-        else if (instancePos != (size_t)-1){
-            SCXCoreLib::SCXHandle<SCXSystemLib::NetworkInterfaceInstance> intf = deps->GetIntf(instancePos);
-            SCX_LANEndpoint_Class inst;
-            EnumerateOneInstance(context, inst, keysOnly, intf);
-        }
 
         context.Post(MI_RESULT_OK);
     }
@@ -194,8 +194,11 @@ void SCX_LANEndpoint_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_LANEndpoint", "GetInstance");
+
         // Global lock for NetworkProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::NetworkProvider::Lock"));
+        timer.LockAcquired();
 
         // We have 4-part key:
         //   [Key] Name=eth0
@@ -211,14 +214,7 @@ void SCX_LANEndpoint_Class_Provider::GetInstance(
         }
 
         std::string csName;
-        try {
-            NameResolver mi;
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e) {
-            SCX_LOGWARNING(SCXCore::g_NetworkProvider.GetLogHandle(), StrAppend(
-                               StrAppend(L"Can't read host/domainname because ", e.What()),
-                               e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
         // Now compare (case insensitive for the class names, case sensitive for the others)
         if ( 0 != strcasecmp("SCX_ComputerSystem", instanceName.SystemCreationClassName_value().Str())
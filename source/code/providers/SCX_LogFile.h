@@ -893,6 +893,9 @@ typedef struct _SCX_LogFile_GetMatchedRows
     /*IN*/ MI_ConstStringField qid;
     /*OUT*/ MI_ConstStringAField rows;
     /*IN*/ MI_ConstStringField elevationType;
+    /*IN*/ MI_ConstUint32Field maxRows;
+    /*IN*/ MI_ConstUint32Field maxBytes;
+    /*IN-OUT*/ MI_ConstStringField resumePosition;
 }
 SCX_LogFile_GetMatchedRows;
 
@@ -1125,6 +1128,70 @@ MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Clear_elevationType(
         5);
 }
 
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Set_maxRows(
+    SCX_LogFile_GetMatchedRows* self,
+    MI_Uint32 x)
+{
+    ((MI_Uint32Field*)&self->maxRows)->value = x;
+    ((MI_Uint32Field*)&self->maxRows)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Clear_maxRows(
+    SCX_LogFile_GetMatchedRows* self)
+{
+    memset((void*)&self->maxRows, 0, sizeof(self->maxRows));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Set_maxBytes(
+    SCX_LogFile_GetMatchedRows* self,
+    MI_Uint32 x)
+{
+    ((MI_Uint32Field*)&self->maxBytes)->value = x;
+    ((MI_Uint32Field*)&self->maxBytes)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Clear_maxBytes(
+    SCX_LogFile_GetMatchedRows* self)
+{
+    memset((void*)&self->maxBytes, 0, sizeof(self->maxBytes));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Set_resumePosition(
+    SCX_LogFile_GetMatchedRows* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        8,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_SetPtr_resumePosition(
+    SCX_LogFile_GetMatchedRows* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        8,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_LogFile_GetMatchedRows_Clear_resumePosition(
+    SCX_LogFile_GetMatchedRows* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        8);
+}
+
 /*
 **==============================================================================
 **
@@ -1744,6 +1811,126 @@ public:
         const size_t n = offsetof(Self, elevationType);
         GetField<String>(n).Clear();
     }
+
+    //
+    // SCX_LogFile_GetMatchedRows_Class.maxRows
+    //
+    
+    const Field<Uint32>& maxRows() const
+    {
+        const size_t n = offsetof(Self, maxRows);
+        return GetField<Uint32>(n);
+    }
+    
+    void maxRows(const Field<Uint32>& x)
+    {
+        const size_t n = offsetof(Self, maxRows);
+        GetField<Uint32>(n) = x;
+    }
+    
+    const Uint32& maxRows_value() const
+    {
+        const size_t n = offsetof(Self, maxRows);
+        return GetField<Uint32>(n).value;
+    }
+    
+    void maxRows_value(const Uint32& x)
+    {
+        const size_t n = offsetof(Self, maxRows);
+        GetField<Uint32>(n).Set(x);
+    }
+    
+    bool maxRows_exists() const
+    {
+        const size_t n = offsetof(Self, maxRows);
+        return GetField<Uint32>(n).exists ? true : false;
+    }
+    
+    void maxRows_clear()
+    {
+        const size_t n = offsetof(Self, maxRows);
+        GetField<Uint32>(n).Clear();
+    }
+
+    //
+    // SCX_LogFile_GetMatchedRows_Class.maxBytes
+    //
+    
+    const Field<Uint32>& maxBytes() const
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        return GetField<Uint32>(n);
+    }
+    
+    void maxBytes(const Field<Uint32>& x)
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        GetField<Uint32>(n) = x;
+    }
+    
+    const Uint32& maxBytes_value() const
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        return GetField<Uint32>(n).value;
+    }
+    
+    void maxBytes_value(const Uint32& x)
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        GetField<Uint32>(n).Set(x);
+    }
+    
+    bool maxBytes_exists() const
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        return GetField<Uint32>(n).exists ? true : false;
+    }
+    
+    void maxBytes_clear()
+    {
+        const size_t n = offsetof(Self, maxBytes);
+        GetField<Uint32>(n).Clear();
+    }
+
+    //
+    // SCX_LogFile_GetMatchedRows_Class.resumePosition
+    //
+    
+    const Field<String>& resumePosition() const
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        return GetField<String>(n);
+    }
+    
+    void resumePosition(const Field<String>& x)
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        GetField<String>(n) = x;
+    }
+    
+    const String& resumePosition_value() const
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        return GetField<String>(n).value;
+    }
+    
+    void resumePosition_value(const String& x)
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        GetField<String>(n).Set(x);
+    }
+    
+    bool resumePosition_exists() const
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        return GetField<String>(n).exists ? true : false;
+    }
+    
+    void resumePosition_clear()
+    {
+        const size_t n = offsetof(Self, resumePosition);
+        GetField<String>(n).Clear();
+    }
 };
 
 typedef Array<SCX_LogFile_GetMatchedRows_Class> SCX_LogFile_GetMatchedRows_ClassA;
@@ -20,6 +20,7 @@
 #include <scxcorelib/stringaid.h>
 
 #include "support/logfileprovider.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
 
 #include <errno.h>
@@ -155,7 +156,10 @@ void SCX_LogFile_Class_Provider::Invoke_GetMatchedRows(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_LogFile", "Invoke_GetMatchedRows");
+
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::LogFileProvider::Lock"));
+        timer.LockAcquired();
 
         // Validate that we have mandatory arguments
         if ( !in.filename_exists() || !in.regexps_exists() || !in.qid_exists() )
@@ -169,6 +173,11 @@ void SCX_LogFile_Class_Provider::Invoke_GetMatchedRows(
         //   regexps       : string array
         //   qid           : string
         //   elevationType : [Optional] string
+        //   maxRows       : [Optional] uint32 (max number of rows returned, 0 for the default)
+        //   maxBytes      : [Optional] uint32 (max size of the rows returned, 0 for the default)
+        //   resumePosition: [Optional] string (resume position returned by an earlier call, to
+        //                   read again from there; by default, reading resumes where the last
+        //                   call stopped)
 
         std::wstring filename = SCXCoreLib::StrFromMultibyte( in.filename_value().Str() );
         const StringA regexps_sa = in.regexps_value();
@@ -187,10 +196,31 @@ void SCX_LogFile_Class_Provider::Invoke_GetMatchedRows(
             fPerformElevation = true;
         }
 
+        // The reader caps what may be asked for: a burst is drained in several
+        // calls, each returning the position the next one resumes at
+        size_t maxRows = SCXCore::LogFileReader::cDefaultMaxRows;
+        if ( in.maxRows_exists() && 0 != in.maxRows_value() )
+        {
+            maxRows = in.maxRows_value();
+        }
+        size_t maxBytes = SCXCore::LogFileReader::cDefaultMaxBytes;
+        if ( in.maxBytes_exists() && 0 != in.maxBytes_value() )
+        {
+            maxBytes = in.maxBytes_value();
+        }
+        std::wstring resumePosition;
+        if ( in.resumePosition_exists() )
+        {
+            resumePosition = SCXCoreLib::StrFromMultibyte( in.resumePosition_value().Str() );
+        }
+
         SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - filename = ", filename));
         SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - qid = ", qid));
         SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - regexp count = ", regexps_sa.GetSize()));
         SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - elevate = ", elevationType));
+        SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - maxRows = ", maxRows));
+        SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - maxBytes = ", maxBytes));
+        SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"SCXLogFileProvider::InvokeMatchedRows - resumePosition = ", resumePosition));
 
         // Extract and parse the regular expressions
 
@@ -228,29 +258,37 @@ void SCX_LogFile_Class_Provider::Invoke_GetMatchedRows(
         }
 
         SCX_LogFile_GetMatchedRows_Class inst;
+        size_t rowsSize = 0;
         try
         {
             // Call helper function to get the data
             std::vector<std::wstring> matchedLines;
             bool bWasPartialRead = SCXCore::g_LogFileProvider.InvokeLogFileReader(
-                filename, qid, regexps, fPerformElevation, matchedLines);
+                filename, qid, regexps, fPerformElevation, matchedLines, maxRows, maxBytes, &resumePosition);
 
             // Add each match to the result property set
             //
             // Reserve space in the vector for efficiency:
             //   Current size + # of lines to add + 1 (for potential "MoreRowsAvailable")
+            //
+            // Each line is released once converted, so large pages aren't held twice
             returnData.reserve( returnData.size() + matchedLines.size() + 1 );
             for (std::vector<std::wstring>::iterator it = matchedLines.begin();
                  it != matchedLines.end();
                  it++)
             {
                 InsertOneString( context, returnData, *it );
+                rowsSize += it->size();
+                std::wstring().swap( *it );
             }
 
-            // Set "MoreRowsAvailable" if we terminated early
+            // Set "MoreRowsAvailable" if we terminated early, along with the position
+            // the next call resumes at (passed back, it reads the following rows again
+            // should these be lost)
             if (bWasPartialRead)
             {
                 InsertOneString( context, returnData, L"MoreRowsAvailable;true" );
+                inst.resumePosition_value( SCXCoreLib::StrToMultibyte(resumePosition).c_str() );
             }
 
             StringA rows(&returnData[0], static_cast<MI_Uint32>(returnData.size()));
@@ -265,6 +303,7 @@ void SCX_LogFile_Class_Provider::Invoke_GetMatchedRows(
         inst.MIReturn_value( static_cast<MI_Uint32> (returnData.size()) );
 
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted(rowsSize);
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_LogFile_Class_Provider::Load", log );
@@ -282,7 +321,10 @@ void SCX_LogFile_Class_Provider::Invoke_ResetStateFile(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_LogFile", "Invoke_ResetStateFile");
+
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::LogFileProvider::Lock"));
+        timer.LockAcquired();
 
         // Validate that we have mandatory arguments
         if ( !in.filename_exists() || !in.qid_exists() )
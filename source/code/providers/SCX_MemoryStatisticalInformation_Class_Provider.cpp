@@ -20,6 +20,7 @@
 #include <scxsystemlib/memoryenumeration.h>
 #include <scxcorelib/scxmath.h>
 
+#include "support/providerstatistics.h"
 #include "support/startuplog.h"
 #include "support/memoryprovider.h"
 #include "support/scxcimutils.h"
@@ -162,6 +163,7 @@ static void EnumerateOneInstance(
     }
 
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_MemoryStatisticalInformation_Class_Provider::SCX_MemoryStatisticalInformation_Class_Provider(
@@ -221,8 +223,11 @@ void SCX_MemoryStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_MemoryStatisticalInformation", "EnumerateInstances");
+
         // Global lock for MemoryProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::MemoryProvider::Lock"));
+        timer.LockAcquired();
 
         // Prepare MemoryStatisticalInformation Enumeration
         SCXCoreLib::SCXHandle<SCXSystemLib::MemoryEnumeration> memEnum = SCXCore::g_MemoryProvider.GetMemoryEnumeration();
@@ -255,8 +260,11 @@ void SCX_MemoryStatisticalInformation_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_MemoryStatisticalInformation", "GetInstance");
+
         // Global lock for MemoryProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::MemoryProvider::Lock"));
+        timer.LockAcquired();
 
         if ( !instanceName.Name_exists() )
         {
@@ -1478,6 +1478,7 @@ typedef struct _SCX_OperatingSystem_ExecuteCommand
     /*OUT*/ MI_ConstStringField StdErr;
     /*IN*/ MI_ConstUint32Field timeout;
     /*IN*/ MI_ConstStringField ElevationType;
+    /*IN*/ MI_ConstUint32Field MaxAge;
 }
 SCX_OperatingSystem_ExecuteCommand;
 
@@ -1694,6 +1695,22 @@ MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteCommand_Clear_ElevationTy
         6);
 }
 
+MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteCommand_Set_MaxAge(
+    SCX_OperatingSystem_ExecuteCommand* self,
+    MI_Uint32 x)
+{
+    ((MI_Uint32Field*)&self->MaxAge)->value = x;
+    ((MI_Uint32Field*)&self->MaxAge)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteCommand_Clear_MaxAge(
+    SCX_OperatingSystem_ExecuteCommand* self)
+{
+    memset((void*)&self->MaxAge, 0, sizeof(self->MaxAge));
+    return MI_RESULT_OK;
+}
+
 /*
 **==============================================================================
 **
@@ -1713,6 +1730,7 @@ typedef struct _SCX_OperatingSystem_ExecuteShellCommand
     /*IN*/ MI_ConstUint32Field timeout;
     /*IN*/ MI_ConstStringField ElevationType;
     /*IN*/ MI_ConstBooleanField b64encoded;
+    /*IN*/ MI_ConstUint32Field MaxAge;
 }
 SCX_OperatingSystem_ExecuteShellCommand;
 
@@ -1945,6 +1963,22 @@ MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteShellCommand_Clear_b64enc
     return MI_RESULT_OK;
 }
 
+MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteShellCommand_Set_MaxAge(
+    SCX_OperatingSystem_ExecuteShellCommand* self,
+    MI_Uint32 x)
+{
+    ((MI_Uint32Field*)&self->MaxAge)->value = x;
+    ((MI_Uint32Field*)&self->MaxAge)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_OperatingSystem_ExecuteShellCommand_Clear_MaxAge(
+    SCX_OperatingSystem_ExecuteShellCommand* self)
+{
+    memset((void*)&self->MaxAge, 0, sizeof(self->MaxAge));
+    return MI_RESULT_OK;
+}
+
 /*
 **==============================================================================
 **
@@ -3212,6 +3246,46 @@ public:
         const size_t n = offsetof(Self, ElevationType);
         GetField<String>(n).Clear();
     }
+
+    //
+    // SCX_OperatingSystem_ExecuteCommand_Class.MaxAge
+    //
+    
+    const Field<Uint32>& MaxAge() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n);
+    }
+    
+    void MaxAge(const Field<Uint32>& x)
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n) = x;
+    }
+    
+    const Uint32& MaxAge_value() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n).value;
+    }
+    
+    void MaxAge_value(const Uint32& x)
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n).Set(x);
+    }
+    
+    bool MaxAge_exists() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n).exists ? true : false;
+    }
+    
+    void MaxAge_clear()
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n).Clear();
+    }
 };
 
 typedef Array<SCX_OperatingSystem_ExecuteCommand_Class> SCX_OperatingSystem_ExecuteCommand_ClassA;
@@ -3583,6 +3657,46 @@ public:
         const size_t n = offsetof(Self, b64encoded);
         GetField<Boolean>(n).Clear();
     }
+
+    //
+    // SCX_OperatingSystem_ExecuteShellCommand_Class.MaxAge
+    //
+    
+    const Field<Uint32>& MaxAge() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n);
+    }
+    
+    void MaxAge(const Field<Uint32>& x)
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n) = x;
+    }
+    
+    const Uint32& MaxAge_value() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n).value;
+    }
+    
+    void MaxAge_value(const Uint32& x)
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n).Set(x);
+    }
+    
+    bool MaxAge_exists() const
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        return GetField<Uint32>(n).exists ? true : false;
+    }
+    
+    void MaxAge_clear()
+    {
+        const size_t n = offsetof(Self, MaxAge);
+        GetField<Uint32>(n).Clear();
+    }
 };
 
 typedef Array<SCX_OperatingSystem_ExecuteShellCommand_Class> SCX_OperatingSystem_ExecuteShellCommand_ClassA;
@@ -15,10 +15,10 @@
 #include "SCX_OperatingSystem_Class_Provider.h"
 
 #include <scxcorelib/scxcmn.h>
+#include <scxcorelib/logsuppressor.h>
 #include <scxcorelib/scxfile.h>
 #include <scxcorelib/scxlog.h>
 #include <scxcorelib/scxmath.h>
-#include <scxcorelib/scxnameresolver.h>
 #include <scxcorelib/scxprocess.h>
 #include <scxcorelib/scxuser.h>
 #include <scxsystemlib/osenumeration.h>
@@ -29,11 +29,14 @@
 #include <scxsystemlib/scxsysteminfo.h>
 #include <util/Base64Helper.h>
 
+#include "support/commandpool.h"
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
 #include "support/scxrunasconfigurator.h"
 #include "support/startuplog.h"
 #include "support/osprovider.h"
 #include "support/runasprovider.h"
+#include "support/scopingkeys.h"
 
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
@@ -121,6 +124,7 @@ static void EnumerateOneInstance(
     Context& context,
     SCX_OperatingSystem_Class& inst,
     bool keysOnly,
+    const SCXCore::RequestedProperties& requested,
     SCXHandle<OSInstance> osinst,
     SCXHandle<MemoryInstance> meminst)
 {
@@ -134,13 +138,10 @@ static void EnumerateOneInstance(
     inst.Name_value( StrToMultibyte(osTypeInfo->GetOSName(true)).c_str() );
     inst.CSCreationClassName_value( "SCX_ComputerSystem" );
 
-    try {
-        NameResolver mi;
-        inst.CSName_value( StrToMultibyte(mi.GetHostDomainname()).c_str() );
-    } catch (SCXException& e) {
-        SCX_LOGWARNING(log, StrAppend(
-                              StrAppend(L"Can't read host/domainname because ", e.What()),
-                              e.Where()));
+    std::string csName;
+    if ( SCXCore::g_ScopingKeys.GetCSName(csName) )
+    {
+        inst.CSName_value( csName.c_str() );
     }
 
     inst.CreationClassName_value( "SCX_OperatingSystem" );
@@ -168,8 +169,12 @@ static void EnumerateOneInstance(
         /* Properties of CIM_ManagedElement                                                  */
         /*===================================================================================*/
 
-        inst.Caption_value( StrToMultibyte(osTypeInfo->GetCaption()).c_str() );
-        inst.Description_value( StrToMultibyte(osTypeInfo->GetDescription()).c_str() );
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Caption"))
+            inst.Caption_value( StrToMultibyte(osTypeInfo->GetCaption()).c_str() );
+
+        if (requested.IsRequested("Description"))
+            inst.Description_value( StrToMultibyte(osTypeInfo->GetDescription()).c_str() );
 
         /*===================================================================================*/
         /* Properties of CIM_ManagedSystemElement                                            */
@@ -199,55 +204,55 @@ static void EnumerateOneInstance(
         /* CSName is a key property and thus set in AddKeys */
         /* CreationClassName is a key property and thus set in AddKeys */
 
-        if (osinst->GetOSType(Aunsignedshort))
+        if (requested.IsRequested("OSType") && osinst->GetOSType(Aunsignedshort))
             inst.OSType_value( Aunsignedshort );
 
-        if (osinst->GetOtherTypeDescription(Awstring))
+        if (requested.IsRequested("OtherTypeDescription") && osinst->GetOtherTypeDescription(Awstring))
             inst.OtherTypeDescription_value( StrToMultibyte(Awstring).c_str() );
 
-        if (osinst->GetVersion(Awstring))
+        if (requested.IsRequested("Version") && osinst->GetVersion(Awstring))
             inst.Version_value( StrToMultibyte(Awstring).c_str() );
 
-        if (osinst->GetLastBootUpTime(ASCXCalendarTime))
+        if (requested.IsRequested("LastBootUpTime") && osinst->GetLastBootUpTime(ASCXCalendarTime))
         {
             MI_Datetime bootTime;
             CIMUtils::ConvertToCIMDatetime( bootTime, ASCXCalendarTime );
             inst.LastBootUpTime_value( bootTime );
         }
 
-        if (osinst->GetLocalDateTime(ASCXCalendarTime))
+        if (requested.IsRequested("LocalDateTime") && osinst->GetLocalDateTime(ASCXCalendarTime))
         {
             MI_Datetime localTime;
             CIMUtils::ConvertToCIMDatetime( localTime, ASCXCalendarTime );
             inst.LocalDateTime_value( localTime );
         }
 
-        if (osinst->GetCurrentTimeZone(Ashort))
+        if (requested.IsRequested("CurrentTimeZone") && osinst->GetCurrentTimeZone(Ashort))
             inst.CurrentTimeZone_value( Ashort );
 
-        if (osinst->GetNumberOfLicensedUsers(Auint))
+        if (requested.IsRequested("NumberOfLicensedUsers") && osinst->GetNumberOfLicensedUsers(Auint))
             inst.NumberOfLicensedUsers_value( Auint );
 
-        if (osinst->GetNumberOfUsers(Auint))
+        if (requested.IsRequested("NumberOfUsers") && osinst->GetNumberOfUsers(Auint))
             inst.NumberOfUsers_value( Auint );
 
-        if (ProcessEnumeration::GetNumberOfProcesses(Auint))
+        if (requested.IsRequested("NumberOfProcesses") && ProcessEnumeration::GetNumberOfProcesses(Auint))
             inst.NumberOfProcesses_value( Auint );
 
-        if (osinst->GetMaxNumberOfProcesses(Auint))
+        if (requested.IsRequested("MaxNumberOfProcesses") && osinst->GetMaxNumberOfProcesses(Auint))
             inst.MaxNumberOfProcesses_value( Auint );
 
-        if (meminst->GetTotalSwap(Ascxulong))
+        if (requested.IsRequested("TotalSwapSpaceSize") && meminst->GetTotalSwap(Ascxulong))
         {
             inst.TotalSwapSpaceSize_value( BytesToKiloBytes(Ascxulong) );
         }
 
-        if (meminst->GetTotalPhysicalMemory(Ascxulong) && meminst->GetTotalSwap(Ascxulong1))
+        if (requested.IsRequested("TotalVirtualMemorySize") && meminst->GetTotalPhysicalMemory(Ascxulong) && meminst->GetTotalSwap(Ascxulong1))
         {
             inst.TotalVirtualMemorySize_value( BytesToKiloBytes(Ascxulong) + BytesToKiloBytes(Ascxulong1) );
         }
 
-        if (meminst->GetAvailableMemory(Ascxulong))
+        if (requested.IsAnyRequested("FreeVirtualMemory", "FreePhysicalMemory") && meminst->GetAvailableMemory(Ascxulong))
         {
             Ascxulong = BytesToKiloBytes(Ascxulong);
 
@@ -258,19 +263,19 @@ static void EnumerateOneInstance(
             inst.FreePhysicalMemory_value( Ascxulong );
         }
 
-        if (meminst->GetTotalPhysicalMemory(Ascxulong))
+        if (requested.IsRequested("TotalVisibleMemorySize") && meminst->GetTotalPhysicalMemory(Ascxulong))
             inst.TotalVisibleMemorySize_value( BytesToKiloBytes(Ascxulong) );
 
-        if (meminst->GetTotalSwap(Ascxulong))
+        if (requested.IsRequested("SizeStoredInPagingFiles") && meminst->GetTotalSwap(Ascxulong))
             inst.SizeStoredInPagingFiles_value( BytesToKiloBytes(Ascxulong) );
 
-        if (meminst->GetAvailableSwap(Ascxulong))
+        if (requested.IsRequested("FreeSpaceInPagingFiles") && meminst->GetAvailableSwap(Ascxulong))
             inst.FreeSpaceInPagingFiles_value( BytesToKiloBytes(Ascxulong) );
 
-        if (osinst->GetMaxProcessMemorySize(Ascxulong))
+        if (requested.IsRequested("MaxProcessMemorySize") && osinst->GetMaxProcessMemorySize(Ascxulong))
             inst.MaxProcessMemorySize_value( Ascxulong );
 
-        if (osinst->GetMaxProcessesPerUser(Auint))
+        if (requested.IsRequested("MaxProcessesPerUser") && osinst->GetMaxProcessesPerUser(Auint))
             inst.MaxProcessesPerUser_value( Auint );
 
         /*===================================================================================*/
@@ -278,7 +283,7 @@ static void EnumerateOneInstance(
         /*===================================================================================*/
 
         SystemInfo sysInfo;
-        if (sysInfo.GetNativeBitSize(Aunsignedshort))
+        if (requested.IsRequested("OperatingSystemCapability") && sysInfo.GetNativeBitSize(Aunsignedshort))
         {
             std::ostringstream bitText;
             bitText << Aunsignedshort << " bit";
@@ -286,11 +291,12 @@ static void EnumerateOneInstance(
             inst.OperatingSystemCapability_value( bitText.str().c_str() );
         }
 
-        if (osinst->GetSystemUpTime(Ascxulong))
+        if (requested.IsRequested("SystemUpTime") && osinst->GetSystemUpTime(Ascxulong))
             inst.SystemUpTime_value( Ascxulong );
     }
 
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_OperatingSystem_Class_Provider::SCX_OperatingSystem_Class_Provider(
@@ -350,7 +356,10 @@ void SCX_OperatingSystem_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_OperatingSystem", "EnumerateInstances");
+
         SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::OSProvider::Lock"));
+        timer.LockAcquired();
 
         // Refresh the collection
         SCXHandle<OSEnumeration> osEnum = SCXCore::g_OSProvider.GetOS_Enumerator();
@@ -359,7 +368,7 @@ void SCX_OperatingSystem_Class_Provider::EnumerateInstances(
         memEnum->Update();
 
         SCX_OperatingSystem_Class inst;
-        EnumerateOneInstance( context, inst, keysOnly, osEnum->GetTotalInstance(), memEnum->GetTotalInstance() );
+        EnumerateOneInstance( context, inst, keysOnly, CIMUtils::GetRequestedProperties(propertySet, filter), osEnum->GetTotalInstance(), memEnum->GetTotalInstance() );
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::EnumerateInstances", log );
@@ -375,7 +384,10 @@ void SCX_OperatingSystem_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_OperatingSystem", "GetInstance");
+
         SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::OSProvider::Lock"));
+        timer.LockAcquired();
 
         // Was have a 4-part key (on Redhat, it looks like this):
         //   [Key] Name=Red Hat Distribution
@@ -395,14 +407,7 @@ void SCX_OperatingSystem_Class_Provider::GetInstance(
 
         std::string osName = StrToMultibyte(SCXCore::g_OSProvider.GetOSTypeInfo()->GetOSName(true)).c_str();
         std::string csName;
-        try {
-            NameResolver mi;
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e) {
-            SCX_LOGWARNING(SCXCore::g_OSProvider.GetLogHandle(), StrAppend(
-                               StrAppend(L"Can't read host/domainname because ", e.What()),
-                               e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
         // Now compare (case insensitive for the class names, case sensitive for the others)
         if ( 0 != strcasecmp("SCX_ComputerSystem", instanceName.CSCreationClassName_value().Str())
@@ -425,7 +430,7 @@ void SCX_OperatingSystem_Class_Provider::GetInstance(
         memEnum->Update();
 
         SCX_OperatingSystem_Class inst;
-        EnumerateOneInstance( context, inst, false, osEnum->GetTotalInstance(), memEnum->GetTotalInstance() );
+        EnumerateOneInstance( context, inst, false, CIMUtils::GetRequestedProperties(propertySet), osEnum->GetTotalInstance(), memEnum->GetTotalInstance() );
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::GetInstance", SCXCore::g_OSProvider.GetLogHandle() );
@@ -474,6 +479,41 @@ void SCX_OperatingSystem_Class_Provider::Invoke_Reboot(
     context.Post(MI_RESULT_NOT_SUPPORTED);
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+   Get the elevation type of a RunAs method, for the limits of the command pool
+
+   \param[in]  in  Input parameters of the method
+   \returns    Elevation type (lower case), L"" if none
+*/
+template <class T> static std::wstring GetElevationType(const T& in)
+{
+    return in.ElevationType_exists() ? StrToLower( StrFromMultibyte(in.ElevationType_value().Str()) ) : L"";
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+   Queue a RunAs method on the command pool, or tell the client to come back later
+
+   \param[in]  context    Context of the request
+   \param[in]  method     Name of the method (for the log)
+   \param[in]  elevation  Elevation type of the command
+   \param[in]  body       Function running the method
+   \param[in]  params     Parameters of the method (owned by the pool, even if refused)
+*/
+static void SubmitCommand(Context& context, const std::wstring& method, const std::wstring& elevation,
+                          SCXCore::CommandPool::JobFunction body, SCX_OperatingSystem_ThreadParam* params)
+{
+    if ( ! SCXCore::g_CommandPool.Submit(elevation, body, params) )
+    {
+        // Warn once per method; a burst would otherwise flood the log
+        static SCXCoreLib::LogSuppressor suppressor(SCXCoreLib::eWarning, SCXCoreLib::eTrace);
+        SCX_LOG( SCXCore::g_RunAsProvider.GetLogHandle(), suppressor.GetSeverity(method),
+                 L"SCX_OperatingSystem_Class_Provider::" + method + L" - too many commands running, request refused" );
+        context.Post(MI_RESULT_SERVER_LIMITS_EXCEEDED);
+    }
+}
+
 void SCX_OperatingSystem_Class_Provider::Invoke_Shutdown(
     Context& context,
     const String& nameSpace,
@@ -504,6 +544,9 @@ static void Invoke_ExecuteCommand_ThreadBody(SCXCoreLib::SCXThreadParamHandle& p
 
     SCX_PEX_BEGIN
     {
+        // Timed here: Invoke_ExecuteCommand() just queues this job
+        SCXCore::ProviderCallTimer timer("SCX_OperatingSystem", "Invoke_ExecuteCommand");
+
         // We specifically do not lock here; we want multiple instances to run
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand" )
 
@@ -514,6 +557,7 @@ static void Invoke_ExecuteCommand_ThreadBody(SCXCoreLib::SCXThreadParamHandle& p
         //   [OUT] string StdErr, 
         //   [IN] uint32 timeout,
         //   [IN] string ElevationType (optional)
+        //   [IN] uint32 MaxAge (optional)
 
         // Validate that we have mandatory arguments
         if ( !in.Command_exists() || 0 == strlen(in.Command_value().Str()) || !in.timeout_exists() )
@@ -539,12 +583,13 @@ static void Invoke_ExecuteCommand_ThreadBody(SCXCoreLib::SCXThreadParamHandle& p
             }
         }
 
-        std::wstring returnOut, returnErr;
+        std::string returnOut, returnErr;
         int returnCode;
         bool cmdok;
 
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand - Executing command: " + command);
-        cmdok = SCXCore::g_RunAsProvider.ExecuteCommand(command, returnOut, returnErr, returnCode, in.timeout_value(), elevation);
+        unsigned maxAge = in.MaxAge_exists() ? in.MaxAge_value() : 0;
+        cmdok = SCXCore::g_RunAsProvider.ExecuteCommand(command, returnOut, returnErr, returnCode, in.timeout_value(), elevation, maxAge);
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand - Finished executing: " + command);
 
         // Pass the results back up the chain
@@ -552,10 +597,11 @@ static void Invoke_ExecuteCommand_ThreadBody(SCXCoreLib::SCXThreadParamHandle& p
         SCX_OperatingSystem_ExecuteCommand_Class inst;
 
         inst.ReturnCode_value( returnCode );
-        inst.StdOut_value( StrToMultibyte(returnOut).c_str() );
-        inst.StdErr_value( StrToMultibyte(returnErr).c_str() );
+        inst.StdOut_value( returnOut.c_str() );
+        inst.StdErr_value( returnErr.c_str() );
         inst.MIReturn_value( cmdok );
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted(returnOut.size() + returnErr.size());
         context.Post(MI_RESULT_OK);
     } 
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand", log );
@@ -572,7 +618,7 @@ void SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand(
     SCX_PEX_BEGIN
     {
         SCX_OperatingSystem_Command_ThreadParam* params = new SCX_OperatingSystem_Command_ThreadParam(context.context(), in);
-        SCXCoreLib::SCXThread(Invoke_ExecuteCommand_ThreadBody, params);
+        SubmitCommand(context, L"Invoke_ExecuteCommand", GetElevationType(in), Invoke_ExecuteCommand_ThreadBody, params);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteCommand", log );
 }
@@ -598,6 +644,9 @@ static void Invoke_ExecuteShellCommand_ThreadBody(SCXCoreLib::SCXThreadParamHand
 
     SCX_PEX_BEGIN
     {
+        // Timed here: Invoke_ExecuteShellCommand() just queues this job
+        SCXCore::ProviderCallTimer timer("SCX_OperatingSystem", "Invoke_ExecuteShellCommand");
+
         // We specifically do not lock here; we want multiple instances to run
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand" )
 
@@ -609,6 +658,7 @@ static void Invoke_ExecuteShellCommand_ThreadBody(SCXCoreLib::SCXThreadParamHand
         //   [IN] uint32 timeout,
         //   [IN] string ElevationType (optional)
         //   [IN] boolean b64encoded (optional)
+        //   [IN] uint32 MaxAge (optional)
 
         // Validate that we have mandatory arguments
         if ( !in.Command_exists() || 0 == strlen(in.Command_value().Str()) || !in.timeout_exists() )
@@ -646,12 +696,13 @@ static void Invoke_ExecuteShellCommand_ThreadBody(SCXCoreLib::SCXThreadParamHand
         }
 
         std::wstring command = StrFromMultibyte( commandNarrow );
-        std::wstring returnOut, returnErr;
+        std::string returnOut, returnErr;
         int returnCode;
         bool cmdok;
 
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand - Executing command: " + command);
-        cmdok = SCXCore::g_RunAsProvider.ExecuteShellCommand(command, returnOut, returnErr, returnCode, in.timeout_value(), elevation);
+        unsigned maxAge = in.MaxAge_exists() ? in.MaxAge_value() : 0;
+        cmdok = SCXCore::g_RunAsProvider.ExecuteShellCommand(command, returnOut, returnErr, returnCode, in.timeout_value(), elevation, maxAge);
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand - Finished executing: " + command);
 
         // Pass the results back up the chain
@@ -659,10 +710,11 @@ static void Invoke_ExecuteShellCommand_ThreadBody(SCXCoreLib::SCXThreadParamHand
         SCX_OperatingSystem_ExecuteShellCommand_Class inst;
 
         inst.ReturnCode_value( returnCode );
-        inst.StdOut_value( StrToMultibyte(returnOut).c_str() );
-        inst.StdErr_value( StrToMultibyte(returnErr).c_str() );
+        inst.StdOut_value( returnOut.c_str() );
+        inst.StdErr_value( returnErr.c_str() );
         inst.MIReturn_value( cmdok );
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted(returnOut.size() + returnErr.size());
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand", log );
@@ -677,7 +729,7 @@ void SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand(
     SCX_PEX_BEGIN
     {
         SCX_OperatingSystem_ShellCommand_ThreadParam* params = new SCX_OperatingSystem_ShellCommand_ThreadParam(context.context(), in);
-        SCXCoreLib::SCXThread(Invoke_ExecuteShellCommand_ThreadBody, params);
+        SubmitCommand(context, L"Invoke_ExecuteShellCommand", GetElevationType(in), Invoke_ExecuteShellCommand_ThreadBody, params);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteShellCommand", SCXCore::g_RunAsProvider.GetLogHandle() );
 }
@@ -703,6 +755,9 @@ static void Invoke_ExecuteScript_ThreadBody(SCXCoreLib::SCXThreadParamHandle& pa
 
     SCX_PEX_BEGIN
     {
+        // Timed here: Invoke_ExecuteScript() just queues this job
+        SCXCore::ProviderCallTimer timer("SCX_OperatingSystem", "Invoke_ExecuteScript");
+
         // We specifically do not lock here; we want multiple instances to run
         SCX_LOGTRACE( log, L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteScript" )
 
@@ -740,7 +795,7 @@ static void Invoke_ExecuteScript_ThreadBody(SCXCoreLib::SCXThreadParamHandle& pa
 
         std::string strScriptNarrow = in.Script_value().Str();
         std::wstring strArgs = StrFromMultibyte(in.Arguments_value().Str());
-        std::wstring returnOut, returnErr;
+        std::string returnOut, returnErr;
         int returnCode;
 
         // If we need to decode a Base64-encoded script, do so (just the script, not the arguments)
@@ -774,10 +829,11 @@ static void Invoke_ExecuteScript_ThreadBody(SCXCoreLib::SCXThreadParamHandle& pa
         SCX_OperatingSystem_ExecuteScript_Class inst;
 
         inst.ReturnCode_value( returnCode );
-        inst.StdOut_value( StrToMultibyte(returnOut).c_str() );
-        inst.StdErr_value( StrToMultibyte(returnErr).c_str() );
+        inst.StdOut_value( returnOut.c_str() );
+        inst.StdErr_value( returnErr.c_str() );
         inst.MIReturn_value( cmdok );
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted(returnOut.size() + returnErr.size());
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteScript", log );
@@ -794,7 +850,7 @@ void SCX_OperatingSystem_Class_Provider::Invoke_ExecuteScript(
     SCX_PEX_BEGIN
     {
         SCX_OperatingSystem_Script_ThreadParam* params = new SCX_OperatingSystem_Script_ThreadParam(context.context(), in);
-        SCXCoreLib::SCXThread(Invoke_ExecuteScript_ThreadBody, params);
+        SubmitCommand(context, L"Invoke_ExecuteScript", GetElevationType(in), Invoke_ExecuteScript_ThreadBody, params);
     }
     SCX_PEX_END( L"SCX_OperatingSystem_Class_Provider::Invoke_ExecuteScript", log );
 }
@@ -19,6 +19,7 @@
 #include <scxcorelib/stringaid.h>
 #include <scxsystemlib/cpuenumeration.h>
 
+#include "support/providerstatistics.h"
 #include "support/startuplog.h"
 #include "support/scxcimutils.h"
 
@@ -137,6 +138,7 @@ static void EnumerateOneInstance(
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_ProcessorStatisticalInformation_Class_Provider::SCX_ProcessorStatisticalInformation_Class_Provider(
@@ -196,8 +198,11 @@ void SCX_ProcessorStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_ProcessorStatisticalInformation", "EnumerateInstances");
+
         // Global lock for CPUProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"CPUProvider::Lock"));
+        timer.LockAcquired();
 
         // Prepare ProcessorStatisticalInformation Enumeration
         // (Note: Only do full update if we're not enumerating keys)
@@ -235,8 +240,11 @@ void SCX_ProcessorStatisticalInformation_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_ProcessorStatisticalInformation", "GetInstance");
+
         // Global lock for CPUProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"CPUProvider::Lock"));
+        timer.LockAcquired();
 
         SCXHandle<SCXSystemLib::CPUEnumeration> cpuEnum = g_CPUProvider.GetEnumCPUs();
         cpuEnum->Update(true);
@@ -10,6 +10,7 @@
 #include <scxcorelib/stringaid.h>
 #include <scxsystemlib/cpuenumeration.h>
 
+#include "support/providerstatistics.h"
 #include "support/startuplog.h"
 #include "support/scxcimutils.h"
 
@@ -172,6 +173,7 @@ static void EnumerateOneInstance(
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_RTProcessorStatisticalInformation_Class_Provider::SCX_RTProcessorStatisticalInformation_Class_Provider(
@@ -231,8 +233,11 @@ void SCX_RTProcessorStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_RTProcessorStatisticalInformation", "EnumerateInstances");
+
         // Global lock for CPUProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"CPUProvider::Lock"));
+        timer.LockAcquired();
 
         // Prepare ProcessorStatisticalInformation Enumeration
         // (Note: Only do full update if we're not enumerating keys)
@@ -270,8 +275,11 @@ void SCX_RTProcessorStatisticalInformation_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
+        SCXCore::ProviderCallTimer timer("SCX_RTProcessorStatisticalInformation", "GetInstance");
+
         // Global lock for CPUProvider class
         SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"CPUProvider::Lock"));
+        timer.LockAcquired();
 
         SCXHandle<SCXSystemLib::CPUEnumeration> cpuEnum = g_CPUProvider.GetEnumCPUs();
         cpuEnum->Update(true);
@@ -0,0 +1,453 @@
+/* @migen@ */
+/*
+**==============================================================================
+**
+** WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. PLEASE DO NOT EDIT.
+**
+**==============================================================================
+*/
+#ifndef _SCX_ResourceConsumer_h
+#define _SCX_ResourceConsumer_h
+
+#include <MI.h>
+
+/*
+**==============================================================================
+**
+** SCX_ResourceConsumer [SCX_ResourceConsumer]
+**
+** Keys:
+**
+**==============================================================================
+*/
+
+typedef struct _SCX_ResourceConsumer
+{
+    MI_Instance __instance;
+    /* SCX_ResourceConsumer properties */
+    MI_ConstStringField Resource;
+    MI_ConstUint64Field PID;
+    MI_ConstUint64Field Value;
+    MI_ConstStringField Name;
+}
+SCX_ResourceConsumer;
+
+typedef struct _SCX_ResourceConsumer_Ref
+{
+    SCX_ResourceConsumer* value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_ResourceConsumer_Ref;
+
+typedef struct _SCX_ResourceConsumer_ConstRef
+{
+    MI_CONST SCX_ResourceConsumer* value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_ResourceConsumer_ConstRef;
+
+typedef struct _SCX_ResourceConsumer_Array
+{
+    struct _SCX_ResourceConsumer** data;
+    MI_Uint32 size;
+}
+SCX_ResourceConsumer_Array;
+
+typedef struct _SCX_ResourceConsumer_ConstArray
+{
+    struct _SCX_ResourceConsumer MI_CONST* MI_CONST* data;
+    MI_Uint32 size;
+}
+SCX_ResourceConsumer_ConstArray;
+
+typedef struct _SCX_ResourceConsumer_ArrayRef
+{
+    SCX_ResourceConsumer_Array value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_ResourceConsumer_ArrayRef;
+
+typedef struct _SCX_ResourceConsumer_ConstArrayRef
+{
+    SCX_ResourceConsumer_ConstArray value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_ResourceConsumer_ConstArrayRef;
+
+MI_EXTERN_C MI_CONST MI_ClassDecl SCX_ResourceConsumer_rtti;
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Construct(
+    SCX_ResourceConsumer* self,
+    MI_Context* context)
+{
+    return MI_ConstructInstance(context, &SCX_ResourceConsumer_rtti,
+        (MI_Instance*)&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Clone(
+    const SCX_ResourceConsumer* self,
+    SCX_ResourceConsumer** newInstance)
+{
+    return MI_Instance_Clone(
+        &self->__instance, (MI_Instance**)newInstance);
+}
+
+MI_INLINE MI_Boolean MI_CALL SCX_ResourceConsumer_IsA(
+    const MI_Instance* self)
+{
+    MI_Boolean res = MI_FALSE;
+    return MI_Instance_IsA(self, &SCX_ResourceConsumer_rtti, &res) == MI_RESULT_OK && res;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Destruct(SCX_ResourceConsumer* self)
+{
+    return MI_Instance_Destruct(&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Delete(SCX_ResourceConsumer* self)
+{
+    return MI_Instance_Delete(&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Post(
+    const SCX_ResourceConsumer* self,
+    MI_Context* context)
+{
+    return MI_PostInstance(context, &self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Set_Resource(
+    SCX_ResourceConsumer* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        0,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_SetPtr_Resource(
+    SCX_ResourceConsumer* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        0,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Clear_Resource(
+    SCX_ResourceConsumer* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Set_PID(
+    SCX_ResourceConsumer* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->PID)->value = x;
+    ((MI_Uint64Field*)&self->PID)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Clear_PID(
+    SCX_ResourceConsumer* self)
+{
+    memset((void*)&self->PID, 0, sizeof(self->PID));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Set_Value(
+    SCX_ResourceConsumer* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->Value)->value = x;
+    ((MI_Uint64Field*)&self->Value)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Clear_Value(
+    SCX_ResourceConsumer* self)
+{
+    memset((void*)&self->Value, 0, sizeof(self->Value));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Set_Name(
+    SCX_ResourceConsumer* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        3,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_SetPtr_Name(
+    SCX_ResourceConsumer* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        3,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_ResourceConsumer_Clear_Name(
+    SCX_ResourceConsumer* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        3);
+}
+
+
+/*
+**==============================================================================
+**
+** SCX_ResourceConsumer_Class
+**
+**==============================================================================
+*/
+
+#ifdef __cplusplus
+# include <micxx/micxx.h>
+
+MI_BEGIN_NAMESPACE
+
+class SCX_ResourceConsumer_Class : public Instance
+{
+public:
+    
+    typedef SCX_ResourceConsumer Self;
+    
+    SCX_ResourceConsumer_Class() :
+        Instance(&SCX_ResourceConsumer_rtti)
+    {
+    }
+    
+    SCX_ResourceConsumer_Class(
+        const SCX_ResourceConsumer* instanceName,
+        bool keysOnly) :
+        Instance(
+            &SCX_ResourceConsumer_rtti,
+            &instanceName->__instance,
+            keysOnly)
+    {
+    }
+    
+    SCX_ResourceConsumer_Class(
+        const MI_ClassDecl* clDecl,
+        const MI_Instance* instance,
+        bool keysOnly) :
+        Instance(clDecl, instance, keysOnly)
+    {
+    }
+    
+    SCX_ResourceConsumer_Class(
+        const MI_ClassDecl* clDecl) :
+        Instance(clDecl)
+    {
+    }
+    
+    SCX_ResourceConsumer_Class& operator=(
+        const SCX_ResourceConsumer_Class& x)
+    {
+        CopyRef(x);
+        return *this;
+    }
+    
+    SCX_ResourceConsumer_Class(
+        const SCX_ResourceConsumer_Class& x) :
+        Instance(x)
+    {
+    }
+
+    static const MI_ClassDecl* GetClassDecl()
+    {
+        return &SCX_ResourceConsumer_rtti;
+    }
+
+    //
+    // SCX_ResourceConsumer_Class.Resource
+    //
+    
+    const Field<String>& Resource() const
+    {
+        const size_t n = offsetof(Self, Resource);
+        return GetField<String>(n);
+    }
+    
+    void Resource(const Field<String>& x)
+    {
+        const size_t n = offsetof(Self, Resource);
+        GetField<String>(n) = x;
+    }
+    
+    const String& Resource_value() const
+    {
+        const size_t n = offsetof(Self, Resource);
+        return GetField<String>(n).value;
+    }
+    
+    void Resource_value(const String& x)
+    {
+        const size_t n = offsetof(Self, Resource);
+        GetField<String>(n).Set(x);
+    }
+    
+    bool Resource_exists() const
+    {
+        const size_t n = offsetof(Self, Resource);
+        return GetField<String>(n).exists ? true : false;
+    }
+    
+    void Resource_clear()
+    {
+        const size_t n = offsetof(Self, Resource);
+        GetField<String>(n).Clear();
+    }
+
+    //
+    // SCX_ResourceConsumer_Class.PID
+    //
+    
+    const Field<Uint64>& PID() const
+    {
+        const size_t n = offsetof(Self, PID);
+        return GetField<Uint64>(n);
+    }
+    
+    void PID(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, PID);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& PID_value() const
+    {
+        const size_t n = offsetof(Self, PID);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void PID_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, PID);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool PID_exists() const
+    {
+        const size_t n = offsetof(Self, PID);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void PID_clear()
+    {
+        const size_t n = offsetof(Self, PID);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_ResourceConsumer_Class.Value
+    //
+    
+    const Field<Uint64>& Value() const
+    {
+        const size_t n = offsetof(Self, Value);
+        return GetField<Uint64>(n);
+    }
+    
+    void Value(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, Value);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& Value_value() const
+    {
+        const size_t n = offsetof(Self, Value);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void Value_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, Value);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool Value_exists() const
+    {
+        const size_t n = offsetof(Self, Value);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void Value_clear()
+    {
+        const size_t n = offsetof(Self, Value);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_ResourceConsumer_Class.Name
+    //
+    
+    const Field<String>& Name() const
+    {
+        const size_t n = offsetof(Self, Name);
+        return GetField<String>(n);
+    }
+    
+    void Name(const Field<String>& x)
+    {
+        const size_t n = offsetof(Self, Name);
+        GetField<String>(n) = x;
+    }
+    
+    const String& Name_value() const
+    {
+        const size_t n = offsetof(Self, Name);
+        return GetField<String>(n).value;
+    }
+    
+    void Name_value(const String& x)
+    {
+        const size_t n = offsetof(Self, Name);
+        GetField<String>(n).Set(x);
+    }
+    
+    bool Name_exists() const
+    {
+        const size_t n = offsetof(Self, Name);
+        return GetField<String>(n).exists ? true : false;
+    }
+    
+    void Name_clear()
+    {
+        const size_t n = offsetof(Self, Name);
+        GetField<String>(n).Clear();
+    }
+};
+
+typedef Array<SCX_ResourceConsumer_Class> SCX_ResourceConsumer_ClassA;
+
+MI_END_NAMESPACE
+
+#endif /* __cplusplus */
+
+#endif /* _SCX_ResourceConsumer_h */
@@ -12,6 +12,7 @@
 #include <MI.h>
 #include "CIM_UnixProcess.h"
 #include "CIM_ConcreteJob.h"
+#include "SCX_ResourceConsumer.h"
 
 /*
 **==============================================================================
@@ -85,6 +86,7 @@ typedef struct _SCX_UnixProcess /* extends CIM_UnixProcess */
     /* SCX_UnixProcess properties */
     MI_ConstUint8Field PercentBusyTime;
     MI_ConstUint64Field UsedMemory;
+    MI_ConstUint64Field Generation;
 }
 SCX_UnixProcess;
 
@@ -1296,6 +1298,22 @@ MI_INLINE MI_Result MI_CALL SCX_UnixProcess_Clear_UsedMemory(
     return MI_RESULT_OK;
 }
 
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_Set_Generation(
+    SCX_UnixProcess* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->Generation)->value = x;
+    ((MI_Uint64Field*)&self->Generation)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_Clear_Generation(
+    SCX_UnixProcess* self)
+{
+    memset((void*)&self->Generation, 0, sizeof(self->Generation));
+    return MI_RESULT_OK;
+}
+
 /*
 **==============================================================================
 **
@@ -1446,6 +1464,8 @@ typedef struct _SCX_UnixProcess_TopResourceConsumers
     /*IN*/ MI_ConstStringField resource;
     /*IN*/ MI_ConstUint16Field count;
     /*IN*/ MI_ConstStringField elevationType;
+    /*IN*/ MI_ConstStringAField resources;
+    /*OUT*/ SCX_ResourceConsumer_ConstArrayRef consumers;
 }
 SCX_UnixProcess_TopResourceConsumers;
 
@@ -1598,6 +1618,86 @@ MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_Clear_elevation
         3);
 }
 
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_Set_resources(
+    SCX_UnixProcess_TopResourceConsumers* self,
+    const MI_Char** data,
+    MI_Uint32 size)
+{
+    MI_Array arr;
+    arr.data = (void*)data;
+    arr.size = size;
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        4,
+        (MI_Value*)&arr,
+        MI_STRINGA,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_SetPtr_resources(
+    SCX_UnixProcess_TopResourceConsumers* self,
+    const MI_Char** data,
+    MI_Uint32 size)
+{
+    MI_Array arr;
+    arr.data = (void*)data;
+    arr.size = size;
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        4,
+        (MI_Value*)&arr,
+        MI_STRINGA,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_Clear_resources(
+    SCX_UnixProcess_TopResourceConsumers* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        4);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_Set_consumers(
+    SCX_UnixProcess_TopResourceConsumers* self,
+    const SCX_ResourceConsumer * const * data,
+    MI_Uint32 size)
+{
+    MI_Array arr;
+    arr.data = (void*)data;
+    arr.size = size;
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        5,
+        (MI_Value*)&arr,
+        MI_INSTANCEA,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_SetPtr_consumers(
+    SCX_UnixProcess_TopResourceConsumers* self,
+    const SCX_ResourceConsumer * const * data,
+    MI_Uint32 size)
+{
+    MI_Array arr;
+    arr.data = (void*)data;
+    arr.size = size;
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        5,
+        (MI_Value*)&arr,
+        MI_INSTANCEA,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcess_TopResourceConsumers_Clear_consumers(
+    SCX_UnixProcess_TopResourceConsumers* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        5);
+}
+
 /*
 **==============================================================================
 **
@@ -1821,6 +1921,46 @@ public:
         const size_t n = offsetof(Self, UsedMemory);
         GetField<Uint64>(n).Clear();
     }
+
+    //
+    // SCX_UnixProcess_Class.Generation
+    //
+    
+    const Field<Uint64>& Generation() const
+    {
+        const size_t n = offsetof(Self, Generation);
+        return GetField<Uint64>(n);
+    }
+    
+    void Generation(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, Generation);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& Generation_value() const
+    {
+        const size_t n = offsetof(Self, Generation);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void Generation_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, Generation);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool Generation_exists() const
+    {
+        const size_t n = offsetof(Self, Generation);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void Generation_clear()
+    {
+        const size_t n = offsetof(Self, Generation);
+        GetField<Uint64>(n).Clear();
+    }
 };
 
 typedef Array<SCX_UnixProcess_Class> SCX_UnixProcess_ClassA;
@@ -2243,6 +2383,86 @@ public:
         const size_t n = offsetof(Self, elevationType);
         GetField<String>(n).Clear();
     }
+
+    //
+    // SCX_UnixProcess_TopResourceConsumers_Class.resources
+    //
+    
+    const Field<StringA>& resources() const
+    {
+        const size_t n = offsetof(Self, resources);
+        return GetField<StringA>(n);
+    }
+    
+    void resources(const Field<StringA>& x)
+    {
+        const size_t n = offsetof(Self, resources);
+        GetField<StringA>(n) = x;
+    }
+    
+    const StringA& resources_value() const
+    {
+        const size_t n = offsetof(Self, resources);
+        return GetField<StringA>(n).value;
+    }
+    
+    void resources_value(const StringA& x)
+    {
+        const size_t n = offsetof(Self, resources);
+        GetField<StringA>(n).Set(x);
+    }
+    
+    bool resources_exists() const
+    {
+        const size_t n = offsetof(Self, resources);
+        return GetField<StringA>(n).exists ? true : false;
+    }
+    
+    void resources_clear()
+    {
+        const size_t n = offsetof(Self, resources);
+        GetField<StringA>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcess_TopResourceConsumers_Class.consumers
+    //
+    
+    const Field<SCX_ResourceConsumer_ClassA>& consumers() const
+    {
+        const size_t n = offsetof(Self, consumers);
+        return GetField<SCX_ResourceConsumer_ClassA>(n);
+    }
+    
+    void consumers(const Field<SCX_ResourceConsumer_ClassA>& x)
+    {
+        const size_t n = offsetof(Self, consumers);
+        GetField<SCX_ResourceConsumer_ClassA>(n) = x;
+    }
+    
+    const SCX_ResourceConsumer_ClassA& consumers_value() const
+    {
+        const size_t n = offsetof(Self, consumers);
+        return GetField<SCX_ResourceConsumer_ClassA>(n).value;
+    }
+    
+    void consumers_value(const SCX_ResourceConsumer_ClassA& x)
+    {
+        const size_t n = offsetof(Self, consumers);
+        GetField<SCX_ResourceConsumer_ClassA>(n).Set(x);
+    }
+    
+    bool consumers_exists() const
+    {
+        const size_t n = offsetof(Self, consumers);
+        return GetField<SCX_ResourceConsumer_ClassA>(n).exists ? true : false;
+    }
+    
+    void consumers_clear()
+    {
+        const size_t n = offsetof(Self, consumers);
+        GetField<SCX_ResourceConsumer_ClassA>(n).Clear();
+    }
 };
 
 typedef Array<SCX_UnixProcess_TopResourceConsumers_Class> SCX_UnixProcess_TopResourceConsumers_ClassA;
@@ -0,0 +1,1041 @@
+/* @migen@ */
+/*
+**==============================================================================
+**
+** WARNING: THIS FILE WAS AUTOMATICALLY GENERATED. PLEASE DO NOT EDIT.
+**
+**==============================================================================
+*/
+#ifndef _SCX_UnixProcessGroupStatisticalInformation_h
+#define _SCX_UnixProcessGroupStatisticalInformation_h
+
+#include <MI.h>
+#include "SCX_StatisticalInformation.h"
+
+/*
+**==============================================================================
+**
+** SCX_UnixProcessGroupStatisticalInformation [SCX_UnixProcessGroupStatisticalInformation]
+**
+** Keys:
+**    Name
+**
+**==============================================================================
+*/
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation /* extends SCX_StatisticalInformation */
+{
+    MI_Instance __instance;
+    /* CIM_ManagedElement properties */
+    MI_ConstStringField InstanceID;
+    MI_ConstStringField Caption;
+    MI_ConstStringField Description;
+    MI_ConstStringField ElementName;
+    /* CIM_StatisticalInformation properties */
+    /*KEY*/ MI_ConstStringField Name;
+    /* SCX_StatisticalInformation properties */
+    MI_ConstBooleanField IsAggregate;
+    /* SCX_UnixProcessGroupStatisticalInformation properties */
+    MI_ConstStringField GroupType;
+    MI_ConstStringField GroupValue;
+    MI_ConstUint32Field NumberOfProcesses;
+    MI_ConstUint64Field PercentUserTime;
+    MI_ConstUint64Field PercentPrivilegedTime;
+    MI_ConstUint64Field UsedMemory;
+    MI_ConstUint64Field PercentUsedMemory;
+    MI_ConstUint64Field BlockReadsPerSecond;
+    MI_ConstUint64Field BlockWritesPerSecond;
+    MI_ConstUint64Field BlockTransfersPerSecond;
+}
+SCX_UnixProcessGroupStatisticalInformation;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_Ref
+{
+    SCX_UnixProcessGroupStatisticalInformation* value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_UnixProcessGroupStatisticalInformation_Ref;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_ConstRef
+{
+    MI_CONST SCX_UnixProcessGroupStatisticalInformation* value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_UnixProcessGroupStatisticalInformation_ConstRef;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_Array
+{
+    struct _SCX_UnixProcessGroupStatisticalInformation** data;
+    MI_Uint32 size;
+}
+SCX_UnixProcessGroupStatisticalInformation_Array;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_ConstArray
+{
+    struct _SCX_UnixProcessGroupStatisticalInformation MI_CONST* MI_CONST* data;
+    MI_Uint32 size;
+}
+SCX_UnixProcessGroupStatisticalInformation_ConstArray;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_ArrayRef
+{
+    SCX_UnixProcessGroupStatisticalInformation_Array value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_UnixProcessGroupStatisticalInformation_ArrayRef;
+
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_ConstArrayRef
+{
+    SCX_UnixProcessGroupStatisticalInformation_ConstArray value;
+    MI_Boolean exists;
+    MI_Uint8 flags;
+}
+SCX_UnixProcessGroupStatisticalInformation_ConstArrayRef;
+
+MI_EXTERN_C MI_CONST MI_ClassDecl SCX_UnixProcessGroupStatisticalInformation_rtti;
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Construct(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Context* context)
+{
+    return MI_ConstructInstance(context, &SCX_UnixProcessGroupStatisticalInformation_rtti,
+        (MI_Instance*)&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clone(
+    const SCX_UnixProcessGroupStatisticalInformation* self,
+    SCX_UnixProcessGroupStatisticalInformation** newInstance)
+{
+    return MI_Instance_Clone(
+        &self->__instance, (MI_Instance**)newInstance);
+}
+
+MI_INLINE MI_Boolean MI_CALL SCX_UnixProcessGroupStatisticalInformation_IsA(
+    const MI_Instance* self)
+{
+    MI_Boolean res = MI_FALSE;
+    return MI_Instance_IsA(self, &SCX_UnixProcessGroupStatisticalInformation_rtti, &res) == MI_RESULT_OK && res;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Destruct(SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return MI_Instance_Destruct(&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Delete(SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return MI_Instance_Delete(&self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Post(
+    const SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Context* context)
+{
+    return MI_PostInstance(context, &self->__instance);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_InstanceID(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        0,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_InstanceID(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        0,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_InstanceID(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_Caption(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        1,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_Caption(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        1,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_Caption(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        1);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_Description(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        2,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_Description(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        2,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_Description(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        2);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_ElementName(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        3,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_ElementName(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        3,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_ElementName(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        3);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_Name(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        4,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_Name(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        4,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_Name(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        4);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_IsAggregate(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Boolean x)
+{
+    ((MI_BooleanField*)&self->IsAggregate)->value = x;
+    ((MI_BooleanField*)&self->IsAggregate)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_IsAggregate(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->IsAggregate, 0, sizeof(self->IsAggregate));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_GroupType(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        6,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_GroupType(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        6,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_GroupType(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        6);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_GroupValue(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        7,
+        (MI_Value*)&str,
+        MI_STRING,
+        0);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_SetPtr_GroupValue(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    const MI_Char* str)
+{
+    return self->__instance.ft->SetElementAt(
+        (MI_Instance*)&self->__instance,
+        7,
+        (MI_Value*)&str,
+        MI_STRING,
+        MI_FLAG_BORROW);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_GroupValue(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    return self->__instance.ft->ClearElementAt(
+        (MI_Instance*)&self->__instance,
+        7);
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_NumberOfProcesses(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint32 x)
+{
+    ((MI_Uint32Field*)&self->NumberOfProcesses)->value = x;
+    ((MI_Uint32Field*)&self->NumberOfProcesses)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_NumberOfProcesses(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->NumberOfProcesses, 0, sizeof(self->NumberOfProcesses));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_PercentUserTime(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->PercentUserTime)->value = x;
+    ((MI_Uint64Field*)&self->PercentUserTime)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_PercentUserTime(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->PercentUserTime, 0, sizeof(self->PercentUserTime));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_PercentPrivilegedTime(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->PercentPrivilegedTime)->value = x;
+    ((MI_Uint64Field*)&self->PercentPrivilegedTime)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_PercentPrivilegedTime(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->PercentPrivilegedTime, 0, sizeof(self->PercentPrivilegedTime));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_UsedMemory(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->UsedMemory)->value = x;
+    ((MI_Uint64Field*)&self->UsedMemory)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_UsedMemory(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->UsedMemory, 0, sizeof(self->UsedMemory));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_PercentUsedMemory(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->PercentUsedMemory)->value = x;
+    ((MI_Uint64Field*)&self->PercentUsedMemory)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_PercentUsedMemory(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->PercentUsedMemory, 0, sizeof(self->PercentUsedMemory));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_BlockReadsPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->BlockReadsPerSecond)->value = x;
+    ((MI_Uint64Field*)&self->BlockReadsPerSecond)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_BlockReadsPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->BlockReadsPerSecond, 0, sizeof(self->BlockReadsPerSecond));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_BlockWritesPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->BlockWritesPerSecond)->value = x;
+    ((MI_Uint64Field*)&self->BlockWritesPerSecond)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_BlockWritesPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->BlockWritesPerSecond, 0, sizeof(self->BlockWritesPerSecond));
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Set_BlockTransfersPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self,
+    MI_Uint64 x)
+{
+    ((MI_Uint64Field*)&self->BlockTransfersPerSecond)->value = x;
+    ((MI_Uint64Field*)&self->BlockTransfersPerSecond)->exists = 1;
+    return MI_RESULT_OK;
+}
+
+MI_INLINE MI_Result MI_CALL SCX_UnixProcessGroupStatisticalInformation_Clear_BlockTransfersPerSecond(
+    SCX_UnixProcessGroupStatisticalInformation* self)
+{
+    memset((void*)&self->BlockTransfersPerSecond, 0, sizeof(self->BlockTransfersPerSecond));
+    return MI_RESULT_OK;
+}
+
+/*
+**==============================================================================
+**
+** SCX_UnixProcessGroupStatisticalInformation provider function prototypes
+**
+**==============================================================================
+*/
+
+/* The developer may optionally define this structure */
+typedef struct _SCX_UnixProcessGroupStatisticalInformation_Self SCX_UnixProcessGroupStatisticalInformation_Self;
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_Load(
+    SCX_UnixProcessGroupStatisticalInformation_Self** self,
+    MI_Module_Self* selfModule,
+    MI_Context* context);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_Unload(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_EnumerateInstances(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const MI_PropertySet* propertySet,
+    MI_Boolean keysOnly,
+    const MI_Filter* filter);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_GetInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* instanceName,
+    const MI_PropertySet* propertySet);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_CreateInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* newInstance);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_ModifyInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* modifiedInstance,
+    const MI_PropertySet* propertySet);
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_DeleteInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* instanceName);
+
+
+/*
+**==============================================================================
+**
+** SCX_UnixProcessGroupStatisticalInformation_Class
+**
+**==============================================================================
+*/
+
+#ifdef __cplusplus
+# include <micxx/micxx.h>
+
+MI_BEGIN_NAMESPACE
+
+class SCX_UnixProcessGroupStatisticalInformation_Class : public SCX_StatisticalInformation_Class
+{
+public:
+    
+    typedef SCX_UnixProcessGroupStatisticalInformation Self;
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class() :
+        SCX_StatisticalInformation_Class(&SCX_UnixProcessGroupStatisticalInformation_rtti)
+    {
+    }
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class(
+        const SCX_UnixProcessGroupStatisticalInformation* instanceName,
+        bool keysOnly) :
+        SCX_StatisticalInformation_Class(
+            &SCX_UnixProcessGroupStatisticalInformation_rtti,
+            &instanceName->__instance,
+            keysOnly)
+    {
+    }
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class(
+        const MI_ClassDecl* clDecl,
+        const MI_Instance* instance,
+        bool keysOnly) :
+        SCX_StatisticalInformation_Class(clDecl, instance, keysOnly)
+    {
+    }
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class(
+        const MI_ClassDecl* clDecl) :
+        SCX_StatisticalInformation_Class(clDecl)
+    {
+    }
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class& operator=(
+        const SCX_UnixProcessGroupStatisticalInformation_Class& x)
+    {
+        CopyRef(x);
+        return *this;
+    }
+    
+    SCX_UnixProcessGroupStatisticalInformation_Class(
+        const SCX_UnixProcessGroupStatisticalInformation_Class& x) :
+        SCX_StatisticalInformation_Class(x)
+    {
+    }
+
+    static const MI_ClassDecl* GetClassDecl()
+    {
+        return &SCX_UnixProcessGroupStatisticalInformation_rtti;
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.GroupType
+    //
+    
+    const Field<String>& GroupType() const
+    {
+        const size_t n = offsetof(Self, GroupType);
+        return GetField<String>(n);
+    }
+    
+    void GroupType(const Field<String>& x)
+    {
+        const size_t n = offsetof(Self, GroupType);
+        GetField<String>(n) = x;
+    }
+    
+    const String& GroupType_value() const
+    {
+        const size_t n = offsetof(Self, GroupType);
+        return GetField<String>(n).value;
+    }
+    
+    void GroupType_value(const String& x)
+    {
+        const size_t n = offsetof(Self, GroupType);
+        GetField<String>(n).Set(x);
+    }
+    
+    bool GroupType_exists() const
+    {
+        const size_t n = offsetof(Self, GroupType);
+        return GetField<String>(n).exists ? true : false;
+    }
+    
+    void GroupType_clear()
+    {
+        const size_t n = offsetof(Self, GroupType);
+        GetField<String>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.GroupValue
+    //
+    
+    const Field<String>& GroupValue() const
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        return GetField<String>(n);
+    }
+    
+    void GroupValue(const Field<String>& x)
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        GetField<String>(n) = x;
+    }
+    
+    const String& GroupValue_value() const
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        return GetField<String>(n).value;
+    }
+    
+    void GroupValue_value(const String& x)
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        GetField<String>(n).Set(x);
+    }
+    
+    bool GroupValue_exists() const
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        return GetField<String>(n).exists ? true : false;
+    }
+    
+    void GroupValue_clear()
+    {
+        const size_t n = offsetof(Self, GroupValue);
+        GetField<String>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.NumberOfProcesses
+    //
+    
+    const Field<Uint32>& NumberOfProcesses() const
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        return GetField<Uint32>(n);
+    }
+    
+    void NumberOfProcesses(const Field<Uint32>& x)
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        GetField<Uint32>(n) = x;
+    }
+    
+    const Uint32& NumberOfProcesses_value() const
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        return GetField<Uint32>(n).value;
+    }
+    
+    void NumberOfProcesses_value(const Uint32& x)
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        GetField<Uint32>(n).Set(x);
+    }
+    
+    bool NumberOfProcesses_exists() const
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        return GetField<Uint32>(n).exists ? true : false;
+    }
+    
+    void NumberOfProcesses_clear()
+    {
+        const size_t n = offsetof(Self, NumberOfProcesses);
+        GetField<Uint32>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.PercentUserTime
+    //
+    
+    const Field<Uint64>& PercentUserTime() const
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        return GetField<Uint64>(n);
+    }
+    
+    void PercentUserTime(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& PercentUserTime_value() const
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void PercentUserTime_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool PercentUserTime_exists() const
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void PercentUserTime_clear()
+    {
+        const size_t n = offsetof(Self, PercentUserTime);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.PercentPrivilegedTime
+    //
+    
+    const Field<Uint64>& PercentPrivilegedTime() const
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        return GetField<Uint64>(n);
+    }
+    
+    void PercentPrivilegedTime(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& PercentPrivilegedTime_value() const
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void PercentPrivilegedTime_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool PercentPrivilegedTime_exists() const
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void PercentPrivilegedTime_clear()
+    {
+        const size_t n = offsetof(Self, PercentPrivilegedTime);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.UsedMemory
+    //
+    
+    const Field<Uint64>& UsedMemory() const
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        return GetField<Uint64>(n);
+    }
+    
+    void UsedMemory(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& UsedMemory_value() const
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void UsedMemory_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool UsedMemory_exists() const
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void UsedMemory_clear()
+    {
+        const size_t n = offsetof(Self, UsedMemory);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.PercentUsedMemory
+    //
+    
+    const Field<Uint64>& PercentUsedMemory() const
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        return GetField<Uint64>(n);
+    }
+    
+    void PercentUsedMemory(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& PercentUsedMemory_value() const
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void PercentUsedMemory_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool PercentUsedMemory_exists() const
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void PercentUsedMemory_clear()
+    {
+        const size_t n = offsetof(Self, PercentUsedMemory);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.BlockReadsPerSecond
+    //
+    
+    const Field<Uint64>& BlockReadsPerSecond() const
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        return GetField<Uint64>(n);
+    }
+    
+    void BlockReadsPerSecond(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& BlockReadsPerSecond_value() const
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void BlockReadsPerSecond_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool BlockReadsPerSecond_exists() const
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void BlockReadsPerSecond_clear()
+    {
+        const size_t n = offsetof(Self, BlockReadsPerSecond);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.BlockWritesPerSecond
+    //
+    
+    const Field<Uint64>& BlockWritesPerSecond() const
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        return GetField<Uint64>(n);
+    }
+    
+    void BlockWritesPerSecond(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& BlockWritesPerSecond_value() const
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void BlockWritesPerSecond_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool BlockWritesPerSecond_exists() const
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void BlockWritesPerSecond_clear()
+    {
+        const size_t n = offsetof(Self, BlockWritesPerSecond);
+        GetField<Uint64>(n).Clear();
+    }
+
+    //
+    // SCX_UnixProcessGroupStatisticalInformation_Class.BlockTransfersPerSecond
+    //
+    
+    const Field<Uint64>& BlockTransfersPerSecond() const
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        return GetField<Uint64>(n);
+    }
+    
+    void BlockTransfersPerSecond(const Field<Uint64>& x)
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        GetField<Uint64>(n) = x;
+    }
+    
+    const Uint64& BlockTransfersPerSecond_value() const
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        return GetField<Uint64>(n).value;
+    }
+    
+    void BlockTransfersPerSecond_value(const Uint64& x)
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        GetField<Uint64>(n).Set(x);
+    }
+    
+    bool BlockTransfersPerSecond_exists() const
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        return GetField<Uint64>(n).exists ? true : false;
+    }
+    
+    void BlockTransfersPerSecond_clear()
+    {
+        const size_t n = offsetof(Self, BlockTransfersPerSecond);
+        GetField<Uint64>(n).Clear();
+    }
+};
+
+typedef Array<SCX_UnixProcessGroupStatisticalInformation_Class> SCX_UnixProcessGroupStatisticalInformation_ClassA;
+
+MI_END_NAMESPACE
+
+#endif /* __cplusplus */
+
+#endif /* _SCX_UnixProcessGroupStatisticalInformation_h */
@@ -0,0 +1,298 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file        SCX_UnixProcessGroupStatisticalInformation_Class_Provider.cpp
+
+    \brief       Provider support using OMI framework.
+
+    \date        2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+/* @migen@ */
+#include <MI.h>
+#include "SCX_UnixProcessGroupStatisticalInformation_Class_Provider.h"
+#include "SCX_UnixProcessGroupStatisticalInformation.h"
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/stringaid.h>
+#include <scxcorelib/scxthreadlock.h>
+#include "support/providerstatistics.h"
+#include "support/scxcimutils.h"
+#include "support/processaggregation.h"
+#include "support/processprovider.h"
+#include "support/wqlfiltercache.h"
+#include <string>
+#include <vector>
+
+using namespace SCXSystemLib;
+using namespace SCXCoreLib;
+
+MI_BEGIN_NAMESPACE
+
+static void EnumerateOneInstance(Context& context,
+        SCX_UnixProcessGroupStatisticalInformation_Class& inst, bool keysOnly,
+        const SCXCore::RequestedProperties& requested,
+        const SCXCore::ProcessGroup& group)
+{
+    // Add the key properties first.
+    inst.Name_value(group.GetName().c_str());
+
+    if (!keysOnly)
+    {
+        scxulong ulong = 0;
+
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Caption"))
+        {
+            inst.Caption_value("Unix process group information");
+        }
+
+        if (requested.IsRequested("Description"))
+        {
+            inst.Description_value("Performance statistics rolled up over a group of Unix processes");
+        }
+
+        std::string elementName;
+        if (requested.IsRequested("ElementName") && group.GetElementName(elementName))
+        {
+            inst.ElementName_value(elementName.c_str());
+        }
+
+        inst.IsAggregate_value(true);
+
+        if (requested.IsRequested("GroupType"))
+        {
+            inst.GroupType_value(group.GetTypeName().c_str());
+        }
+
+        if (requested.IsRequested("GroupValue"))
+        {
+            inst.GroupValue_value(group.GetValue().c_str());
+        }
+
+        if (requested.IsRequested("NumberOfProcesses"))
+        {
+            inst.NumberOfProcesses_value(group.GetNumberOfProcesses());
+        }
+
+        if (requested.IsRequested("PercentUserTime") && group.GetSum(SCXCore::ProcessGroup::ePercentUserTime, ulong))
+        {
+            inst.PercentUserTime_value(ulong);
+        }
+
+        if (requested.IsRequested("PercentPrivilegedTime") && group.GetSum(SCXCore::ProcessGroup::ePercentPrivilegedTime, ulong))
+        {
+            inst.PercentPrivilegedTime_value(ulong);
+        }
+
+        if (requested.IsRequested("UsedMemory") && group.GetSum(SCXCore::ProcessGroup::eUsedMemory, ulong))
+        {
+            inst.UsedMemory_value(ulong);
+        }
+
+        if (requested.IsRequested("PercentUsedMemory") && group.GetSum(SCXCore::ProcessGroup::ePercentUsedMemory, ulong))
+        {
+            inst.PercentUsedMemory_value(ulong);
+        }
+
+        if (requested.IsRequested("BlockReadsPerSecond") && group.GetSum(SCXCore::ProcessGroup::eBlockReadsPerSecond, ulong))
+        {
+            inst.BlockReadsPerSecond_value(ulong);
+        }
+
+        if (requested.IsRequested("BlockWritesPerSecond") && group.GetSum(SCXCore::ProcessGroup::eBlockWritesPerSecond, ulong))
+        {
+            inst.BlockWritesPerSecond_value(ulong);
+        }
+
+        if (requested.IsRequested("BlockTransfersPerSecond") && group.GetSum(SCXCore::ProcessGroup::eBlockTransfersPerSecond, ulong))
+        {
+            inst.BlockTransfersPerSecond_value(ulong);
+        }
+    }
+    context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
+}
+
+SCX_UnixProcessGroupStatisticalInformation_Class_Provider::SCX_UnixProcessGroupStatisticalInformation_Class_Provider(
+    Module* module) :
+    m_Module(module)
+{
+}
+
+SCX_UnixProcessGroupStatisticalInformation_Class_Provider::~SCX_UnixProcessGroupStatisticalInformation_Class_Provider()
+{
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::Load(
+        Context& context)
+{
+    SCX_PEX_BEGIN
+    {
+        // Global lock for ProcessProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+        SCXCore::g_ProcessProvider.Load();
+
+        // Notify that we don't wish to unload
+        MI_Result r = context.RefuseUnload();
+        if ( MI_RESULT_OK != r )
+        {
+            SCX_LOGWARNING(SCXCore::g_ProcessProvider.GetLogHandle(),
+                    SCXCoreLib::StrAppend(L"SCX_UnixProcessGroupStatisticalInformation_Class_Provider::Load() refuses to not unload, error = ", r));
+        }
+
+        context.Post(MI_RESULT_OK);
+    }
+    SCX_PEX_END( L"SCX_UnixProcessGroupStatisticalInformation_Class_Provider::Load", SCXCore::g_ProcessProvider.GetLogHandle() );
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::Unload(
+        Context& context)
+{
+    SCX_PEX_BEGIN
+    {
+        // Global lock for ProcessProvider class
+        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+        SCXCore::g_ProcessProvider.Unload();
+
+        context.Post(MI_RESULT_OK);
+    }
+    SCX_PEX_END( L"SCX_UnixProcessGroupStatisticalInformation_Class_Provider::Unload", SCXCore::g_ProcessProvider.GetLogHandle() );
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::EnumerateInstances(
+    Context& context,
+    const String& nameSpace,
+    const PropertySet& propertySet,
+    bool keysOnly,
+    const MI_Filter* filter)
+{
+    SCXLogHandle& log = SCXCore::g_ProcessProvider.GetLogHandle();
+    SCX_LOGTRACE(log, L"UnixProcessGroupStat Provider EnumerateInstances begin");
+
+    SCX_PEX_BEGIN
+    {
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcessGroupStatisticalInformation", "EnumerateInstances");
+
+        // Names of the groups the filter can match (if few enough to roll them up one by one)
+        std::set<std::wstring> names;
+        bool targeted = false;
+
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"Unix Process Group Statistical Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
+
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Name", names);
+            if (targeted)
+            {
+                SCX_LOGTRACE(log, StrAppend(L"Unix Process Group Statistical Provider Enum Requested for Groups, count: ", names.size()));
+            }
+        }
+
+        SCXCore::RequestedProperties requested = CIMUtils::GetRequestedProperties(propertySet, filter);
+
+        // The snapshot is immutable: no lock is held while reading it
+        SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCX_LOGTRACE(log, StrAppend(L"Number of Processes = ", snapshot->Size()));
+
+        if (targeted)
+        {
+            for (std::set<std::wstring>::const_iterator it = names.begin(); it != names.end(); ++it)
+            {
+                SCXCore::ProcessGroup group(SCXCore::ProcessGroup::eUser, "");
+                if (SCXCore::ProcessGroup::Aggregate(*snapshot, StrToUTF8(*it), group))
+                {
+                    SCX_UnixProcessGroupStatisticalInformation_Class inst;
+                    EnumerateOneInstance(context, inst, keysOnly, requested, group);
+                }
+            }
+        }
+        else
+        {
+            std::vector<SCXCore::ProcessGroup> groups;
+            SCXCore::ProcessGroup::Aggregate(*snapshot, groups);
+            SCX_LOGTRACE(log, StrAppend(L"Number of Process Groups = ", groups.size()));
+
+            for (size_t i = 0; i < groups.size(); i++)
+            {
+                SCX_UnixProcessGroupStatisticalInformation_Class inst;
+                EnumerateOneInstance(context, inst, keysOnly, requested, groups[i]);
+            }
+        }
+        context.Post(MI_RESULT_OK);
+    }
+    SCX_PEX_END( L"SCX_UnixProcessGroupStatisticalInformation_Class_Provider::EnumerateInstances", log );
+
+    SCX_LOGTRACE(log, L"UnixProcessGroupStat Provider EnumerateInstances end");
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::GetInstance(
+    Context& context,
+    const String& nameSpace,
+    const SCX_UnixProcessGroupStatisticalInformation_Class& instanceName,
+    const PropertySet& propertySet)
+{
+    SCXLogHandle& log = SCXCore::g_ProcessProvider.GetLogHandle();
+
+    SCX_PEX_BEGIN
+    {
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcessGroupStatisticalInformation", "GetInstance");
+
+        // We have 1-part key:
+        //   [Key] Name=User:0
+
+        if ( !instanceName.Name_exists() )
+        {
+            context.Post(MI_RESULT_INVALID_PARAMETER);
+            return;
+        }
+
+        // The snapshot is immutable: no lock is held while reading it
+        SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+
+        SCXCore::ProcessGroup group(SCXCore::ProcessGroup::eUser, "");
+        if ( !SCXCore::ProcessGroup::Aggregate(*snapshot, instanceName.Name_value().Str(), group) )
+        {
+            // Didn't find a match.
+            context.Post(MI_RESULT_NOT_FOUND);
+            return;
+        }
+
+        // Found a Match. Enumerate the properties for the instance.
+        SCX_UnixProcessGroupStatisticalInformation_Class inst;
+        EnumerateOneInstance(context, inst, false, CIMUtils::GetRequestedProperties(propertySet), group);
+
+        context.Post(MI_RESULT_OK);
+    }
+    SCX_PEX_END( L"SCX_UnixProcessGroupStatisticalInformation_Class_Provider::GetInstance", log );
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::CreateInstance(
+    Context& context,
+    const String& nameSpace,
+    const SCX_UnixProcessGroupStatisticalInformation_Class& newInstance)
+{
+    context.Post(MI_RESULT_NOT_SUPPORTED);
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::ModifyInstance(
+    Context& context,
+    const String& nameSpace,
+    const SCX_UnixProcessGroupStatisticalInformation_Class& modifiedInstance,
+    const PropertySet& propertySet)
+{
+    context.Post(MI_RESULT_NOT_SUPPORTED);
+}
+
+void SCX_UnixProcessGroupStatisticalInformation_Class_Provider::DeleteInstance(
+    Context& context,
+    const String& nameSpace,
+    const SCX_UnixProcessGroupStatisticalInformation_Class& instanceName)
+{
+    context.Post(MI_RESULT_NOT_SUPPORTED);
+}
+
+
+MI_END_NAMESPACE
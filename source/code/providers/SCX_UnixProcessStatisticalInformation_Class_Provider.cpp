@@ -18,18 +18,16 @@
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxthreadlock.h>
-#include <scxcorelib/scxnameresolver.h>
-#include <scxsystemlib/scxostypeinfo.h>
 #include <scxsystemlib/processinstance.h>
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
 #include "support/processprovider.h"
+#include "support/scopingkeys.h"
+#include "support/wqlfiltercache.h"
 #include <sstream>
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
 #include <string>
 
-# define QLENGTH 1000
-
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
 
@@ -37,42 +35,34 @@ MI_BEGIN_NAMESPACE
 
 static void EnumerateOneInstance(Context& context,
         SCX_UnixProcessStatisticalInformation_Class& inst, bool keysOnly,
-        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processinst)
+        const SCXCore::RequestedProperties& requested,
+        const SCXCore::ProcessSnapshotInstance& processinst)
 {
-    SCXLogHandle& log = SCXCore::g_ProcessProvider.GetLogHandle();
-
     // Add the key properties first.
     scxulong pid;
-    if (processinst->GetPID(pid))
+    if (processinst.GetPID(pid))
     {
         inst.Handle_value(StrToUTF8(StrFrom(pid)).c_str());
     }
 
     // Add keys of scoping operating system
-    try {
-        SCXCoreLib::NameResolver mi;
-        inst.CSName_value(StrToMultibyte(mi.GetHostDomainname()).c_str());
-    } catch (SCXException& e){
-        SCX_LOGWARNING(log, StrAppend(
-                    StrAppend(L"Can't read host/domainname because ", e.What()),
-                    e.Where()));
+    std::string scopingKey;
+    if (SCXCore::g_ScopingKeys.GetCSName(scopingKey))
+    {
+        inst.CSName_value(scopingKey.c_str());
     }
 
-    try {
-        SCXSystemLib::SCXOSTypeInfo osinfo;
-        inst.OSName_value(StrToMultibyte(osinfo.GetOSName(true)).c_str());
-    } catch (SCXException& e){
-        SCX_LOGWARNING(log, StrAppend(
-                    StrAppend(L"Can't read OS name because ", e.What()),
-                    e.Where()));
+    if (SCXCore::g_ScopingKeys.GetOSName(scopingKey))
+    {
+        inst.OSName_value(scopingKey.c_str());
     }
 
-    inst.CSCreationClassName_value("SCX_ComputerSystem");
-    inst.OSCreationClassName_value("SCX_OperatingSystem");
+    inst.CSCreationClassName_value(SCXCore::ScopingKeys::cCSCreationClassName);
+    inst.OSCreationClassName_value(SCXCore::ScopingKeys::cOSCreationClassName);
     inst.ProcessCreationClassName_value("SCX_UnixProcessStatisticalInformation");
 
     std::string name;
-    if (processinst->GetName(name))
+    if (processinst.GetName(name))
     {
         inst.Name_value(name.c_str());
     }
@@ -82,105 +72,114 @@ static void EnumerateOneInstance(Context& context,
         unsigned int uint = 0;
         scxulong ulong = 0;
 
-        inst.Description_value("A snapshot of a current process");
-        inst.Caption_value("Unix process information");
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Description"))
+        {
+            inst.Description_value("A snapshot of a current process");
+        }
+
+        if (requested.IsRequested("Caption"))
+        {
+            inst.Caption_value("Unix process information");
+        }
 
-        if (processinst->GetRealData(ulong))
+        if (requested.IsRequested("RealData") && processinst.GetRealData(ulong))
         {
             inst.RealData_value(ulong);
         }
 
-        if (processinst->GetRealStack(ulong))
+        if (requested.IsRequested("RealStack") && processinst.GetRealStack(ulong))
         {
             inst.RealStack_value(ulong);
         }
 
-        if (processinst->GetVirtualText(ulong))
+        if (requested.IsRequested("VirtualText") && processinst.GetVirtualText(ulong))
         {
             inst.VirtualText_value(ulong);
         }
 
-        if (processinst->GetVirtualData(ulong))
+        if (requested.IsRequested("VirtualData") && processinst.GetVirtualData(ulong))
         {
             inst.VirtualData_value(ulong);
         }
 
-        if (processinst->GetVirtualStack(ulong))
+        if (requested.IsRequested("VirtualStack") && processinst.GetVirtualStack(ulong))
         {
             inst.VirtualStack_value(ulong);
         }
 
-        if (processinst->GetVirtualMemoryMappedFileSize(ulong))
+        if (requested.IsRequested("VirtualMemoryMappedFileSize") && processinst.GetVirtualMemoryMappedFileSize(ulong))
         {
             inst.VirtualMemoryMappedFileSize_value(ulong);
         }
 
-        if (processinst->GetVirtualSharedMemory(ulong))
+        if (requested.IsRequested("VirtualSharedMemory") && processinst.GetVirtualSharedMemory(ulong))
         {
             inst.VirtualSharedMemory_value(ulong);
         }
 
-        if (processinst->GetCpuTimeDeadChildren(ulong))
+        if (requested.IsRequested("CpuTimeDeadChildren") && processinst.GetCpuTimeDeadChildren(ulong))
         {
             inst.CpuTimeDeadChildren_value(ulong);
         }
 
-        if (processinst->GetSystemTimeDeadChildren(ulong))
+        if (requested.IsRequested("SystemTimeDeadChildren") && processinst.GetSystemTimeDeadChildren(ulong))
         {
             inst.SystemTimeDeadChildren_value(ulong);
         }
 
-        if (processinst->GetRealText(ulong))
+        if (requested.IsRequested("RealText") && processinst.GetRealText(ulong))
         {
             inst.RealText_value(ulong);
         }
 
-        if (processinst->GetCPUTime(uint))
+        if (requested.IsRequested("CPUTime") && processinst.GetCPUTime(uint))
         {
             inst.CPUTime_value(uint);
         }
 
-        if (processinst->GetBlockWritesPerSecond(ulong))
+        if (requested.IsRequested("BlockWritesPerSecond") && processinst.GetBlockWritesPerSecond(ulong))
         {
             inst.BlockWritesPerSecond_value(ulong);
         }
 
-        if (processinst->GetBlockReadsPerSecond(ulong))
+        if (requested.IsRequested("BlockReadsPerSecond") && processinst.GetBlockReadsPerSecond(ulong))
         {
             inst.BlockReadsPerSecond_value(ulong);
         }
 
-        if (processinst->GetBlockTransfersPerSecond(ulong))
+        if (requested.IsRequested("BlockTransfersPerSecond") && processinst.GetBlockTransfersPerSecond(ulong))
         {
             inst.BlockTransfersPerSecond_value(ulong);
         }
 
-        if (processinst->GetPercentUserTime(ulong))
+        if (requested.IsRequested("PercentUserTime") && processinst.GetPercentUserTime(ulong))
         {
             inst.PercentUserTime_value((unsigned char) ulong);
         }
 
-        if (processinst->GetPercentPrivilegedTime(ulong))
+        if (requested.IsRequested("PercentPrivilegedTime") && processinst.GetPercentPrivilegedTime(ulong))
         {
             inst.PercentPrivilegedTime_value((unsigned char) ulong);
         }
 
-        if (processinst->GetUsedMemory(ulong))
+        if (requested.IsRequested("UsedMemory") && processinst.GetUsedMemory(ulong))
         {
             inst.UsedMemory_value(ulong);
         }
 
-        if (processinst->GetPercentUsedMemory(ulong))
+        if (requested.IsRequested("PercentUsedMemory") && processinst.GetPercentUsedMemory(ulong))
         {
             inst.PercentUsedMemory_value((unsigned char) ulong);
         }
 
-        if (processinst->GetPagesReadPerSec(ulong))
+        if (requested.IsRequested("PagesReadPerSec") && processinst.GetPagesReadPerSec(ulong))
         {
             inst.PagesReadPerSec_value(ulong);
         }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 }
 
 SCX_UnixProcessStatisticalInformation_Class_Provider::SCX_UnixProcessStatisticalInformation_Class_Provider(
@@ -241,67 +240,61 @@ void SCX_UnixProcessStatisticalInformation_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for ProcessProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
-
-        SCX_LOGTRACE(SCXCore::g_ProcessProvider.GetLogHandle(), L"Process Provider EnumerateInstances");
-
-        SCXHandle<SCXSystemLib::ProcessEnumeration> processEnum = SCXCore::g_ProcessProvider.GetProcessEnumerator();
-
-        string processID="";
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
-
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
-
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"Unix Process Statistical Provider Filter Set with Expression: ",*expr));
-
-            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
-
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_UnixProcessStatisticalInformation where Handle=%name");
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcessStatisticalInformation", "EnumerateInstances");
 
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+        // Handles of the processes the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> handles;
+        bool targeted = false;
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"Unix Process Statistical Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            if (status && id == s_patternID && param.end() != param.find(L"name"))
+            targeted = SCXCore::g_WqlFilterCache.Get(query)->GetTargetValues(L"Handle", handles);
+            if (targeted)
             {
-                processID=StrToUTF8(param.find(L"name")->second);
-                SCX_LOGTRACE(log,  StrAppend(L"Unix Process Statistical Provider Enum Requested for Process ID: ", param.find(L"name")->second));
+                SCX_LOGTRACE(log, StrAppend(L"Unix Process Statistical Provider Enum Requested for Process IDs, count: ", handles.size()));
             }
         }
 
-        if ( processID != "" ) {
-            stringstream ss(processID);
-            int pid;
-            ss >> pid;
-            processEnum->UpdateSpecific(pid);
-        }
-        else
-            processEnum->Update();
-
-        SCX_LOGTRACE(log, StrAppend(L"Number of Processes = ", processEnum->Size()));
+        SCXCore::RequestedProperties requested = CIMUtils::GetRequestedProperties(propertySet, filter);
 
-        for(size_t i = 0; i < processEnum->Size(); i++)
+        if (targeted)
         {
-            if ( processID != ""){
+            // Handles that aren't process IDs can't match any process
+            std::set<scxulong> pids;
+            for (std::set<std::wstring>::const_iterator it = handles.begin(); it != handles.end(); ++it)
+            {
                 scxulong pid = 0;
-                processEnum->GetInstance(i)->GetPID(pid);
-                stringstream ss; ss<<pid;
-                string spid;ss>>spid;
-                if ( spid != processID) continue;
+                if (SCXCore::ProcessSnapshot::ParseHandle(*it, pid))
+                {
+                    pids.insert(pid);
+                }
+            }
+
+            // The snapshot is immutable: no lock is held while reading it
+            SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot(pids);
+            for (std::set<scxulong>::const_iterator it = pids.begin(); it != pids.end(); ++it)
+            {
+                const SCXCore::ProcessSnapshotInstance* processInst = snapshot->GetInstanceByPid(*it);
+                if ( processInst != NULL )
+                {
+                    SCX_UnixProcessStatisticalInformation_Class proc;
+                    EnumerateOneInstance(context, proc, keysOnly, requested, *processInst);
+                }
             }
+        }
+        else
+        {
+            // The snapshot is immutable: no lock is held while reading it
+            SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+            SCX_LOGTRACE(log, StrAppend(L"Number of Processes = ", snapshot->Size()));
 
-            SCX_UnixProcessStatisticalInformation_Class proc;
-            EnumerateOneInstance(context, proc, keysOnly, processEnum->GetInstance(i));
-            if ( processID != "") break;
+            for(size_t i = 0; i < snapshot->Size(); i++)
+            {
+                SCX_UnixProcessStatisticalInformation_Class proc;
+                EnumerateOneInstance(context, proc, keysOnly, requested, snapshot->GetInstance(i));
+            }
         }
         context.Post(MI_RESULT_OK);
     }
@@ -320,8 +313,7 @@ void SCX_UnixProcessStatisticalInformation_Class_Provider::GetInstance(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for ProcessProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcessStatisticalInformation", "GetInstance");
 
         // We have 7-part key:
         //   [Key] Name=udevd
@@ -344,32 +336,25 @@ void SCX_UnixProcessStatisticalInformation_Class_Provider::GetInstance(
             return;
         }
 
-        SCXCoreLib::NameResolver mi;
         std::string csName;
-        try {
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e){
-            SCX_LOGWARNING(log, StrAppend(
-                        StrAppend(L"Can't read host/domainname because ", e.What()),
-                        e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
-        SCXSystemLib::SCXOSTypeInfo osinfo;
         std::string osName;
-        try {
-            osName = StrToMultibyte(osinfo.GetOSName(true)).c_str();
-        } catch (SCXException& e){
-            SCX_LOGWARNING(log, StrAppend(
-                        StrAppend(L"Can't read OS name because ", e.What()),
-                        e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetOSName(osName);
 
         SCX_LOGTRACE(log, L"Process Provider GetInstances");
-        SCXHandle<SCXSystemLib::ProcessEnumeration> processEnum = SCXCore::g_ProcessProvider.GetProcessEnumerator();
-        processEnum->Update();
+        scxulong pid = 0;
+        if (!SCXCore::ProcessSnapshot::ParseHandle(StrFromMultibyte(instanceName.Handle_value().Str()), pid))
+        {
+            // Not a process ID: can't match any process
+            context.Post(MI_RESULT_NOT_FOUND);
+            return;
+        }
 
-        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processInst =
-            processEnum->GetInstance(StrFromMultibyte(instanceName.Handle_value().Str()));
+        // Only this process is refreshed if the shared snapshot is too old.
+        // The snapshot is immutable: no lock is held while reading it
+        SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot(pid);
+        const SCXCore::ProcessSnapshotInstance* processInst = snapshot->GetInstanceByPid(pid);
 
         std::string name;
         if (processInst != NULL)
@@ -392,7 +377,7 @@ void SCX_UnixProcessStatisticalInformation_Class_Provider::GetInstance(
 
         // Found a Match. Enumerate the properties for the instance.
         SCX_UnixProcessStatisticalInformation_Class proc;
-        EnumerateOneInstance(context, proc, false, processInst);
+        EnumerateOneInstance(context, proc, false, CIMUtils::GetRequestedProperties(propertySet), *processInst);
 
         context.Post(MI_RESULT_OK);
     }
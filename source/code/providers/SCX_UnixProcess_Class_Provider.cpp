@@ -18,18 +18,16 @@
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxthreadlock.h>
-#include <scxcorelib/scxnameresolver.h>
-#include <scxsystemlib/scxostypeinfo.h>
 #include <scxsystemlib/processinstance.h>
+#include "support/providerstatistics.h"
 #include "support/scxcimutils.h"
 #include "support/processprovider.h"
+#include "support/scopingkeys.h"
+#include "support/wqlfiltercache.h"
 #include <sstream>
 #include <scxcorelib/scxregex.h>
-#include <scxcorelib/scxpatternfinder.h>
 #include <string>
 
-# define QLENGTH 1000
-
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
 
@@ -41,43 +39,42 @@ namespace SCXCore
 
 MI_BEGIN_NAMESPACE
 
+static void AddKeys(SCX_UnixProcess_Class& inst, scxulong pid)
+{
+    inst.Handle_value(StrToUTF8(StrFrom(pid)).c_str());
+
+    // Add keys of scoping operating system
+    std::string scopingKey;
+    if (SCXCore::g_ScopingKeys.GetCSName(scopingKey))
+    {
+        inst.CSName_value(scopingKey.c_str());
+    }
+
+    if (SCXCore::g_ScopingKeys.GetOSName(scopingKey))
+    {
+        inst.OSName_value(scopingKey.c_str());
+    }
+
+    inst.CSCreationClassName_value(SCXCore::ScopingKeys::cCSCreationClassName);
+    inst.OSCreationClassName_value(SCXCore::ScopingKeys::cOSCreationClassName);
+    inst.CreationClassName_value("SCX_UnixProcess");
+}
+
 static void EnumerateOneInstance(Context& context,
         SCX_UnixProcess_Class& inst, bool keysOnly,
-        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processinst)
+        const SCXCore::RequestedProperties& requested,
+        const SCXCore::ProcessSnapshotInstance& processinst)
 {
     SCXLogHandle& log = SCXCore::g_ProcessProvider.GetLogHandle();
 
     // Add the key properties first.
     scxulong pid = 0;
-    if (processinst->GetPID(pid))
+    if (processinst.GetPID(pid))
     {
-        inst.Handle_value(StrToUTF8(StrFrom(pid)).c_str());
+        AddKeys(inst, pid);
     }
 
     SCX_LOGHYSTERICAL(log, StrAppend(L"UnixProcess Provider sending instance for handle: ", StrFrom(pid)));
-    
-    // Add keys of scoping operating system
-    try {
-        SCXCoreLib::NameResolver mi;
-        inst.CSName_value(StrToMultibyte(mi.GetHostDomainname()).c_str());
-    } catch (SCXException& e){
-        SCX_LOGWARNING(log, StrAppend(
-                    StrAppend(L"Can't read host/domainname because ", e.What()),
-                    e.Where()));
-    }
-
-    try {
-        SCXSystemLib::SCXOSTypeInfo osinfo;
-        inst.OSName_value(StrToMultibyte(osinfo.GetOSName(true)).c_str());
-    } catch (SCXException& e){
-        SCX_LOGWARNING(log, StrAppend(
-                    StrAppend(L"Can't read OS name because ", e.What()),
-                    e.Where()));
-    }
-
-    inst.CSCreationClassName_value("SCX_ComputerSystem");
-    inst.OSCreationClassName_value("SCX_OperatingSystem");
-    inst.CreationClassName_value("SCX_UnixProcess");
 
 
     if (!keysOnly)
@@ -91,45 +88,53 @@ static void EnumerateOneInstance(Context& context,
         SCXCoreLib::SCXCalendarTime ctime;
         int ppid = 0;
 
-        inst.Description_value("A snapshot of a current process");
-        inst.Caption_value("Unix process information");
+        // Properties the client didn't ask for are neither computed nor posted
+        if (requested.IsRequested("Description"))
+        {
+            inst.Description_value("A snapshot of a current process");
+        }
 
-        if (processinst->GetOtherExecutionDescription(str))
+        if (requested.IsRequested("Caption"))
+        {
+            inst.Caption_value("Unix process information");
+        }
+
+        if (requested.IsRequested("OtherExecutionDescription") && processinst.GetOtherExecutionDescription(str))
         {
             inst.OtherExecutionDescription_value(StrToUTF8(str).c_str());
         }
 
-        if (processinst->GetKernelModeTime(ulong))
+        if (requested.IsRequested("KernelModeTime") && processinst.GetKernelModeTime(ulong))
         {
             inst.KernelModeTime_value(ulong);
         }
 
-        if (processinst->GetUserModeTime(ulong))
+        if (requested.IsRequested("UserModeTime") && processinst.GetUserModeTime(ulong))
         {
             inst.UserModeTime_value(ulong);
         }
 
-        if (processinst->GetWorkingSetSize(ulong))
+        if (requested.IsRequested("WorkingSetSize") && processinst.GetWorkingSetSize(ulong))
         {
             inst.WorkingSetSize_value(ulong);
         }
 
-        if (processinst->GetProcessSessionID(ulong))
+        if (requested.IsRequested("ProcessSessionID") && processinst.GetProcessSessionID(ulong))
         {
             inst.ProcessSessionID_value(ulong);
         }
 
-        if (processinst->GetProcessTTY(name))
+        if (requested.IsRequested("ProcessTTY") && processinst.GetProcessTTY(name))
         {
             inst.ProcessTTY_value(name.c_str());
         }
 
-        if (processinst->GetModulePath(name))
+        if (requested.IsRequested("ModulePath") && processinst.GetModulePath(name))
         {
             inst.ModulePath_value(name.c_str());
         }
 
-        if (processinst->GetParameters(params))
+        if (requested.IsRequested("Parameters") && processinst.GetParameters(params))
         {
             std::vector<mi::String> strArrary;
             for (std::vector<std::string>::const_iterator iter = params.begin();
@@ -141,75 +146,118 @@ static void EnumerateOneInstance(Context& context,
             inst.Parameters_value(props);
         } 
 
-        if (processinst->GetProcessWaitingForEvent(name))
+        if (requested.IsRequested("ProcessWaitingForEvent") && processinst.GetProcessWaitingForEvent(name))
         {
             inst.ProcessWaitingForEvent_value(name.c_str());
         }
 
-        if (processinst->GetName(name))
+        if (requested.IsRequested("Name") && processinst.GetName(name))
         {
             inst.Name_value(name.c_str());
         }
 
-        if (processinst->GetNormalizedWin32Priority(uint))
+        if (requested.IsRequested("Priority") && processinst.GetNormalizedWin32Priority(uint))
         {
             inst.Priority_value(uint);
         }
 
-        if (processinst->GetExecutionState(ushort))
+        if (requested.IsRequested("ExecutionState") && processinst.GetExecutionState(ushort))
         {
             inst.ExecutionState_value(ushort);
         }
 
-        if (processinst->GetCreationDate(ctime))
+        if (requested.IsRequested("CreationDate") && processinst.GetCreationDate(ctime))
         {
             MI_Datetime creationDate; 
             CIMUtils::ConvertToCIMDatetime(creationDate, ctime);
             inst.CreationDate_value(creationDate);
         }
 
-        if (processinst->GetTerminationDate(ctime))
+        if (requested.IsRequested("TerminationDate") && processinst.GetTerminationDate(ctime))
         {
             MI_Datetime terminationDate; 
             CIMUtils::ConvertToCIMDatetime(terminationDate, ctime);
             inst.TerminationDate_value(terminationDate);
         }
 
-        if (processinst->GetParentProcessID(ppid))
+        if (requested.IsRequested("ParentProcessID") && processinst.GetParentProcessID(ppid))
         {
             inst.ParentProcessID_value(StrToUTF8(StrFrom(ppid)).c_str());
         }
 
-        if (processinst->GetRealUserID(ulong))
+        if (requested.IsRequested("RealUserID") && processinst.GetRealUserID(ulong))
         {
             inst.RealUserID_value(ulong);
         }
 
-        if (processinst->GetProcessGroupID(ulong))
+        if (requested.IsRequested("ProcessGroupID") && processinst.GetProcessGroupID(ulong))
         {
             inst.ProcessGroupID_value( ulong);
         }
 
-        if (processinst->GetProcessNiceValue(uint))
+        if (requested.IsRequested("ProcessNiceValue") && processinst.GetProcessNiceValue(uint))
         {
             inst.ProcessNiceValue_value(uint);
         }
 
-        if (processinst->GetPercentUserTime(ulong) && processinst->GetPercentPrivilegedTime(ulong1))
+        if (requested.IsRequested("PercentBusyTime")
+            && processinst.GetPercentUserTime(ulong) && processinst.GetPercentPrivilegedTime(ulong1))
         {
             inst.PercentBusyTime_value((unsigned char) (ulong + ulong1));
         }
 
-        if (processinst->GetUsedMemory(ulong))
+        if (requested.IsRequested("UsedMemory") && processinst.GetUsedMemory(ulong))
         {
             inst.UsedMemory_value(ulong);
         }
+
+        if (requested.IsRequested("Generation") && 0 != processinst.GetGeneration())
+        {
+            inst.Generation_value(processinst.GetGeneration());
+        }
     }
     context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
 
     SCX_LOGHYSTERICAL(log, StrAppend(L"UnixProcess Provider sent instance for handle: ", StrFrom(pid)));
 }
 
+static void EnumerateTerminatedInstance(Context& context,
+        SCX_UnixProcess_Class& inst, bool keysOnly,
+        const SCXCore::RequestedProperties& requested,
+        const SCXCore::TerminatedProcess& terminated)
+{
+    // Only what is left of the process: its identity and the generation it terminated in
+    AddKeys(inst, terminated.pid);
+
+    if (!keysOnly)
+    {
+        if (requested.IsRequested("Name"))
+        {
+            inst.Name_value(terminated.name.c_str());
+        }
+
+        if (requested.IsRequested("ExecutionState"))
+        {
+            // Terminated
+            inst.ExecutionState_value(7);
+        }
+
+        if (requested.IsRequested("Generation"))
+        {
+            inst.Generation_value(terminated.generation);
+        }
+    }
+    context.Post(inst);
+    SCXCore::ProviderCallTimer::InstancePosted();
+}
+
+//! Is a generation within an inclusive range of the filter?
+static bool InRange(scxulong generation, scxlong low, scxlong high)
+{
+    return static_cast<scxlong>(generation) >= low && static_cast<scxlong>(generation) <= high;
+}
+
 SCX_UnixProcess_Class_Provider::SCX_UnixProcess_Class_Provider(
     Module* module) :
     m_Module(module)
@@ -268,65 +316,91 @@ void SCX_UnixProcess_Class_Provider::EnumerateInstances(
 
     SCX_PEX_BEGIN
     {
-        // Global lock for ProcessProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
-
-        SCXHandle<SCXSystemLib::ProcessEnumeration> processEnum = SCXCore::g_ProcessProvider.GetProcessEnumerator();
-
-	string processID="";
-
-        if(filter) {
-            char* exprStr[QLENGTH]={'\0'};
-            char* qtypeStr[QLENGTH]={'\0'};
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcess", "EnumerateInstances");
 
-            const MI_Char** expr=(const MI_Char**)&exprStr;
-            const MI_Char** qtype=(const MI_Char**)&qtypeStr;
+        // Handles of the processes the filter can match (if few enough to collect them one by one)
+        std::set<std::wstring> handles;
+        bool targeted = false;
 
-            MI_Filter_GetExpression(filter, qtype, expr);
-            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"Unix Process Provider Filter Set with Expression: ",*expr));
+        // Generations the filter can match, when the client asks for changes since a cursor
+        scxlong lowGeneration = 0, highGeneration = 0;
+        bool delta = false;
 
-	    std::wstring filterQuery(SCXCoreLib::StrFromUTF8(*expr));
+        std::string query;
+        if (CIMUtils::GetFilterExpression(filter, query)) {
+            SCX_LOGTRACE(log, SCXCoreLib::StrAppend(L"Unix Process Provider Filter Set with Expression: ", SCXCoreLib::StrFromUTF8(query)));
 
-            SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID = 0, id=0;
-            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
-            std::wstring s_pattern(L"select * from SCX_UnixProcess where Handle=%name");
-
-            SCXCoreLib::SCXPatternFinder patterenfinder;
-            patterenfinder.RegisterPattern(s_patternID, s_pattern);
+            SCXHandle<SCXCore::WqlFilter> wql = SCXCore::g_WqlFilterCache.Get(query);
+            targeted = wql->GetTargetValues(L"Handle", handles);
+            if (targeted)
+            {
+                SCX_LOGTRACE(log, StrAppend(L"Unix Process Provider Enum Requested for Process IDs, count: ", handles.size()));
+            }
+            else
+            {
+                // Generation is posted whatever the projection, since OMI evaluates the filter
+                // on it (see CIMUtils::GetRequestedProperties())
+                delta = wql->GetRange(L"Generation", lowGeneration, highGeneration);
+            }
+        }
 
-            bool status=patterenfinder.Match(filterQuery, id, param);
+        SCXCore::RequestedProperties requested = CIMUtils::GetRequestedProperties(propertySet, filter);
 
-            if (status && id == s_patternID && param.end() != param.find(L"name"))
+        if (targeted)
+        {
+            // Handles that aren't process IDs can't match any process
+            std::set<scxulong> pids;
+            for (std::set<std::wstring>::const_iterator it = handles.begin(); it != handles.end(); ++it)
             {
-                processID=StrToUTF8(param.find(L"name")->second);
-                SCX_LOGTRACE(log,  StrAppend(L"Unix Process Provider Enum Requested for Process ID: ", param.find(L"name")->second));
+                scxulong pid = 0;
+                if (SCXCore::ProcessSnapshot::ParseHandle(*it, pid))
+                {
+                    pids.insert(pid);
+                }
             }
-        }
 
-        if ( processID != "" ) {
-            stringstream ss(processID);
-            int pid;
-            ss >> pid;
-            processEnum->UpdateSpecific(pid);
+            // The snapshot is immutable: no lock is held while reading it
+            SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot(pids);
+            for (std::set<scxulong>::const_iterator it = pids.begin(); it != pids.end(); ++it)
+            {
+                const SCXCore::ProcessSnapshotInstance* processInst = snapshot->GetInstanceByPid(*it);
+                if ( processInst != NULL )
+                {
+                    SCX_UnixProcess_Class proc;
+                    EnumerateOneInstance(context, proc, keysOnly, requested, *processInst);
+                }
+            }
         }
         else
-            processEnum->Update();
+        {
+            // The snapshot is immutable: no lock is held while reading it
+            SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+            SCX_LOGTRACE(log, StrAppend(L"Number of Processes = ", snapshot->Size()));
 
-        SCX_LOGTRACE(log, StrAppend(L"Number of Processes = ", processEnum->Size()));
+            for(size_t i = 0; i < snapshot->Size(); i++)
+            {
+                if (delta && !InRange(snapshot->GetInstance(i).GetGeneration(), lowGeneration, highGeneration))
+                {
+                    continue;
+                }
 
-        for(size_t i = 0; i < processEnum->Size(); i++)
-        {
-            if ( processID != ""){
-                scxulong pid = 0;
-                processEnum->GetInstance(i)->GetPID(pid);
-                stringstream ss; ss<<pid;
-                string spid;ss>>spid;
-                if ( spid != processID) continue;
+                SCX_UnixProcess_Class proc;
+                EnumerateOneInstance(context, proc, keysOnly, requested, snapshot->GetInstance(i));
             }
 
-            SCX_UnixProcess_Class proc;
-            EnumerateOneInstance(context, proc, keysOnly, processEnum->GetInstance(i));
-            if ( processID != "") break;
+            // Clients that follow the changes also learn which processes went away
+            if (delta)
+            {
+                const std::vector<SCXCore::TerminatedProcess>& terminated = snapshot->GetTerminated();
+                for (size_t i = 0; i < terminated.size(); i++)
+                {
+                    if (InRange(terminated[i].generation, lowGeneration, highGeneration))
+                    {
+                        SCX_UnixProcess_Class proc;
+                        EnumerateTerminatedInstance(context, proc, keysOnly, requested, terminated[i]);
+                    }
+                }
+            }
         }
         context.Post(MI_RESULT_OK);
     }
@@ -343,8 +417,7 @@ void SCX_UnixProcess_Class_Provider::GetInstance(
 {
     SCX_PEX_BEGIN
     {
-        // Global lock for ProcessProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcess", "GetInstance");
 
         // We have 6-part key:
         //   [Key] CSCreationClassName=SCX_ComputerSystem
@@ -363,24 +436,10 @@ void SCX_UnixProcess_Class_Provider::GetInstance(
         }
 
         std::string csName;
-        try {
-            NameResolver mi;
-            csName = StrToMultibyte(mi.GetHostDomainname()).c_str();
-        } catch (SCXException& e) {
-            SCX_LOGWARNING(SCXCore::g_ProcessProvider.GetLogHandle(), StrAppend(
-                               StrAppend(L"Can't read host/domainname because ", e.What()),
-                               e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetCSName(csName);
 
         std::string osName;
-        try {
-            SCXSystemLib::SCXOSTypeInfo osinfo;
-            osName = StrToMultibyte(osinfo.GetOSName(true)).c_str();
-        } catch (SCXException& e){
-            SCX_LOGWARNING(SCXCore::g_ProcessProvider.GetLogHandle(), StrAppend(
-                        StrAppend(L"Can't read OS name because ", e.What()),
-                        e.Where()));
-        }
+        SCXCore::g_ScopingKeys.GetOSName(osName);
 
         // Now compare (case insensitive for the class names, case sensitive for the others)
         if ( 0 != strcasecmp("SCX_ComputerSystem", instanceName.CSCreationClassName_value().Str())
@@ -400,11 +459,18 @@ void SCX_UnixProcess_Class_Provider::GetInstance(
         }
 
         SCX_LOGTRACE(SCXCore::g_ProcessProvider.GetLogHandle(), L"Process Provider GetInstances");
-        SCXHandle<SCXSystemLib::ProcessEnumeration> processEnum = SCXCore::g_ProcessProvider.GetProcessEnumerator();
-        processEnum->Update();
+        scxulong pid = 0;
+        if (!SCXCore::ProcessSnapshot::ParseHandle(StrFromMultibyte(instanceName.Handle_value().Str()), pid))
+        {
+            // Not a process ID: can't match any process
+            context.Post(MI_RESULT_NOT_FOUND);
+            return;
+        }
 
-        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processInst = processEnum->GetInstance(
-            StrFromMultibyte(instanceName.Handle_value().Str()));
+        // Only this process is refreshed if the shared snapshot is too old.
+        // The snapshot is immutable: no lock is held while reading it
+        SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot(pid);
+        const SCXCore::ProcessSnapshotInstance* processInst = snapshot->GetInstanceByPid(pid);
 
         if (processInst == NULL)
         {
@@ -415,7 +481,7 @@ void SCX_UnixProcess_Class_Provider::GetInstance(
 
         // Found a Match. Enumerate the properties for the instance.
         SCX_UnixProcess_Class proc;
-        EnumerateOneInstance(context, proc, false, processInst);
+        EnumerateOneInstance(context, proc, false, CIMUtils::GetRequestedProperties(propertySet), *processInst);
 
         context.Post(MI_RESULT_OK);
     }
@@ -467,25 +533,67 @@ void SCX_UnixProcess_Class_Provider::Invoke_TopResourceConsumers(
     SCXCoreLib::SCXLogHandle log = SCXCore::g_ProcessProvider.GetLogHandle();
     SCX_PEX_BEGIN
     {
-        // Global lock for ProcessProvider class
-        SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+        SCXCore::ProviderCallTimer timer("SCX_UnixProcess", "Invoke_TopResourceConsumers");
+
         SCX_LOGTRACE( log, L"SCX_UnixProcess_Class_Provider::Invoke_TopResourceConsumers" );
 
-        // Validate that we have mandatory arguments
-        if ( !in.count_exists() || !in.resource_exists() )
+        // Validate that we have mandatory arguments (a resource, or a list of them)
+        if ( !in.count_exists() || (!in.resource_exists() && !in.resources_exists()) )
         {
             SCX_LOGTRACE( log, L"Missing arguments to Invoke_TopResourceConsumers method" );
             context.Post(MI_RESULT_INVALID_PARAMETER);
             return;
         }
-        std::wstring return_str;
-        std::wstring resourceStr = StrFromUTF8(in.resource_value().Str());
-        SCXCore::g_ProcessProvider.GetTopResourceConsumers(resourceStr, (unsigned short)in.count_value(), return_str);
+        // The snapshot is immutable: no lock is held while reading it
+        SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
 
         SCX_UnixProcess_TopResourceConsumers_Class inst;
-        inst.MIReturn_value(StrToMultibyte(return_str).c_str());
+        if ( in.resource_exists() )
+        {
+            std::wstring return_str;
+            std::wstring resourceStr = StrFromUTF8(in.resource_value().Str());
+            SCXCore::g_ProcessProvider.GetTopResourceConsumers(snapshot, resourceStr, (unsigned short)in.count_value(), return_str);
+            inst.MIReturn_value(StrToMultibyte(return_str).c_str());
+        }
+
+        // Several resources are ranked in one pass over the snapshot, one SCX_ResourceConsumer per process
+        if ( in.resources_exists() )
+        {
+            const StringA resources_sa = in.resources_value();
+            std::vector<std::wstring> resources;
+            for (MI_Uint32 i = 0; i < resources_sa.GetSize(); i++)
+            {
+                resources.push_back(StrFromUTF8(resources_sa[i].Str()));
+            }
+
+            std::vector<std::vector<SCXCore::ProcessProvider::ResourceConsumer> > consumers;
+            SCXCore::g_ProcessProvider.GetTopResourceConsumers(snapshot, resources, (unsigned short)in.count_value(), consumers);
+
+            SCX_ResourceConsumer_ClassA consumers_ca;
+            for (size_t r = 0; r < consumers.size(); r++)
+            {
+                for (size_t i = 0; i < consumers[r].size(); i++)
+                {
+                    const SCXCore::ProcessProvider::ResourceConsumer& consumer = consumers[r][i];
+                    scxulong pid = 0;
+                    std::string name;
+                    consumer.procinst->GetPID(pid);
+                    consumer.procinst->GetName(name);
+
+                    SCX_ResourceConsumer_Class consumer_inst;
+                    consumer_inst.Resource_value(resources_sa[static_cast<MI_Uint32>(r)]);
+                    consumer_inst.PID_value(pid);
+                    consumer_inst.Value_value(consumer.value);
+                    consumer_inst.Name_value(name.c_str());
+                    consumers_ca.PushBack(consumer_inst);
+                }
+            }
+
+            inst.consumers_value(consumers_ca);
+        }
 
         context.Post(inst);
+        SCXCore::ProviderCallTimer::InstancePosted();
         context.Post(MI_RESULT_OK);
     }
     SCX_PEX_END( L"SCX_UnixProcess_Class_Provider::Invoke_TopResourceConsumers", log );
@@ -21,9 +21,11 @@
 #include "SCX_MemoryStatisticalInformation.h"
 #include "SCX_OperatingSystem.h"
 #include "SCX_ProcessorStatisticalInformation.h"
+#include "SCX_ResourceConsumer.h"
 #include "SCX_RTProcessorStatisticalInformation.h"
 #include "SCX_UnixProcess.h"
 #include "SCX_UnixProcessStatisticalInformation.h"
+#include "SCX_UnixProcessGroupStatisticalInformation.h"
 
 /*
 **==============================================================================
@@ -992,6 +994,23 @@ static MI_CONST MI_PropertyDecl SCX_Agent_LogicalProcessors_prop =
     NULL,
 };
 
+/* property SCX_Agent.ProviderStatistics */
+static MI_CONST MI_PropertyDecl SCX_Agent_ProviderStatistics_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00707312, /* code */
+    MI_T("ProviderStatistics"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRINGA, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_Agent, ProviderStatistics), /* offset */
+    MI_T("SCX_Agent"), /* origin */
+    MI_T("SCX_Agent"), /* propagator */
+    NULL,
+};
+
 static MI_PropertyDecl MI_CONST* MI_CONST SCX_Agent_props[] =
 {
     &CIM_ManagedElement_InstanceID_prop,
@@ -1026,6 +1045,7 @@ static MI_PropertyDecl MI_CONST* MI_CONST SCX_Agent_props[] =
     &SCX_Agent_MachineType_prop,
     &SCX_Agent_PhysicalProcessors_prop,
     &SCX_Agent_LogicalProcessors_prop,
+    &SCX_Agent_ProviderStatistics_prop,
 };
 
 static MI_CONST MI_ProviderFT SCX_Agent_funcs =
@@ -12721,6 +12741,48 @@ static MI_CONST MI_ParameterDecl SCX_LogFile_GetMatchedRows_elevationType_param
     offsetof(SCX_LogFile_GetMatchedRows, elevationType), /* offset */
 };
 
+/* parameter SCX_LogFile.GetMatchedRows(): maxRows */
+static MI_CONST MI_ParameterDecl SCX_LogFile_GetMatchedRows_maxRows_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN, /* flags */
+    0x006D7307, /* code */
+    MI_T("maxRows"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT32, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_LogFile_GetMatchedRows, maxRows), /* offset */
+};
+
+/* parameter SCX_LogFile.GetMatchedRows(): maxBytes */
+static MI_CONST MI_ParameterDecl SCX_LogFile_GetMatchedRows_maxBytes_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN, /* flags */
+    0x006D7308, /* code */
+    MI_T("maxBytes"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT32, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_LogFile_GetMatchedRows, maxBytes), /* offset */
+};
+
+/* parameter SCX_LogFile.GetMatchedRows(): resumePosition */
+static MI_CONST MI_ParameterDecl SCX_LogFile_GetMatchedRows_resumePosition_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN|MI_FLAG_OUT, /* flags */
+    0x00726E0E, /* code */
+    MI_T("resumePosition"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_LogFile_GetMatchedRows, resumePosition), /* offset */
+};
+
 /* parameter SCX_LogFile.GetMatchedRows(): MIReturn */
 static MI_CONST MI_ParameterDecl SCX_LogFile_GetMatchedRows_MIReturn_param =
 {
@@ -12743,6 +12805,9 @@ static MI_ParameterDecl MI_CONST* MI_CONST SCX_LogFile_GetMatchedRows_params[] =
     &SCX_LogFile_GetMatchedRows_qid_param,
     &SCX_LogFile_GetMatchedRows_rows_param,
     &SCX_LogFile_GetMatchedRows_elevationType_param,
+    &SCX_LogFile_GetMatchedRows_maxRows_param,
+    &SCX_LogFile_GetMatchedRows_maxBytes_param,
+    &SCX_LogFile_GetMatchedRows_resumePosition_param,
 };
 
 /* method SCX_LogFile.GetMatchedRows() */
@@ -14685,6 +14750,20 @@ static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteCommand_ElevationTyp
     offsetof(SCX_OperatingSystem_ExecuteCommand, ElevationType), /* offset */
 };
 
+/* parameter SCX_OperatingSystem.ExecuteCommand(): MaxAge */
+static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteCommand_MaxAge_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN, /* flags */
+    0x006D6506, /* code */
+    MI_T("MaxAge"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT32, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_OperatingSystem_ExecuteCommand, MaxAge), /* offset */
+};
+
 /* parameter SCX_OperatingSystem.ExecuteCommand(): MIReturn */
 static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteCommand_MIReturn_param =
 {
@@ -14708,6 +14787,7 @@ static MI_ParameterDecl MI_CONST* MI_CONST SCX_OperatingSystem_ExecuteCommand_pa
     &SCX_OperatingSystem_ExecuteCommand_StdErr_param,
     &SCX_OperatingSystem_ExecuteCommand_timeout_param,
     &SCX_OperatingSystem_ExecuteCommand_ElevationType_param,
+    &SCX_OperatingSystem_ExecuteCommand_MaxAge_param,
 };
 
 /* method SCX_OperatingSystem.ExecuteCommand() */
@@ -14826,6 +14906,20 @@ static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteShellCommand_b64enco
     offsetof(SCX_OperatingSystem_ExecuteShellCommand, b64encoded), /* offset */
 };
 
+/* parameter SCX_OperatingSystem.ExecuteShellCommand(): MaxAge */
+static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteShellCommand_MaxAge_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN, /* flags */
+    0x006D6506, /* code */
+    MI_T("MaxAge"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT32, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_OperatingSystem_ExecuteShellCommand, MaxAge), /* offset */
+};
+
 /* parameter SCX_OperatingSystem.ExecuteShellCommand(): MIReturn */
 static MI_CONST MI_ParameterDecl SCX_OperatingSystem_ExecuteShellCommand_MIReturn_param =
 {
@@ -14850,6 +14944,7 @@ static MI_ParameterDecl MI_CONST* MI_CONST SCX_OperatingSystem_ExecuteShellComma
     &SCX_OperatingSystem_ExecuteShellCommand_timeout_param,
     &SCX_OperatingSystem_ExecuteShellCommand_ElevationType_param,
     &SCX_OperatingSystem_ExecuteShellCommand_b64encoded_param,
+    &SCX_OperatingSystem_ExecuteShellCommand_MaxAge_param,
 };
 
 /* method SCX_OperatingSystem.ExecuteShellCommand() */
@@ -16803,6 +16898,125 @@ MI_CONST MI_ClassDecl CIM_UnixProcess_rtti =
     NULL, /* owningClass */
 };
 
+/*
+**==============================================================================
+**
+** SCX_ResourceConsumer
+**
+**==============================================================================
+*/
+
+/* property SCX_ResourceConsumer.Resource */
+static MI_CONST MI_PropertyDecl SCX_ResourceConsumer_Resource_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00726508, /* code */
+    MI_T("Resource"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_ResourceConsumer, Resource), /* offset */
+    MI_T("SCX_ResourceConsumer"), /* origin */
+    MI_T("SCX_ResourceConsumer"), /* propagator */
+    NULL,
+};
+
+/* property SCX_ResourceConsumer.PID */
+static MI_CONST MI_PropertyDecl SCX_ResourceConsumer_PID_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00706403, /* code */
+    MI_T("PID"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_ResourceConsumer, PID), /* offset */
+    MI_T("SCX_ResourceConsumer"), /* origin */
+    MI_T("SCX_ResourceConsumer"), /* propagator */
+    NULL,
+};
+
+/* property SCX_ResourceConsumer.Value */
+static MI_CONST MI_PropertyDecl SCX_ResourceConsumer_Value_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00766505, /* code */
+    MI_T("Value"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_ResourceConsumer, Value), /* offset */
+    MI_T("SCX_ResourceConsumer"), /* origin */
+    MI_T("SCX_ResourceConsumer"), /* propagator */
+    NULL,
+};
+
+/* property SCX_ResourceConsumer.Name */
+static MI_CONST MI_PropertyDecl SCX_ResourceConsumer_Name_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x006E6504, /* code */
+    MI_T("Name"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_ResourceConsumer, Name), /* offset */
+    MI_T("SCX_ResourceConsumer"), /* origin */
+    MI_T("SCX_ResourceConsumer"), /* propagator */
+    NULL,
+};
+
+static MI_PropertyDecl MI_CONST* MI_CONST SCX_ResourceConsumer_props[] =
+{
+    &SCX_ResourceConsumer_Resource_prop,
+    &SCX_ResourceConsumer_PID_prop,
+    &SCX_ResourceConsumer_Value_prop,
+    &SCX_ResourceConsumer_Name_prop,
+};
+
+static MI_CONST MI_Char* SCX_ResourceConsumer_Version_qual_value = MI_T("1.3.0");
+
+static MI_CONST MI_Qualifier SCX_ResourceConsumer_Version_qual =
+{
+    MI_T("Version"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TRANSLATABLE|MI_FLAG_RESTRICTED,
+    &SCX_ResourceConsumer_Version_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_ResourceConsumer_quals[] =
+{
+    &SCX_ResourceConsumer_Version_qual,
+};
+
+/* class SCX_ResourceConsumer */
+MI_CONST MI_ClassDecl SCX_ResourceConsumer_rtti =
+{
+    MI_FLAG_CLASS, /* flags */
+    0x00737214, /* code */
+    MI_T("SCX_ResourceConsumer"), /* name */
+    SCX_ResourceConsumer_quals, /* qualifiers */
+    MI_COUNT(SCX_ResourceConsumer_quals), /* numQualifiers */
+    SCX_ResourceConsumer_props, /* properties */
+    MI_COUNT(SCX_ResourceConsumer_props), /* numProperties */
+    sizeof(SCX_ResourceConsumer), /* size */
+    NULL, /* superClass */
+    NULL, /* superClassDecl */
+    NULL, /* methods */
+    0, /* numMethods */
+    &schemaDecl, /* schema */
+    NULL, /* functions */
+    NULL, /* owningClass */
+};
+
 /*
 **==============================================================================
 **
@@ -16928,6 +17142,23 @@ static MI_CONST MI_PropertyDecl SCX_UnixProcess_UsedMemory_prop =
     NULL,
 };
 
+/* property SCX_UnixProcess.Generation */
+static MI_CONST MI_PropertyDecl SCX_UnixProcess_Generation_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00676E0A, /* code */
+    MI_T("Generation"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcess, Generation), /* offset */
+    MI_T("SCX_UnixProcess"), /* origin */
+    MI_T("SCX_UnixProcess"), /* propagator */
+    NULL,
+};
+
 static MI_PropertyDecl MI_CONST* MI_CONST SCX_UnixProcess_props[] =
 {
     &CIM_ManagedElement_InstanceID_prop,
@@ -16976,6 +17207,7 @@ static MI_PropertyDecl MI_CONST* MI_CONST SCX_UnixProcess_props[] =
     &CIM_UnixProcess_ProcessWaitingForEvent_prop,
     &SCX_UnixProcess_PercentBusyTime_prop,
     &SCX_UnixProcess_UsedMemory_prop,
+    &SCX_UnixProcess_Generation_prop,
 };
 
 /* parameter SCX_UnixProcess.RequestStateChange(): RequestedState */
@@ -17102,6 +17334,60 @@ static MI_CONST MI_ParameterDecl SCX_UnixProcess_TopResourceConsumers_elevationT
     offsetof(SCX_UnixProcess_TopResourceConsumers, elevationType), /* offset */
 };
 
+/* parameter SCX_UnixProcess.TopResourceConsumers(): resources */
+static MI_CONST MI_ParameterDecl SCX_UnixProcess_TopResourceConsumers_resources_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_IN, /* flags */
+    0x00727309, /* code */
+    MI_T("resources"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRINGA, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcess_TopResourceConsumers, resources), /* offset */
+};
+
+static MI_CONST MI_Char* SCX_UnixProcess_TopResourceConsumers_consumers_EmbeddedInstance_qual_value = MI_T("SCX_ResourceConsumer");
+
+static MI_CONST MI_Qualifier SCX_UnixProcess_TopResourceConsumers_consumers_EmbeddedInstance_qual =
+{
+    MI_T("EmbeddedInstance"),
+    MI_STRING,
+    0,
+    &SCX_UnixProcess_TopResourceConsumers_consumers_EmbeddedInstance_qual_value
+};
+
+static MI_CONST MI_Char* SCX_UnixProcess_TopResourceConsumers_consumers_ArrayType_qual_value = MI_T("Ordered");
+
+static MI_CONST MI_Qualifier SCX_UnixProcess_TopResourceConsumers_consumers_ArrayType_qual =
+{
+    MI_T("ArrayType"),
+    MI_STRING,
+    MI_FLAG_DISABLEOVERRIDE|MI_FLAG_TOSUBCLASS,
+    &SCX_UnixProcess_TopResourceConsumers_consumers_ArrayType_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcess_TopResourceConsumers_consumers_quals[] =
+{
+    &SCX_UnixProcess_TopResourceConsumers_consumers_EmbeddedInstance_qual,
+    &SCX_UnixProcess_TopResourceConsumers_consumers_ArrayType_qual,
+};
+
+/* parameter SCX_UnixProcess.TopResourceConsumers(): consumers */
+static MI_CONST MI_ParameterDecl SCX_UnixProcess_TopResourceConsumers_consumers_param =
+{
+    MI_FLAG_PARAMETER|MI_FLAG_OUT, /* flags */
+    0x00637309, /* code */
+    MI_T("consumers"), /* name */
+    SCX_UnixProcess_TopResourceConsumers_consumers_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcess_TopResourceConsumers_consumers_quals), /* numQualifiers */
+    MI_INSTANCEA, /* type */
+    MI_T("SCX_ResourceConsumer"), /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcess_TopResourceConsumers, consumers), /* offset */
+};
+
 /* parameter SCX_UnixProcess.TopResourceConsumers(): MIReturn */
 static MI_CONST MI_ParameterDecl SCX_UnixProcess_TopResourceConsumers_MIReturn_param =
 {
@@ -17122,6 +17408,8 @@ static MI_ParameterDecl MI_CONST* MI_CONST SCX_UnixProcess_TopResourceConsumers_
     &SCX_UnixProcess_TopResourceConsumers_resource_param,
     &SCX_UnixProcess_TopResourceConsumers_count_param,
     &SCX_UnixProcess_TopResourceConsumers_elevationType_param,
+    &SCX_UnixProcess_TopResourceConsumers_resources_param,
+    &SCX_UnixProcess_TopResourceConsumers_consumers_param,
 };
 
 /* method SCX_UnixProcess.TopResourceConsumers() */
@@ -18360,6 +18648,469 @@ MI_CONST MI_ClassDecl SCX_UnixProcessStatisticalInformation_rtti =
     NULL, /* owningClass */
 };
 
+/*
+**==============================================================================
+**
+** SCX_UnixProcessGroupStatisticalInformation
+**
+**==============================================================================
+*/
+
+static MI_CONST MI_Uint32 SCX_UnixProcessGroupStatisticalInformation_Caption_MaxLen_qual_value = 64U;
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_Caption_MaxLen_qual =
+{
+    MI_T("MaxLen"),
+    MI_UINT32,
+    0,
+    &SCX_UnixProcessGroupStatisticalInformation_Caption_MaxLen_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_Caption_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_Caption_MaxLen_qual,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_Caption_value = MI_T("Unix process group information");
+
+/* property SCX_UnixProcessGroupStatisticalInformation.Caption */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_Caption_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00636E07, /* code */
+    MI_T("Caption"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_Caption_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_Caption_quals), /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, Caption), /* offset */
+    MI_T("CIM_ManagedElement"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    &SCX_UnixProcessGroupStatisticalInformation_Caption_value,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_Description_value = MI_T("Performance statistics rolled up over a group of Unix processes");
+
+/* property SCX_UnixProcessGroupStatisticalInformation.Description */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_Description_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00646E0B, /* code */
+    MI_T("Description"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, Description), /* offset */
+    MI_T("CIM_ManagedElement"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    &SCX_UnixProcessGroupStatisticalInformation_Description_value,
+};
+
+static MI_CONST MI_Uint32 SCX_UnixProcessGroupStatisticalInformation_Name_MaxLen_qual_value = 256U;
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_Name_MaxLen_qual =
+{
+    MI_T("MaxLen"),
+    MI_UINT32,
+    0,
+    &SCX_UnixProcessGroupStatisticalInformation_Name_MaxLen_qual_value
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_Name_Override_qual_value = MI_T("Name");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_Name_Override_qual =
+{
+    MI_T("Override"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_RESTRICTED,
+    &SCX_UnixProcessGroupStatisticalInformation_Name_Override_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_Name_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_Name_MaxLen_qual,
+    &SCX_UnixProcessGroupStatisticalInformation_Name_Override_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.Name */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_Name_prop =
+{
+    MI_FLAG_PROPERTY|MI_FLAG_KEY, /* flags */
+    0x006E6504, /* code */
+    MI_T("Name"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_Name_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_Name_quals), /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, Name), /* offset */
+    MI_T("CIM_StatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.GroupType */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_GroupType_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00676509, /* code */
+    MI_T("GroupType"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, GroupType), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.GroupValue */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_GroupValue_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x0067650A, /* code */
+    MI_T("GroupValue"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_STRING, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, GroupValue), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.NumberOfProcesses */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_NumberOfProcesses_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x006E7311, /* code */
+    MI_T("NumberOfProcesses"), /* name */
+    NULL, /* qualifiers */
+    0, /* numQualifiers */
+    MI_UINT32, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, NumberOfProcesses), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_Units_qual_value = MI_T("Percent");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.PercentUserTime */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x0070650F, /* code */
+    MI_T("PercentUserTime"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, PercentUserTime), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_Units_qual_value = MI_T("Percent");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.PercentPrivilegedTime */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00706515, /* code */
+    MI_T("PercentPrivilegedTime"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, PercentPrivilegedTime), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_UsedMemory_Units_qual_value = MI_T("KiloBytes");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_UsedMemory_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_UsedMemory_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_UsedMemory_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_UsedMemory_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.UsedMemory */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_UsedMemory_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x0075790A, /* code */
+    MI_T("UsedMemory"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_UsedMemory_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_UsedMemory_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, UsedMemory), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_Units_qual_value = MI_T("Percent");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.PercentUsedMemory */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00707911, /* code */
+    MI_T("PercentUsedMemory"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, PercentUsedMemory), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_Units_qual_value = MI_T("Transfers per Second");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.BlockReadsPerSecond */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00626413, /* code */
+    MI_T("BlockReadsPerSecond"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, BlockReadsPerSecond), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_Units_qual_value = MI_T("Transfers per Second");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.BlockWritesPerSecond */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00626414, /* code */
+    MI_T("BlockWritesPerSecond"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, BlockWritesPerSecond), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_Units_qual_value = MI_T("Transfers per Second");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_Units_qual =
+{
+    MI_T("Units"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TOSUBCLASS|MI_FLAG_TRANSLATABLE,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_Units_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_Units_qual,
+};
+
+/* property SCX_UnixProcessGroupStatisticalInformation.BlockTransfersPerSecond */
+static MI_CONST MI_PropertyDecl SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_prop =
+{
+    MI_FLAG_PROPERTY, /* flags */
+    0x00626417, /* code */
+    MI_T("BlockTransfersPerSecond"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_quals), /* numQualifiers */
+    MI_UINT64, /* type */
+    NULL, /* className */
+    0, /* subscript */
+    offsetof(SCX_UnixProcessGroupStatisticalInformation, BlockTransfersPerSecond), /* offset */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* origin */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* propagator */
+    NULL,
+};
+
+static MI_PropertyDecl MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_props[] =
+{
+    &CIM_ManagedElement_InstanceID_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_Caption_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_Description_prop,
+    &CIM_ManagedElement_ElementName_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_Name_prop,
+    &SCX_StatisticalInformation_IsAggregate_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_GroupType_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_GroupValue_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_NumberOfProcesses_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUserTime_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentPrivilegedTime_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_UsedMemory_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_PercentUsedMemory_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockReadsPerSecond_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockWritesPerSecond_prop,
+    &SCX_UnixProcessGroupStatisticalInformation_BlockTransfersPerSecond_prop,
+};
+
+static MI_CONST MI_ProviderFT SCX_UnixProcessGroupStatisticalInformation_funcs =
+{
+  (MI_ProviderFT_Load)SCX_UnixProcessGroupStatisticalInformation_Load,
+  (MI_ProviderFT_Unload)SCX_UnixProcessGroupStatisticalInformation_Unload,
+  (MI_ProviderFT_GetInstance)SCX_UnixProcessGroupStatisticalInformation_GetInstance,
+  (MI_ProviderFT_EnumerateInstances)SCX_UnixProcessGroupStatisticalInformation_EnumerateInstances,
+  (MI_ProviderFT_CreateInstance)SCX_UnixProcessGroupStatisticalInformation_CreateInstance,
+  (MI_ProviderFT_ModifyInstance)SCX_UnixProcessGroupStatisticalInformation_ModifyInstance,
+  (MI_ProviderFT_DeleteInstance)SCX_UnixProcessGroupStatisticalInformation_DeleteInstance,
+  (MI_ProviderFT_AssociatorInstances)NULL,
+  (MI_ProviderFT_ReferenceInstances)NULL,
+  (MI_ProviderFT_EnableIndications)NULL,
+  (MI_ProviderFT_DisableIndications)NULL,
+  (MI_ProviderFT_Subscribe)NULL,
+  (MI_ProviderFT_Unsubscribe)NULL,
+  (MI_ProviderFT_Invoke)NULL,
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_UMLPackagePath_qual_value = MI_T("CIM::Core::Statistics");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_UMLPackagePath_qual =
+{
+    MI_T("UMLPackagePath"),
+    MI_STRING,
+    0,
+    &SCX_UnixProcessGroupStatisticalInformation_UMLPackagePath_qual_value
+};
+
+static MI_CONST MI_Char* SCX_UnixProcessGroupStatisticalInformation_Version_qual_value = MI_T("1.3.0");
+
+static MI_CONST MI_Qualifier SCX_UnixProcessGroupStatisticalInformation_Version_qual =
+{
+    MI_T("Version"),
+    MI_STRING,
+    MI_FLAG_ENABLEOVERRIDE|MI_FLAG_TRANSLATABLE|MI_FLAG_RESTRICTED,
+    &SCX_UnixProcessGroupStatisticalInformation_Version_qual_value
+};
+
+static MI_Qualifier MI_CONST* MI_CONST SCX_UnixProcessGroupStatisticalInformation_quals[] =
+{
+    &SCX_UnixProcessGroupStatisticalInformation_UMLPackagePath_qual,
+    &SCX_UnixProcessGroupStatisticalInformation_Version_qual,
+};
+
+/* class SCX_UnixProcessGroupStatisticalInformation */
+MI_CONST MI_ClassDecl SCX_UnixProcessGroupStatisticalInformation_rtti =
+{
+    MI_FLAG_CLASS, /* flags */
+    0x00736E2A, /* code */
+    MI_T("SCX_UnixProcessGroupStatisticalInformation"), /* name */
+    SCX_UnixProcessGroupStatisticalInformation_quals, /* qualifiers */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_quals), /* numQualifiers */
+    SCX_UnixProcessGroupStatisticalInformation_props, /* properties */
+    MI_COUNT(SCX_UnixProcessGroupStatisticalInformation_props), /* numProperties */
+    sizeof(SCX_UnixProcessGroupStatisticalInformation), /* size */
+    MI_T("SCX_StatisticalInformation"), /* superClass */
+    &SCX_StatisticalInformation_rtti, /* superClassDecl */
+    NULL, /* methods */
+    0, /* numMethods */
+    &schemaDecl, /* schema */
+    &SCX_UnixProcessGroupStatisticalInformation_funcs, /* functions */
+    NULL, /* owningClass */
+};
+
 /*
 **==============================================================================
 **
@@ -18417,8 +19168,10 @@ static MI_ClassDecl MI_CONST* MI_CONST classes[] =
     &SCX_OperatingSystem_rtti,
     &SCX_ProcessorStatisticalInformation_rtti,
     &SCX_RTProcessorStatisticalInformation_rtti,
+    &SCX_ResourceConsumer_rtti,
     &SCX_StatisticalInformation_rtti,
     &SCX_UnixProcess_rtti,
+    &SCX_UnixProcessGroupStatisticalInformation_rtti,
     &SCX_UnixProcessStatisticalInformation_rtti,
 };
 
@@ -24,6 +24,7 @@
 #include "SCX_RTProcessorStatisticalInformation_Class_Provider.h"
 #include "SCX_UnixProcess_Class_Provider.h"
 #include "SCX_UnixProcessStatisticalInformation_Class_Provider.h"
+#include "SCX_UnixProcessGroupStatisticalInformation_Class_Provider.h"
 
 using namespace mi;
 
@@ -2373,6 +2374,125 @@ MI_EXTERN_C void MI_CALL SCX_UnixProcessStatisticalInformation_DeleteInstance(
     cxxSelf->DeleteInstance(cxxContext, nameSpace, cxxInstanceName);
 }
 
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_Load(
+    SCX_UnixProcessGroupStatisticalInformation_Self** self,
+    MI_Module_Self* selfModule,
+    MI_Context* context)
+{
+    MI_Result r = MI_RESULT_OK;
+    Context ctx(context, &r);
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* prov = new SCX_UnixProcessGroupStatisticalInformation_Class_Provider((Module*)selfModule);
+
+    prov->Load(ctx);
+    if (MI_RESULT_OK != r)
+    {
+        delete prov;
+        MI_Context_PostResult(context, r);
+        return;
+    }
+    *self = (SCX_UnixProcessGroupStatisticalInformation_Self*)prov;
+    MI_Context_PostResult(context, MI_RESULT_OK);
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_Unload(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context)
+{
+    MI_Result r = MI_RESULT_OK;
+    Context ctx(context, &r);
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* prov = (SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self;
+
+    prov->Unload(ctx);
+    delete ((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    MI_Context_PostResult(context, r);
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_EnumerateInstances(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const MI_PropertySet* propertySet,
+    MI_Boolean keysOnly,
+    const MI_Filter* filter)
+{
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* cxxSelf =((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    Context  cxxContext(context);
+
+    cxxSelf->EnumerateInstances(
+        cxxContext,
+        nameSpace,
+        __PropertySet(propertySet),
+        __bool(keysOnly),
+        filter);
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_GetInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* instanceName,
+    const MI_PropertySet* propertySet)
+{
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* cxxSelf =((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    Context  cxxContext(context);
+    SCX_UnixProcessGroupStatisticalInformation_Class cxxInstanceName(instanceName, true);
+
+    cxxSelf->GetInstance(
+        cxxContext,
+        nameSpace,
+        cxxInstanceName,
+        __PropertySet(propertySet));
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_CreateInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* newInstance)
+{
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* cxxSelf =((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    Context  cxxContext(context);
+    SCX_UnixProcessGroupStatisticalInformation_Class cxxNewInstance(newInstance, false);
+
+    cxxSelf->CreateInstance(cxxContext, nameSpace, cxxNewInstance);
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_ModifyInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* modifiedInstance,
+    const MI_PropertySet* propertySet)
+{
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* cxxSelf =((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    Context  cxxContext(context);
+    SCX_UnixProcessGroupStatisticalInformation_Class cxxModifiedInstance(modifiedInstance, false);
+
+    cxxSelf->ModifyInstance(
+        cxxContext,
+        nameSpace,
+        cxxModifiedInstance,
+        __PropertySet(propertySet));
+}
+
+MI_EXTERN_C void MI_CALL SCX_UnixProcessGroupStatisticalInformation_DeleteInstance(
+    SCX_UnixProcessGroupStatisticalInformation_Self* self,
+    MI_Context* context,
+    const MI_Char* nameSpace,
+    const MI_Char* className,
+    const SCX_UnixProcessGroupStatisticalInformation* instanceName)
+{
+    SCX_UnixProcessGroupStatisticalInformation_Class_Provider* cxxSelf =((SCX_UnixProcessGroupStatisticalInformation_Class_Provider*)self);
+    Context  cxxContext(context);
+    SCX_UnixProcessGroupStatisticalInformation_Class cxxInstanceName(instanceName, true);
+
+    cxxSelf->DeleteInstance(cxxContext, nameSpace, cxxInstanceName);
+}
+
 
 MI_EXTERN_C MI_SchemaDecl schemaDecl;
 
@@ -19,6 +19,8 @@
 #include <scxcorelib/scxlog.h>
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxfilepath.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/scxtime.h>
 
 #include <scxsystemlib/processenumeration.h>
 #include <scxsystemlib/processinstance.h>
@@ -30,7 +32,9 @@
 #include "websphereappserverinstance.h"
 #include "manipulateappserverinstances.h"
 #include "persistappserverinstances.h"
+#include "../processprovider.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -41,12 +45,13 @@ namespace SCXSystemLib
 {
     /**
        Returns a vector containing all running processes with the name matching the criteria.
+
+       Reuses the sample of the process provider (refreshed at most once per
+       snapshot period) rather than walking the whole process table each time.
     */
     vector<SCXHandle<ProcessInstance> > AppServerPALDependencies::Find(const wstring& name)
     {
-        SCXHandle<ProcessEnumeration> enumProc =  SCXHandle<ProcessEnumeration>(new ProcessEnumeration());
-        enumProc->SampleData();
-        return enumProc->Find(name);
+        return SCXCore::g_ProcessProvider.FindProcesses(name);
     }
     
     /**
@@ -54,7 +59,30 @@ namespace SCXSystemLib
     */
     bool AppServerPALDependencies::GetParameters(SCXHandle<ProcessInstance> inst, vector<string>& params)
     {
-        return inst->GetParameters(params);
+        return SCXCore::g_ProcessProvider.GetParameters(inst, params);
+    }
+
+    /**
+       Gets the values identifying a process across restarts (pid and start time).
+
+       \param[in]  inst       Process to identify
+       \param[out] pid        Process ID
+       \param[out] startTime  Start time of the process
+       \returns    true if the process could be identified
+    */
+    bool AppServerPALDependencies::GetProcessIdentity(SCXHandle<ProcessInstance> inst, scxulong& pid, wstring& startTime)
+    {
+        SCXCalendarTime creationDate;
+        {
+            SCXThreadLock lock(SCXCore::g_ProcessProvider.GetProcessEnumerator()->GetLockHandle());
+            if ( !inst->GetPID(pid) || !inst->GetCreationDate(creationDate) )
+            {
+                return false;
+            }
+        }
+
+        startTime = creationDate.ToExtendedISO8601();
+        return true;
     }
 
     /**
@@ -456,6 +484,9 @@ namespace SCXSystemLib
         bool gotWeblogicProcesses = false;
         vector<wstring> weblogicProcesses;
 
+        // Java processes classified during this update, by pid (replaces m_knownProcesses)
+        map<scxulong, KnownProcess> knownProcesses;
+
         // Find all Java processes running
         vector<SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> > procList = m_deps->Find(L"java");
         for (vector<SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> >::iterator it = procList.begin(); it != procList.end(); it++)
@@ -464,6 +495,29 @@ namespace SCXSystemLib
 
           if (m_deps->GetParameters((*it),params)) 
           {
+             // A process classified by a previous update (same pid, start time and command
+             // line) gives the same instances; reuse them rather than classifying it again
+             scxulong pid = 0;
+             wstring startTime;
+             bool gotIdentity = m_deps->GetProcessIdentity((*it), pid, startTime);
+             if (gotIdentity)
+             {
+                 map<scxulong, KnownProcess>::const_iterator known = m_knownProcesses.find(pid);
+                 if (known != m_knownProcesses.end() &&
+                     known->second.startTime == startTime &&
+                     known->second.params == params)
+                 {
+                     SCX_LOGHYSTERICAL(m_log, StrAppend(L"AppServerEnumeration Update(): Reusing known java process, pid: ", pid));
+                     ReuseKnownProcess(known->second, ASInstances, weblogicProcesses);
+                     gotWeblogicProcesses = gotWeblogicProcesses || !known->second.weblogicHome.empty();
+                     knownProcesses[pid] = known->second;
+                     continue;
+                 }
+             }
+
+             size_t firstNewInstance = ASInstances.size();
+             wstring wlHome;
+
              // Log "Found java process, Parameters: Size=x, Contents: y"
              if (eTrace == m_log.GetSeverityThreshold())
              {
@@ -499,7 +553,7 @@ namespace SCXSystemLib
              // Loop through each 'java' process and check for Weblogic i.e. 'weblogic.Server' argument on the commandline
              if(CheckProcessCmdLineArgExists(params,"weblogic.Server"))
              {
-                wstring wlHome = GetWeblogicHome(params);
+                wlHome = GetWeblogicHome(params);
                 if(!wlHome.empty())
                 {
                     weblogicProcesses.push_back(wlHome);
@@ -514,9 +568,21 @@ namespace SCXSystemLib
              {
                 CreateWebSphereInstance(&ASInstances, params);
              }
+
+             if (gotIdentity)
+             {
+                 KnownProcess& known = knownProcesses[pid];
+                 known.startTime = startTime;
+                 known.params = params;
+                 known.instances.assign(ASInstances.begin() + firstNewInstance, ASInstances.end());
+                 known.weblogicHome = wlHome;
+             }
           }
         }
 
+        // Processes that are no longer running are forgotten
+        m_knownProcesses.swap(knownProcesses);
+
         // Get the list of Weblogic Instances and add them to the enumerator
         if(gotWeblogicProcesses)
         {
@@ -549,6 +615,15 @@ namespace SCXSystemLib
 
         ManipulateAppServerInstances::UpdateInstancesWithRunningProcesses(knownInstances, ASInstances);
 
+        // Reused instances are also in the list of previously known instances,
+        // which the merge marks as not running
+        for (vector<SCXHandle<AppServerInstance> >::iterator it = ASInstances.begin();
+                it != ASInstances.end();
+                ++it)
+        {
+            (*it)->SetIsRunning(true);
+        }
+
         SCX_LOGTRACE(m_log,
                 StrAppend(L"size of merged list : ",
                         knownInstances.size()));
@@ -564,6 +639,41 @@ namespace SCXSystemLib
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add the instances of a java process classified by a previous update
+
+       The instances are only updated (i.e. their configuration files parsed
+       again) if any of their configuration files has changed.
+
+       \param[in]  known              What was discovered from the process
+       \param[out] ASInstances        Instances of running application servers
+       \param[out] weblogicProcesses  Home directories of running Weblogic servers
+    */
+    void AppServerEnumeration::ReuseKnownProcess(const KnownProcess& known,
+                                                 vector<SCXHandle<AppServerInstance> >& ASInstances,
+                                                 vector<wstring>& weblogicProcesses)
+    {
+        for (vector<SCXHandle<AppServerInstance> >::const_iterator it = known.instances.begin();
+                it != known.instances.end();
+                ++it)
+        {
+            if ((*it)->IsConfigurationChanged())
+            {
+                SCX_LOGTRACE(m_log, wstring(L"AppServerEnumeration ReuseKnownProcess(): Configuration changed for ").append((*it)->GetId()));
+                (*it)->Update();
+            }
+
+            (*it)->SetIsRunning(true);
+            ASInstances.push_back(*it);
+        }
+
+        if (!known.weblogicHome.empty())
+        {
+            weblogicProcesses.push_back(known.weblogicHome);
+        }
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
        Wrapper to EntityEnumeration's UpdateInstances()
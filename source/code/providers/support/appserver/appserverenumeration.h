@@ -13,6 +13,7 @@
 #ifndef APPSERVERENUMERATION_H
 #define APPSERVERENUMERATION_H
 
+#include <map>
 #include <vector>
 
 #include <scxsystemlib/entityenumeration.h>
@@ -37,6 +38,7 @@ namespace SCXSystemLib
         virtual ~AppServerPALDependencies() {};
         virtual std::vector<SCXCoreLib::SCXHandle<ProcessInstance> > Find(const std::wstring& name);
         virtual bool GetParameters(SCXCoreLib::SCXHandle<ProcessInstance> inst, std::vector<std::string>& params);
+        virtual bool GetProcessIdentity(SCXCoreLib::SCXHandle<ProcessInstance> inst, scxulong& pid, std::wstring& startTime);
         virtual void GetWeblogicInstances(vector<wstring> weblogicProcesses, vector<SCXCoreLib::SCXHandle<AppServerInstance> >& newInst);
     };
 
@@ -69,8 +71,24 @@ namespace SCXSystemLib
         virtual void WriteInstancesToDisk();
 
     private:
+        /*----------------------------------------------------------------------------*/
+        /**
+           What was discovered from a java process the last time it was classified
+        */
+        struct KnownProcess
+        {
+            std::wstring startTime;                 //!< Start time of the process
+            std::vector<std::string> params;        //!< Command line of the process
+            std::vector<SCXCoreLib::SCXHandle<AppServerInstance> > instances; //!< Instances created from the command line
+            std::wstring weblogicHome;              //!< Weblogic home found on the command line (if any)
+        };
+
         SCXCoreLib::SCXHandle<AppServerPALDependencies> m_deps; //!< Collects external dependencies of this class.
         SCXCoreLib::SCXLogHandle m_log;         //!< Log handle.
+        std::map<scxulong, KnownProcess> m_knownProcesses; //!< Java processes classified by the last Update(), by pid
+        void ReuseKnownProcess(const KnownProcess& known,
+                               vector<SCXCoreLib::SCXHandle<AppServerInstance> >& ASInstances,
+                               vector<wstring>& weblogicProcesses);
         bool CheckProcessCmdLineArgExists(std::vector<std::string>& params, const std::string& value);
         std::string ParseOutCommandLineArg(std::vector<std::string>& params, 
                                            const std::string& key,
@@ -15,6 +15,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <sys/stat.h>
 
 #include <scxcorelib/stringaid.h>
 #include <scxcorelib/scxdirectoryinfo.h>
@@ -29,6 +30,19 @@ using namespace SCXCoreLib;
 namespace SCXSystemLib
 {
 
+    /*------------------------------------------------------------------------*/
+    /**
+        Get the status of a configuration file
+
+        \param[in]     filename   Name of the configuration file
+        \param[out]    buf        Status of the file
+        \returns      true if the file status was read
+    */
+    bool AppServerInstancePALDependencies::StatConfigFile(const wstring& filename, struct stat& buf)
+    {
+        return 0 == stat(StrToMultibyte(filename).c_str(), &buf);
+    }
+
     /*------------------------------------------------------------------------*/
     /**
         Constructor
@@ -370,6 +384,113 @@ namespace SCXSystemLib
         SCX_LOGTRACE(m_log, wstring(L"AppServerInstance::Update() - ").append(GetId()));
     }
 
+    /*--------------------------------------------------------------------*/
+    /**
+        Check if any configuration file has changed since the last Update()
+
+        Configuration files are recorded (with their inode, size and
+        modification time) while they are parsed by Update(). As long as none
+        of them changes, the values read by Update() are still valid and
+        calling Update() again would just parse the same files once more.
+
+        \returns      true if Update() should be called to refresh the values;
+                      also true if no configuration file has been recorded
+    */
+    bool AppServerInstance::IsConfigurationChanged() const
+    {
+        if (m_configFiles.empty())
+        {
+            return true;
+        }
+
+        for (map<wstring, ConfigFileStamp>::const_iterator it = m_configFiles.begin();
+             it != m_configFiles.end(); ++it)
+        {
+            if ( !(GetConfigFileStamp(it->first) == it->second) )
+            {
+                SCX_LOGTRACE(m_log, wstring(L"AppServerInstance::IsConfigurationChanged() - changed: ").append(it->first));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*--------------------------------------------------------------------*/
+    /**
+        Forget all recorded configuration files (to be called when Update() starts)
+    */
+    void AppServerInstance::ClearConfigFiles()
+    {
+        m_configFiles.clear();
+    }
+
+    /*--------------------------------------------------------------------*/
+    /**
+        Record a configuration file that is about to be parsed by Update()
+
+        Files that do not exist are recorded too, so that their creation
+        is detected as a change.
+
+        \param[in]     filename   Name of the configuration file
+    */
+    void AppServerInstance::RecordConfigFile(const wstring& filename)
+    {
+        m_configFiles[filename] = GetConfigFileStamp(filename);
+    }
+
+    /*--------------------------------------------------------------------*/
+    /**
+        Get the status of a configuration file
+
+        Application servers with injectable dependencies read it through them.
+
+        \param[in]     filename   Name of the configuration file
+        \param[out]    buf        Status of the file
+        \returns      true if the file status was read
+    */
+    bool AppServerInstance::StatConfigFile(const wstring& filename, struct stat& buf) const
+    {
+        return AppServerInstancePALDependencies().StatConfigFile(filename, buf);
+    }
+
+    /*--------------------------------------------------------------------*/
+    /**
+        Get the current stamp of a configuration file
+
+        \param[in]     filename   Name of the configuration file
+        \returns      Stamp of the file (exists is false if it can't be accessed)
+    */
+    AppServerInstance::ConfigFileStamp AppServerInstance::GetConfigFileStamp(const wstring& filename) const
+    {
+        ConfigFileStamp stamp;
+        struct stat buf;
+
+        stamp.exists = StatConfigFile(filename, buf);
+        stamp.dev = stamp.exists ? buf.st_dev : 0;
+        stamp.ino = stamp.exists ? buf.st_ino : 0;
+        stamp.size = stamp.exists ? buf.st_size : 0;
+        stamp.mtime = stamp.exists ? buf.st_mtime : 0;
+
+        return stamp;
+    }
+
+    /*--------------------------------------------------------------------*/
+    /**
+        Compare two configuration file stamps
+
+        \param[in]     other   Stamp to compare with
+        \returns      true if the stamps describe the same, unmodified file
+    */
+    bool AppServerInstance::ConfigFileStamp::operator==(const ConfigFileStamp& other) const
+    {
+        return exists == other.exists &&
+               dev == other.dev &&
+               ino == other.ino &&
+               size == other.size &&
+               mtime == other.mtime;
+    }
+
     /*--------------------------------------------------------------------*/
     /**
         Extract the major version number from the complete version
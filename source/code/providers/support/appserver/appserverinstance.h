@@ -12,13 +12,30 @@
 #ifndef APPSERVERINSTANCE_H
 #define APPSERVERINSTANCE_H
 
+#include <map>
 #include <string>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
 
 #include <scxsystemlib/entityinstance.h>
 #include <scxcorelib/scxlog.h>
 
 namespace SCXSystemLib
 {
+    /*----------------------------------------------------------------------------*/
+    /**
+       Class representing the external dependencies shared by all application
+       servers; the dependencies of each type of application server derive from it.
+
+    */
+    class AppServerInstancePALDependencies
+    {
+    public:
+        virtual bool StatConfigFile(const std::wstring& filename, struct stat& buf);
+        virtual ~AppServerInstancePALDependencies() {};
+    };
+
     /*----------------------------------------------------------------------------*/
     /**
        Class that represents an instances.
@@ -78,11 +95,16 @@ namespace SCXSystemLib
         void SetVersion(const std::wstring& version);
 
         virtual void Update();
+        virtual bool IsConfigurationChanged() const;
 
     protected:
 
         virtual std::wstring ExtractMajorVersion(const std::wstring& version);
 
+        void ClearConfigFiles();
+        void RecordConfigFile(const std::wstring& filename);
+        virtual bool StatConfigFile(const std::wstring& filename, struct stat& buf) const;
+
         SCXCoreLib::SCXLogHandle m_log;  //!< Log handle
 
         std::wstring m_httpPort;
@@ -100,6 +122,26 @@ namespace SCXSystemLib
         std::wstring m_node;
         std::wstring m_server;
 
+    private:
+        /*--------------------------------------------------------------------*/
+        /**
+           Identity of a configuration file as seen when it was last parsed
+        */
+        struct ConfigFileStamp
+        {
+            bool exists;    //!< Did the file exist?
+            dev_t dev;      //!< Device of the file
+            ino_t ino;      //!< Inode of the file
+            off_t size;     //!< Size of the file
+            time_t mtime;   //!< Last modification time of the file
+
+            bool operator==(const ConfigFileStamp& other) const;
+        };
+
+        ConfigFileStamp GetConfigFileStamp(const std::wstring& filename) const;
+
+        //! Configuration files read by the last Update(), with their stamps
+        std::map<std::wstring, ConfigFileStamp> m_configFiles;
     };
 
 }
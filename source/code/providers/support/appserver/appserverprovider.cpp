@@ -10,9 +10,12 @@
 */
 /*----------------------------------------------------------------------------*/
 
+#include <scxcorelib/scxthreadlock.h>
+
 #include "../startuplog.h"
 #include "appserverenumeration.h"
 #include "appserverprovider.h"
+#include "../processprovider.h"
 
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
@@ -28,6 +31,13 @@ namespace SCXCore
             LogStartup();
             SCX_LOGTRACE(m_log, L"ApplicationServerProvider::Load()");
 
+            // Application server discovery reuses the process provider's sample;
+            // its load count is guarded by the lock of the process providers
+            {
+                SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+                g_ProcessProvider.Load();
+            }
+
             if ( NULL == m_deps )
             {
                 m_deps = new AppServerProviderPALDependencies();
@@ -52,6 +62,9 @@ namespace SCXCore
             }
 
             m_deps = NULL;
+
+            SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ProcessProvider::Lock"));
+            g_ProcessProvider.Unload();
         }
     }
 
@@ -313,6 +313,7 @@ namespace SCXSystemLib
 
         try {
             string xmlcontent;
+            RecordConfigFile(filename);
             SCXHandle<istream> mystream = m_deps->OpenXmlBindingFile(filename);
             GetStringFromStream(mystream, xmlcontent);
 
@@ -410,6 +411,7 @@ namespace SCXSystemLib
         filename.Append(L"/deploy/jboss-web.deployer/server.xml");
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlServerFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -511,6 +513,7 @@ namespace SCXSystemLib
         filename.Append(L"/conf/jboss-service.xml");
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlServiceFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -673,6 +676,7 @@ namespace SCXSystemLib
         filename.Append(L"/conf/bindingservice.beans/META-INF/bindings-jboss-beans.xml");
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlPortsFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -931,6 +935,7 @@ namespace SCXSystemLib
 
             try 
             {
+                RecordConfigFile(filename.Get());
                 SCXHandle<istream> mystream = m_deps->OpenXmlPortsFile(filename.Get());
                 GetStringFromStream(mystream, xmlcontent);
 
@@ -1095,6 +1100,7 @@ namespace SCXSystemLib
 
 				filename.Append(L"domain/configuration/domain.xml");
 
+				RecordConfigFile(filename.Get());
 				SCXHandle<istream> mystream = m_deps->OpenDomainXmlFile(filename.Get());
 				SCXRegex re(L"[0-9]+");
 				GetStringFromStream(mystream, xmlcontent);
@@ -1278,6 +1284,7 @@ namespace SCXSystemLib
         filename.Append(L"/domain/configuration/host.xml");
         try
         {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenDomainHostXmlFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 			
@@ -1423,6 +1430,7 @@ namespace SCXSystemLib
             filename.Append(L"jar-versions.xml");
 
             try {
+                RecordConfigFile(filename.Get());
                 SCXHandle<istream> mystream = m_deps->OpenXmlVersionFile(filename.Get());
                 GetStringFromStream(mystream, xmlcontent);
 
@@ -1508,6 +1516,7 @@ namespace SCXSystemLib
                         {
                             moduleFilename.Append(filePathForWF8);
                         }
+                        RecordConfigFile(moduleFilename.Get());
                         SCXHandle<istream> mystream = m_deps->OpenModuleXmlFile(moduleFilename.Get());
                         GetStringFromStream(mystream, xmlcontent);
                         XElementPtr topNode;
@@ -1589,6 +1598,7 @@ namespace SCXSystemLib
     void JBossAppServerInstance::Update()
     {
         SCX_LOGTRACE(m_log, wstring(L"JBossAppServerInstance::Update() - ").append(GetId()));
+        ClearConfigFiles();
         UpdateVersion();
         if (m_majorVersion.length() > 0)
         {
@@ -1607,6 +1617,19 @@ namespace SCXSystemLib
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the status of a configuration file, through the dependencies
+
+       \param[in]  filename   Name of the configuration file
+       \param[out] buf        Status of the file
+       \returns    true if the file status was read
+    */
+    bool JBossAppServerInstance::StatConfigFile(const wstring& filename, struct stat& buf) const
+    {
+        return m_deps->StatConfigFile(filename, buf);
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
        Read all lines from a stream and save in a string
@@ -27,7 +27,7 @@ namespace SCXSystemLib
 		jboss_version_7,
 		jboss_version_8
 	} jboss_version_type;
-    class JBossAppServerInstancePALDependencies
+    class JBossAppServerInstancePALDependencies : public AppServerInstancePALDependencies
     {
     public:
         virtual SCXCoreLib::SCXHandle<std::istream> OpenXmlVersionFile(std::wstring filename);
@@ -68,6 +68,9 @@ namespace SCXSystemLib
         virtual void Update();
         virtual bool IsStillInstalled();
 
+    protected:
+        virtual bool StatConfigFile(const std::wstring& filename, struct stat& buf) const;
+
     private:
         void UpdateVersion();
         void UpdateJBoss4PortsFromServiceBinding(std::wstring filename, std::string servername);
@@ -129,6 +129,7 @@ namespace SCXSystemLib
         filename.Append(L"/conf/server.xml");
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlServerFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -218,6 +219,7 @@ namespace SCXSystemLib
 
         try {
             string filecontent;
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenVersionFile(filename.Get());
             bool foundVersion = false;
 
@@ -303,11 +305,25 @@ namespace SCXSystemLib
     void TomcatAppServerInstance::Update()
     {
         SCX_LOGTRACE(m_log, wstring(L"TomcatAppServerInstance::Update() - ").append(GetId()));
+        ClearConfigFiles();
 
         UpdateVersion();
         UpdatePorts();
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the status of a configuration file, through the dependencies
+
+       \param[in]  filename   Name of the configuration file
+       \param[out] buf        Status of the file
+       \returns    true if the file status was read
+    */
+    bool TomcatAppServerInstance::StatConfigFile(const wstring& filename, struct stat& buf) const
+    {
+        return m_deps->StatConfigFile(filename, buf);
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
         Read all lines from a stream and save in a string
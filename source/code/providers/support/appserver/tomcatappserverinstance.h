@@ -23,7 +23,7 @@ namespace SCXSystemLib
        Class representing all external dependencies from the AppServer PAL.
 
     */
-    class TomcatAppServerInstancePALDependencies
+    class TomcatAppServerInstancePALDependencies : public AppServerInstancePALDependencies
     {
     public:
         virtual SCXCoreLib::SCXHandle<std::istream> OpenVersionFile(std::wstring filename);
@@ -53,6 +53,9 @@ namespace SCXSystemLib
 
         virtual void Update();
 
+    protected:
+        virtual bool StatConfigFile(const std::wstring& filename, struct stat& buf) const;
+
     private:
 
         void UpdateVersion();
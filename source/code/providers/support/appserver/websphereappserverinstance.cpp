@@ -179,6 +179,7 @@ namespace SCXSystemLib
         filename.SetFilename(L"serverindex.xml");
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlServerFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -263,6 +264,7 @@ namespace SCXSystemLib
         SCXFilePath filename(GetProfileVersionXml());
 
         try {
+            RecordConfigFile(filename.Get());
             SCXHandle<istream> mystream = m_deps->OpenXmlVersionFile(filename.Get());
             GetStringFromStream(mystream, xmlcontent);
 
@@ -318,11 +320,25 @@ namespace SCXSystemLib
     void WebSphereAppServerInstance::Update()
     {
         SCX_LOGTRACE(m_log, wstring(L"WebSphereAppServerInstance::Update() - ").append(GetId()));
+        ClearConfigFiles();
 
         UpdateVersion();
         UpdatePorts();
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the status of a configuration file, through the dependencies
+
+       \param[in]  filename   Name of the configuration file
+       \param[out] buf        Status of the file
+       \returns    true if the file status was read
+    */
+    bool WebSphereAppServerInstance::StatConfigFile(const wstring& filename, struct stat& buf) const
+    {
+        return m_deps->StatConfigFile(filename, buf);
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
         Read all lines from a stream and save in a string
@@ -24,7 +24,7 @@ namespace SCXSystemLib
        Class representing all external dependencies from the AppServer PAL.
 
     */
-    class WebSphereAppServerInstancePALDependencies
+    class WebSphereAppServerInstancePALDependencies : public AppServerInstancePALDependencies
     {
     public:
         virtual SCXCoreLib::SCXHandle<std::istream> OpenXmlServerFile(const std::wstring& filename);
@@ -54,6 +54,9 @@ namespace SCXSystemLib
 
         virtual void Update();
 
+    protected:
+        virtual bool StatConfigFile(const std::wstring& filename, struct stat& buf) const;
+
     private:
 
         void UpdateVersion();
@@ -0,0 +1,341 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      commandpool.cpp
+
+    \brief     Bounded pool of threads running the RunAs methods (ExecuteCommand and friends)
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxlog.h>
+
+#include "commandpool.h"
+#include "snapshotpublisher.h"
+
+#include <sstream>
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Time (in milliseconds) after which an idle worker looks at the queue again
+    const scxulong cIdleWait = 1000;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parameter of a worker thread of a CommandPool
+    */
+    class CommandPoolThreadParam : public SCXThreadParam
+    {
+    public:
+        //! Constructor
+        //! \param[in] pool  Pool whose jobs the thread runs
+        explicit CommandPoolThreadParam(SCXCore::CommandPool* pool) :
+            SCXThreadParam(), m_pool(pool)
+        {
+        }
+
+        SCXCore::CommandPool* m_pool;   //!< Pool whose jobs the thread runs
+    };
+}
+
+namespace SCXCore
+{
+    //! Pool running the RunAs methods of SCX_OperatingSystem
+    CommandPool g_CommandPool;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+    */
+    CommandPool::Statistics::Statistics() :
+        workers(0), running(0), queued(0), maxQueued(0),
+        submitted(0), rejected(0), completed(0),
+        totalWaitMilliseconds(0), maxWaitMilliseconds(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - the pool has the default sizes, and no elevation limits
+    */
+    CommandPool::CommandPool() :
+        m_workers(cDefaultWorkers),
+        m_queueSize(cDefaultQueueSize),
+        m_threads(0),
+        m_idle(0),
+        m_stopping(false)
+    {
+        m_cond.SetSleep(cIdleWait);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Destructor - runs the jobs still queued, and waits for the workers to exit
+    */
+    CommandPool::~CommandPool()
+    {
+        Stop(true);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the sizes of the pool, and (re)start accepting jobs after Stop()
+
+       Shrinking the pool doesn't interrupt any job: extra workers exit once
+       they are done with their current job.
+
+       \param[in] workers    Maximum number of worker threads (at least 1)
+       \param[in] queueSize  Maximum number of jobs waiting for a worker
+    */
+    void CommandPool::Configure(size_t workers, size_t queueSize)
+    {
+        SCXConditionHandle h(m_cond);
+        m_workers = workers > 0 ? workers : 1;
+        m_queueSize = queueSize;
+        m_stopping = false;
+        h.Broadcast();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Limit the number of jobs of an elevation type running at the same time
+
+       \param[in] elevation  Elevation type (like L"sudo"; L"" for jobs without elevation)
+       \param[in] limit      Maximum number of jobs running (0 for no limit but the number of workers)
+    */
+    void CommandPool::SetLimit(const std::wstring& elevation, size_t limit)
+    {
+        SCXConditionHandle h(m_cond);
+        if (0 == limit)
+        {
+            m_limits.erase(elevation);
+        }
+        else
+        {
+            m_limits[elevation] = limit;
+        }
+        h.Broadcast();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Queue a job
+
+       \param[in] elevation  Elevation type of the job (see SetLimit())
+       \param[in] function   Function running the job
+       \param[in] param      Parameter of the function; owned by the pool, even if the job is refused
+       \returns   true if the job was queued; false if the pool is full or stopped,
+                  in which case the job won't run
+    */
+    bool CommandPool::Submit(const std::wstring& elevation, JobFunction function, SCXThreadParam* param)
+    {
+        Job job;
+        job.function = function;
+        job.param = param;
+        job.elevation = elevation;
+        job.queued = GetSnapshotTime();
+
+        SCXConditionHandle h(m_cond);
+        if (m_stopping || m_queue.size() >= m_queueSize)
+        {
+            m_statistics.rejected++;
+            return false;
+        }
+
+        m_queue.push_back(job);
+        m_statistics.submitted++;
+        if (m_queue.size() > m_statistics.maxQueued)
+        {
+            m_statistics.maxQueued = m_queue.size();
+        }
+
+        // Start a worker unless an idle one can take the job; the thread runs detached
+        if (m_queue.size() > m_idle && m_threads < m_workers)
+        {
+            m_threads++;
+            SCXThread(ThreadBody, new CommandPoolThreadParam(this));
+        }
+
+        h.Broadcast();
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Stop accepting jobs; the workers exit once the queued jobs have run
+
+       \param[in] wait  Wait for the workers to exit? (the jobs running and
+                        queued may take as long as their timeouts)
+    */
+    void CommandPool::Stop(bool wait)
+    {
+        SCXConditionHandle h(m_cond);
+        m_stopping = true;
+        h.Broadcast();
+
+        while (wait && m_threads > 0)
+        {
+            h.Wait();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the counters of the pool
+
+       \param[out] statistics  Current and cumulated counters
+    */
+    void CommandPool::GetStatistics(Statistics& statistics) const
+    {
+        SCXConditionHandle h(m_cond);
+        statistics = m_statistics;
+        statistics.workers = m_threads;
+        statistics.queued = m_queue.size();
+        statistics.running = 0;
+        for (std::map<std::wstring, size_t>::const_iterator it = m_runningBy.begin(); it != m_runningBy.end(); ++it)
+        {
+            statistics.running += it->second;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Format the counters of the pool on one line, like:
+
+         CommandPool Workers=2 Running=1 Queued=0 MaxQueued=3 Submitted=10 Rejected=0
+           Completed=9 TotalWaitMilliseconds=12 MaxWaitMilliseconds=8
+
+       (all on one line).
+
+       \returns   Formatted counters
+    */
+    std::string CommandPool::Format() const
+    {
+        Statistics s;
+        GetStatistics(s);
+
+        std::ostringstream line;
+        line << "CommandPool"
+             << " Workers=" << s.workers
+             << " Running=" << s.running
+             << " Queued=" << s.queued
+             << " MaxQueued=" << s.maxQueued
+             << " Submitted=" << s.submitted
+             << " Rejected=" << s.rejected
+             << " Completed=" << s.completed
+             << " TotalWaitMilliseconds=" << s.totalWaitMilliseconds
+             << " MaxWaitMilliseconds=" << s.maxWaitMilliseconds;
+        return line.str();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Take the oldest job that may run, given the limits of the elevation types
+
+       Caller holds m_cond.
+
+       \param[out] job  The job to run
+       \returns    true if a job may run
+    */
+    bool CommandPool::TakeJob(Job& job)
+    {
+        for (std::deque<Job>::iterator it = m_queue.begin(); it != m_queue.end(); ++it)
+        {
+            std::map<std::wstring, size_t>::const_iterator limit = m_limits.find(it->elevation);
+            if (limit != m_limits.end() && m_runningBy[it->elevation] >= limit->second)
+            {
+                continue;
+            }
+
+            job = *it;
+            m_queue.erase(it);
+            m_runningBy[job.elevation]++;
+
+            scxulong now = GetSnapshotTime();
+            scxulong waited = now > job.queued ? now - job.queued : 0;
+            m_statistics.totalWaitMilliseconds += waited;
+            if (waited > m_statistics.maxWaitMilliseconds)
+            {
+                m_statistics.maxWaitMilliseconds = waited;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Account for a job that has run
+
+       Caller holds m_cond.
+
+       \param[in] job  The job that has run
+    */
+    void CommandPool::JobDone(const Job& job)
+    {
+        m_runningBy[job.elevation]--;
+        m_statistics.completed++;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Body of a worker thread
+
+       \param[in] param  A CommandPoolThreadParam
+    */
+    void CommandPool::ThreadBody(SCXThreadParamHandle& param)
+    {
+        CommandPoolThreadParam* p = static_cast<CommandPoolThreadParam*>(param.GetData());
+        SCXASSERT(NULL != p);
+        CommandPool* pool = p->m_pool;
+
+        SCXConditionHandle h(pool->m_cond);
+        for (;;)
+        {
+            Job job;
+            if (pool->TakeJob(job))
+            {
+                h.Unlock();
+                try
+                {
+                    job.function(job.param);
+                }
+                catch (const SCXException& e)
+                {
+                    SCX_LOGWARNING(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.commandpool"),
+                                   StrAppend(L"Job failed: ", e.What()));
+                }
+                job.param = NULL;
+                h.Lock();
+
+                // A job of this elevation type may run now
+                pool->JobDone(job);
+                h.Broadcast();
+            }
+            else if ((pool->m_stopping && pool->m_queue.empty()) || pool->m_threads > pool->m_workers)
+            {
+                break;
+            }
+            else
+            {
+                pool->m_idle++;
+                h.Wait();
+                pool->m_idle--;
+            }
+        }
+
+        // Stop() may be waiting for the last worker
+        pool->m_threads--;
+        h.Broadcast();
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,122 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      commandpool.h
+
+    \brief     Bounded pool of threads running the RunAs methods (ExecuteCommand and friends)
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef COMMANDPOOL_H
+#define COMMANDPOOL_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxcondition.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxthread.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Runs jobs (typically RunAs commands) on a fixed number of threads
+
+       A job is queued by Submit() and run by the first free worker thread.
+       Workers are started as jobs arrive, up to the configured number, and
+       then live until the pool is stopped. Jobs of an elevation type (like
+       L"sudo") may further be limited to a number running at the same time;
+       a job over its limit waits in the queue while later jobs of other
+       elevation types run.
+
+       The queue is bounded: when it is full, Submit() refuses the job, so a
+       burst of requests can't create more threads and child processes than
+       configured. Queue depth, wait times and refusals are counted for
+       SCX_Agent (see Format()).
+
+       This class is thread safe.
+    */
+    class CommandPool
+    {
+    public:
+        //! Function running a job (same signature as a thread body)
+        typedef void (*JobFunction)(SCXCoreLib::SCXThreadParamHandle& param);
+
+        //! Default number of worker threads
+        static const size_t cDefaultWorkers = 8;
+        //! Default number of jobs that may wait for a worker
+        static const size_t cDefaultQueueSize = 32;
+        //! Default number of elevated jobs running at the same time
+        static const size_t cDefaultElevatedWorkers = 4;
+
+        //! Counters of the pool
+        struct Statistics
+        {
+            Statistics();
+
+            size_t workers;                 //!< Number of worker threads
+            size_t running;                 //!< Number of jobs running
+            size_t queued;                  //!< Number of jobs waiting for a worker
+            size_t maxQueued;               //!< Highest number of jobs waiting at once
+            scxulong submitted;             //!< Number of jobs accepted
+            scxulong rejected;              //!< Number of jobs refused because the pool was full
+            scxulong completed;             //!< Number of jobs run to completion
+            scxulong totalWaitMilliseconds; //!< Total time jobs waited for a worker
+            scxulong maxWaitMilliseconds;   //!< Longest time a job waited for a worker
+        };
+
+        CommandPool();
+        ~CommandPool();
+
+        void Configure(size_t workers, size_t queueSize);
+        void SetLimit(const std::wstring& elevation, size_t limit);
+        bool Submit(const std::wstring& elevation, JobFunction function, SCXCoreLib::SCXThreadParam* param);
+        void Stop(bool wait);
+
+        void GetStatistics(Statistics& statistics) const;
+        std::string Format() const;
+
+    private:
+        //! A job waiting for a worker
+        struct Job
+        {
+            JobFunction function;                       //!< Function running the job
+            SCXCoreLib::SCXThreadParamHandle param;     //!< Parameter of the function
+            std::wstring elevation;                     //!< Elevation type of the job
+            scxulong queued;                            //!< Time (ms) when the job was queued
+        };
+
+        //! Not copyable
+        CommandPool(const CommandPool&);
+        CommandPool& operator=(const CommandPool&);
+
+        bool TakeJob(Job& job);
+        void JobDone(const Job& job);
+
+        static void ThreadBody(SCXCoreLib::SCXThreadParamHandle& param);
+
+        //! Guards all members below, and wakes up the workers
+        mutable SCXCoreLib::SCXCondition m_cond;
+
+        size_t m_workers;                               //!< Maximum number of worker threads
+        size_t m_queueSize;                             //!< Maximum number of jobs waiting
+        std::map<std::wstring, size_t> m_limits;        //!< Maximum number of jobs running, by elevation type
+        std::map<std::wstring, size_t> m_runningBy;     //!< Number of jobs running, by elevation type
+        std::deque<Job> m_queue;                        //!< Jobs waiting for a worker, oldest first
+        size_t m_threads;                               //!< Number of worker threads alive
+        size_t m_idle;                                  //!< Number of worker threads waiting for a job
+        bool m_stopping;                                //!< Should the workers exit once the queue is empty?
+        Statistics m_statistics;                        //!< Cumulated counters (current ones are computed)
+    };
+
+    extern SCXCore::CommandPool g_CommandPool;
+}
+
+#endif /* COMMANDPOOL_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,216 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     commandresultcache.cpp
+
+    \brief    Cache of the results of the RunAs commands, for callers accepting a recent result
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+
+#include "commandresultcache.h"
+#include "snapshotpublisher.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] lockName  Name of the lock guarding the cache
+    */
+    CommandResultCache::CommandResultCache(const std::wstring& lockName) :
+        m_lockName(lockName),
+        m_maxResults(cDefaultMaxResults),
+        m_maxBytes(cDefaultMaxBytes),
+        m_maxAge(cDefaultMaxAge),
+        m_bytes(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the size of the cache, removing results if it is now too large
+
+       \param[in] maxResults  Maximum number of results kept (0 disables the cache)
+       \param[in] maxBytes    Maximum number of bytes of output kept
+       \param[in] maxAge      Maximum age (in seconds) of a result served, whatever callers accept
+    */
+    void CommandResultCache::SetLimits(size_t maxResults, size_t maxBytes, unsigned maxAge)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        m_maxResults = maxResults;
+        m_maxBytes = maxBytes;
+        m_maxAge = maxAge;
+        Evict(GetSnapshotTime());
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the result of a command, if run recently enough
+
+       \param[in]  key     Key of the command (see Key())
+       \param[in]  maxAge  Maximum age (in seconds) of the result accepted by the caller (0 for none)
+       \param[out] result  Result of the command; untouched if none is recent enough
+       \returns    true if the result is provided
+    */
+    bool CommandResultCache::Get(const std::wstring& key, unsigned maxAge, Result& result)
+    {
+        if (0 == maxAge)
+        {
+            return false;
+        }
+
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        std::map<std::wstring, Entry>::const_iterator it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+
+        // A clock set back makes the result of an unknown age
+        scxulong now = GetSnapshotTime();
+        scxulong limit = static_cast<scxulong>(maxAge < m_maxAge ? maxAge : m_maxAge) * 1000;
+        if (now < it->second.time || now - it->second.time > limit)
+        {
+            return false;
+        }
+
+        result = it->second.result;
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Keep the result of a command just run
+
+       \param[in] key     Key of the command (see Key())
+       \param[in] result  Result of the command
+    */
+    void CommandResultCache::Put(const std::wstring& key, const Result& result)
+    {
+        size_t bytes = result.resultOut.size() + result.resultErr.size();
+
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+
+        // Leave room for a few results: a single one may not fill the cache
+        if (0 == m_maxResults || bytes > m_maxBytes / 4)
+        {
+            return;
+        }
+
+        std::map<std::wstring, Entry>::iterator it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            Remove(it);
+        }
+
+        Entry& entry = m_entries[key];
+        entry.result = result;
+        entry.time = GetSnapshotTime();
+        m_bytes += bytes;
+        Evict(entry.time);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove all results
+    */
+    void CommandResultCache::Clear()
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        m_entries.clear();
+        m_bytes = 0;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Number of results kept
+
+       \returns   Number of results
+    */
+    size_t CommandResultCache::Size() const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        return m_entries.size();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Key of a command, covering everything its result depends on
+
+       \param[in] method         Name of the method running the command (ExecuteCommand, ...)
+       \param[in] command        Command line, with its arguments
+       \param[in] elevationtype  Elevation type
+       \param[in] user           User running the command
+       \returns   Key of the command
+    */
+    std::wstring CommandResultCache::Key(const std::wstring& method, const std::wstring& command,
+                                         const std::wstring& elevationtype, uid_t user)
+    {
+        // The command goes last: it is the only part that may hold the separator
+        return method + L"\n" + elevationtype + L"\n" + StrFrom(static_cast<scxulong>(user)) + L"\n" + command;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove the results too old to be served, then the oldest results until
+       the cache is within its limits
+
+       Caller holds the lock of the cache.
+
+       \param[in] now  Current time (see GetSnapshotTime())
+    */
+    void CommandResultCache::Evict(scxulong now)
+    {
+        scxulong limit = static_cast<scxulong>(m_maxAge) * 1000;
+        std::map<std::wstring, Entry>::iterator it = m_entries.begin();
+        while (it != m_entries.end())
+        {
+            std::map<std::wstring, Entry>::iterator current = it++;
+            if (now < current->second.time || now - current->second.time > limit)
+            {
+                Remove(current);
+            }
+        }
+
+        while (!m_entries.empty() && (m_entries.size() > m_maxResults || m_bytes > m_maxBytes))
+        {
+            std::map<std::wstring, Entry>::iterator oldest = m_entries.begin();
+            for (it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (it->second.time < oldest->second.time)
+                {
+                    oldest = it;
+                }
+            }
+            Remove(oldest);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove a result
+
+       Caller holds the lock of the cache.
+
+       \param[in] it  Kept result
+    */
+    void CommandResultCache::Remove(std::map<std::wstring, Entry>::iterator it)
+    {
+        m_bytes -= it->second.result.resultOut.size() + it->second.result.resultErr.size();
+        m_entries.erase(it);
+    }
+
+} // End of namespace SCXCore
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,104 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     commandresultcache.h
+
+    \brief    Cache of the results of the RunAs commands, for callers accepting a recent result
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef COMMANDRESULTCACHE_H
+#define COMMANDRESULTCACHE_H
+
+#include <scxcorelib/scxcmn.h>
+
+#include <sys/types.h>
+
+#include <map>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Results of ExecuteCommand and ExecuteShellCommand, served again to callers
+       running the same command within the age they accept
+
+       Monitoring rules run the same command lines (df, cat /proc/...) several
+       times a minute; a caller passing a maximum age gets the result of an
+       identical run that recent instead of forking again. The key of a result
+       (see Key()) covers everything the output depends on: the kind of method,
+       the command line (with its arguments), the elevation type and the user
+       running it. Callers not passing a maximum age always run the command.
+
+       Results are kept for at most a configured age, whatever callers accept,
+       and at most a configured number of results and bytes of output are
+       kept; the oldest results are removed first.
+
+       This class is thread safe.
+    */
+    class CommandResultCache
+    {
+    public:
+        //! Default maximum number of results kept
+        static const size_t cDefaultMaxResults = 64;
+        //! Default maximum number of bytes of output (stdout and stderr) kept
+        static const size_t cDefaultMaxBytes = 1024 * 1024;
+        //! Default maximum age (in seconds) of a result served
+        static const unsigned cDefaultMaxAge = 300;
+
+        //! Result of a command
+        struct Result
+        {
+            Result() : returncode(0) { }
+
+            std::string resultOut;      //!< Standard output
+            std::string resultErr;      //!< Standard error
+            int returncode;             //!< Exit code
+        };
+
+        explicit CommandResultCache(const std::wstring& lockName);
+
+        void SetLimits(size_t maxResults, size_t maxBytes, unsigned maxAge);
+
+        bool Get(const std::wstring& key, unsigned maxAge, Result& result);
+        void Put(const std::wstring& key, const Result& result);
+        void Clear();
+
+        //! Number of results kept
+        //! \returns Number of results
+        size_t Size() const;
+
+        static std::wstring Key(const std::wstring& method, const std::wstring& command,
+                                const std::wstring& elevationtype, uid_t user);
+
+    private:
+        //! A kept result
+        struct Entry
+        {
+            Result result;              //!< Result of the command
+            scxulong time;              //!< When the command ended (see GetSnapshotTime())
+        };
+
+        //! Not copyable
+        CommandResultCache(const CommandResultCache&);
+        CommandResultCache& operator=(const CommandResultCache&);
+
+        void Evict(scxulong now);
+        void Remove(std::map<std::wstring, Entry>::iterator it);
+
+        const std::wstring m_lockName;                  //!< Name of the lock guarding the cache
+        size_t m_maxResults;                            //!< Maximum number of results kept (0 disables the cache)
+        size_t m_maxBytes;                              //!< Maximum number of bytes of output kept
+        unsigned m_maxAge;                              //!< Maximum age (in seconds) of a result served
+        std::map<std::wstring, Entry> m_entries;        //!< Kept results, by key
+        size_t m_bytes;                                 //!< Number of bytes of output kept
+    };
+
+} // End of namespace SCXCore
+
+#endif /* COMMANDRESULTCACHE_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -12,11 +12,22 @@
 /*----------------------------------------------------------------------------*/
 
 #include "diskprovider.h"
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
 
 namespace SCXCore
 {
+    /*----------------------------------------------------------------------------*/
+    /**
+        Sampler of the statistics of the physical disks (see SamplingScheduler)
+    */
+    static void SampleDiskStatistics()
+    {
+        g_DiskProvider.Sample();
+    }
+
     void DiskProvider::Load()
     {
         if ( 1 == ++ms_loadCount )
@@ -35,6 +46,14 @@ namespace SCXCore
 
             m_staticPhysicalDisks = new StaticPhysicalDiskEnumeration(m_staticPhysicaldeps);
             m_staticPhysicalDisks->Init();
+
+            m_snapshotMaxAge = cDefaultSnapshotMaxAge;
+            m_sampleInterval = cDefaultSampleInterval;
+            ReadSamplingConfiguration(m_log, L"DiskProvider", m_snapshotMaxAge, m_sampleInterval);
+            if (0 != m_sampleInterval)
+            {
+                g_SamplingScheduler.Register(L"DiskProvider", SampleDiskStatistics, m_sampleInterval);
+            }
         }
     }
 
@@ -43,6 +62,12 @@ namespace SCXCore
         SCX_LOGTRACE(m_log, L"DiskProvider::Unload()");
         if (0 == --ms_loadCount)
         {
+            g_SamplingScheduler.Unregister(L"DiskProvider");
+
+            // Requests no longer hold the provider lock while refreshing statistics
+            SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+            m_statisticsSnapshots.Publish(SCXHandle<DiskStatisticsSnapshot>(0));
+
 
             if (m_statisticalPhysicalDisks != NULL)
             {
@@ -58,6 +83,111 @@ namespace SCXCore
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot of the statistics of all physical disks, shared by the
+        requests while it is younger than the maximum age
+
+        \returns      Snapshot of all physical disks (and of their total)
+    */
+    SCXHandle<DiskStatisticsSnapshot> DiskProvider::GetStatisticsSnapshot()
+    {
+        return m_statisticsSnapshots.GetOrRefresh(GetSnapshotTime(), m_snapshotMaxAge,
+                                                  MakeSnapshotTaker(this, &DiskProvider::TakeStatisticsSnapshot));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Refresh the statistics snapshot in the background (called by g_SamplingScheduler)
+    */
+    void DiskProvider::Sample()
+    {
+        m_statisticsSnapshots.SampleIfNeeded(m_snapshotMaxAge, m_sampleInterval, SamplingScheduler::cDemandTimeout,
+                                             MakeSnapshotTaker(this, &DiskProvider::TakeStatisticsSnapshot));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Update the statistics of all physical disks into a new snapshot
+
+        Caller must hold the refresh lock of the snapshots.
+
+        \returns      Snapshot of all physical disks (and of their total)
+    */
+    SCXHandle<DiskStatisticsSnapshot> DiskProvider::TakeStatisticsSnapshot()
+    {
+        SCXHandle<DiskStatisticsSnapshot> snapshot(new DiskStatisticsSnapshot(GetSnapshotTime()));
+        m_statisticalPhysicalDisks->Update(true);
+        for (size_t i = 0; i < m_statisticalPhysicalDisks->Size(); i++)
+        {
+            snapshot->AddInstance(DiskStatisticsSnapshotInstance(m_statisticalPhysicalDisks->GetInstance(i)));
+        }
+
+        SCXHandle<StatisticalPhysicalDiskInstance> totalInst = m_statisticalPhysicalDisks->GetTotalInstance();
+        if (totalInst != NULL)
+        {
+            snapshot->SetTotalInstance(DiskStatisticsSnapshotInstance(totalInst));
+        }
+
+        SCX_LOGTRACE(m_log, StrAppend(L"DiskProvider::TakeStatisticsSnapshot() - new snapshot, number of instances = ", snapshot->Size()));
+        return snapshot;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot containing (at least) the statistics of one disk
+
+        If the shared snapshot is recent enough it is returned as is. Otherwise
+        only the requested disk is refreshed, and a private snapshot holding
+        just that disk is returned (it is not published since it is incomplete).
+        If the disk isn't found, a snapshot of all physical disks is returned.
+
+        \param[in]     name   Name of the disk of interest
+        \returns      Snapshot holding the disk, if it exists
+    */
+    SCXHandle<DiskStatisticsSnapshot> DiskProvider::GetStatisticsSnapshot(const std::wstring& name)
+    {
+        scxulong now = GetSnapshotTime();
+        SCXHandle<DiskStatisticsSnapshot> shared = m_statisticsSnapshots.Get(now, m_snapshotMaxAge);
+        if (shared != NULL)
+        {
+            return shared;
+        }
+
+        {
+            SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+
+            size_t instancePos = (size_t)-1;
+            m_statisticalPhysicalDisks->UpdateSpecific(true, name, &instancePos);
+            if (instancePos != (size_t)-1)
+            {
+                SCXHandle<DiskStatisticsSnapshot> snapshot(new DiskStatisticsSnapshot(now));
+                snapshot->AddInstance(DiskStatisticsSnapshotInstance(m_statisticalPhysicalDisks->GetInstance(instancePos)));
+                return snapshot;
+            }
+        }
+
+        return GetStatisticsSnapshot();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Remove a disk from the statistics (see RemoveByName() of the class provider)
+
+        The shared snapshot is dropped, so that no request sees the disk afterwards.
+
+        \param[in]     name   Name of the disk to remove
+        \returns      true if the disk was removed
+    */
+    bool DiskProvider::RemoveStatisticalInstance(const std::wstring& name)
+    {
+        SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+
+        bool removed = m_statisticalPhysicalDisks->RemoveInstanceById(name);
+        m_statisticsSnapshots.Publish(SCXHandle<DiskStatisticsSnapshot>(0));
+        return removed;
+    }
+
     // Only construct DiskProvider class once - installation date/version never changes!
     SCXCore::DiskProvider g_DiskProvider;
     int SCXCore::DiskProvider::ms_loadCount = 0;
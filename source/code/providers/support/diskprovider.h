@@ -21,6 +21,9 @@
 #include <scxsystemlib/staticphysicaldiskenumeration.h>
 #include <scxsystemlib/statisticalphysicaldiskenumeration.h>
 #include <scxcorelib/scxhandle.h>
+#include "diskstatisticssnapshot.h"
+#include "samplingscheduler.h"
+#include "snapshotpublisher.h"
 
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
@@ -35,9 +38,17 @@ namespace SCXCore
     class DiskProvider
     {
     public:
+        //! Default maximum age (in milliseconds) of a shared statistics snapshot
+        static const scxulong cDefaultSnapshotMaxAge = 1000;
+        //! Default interval (in milliseconds) of the background refresh of the statistics snapshot
+        static const scxulong cDefaultSampleInterval = cDefaultSnapshotMaxAge / 2;
+
         DiskProvider()
             : m_staticPhysicaldeps(0),
-              m_statisticalPhysicsdeps(0) { };
+              m_statisticalPhysicsdeps(0),
+              m_statisticsSnapshots(L"SCXCore::DiskProvider::Statistics"),
+              m_snapshotMaxAge(cDefaultSnapshotMaxAge),
+              m_sampleInterval(cDefaultSampleInterval) { };
         virtual ~DiskProvider() { };
         virtual void UpdateDependency(SCXHandle<SCXSystemLib::DiskDepend> staticPhysicaldeps,
                                       SCXHandle<SCXSystemLib::DiskDepend> statisticalPhysicsdeps) 
@@ -60,6 +71,13 @@ namespace SCXCore
             return m_staticPhysicalDisks;
         }
 
+        SCXHandle<DiskStatisticsSnapshot> GetStatisticsSnapshot();
+        SCXHandle<DiskStatisticsSnapshot> GetStatisticsSnapshot(const std::wstring& name);
+        bool RemoveStatisticalInstance(const std::wstring& name);
+        void SetSnapshotMaxAge(scxulong maxAge) { m_snapshotMaxAge = maxAge; }
+        scxulong GetSnapshotMaxAge() const { return m_snapshotMaxAge; }
+        void Sample();
+
         private:
             SCXHandle<SCXSystemLib::DiskDepend> m_staticPhysicaldeps, m_statisticalPhysicsdeps;
             SCXCoreLib::SCXLogHandle m_log;
@@ -69,6 +87,14 @@ namespace SCXCore
             SCXHandle<SCXSystemLib::StatisticalPhysicalDiskEnumeration> m_statisticalPhysicalDisks;
             //! PAL implementation retrieving static physical disk information for local host
             SCXHandle<SCXSystemLib::StaticPhysicalDiskEnumeration> m_staticPhysicalDisks;
+            //! Most recent complete snapshot of the statistics, shared by all requests
+            SnapshotPublisher<DiskStatisticsSnapshot> m_statisticsSnapshots;
+            //! Maximum age (in milliseconds) before the shared snapshot is refreshed
+            scxulong m_snapshotMaxAge;
+            //! Interval (in milliseconds) of the background refresh of the snapshot
+            scxulong m_sampleInterval;
+
+            SCXHandle<DiskStatisticsSnapshot> TakeStatisticsSnapshot();
     };
 
     extern SCXCore::DiskProvider g_DiskProvider;
@@ -0,0 +1,175 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     diskstatisticssnapshot.cpp
+
+    \brief    Implementation of the immutable disk statistics snapshot shared by the
+              disk drive and file system statistics providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include "diskstatisticssnapshot.h"
+
+using namespace SCXCoreLib;
+using namespace SCXSystemLib;
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Copy the values supported by both physical and logical disks
+
+       \param[in] inst  Disk instance to copy (caller holds the refresh lock)
+    */
+    template <typename I> void DiskStatisticsSnapshotInstance::CopyCommon(SCXHandle<I> inst)
+    {
+        m_diskName.m_valid = inst->GetDiskName(m_diskName.m_value);
+        m_healthState.m_valid = inst->GetHealthState(m_healthState.m_value);
+        m_isTotal = inst->IsTotal();
+        m_ioPercentageTotal.m_valid = inst->GetIOPercentageTotal(m_ioPercentageTotal.m_value);
+        m_bytesPerSecondTotal.m_valid = inst->GetBytesPerSecondTotal(m_bytesPerSecondTotal.m_value);
+        m_bytesPerSecond.m_valid = inst->GetBytesPerSecond(m_bytesPerSecond.m_value.first, m_bytesPerSecond.m_value.second);
+        m_transfersPerSecond.m_valid = inst->GetTransfersPerSecond(m_transfersPerSecond.m_value);
+        m_readsPerSecond.m_valid = inst->GetReadsPerSecond(m_readsPerSecond.m_value);
+        m_writesPerSecond.m_valid = inst->GetWritesPerSecond(m_writesPerSecond.m_value);
+        m_ioTimesTotal.m_valid = inst->GetIOTimesTotal(m_ioTimesTotal.m_value);
+        m_diskQueueLength.m_valid = inst->GetDiskQueueLength(m_diskQueueLength.m_value);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - copies all published values out of a physical disk instance
+
+       \param[in] inst  Disk instance to copy (caller holds the refresh lock)
+    */
+    DiskStatisticsSnapshotInstance::DiskStatisticsSnapshotInstance(SCXHandle<StatisticalPhysicalDiskInstance> inst) :
+        m_isTotal(false)
+    {
+        CopyCommon(inst);
+        m_ioTimes.m_valid = inst->GetIOTimes(m_ioTimes.m_value.first, m_ioTimes.m_value.second);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - copies all published values out of a logical disk instance
+
+       The caller updates a responding instance first, to get the current size
+       and inode usage of the file system. A file system whose mount point
+       doesn't respond (see MountProbe) can't be updated without blocking: it
+       is reported offline, without size nor inode usage.
+
+       \param[in] inst        Disk instance to copy (caller holds the refresh lock)
+       \param[in] responding  Does the mount point of the file system respond?
+    */
+    DiskStatisticsSnapshotInstance::DiskStatisticsSnapshotInstance(SCXHandle<StatisticalLogicalDiskInstance> inst, bool responding) :
+        m_isTotal(false)
+    {
+        if (!responding)
+        {
+            CopyCommon(inst);
+            m_healthState.m_valid = true;
+            m_healthState.m_value = false;
+            return;
+        }
+
+        CopyCommon(inst);
+        m_diskSize.m_valid = inst->GetDiskSize(m_diskSize.m_value.first, m_diskSize.m_value.second);
+        m_inodeUsage.m_valid = inst->GetInodeUsage(m_inodeUsage.m_value.first, m_inodeUsage.m_value.second);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] sampleTime  Time (in milliseconds) when the snapshot is taken
+    */
+    DiskStatisticsSnapshot::DiskStatisticsSnapshot(scxulong sampleTime) :
+        m_sampleTime(sampleTime)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add a disk to the snapshot
+
+       Only to be called while the snapshot is being built, before it is published.
+
+       \param[in] inst  Copy of the disk
+    */
+    void DiskStatisticsSnapshot::AddInstance(const DiskStatisticsSnapshotInstance& inst)
+    {
+        m_instances.push_back(inst);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the total instance of the snapshot
+
+       Only to be called while the snapshot is being built, before it is published.
+
+       \param[in] inst  Copy of the total instance
+    */
+    void DiskStatisticsSnapshot::SetTotalInstance(const DiskStatisticsSnapshotInstance& inst)
+    {
+        m_total.assign(1, inst);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a disk by name (including the total instance)
+
+       \param[in] name  Name of the disk to find
+       \returns   Pointer to the disk (owned by the snapshot), or NULL if not found
+    */
+    const DiskStatisticsSnapshotInstance* DiskStatisticsSnapshot::GetInstance(const std::wstring& name) const
+    {
+        for (std::vector<DiskStatisticsSnapshotInstance>::const_iterator iter = m_instances.begin();
+             iter != m_instances.end(); ++iter)
+        {
+            std::wstring diskName;
+            if (iter->GetDiskName(diskName) && diskName == name)
+            {
+                return &(*iter);
+            }
+        }
+
+        std::wstring totalName;
+        if (!m_total.empty() && m_total[0].GetDiskName(totalName) && totalName == name)
+        {
+            return &m_total[0];
+        }
+
+        return NULL;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the total instance
+
+       \returns   Pointer to the total instance (owned by the snapshot), or NULL if none
+    */
+    const DiskStatisticsSnapshotInstance* DiskStatisticsSnapshot::GetTotalInstance() const
+    {
+        return m_total.empty() ? NULL : &m_total[0];
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check if the snapshot is too old to be shared
+
+       \param[in] now     Current time in milliseconds
+       \param[in] maxAge  Maximum age in milliseconds
+       \returns   true if the snapshot is older than the maximum age
+    */
+    bool DiskStatisticsSnapshot::IsStale(scxulong now, scxulong maxAge) const
+    {
+        // A clock that moves backwards also makes the snapshot stale
+        return now < m_sampleTime || now - m_sampleTime >= maxAge;
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     diskstatisticssnapshot.h
+
+    \brief    Declarations of the immutable disk statistics snapshot shared by the
+              disk drive and file system statistics providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef DISKSTATISTICSSNAPSHOT_H
+#define DISKSTATISTICSSNAPSHOT_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxsystemlib/statisticallogicaldiskenumeration.h>
+#include <scxsystemlib/statisticalphysicaldiskenumeration.h>
+#include "snapshotpublisher.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Copy of all values of one disk that are published by the statistics providers
+
+       The getters mirror the ones of SCXSystemLib::StatisticalPhysicalDiskInstance
+       and SCXSystemLib::StatisticalLogicalDiskInstance, but return the values
+       captured when the snapshot was taken. Values only supported by one kind of
+       disk (like GetIOTimes() or GetDiskSize()) are never valid for the other.
+       Objects of this class are never modified after construction, so they can
+       be read without any lock.
+    */
+    class DiskStatisticsSnapshotInstance
+    {
+    public:
+        explicit DiskStatisticsSnapshotInstance(SCXCoreLib::SCXHandle<SCXSystemLib::StatisticalPhysicalDiskInstance> inst);
+        explicit DiskStatisticsSnapshotInstance(SCXCoreLib::SCXHandle<SCXSystemLib::StatisticalLogicalDiskInstance> inst, bool responding = true);
+
+        bool GetDiskName(std::wstring& name) const { return m_diskName.Get(name); }
+        bool GetHealthState(bool& healthy) const { return m_healthState.Get(healthy); }
+        bool IsTotal() const { return m_isTotal; }
+        bool GetIOPercentageTotal(scxulong& pct) const { return m_ioPercentageTotal.Get(pct); }
+        bool GetBytesPerSecondTotal(scxulong& bytes) const { return m_bytesPerSecondTotal.Get(bytes); }
+        bool GetBytesPerSecond(scxulong& read, scxulong& write) const { return GetPair(m_bytesPerSecond, read, write); }
+        bool GetTransfersPerSecond(scxulong& transfers) const { return m_transfersPerSecond.Get(transfers); }
+        bool GetReadsPerSecond(scxulong& reads) const { return m_readsPerSecond.Get(reads); }
+        bool GetWritesPerSecond(scxulong& writes) const { return m_writesPerSecond.Get(writes); }
+        bool GetIOTimesTotal(double& t) const { return m_ioTimesTotal.Get(t); }
+        bool GetIOTimes(double& read, double& write) const { return GetPair(m_ioTimes, read, write); }
+        bool GetDiskQueueLength(double& length) const { return m_diskQueueLength.Get(length); }
+        bool GetDiskSize(scxulong& used, scxulong& free) const { return GetPair(m_diskSize, used, free); }
+        bool GetInodeUsage(scxulong& total, scxulong& free) const { return GetPair(m_inodeUsage, total, free); }
+
+    private:
+        //! Get both halves of a value returned in two parts by the PAL
+        template <typename T> static bool GetPair(const SnapshotValue<std::pair<T, T> >& value, T& first, T& second)
+        {
+            std::pair<T, T> pair;
+            if (!value.Get(pair))
+            {
+                return false;
+            }
+            first = pair.first;
+            second = pair.second;
+            return true;
+        }
+
+        template <typename I> void CopyCommon(SCXCoreLib::SCXHandle<I> inst);
+
+        SnapshotValue<std::wstring> m_diskName;
+        SnapshotValue<bool> m_healthState;
+        bool m_isTotal;
+        SnapshotValue<scxulong> m_ioPercentageTotal;
+        SnapshotValue<scxulong> m_bytesPerSecondTotal;
+        SnapshotValue<std::pair<scxulong, scxulong> > m_bytesPerSecond;
+        SnapshotValue<scxulong> m_transfersPerSecond;
+        SnapshotValue<scxulong> m_readsPerSecond;
+        SnapshotValue<scxulong> m_writesPerSecond;
+        SnapshotValue<double> m_ioTimesTotal;
+        SnapshotValue<std::pair<double, double> > m_ioTimes;
+        SnapshotValue<double> m_diskQueueLength;
+        SnapshotValue<std::pair<scxulong, scxulong> > m_diskSize;
+        SnapshotValue<std::pair<scxulong, scxulong> > m_inodeUsage;
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Immutable sample of the statistics of the physical disks or of the file systems
+
+       A snapshot is filled in by the DiskProvider (or FileSystemProvider) while
+       it holds the refresh lock of its statistics, and is never modified once it
+       has been published. Any number of requests may therefore read the same
+       snapshot concurrently without holding any lock; the snapshot lives for as
+       long as a request holds a handle to it.
+    */
+    class DiskStatisticsSnapshot
+    {
+    public:
+        explicit DiskStatisticsSnapshot(scxulong sampleTime);
+
+        void AddInstance(const DiskStatisticsSnapshotInstance& inst);
+        void SetTotalInstance(const DiskStatisticsSnapshotInstance& inst);
+
+        //! Number of disks in the snapshot (not counting the total instance)
+        //! \returns Number of disks
+        size_t Size() const { return m_instances.size(); }
+
+        //! Get a disk by position
+        //! \param[in] pos  Position in the snapshot (0 .. Size() - 1)
+        //! \returns    The disk at the given position
+        const DiskStatisticsSnapshotInstance& GetInstance(size_t pos) const { return m_instances[pos]; }
+
+        const DiskStatisticsSnapshotInstance* GetInstance(const std::wstring& name) const;
+        const DiskStatisticsSnapshotInstance* GetTotalInstance() const;
+
+        //! Time (in milliseconds) when the snapshot was taken
+        //! \returns Sample time
+        scxulong GetSampleTime() const { return m_sampleTime; }
+
+        bool IsStale(scxulong now, scxulong maxAge) const;
+
+    private:
+        std::vector<DiskStatisticsSnapshotInstance> m_instances;   //!< The disks in the snapshot
+        std::vector<DiskStatisticsSnapshotInstance> m_total;       //!< The total instance (if any)
+        scxulong m_sampleTime;                                      //!< Time (ms) when the snapshot was taken
+    };
+
+} // End of namespace SCXCore
+
+#endif /* DISKSTATISTICSSNAPSHOT_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
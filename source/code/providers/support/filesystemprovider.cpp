@@ -12,11 +12,39 @@
 /*----------------------------------------------------------------------------*/
 
 #include "filesystemprovider.h"
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+
+#include <algorithm>
+#include <vector>
+
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
 
 namespace SCXCore
 {
+    /*----------------------------------------------------------------------------*/
+    /**
+        Is a mount point not to be updated?
+
+        \param[in]     status   State of the mount point (see MountProbe)
+        \returns      true unless the mount point responded in time
+    */
+    static bool IsUnavailable(MountProbe::Status status)
+    {
+        return MountProbe::eAvailable != status;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Sampler of the statistics of the file systems (see SamplingScheduler)
+    */
+    static void SampleFileSystemStatistics()
+    {
+        g_FileSystemProvider.Sample();
+    }
+
     void FileSystemProvider::Load()
     {
         if ( 1 == ++ms_loadCount )
@@ -35,6 +63,82 @@ namespace SCXCore
 
             m_staticLogicalDisks = new StaticLogicalDiskEnumeration(m_staticLogicaldeps);
             m_staticLogicalDisks->Init();
+
+            ReadConfiguration();
+            if (0 != m_sampleInterval)
+            {
+                g_SamplingScheduler.Register(L"FileSystemProvider", SampleFileSystemStatistics, m_sampleInterval);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read provider settings from the SCX configuration file
+
+        Supported settings (besides FileSystemProvider_SnapshotMaxAgeMs and
+        FileSystemProvider_SampleIntervalMs, see ReadSamplingConfiguration()):
+          FileSystemProvider_ProbeTimeoutMs        - Time (in milliseconds) a probe of a
+                                                     mount point may take
+          FileSystemProvider_ProbeMaxTimeouts      - Missed deadlines in a row before a mount
+                                                     point is quarantined (0 never quarantines)
+          FileSystemProvider_QuarantineMs          - Time (in milliseconds) a mount point
+                                                     stays quarantined
+          FileSystemProvider_ProbeResponseMaxAgeMs - Time (in milliseconds) a response is
+                                                     trusted (0 probes on every request)
+    */
+    void FileSystemProvider::ReadConfiguration()
+    {
+        m_snapshotMaxAge = cDefaultSnapshotMaxAge;
+        m_sampleInterval = cDefaultSampleInterval;
+        ReadSamplingConfiguration(m_log, L"FileSystemProvider", m_snapshotMaxAge, m_sampleInterval);
+
+        scxulong timeout = MountProbe::cDefaultTimeout;
+        scxulong maxTimeouts = MountProbe::cDefaultMaxTimeouts;
+        scxulong quarantine = MountProbe::cDefaultQuarantine;
+        scxulong responseMaxAge = MountProbe::cDefaultResponseMaxAge;
+
+        SCXConfigFile conf(SCXConfFile);
+        try {
+            conf.LoadConfig();
+
+            ReadULong(conf, L"FileSystemProvider_ProbeTimeoutMs", timeout);
+            ReadULong(conf, L"FileSystemProvider_ProbeMaxTimeouts", maxTimeouts);
+            ReadULong(conf, L"FileSystemProvider_QuarantineMs", quarantine);
+            ReadULong(conf, L"FileSystemProvider_ProbeResponseMaxAgeMs", responseMaxAge);
+        }
+        catch (SCXFilePathNotFoundException&)
+        {
+        }
+
+        m_mountProbe.SetLimits(timeout, static_cast<unsigned int>(maxTimeouts), quarantine, responseMaxAge);
+
+        SCX_LOGTRACE(m_log, StrAppend(L"FileSystemProvider parameters: Probe timeout (ms) = ", timeout));
+        SCX_LOGTRACE(m_log, StrAppend(L"FileSystemProvider parameters: Probe max timeouts = ", maxTimeouts));
+        SCX_LOGTRACE(m_log, StrAppend(L"FileSystemProvider parameters: Quarantine (ms) = ", quarantine));
+        SCX_LOGTRACE(m_log, StrAppend(L"FileSystemProvider parameters: Probe response max age (ms) = ", responseMaxAge));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read a number from the SCX configuration file
+
+        \param[in]     conf   Loaded configuration file
+        \param[in]     key    Setting to read
+        \param[in,out] value  Value of the setting (unchanged if missing or invalid)
+    */
+    void FileSystemProvider::ReadULong(SCXConfigFile& conf, const std::wstring& key, scxulong& value)
+    {
+        std::wstring str;
+        if (conf.GetValue(key, str))
+        {
+            try {
+                value = StrToULong(str);
+            }
+            catch (SCXException&)
+            {
+                SCX_LOGWARNING(m_log, L"Invalid " + key + L" value in configuration file: " + str);
+            }
         }
     }
 
@@ -43,6 +147,13 @@ namespace SCXCore
         SCX_LOGTRACE(m_log, L"FileSystemProvider::Unload()");
         if (0 == --ms_loadCount)
         {
+            g_SamplingScheduler.Unregister(L"FileSystemProvider");
+            m_mountProbe.Clear();
+
+            // Requests no longer hold the provider lock while refreshing statistics
+            SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+            m_statisticsSnapshots.Publish(SCXHandle<DiskStatisticsSnapshot>(0));
+
             if (m_statisticalLogicalDisks != NULL)
             {
                 m_statisticalLogicalDisks->CleanUp();
@@ -57,6 +168,153 @@ namespace SCXCore
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot of the statistics of all file systems, shared by the
+        requests while it is younger than the maximum age
+
+        \returns      Snapshot of all file systems (and of their total)
+    */
+    SCXHandle<DiskStatisticsSnapshot> FileSystemProvider::GetStatisticsSnapshot()
+    {
+        return m_statisticsSnapshots.GetOrRefresh(GetSnapshotTime(), m_snapshotMaxAge,
+                                                  MakeSnapshotTaker(this, &FileSystemProvider::TakeStatisticsSnapshot));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Refresh the statistics snapshot in the background (called by g_SamplingScheduler)
+    */
+    void FileSystemProvider::Sample()
+    {
+        m_statisticsSnapshots.SampleIfNeeded(m_snapshotMaxAge, m_sampleInterval, SamplingScheduler::cDemandTimeout,
+                                             MakeSnapshotTaker(this, &FileSystemProvider::TakeStatisticsSnapshot));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Update the statistics of all file systems into a new snapshot
+
+        The mount points are probed first (all at the same time, see MountProbe),
+        so that a hung network file system can't block the update: as long as
+        one doesn't respond, the ones responding are updated one by one, and
+        the others keep their last values and are reported offline. The total
+        instance then keeps the values of the last complete update.
+
+        Caller must hold the refresh lock of the snapshots.
+
+        \returns      Snapshot of all file systems (and of their total)
+    */
+    SCXHandle<DiskStatisticsSnapshot> FileSystemProvider::TakeStatisticsSnapshot()
+    {
+        SCXHandle<DiskStatisticsSnapshot> snapshot(new DiskStatisticsSnapshot(GetSnapshotTime()));
+
+        // Find the file systems without updating them
+        m_statisticalLogicalDisks->Update(false);
+
+        std::vector<std::wstring> mountPoints;
+        for (size_t i = 0; i < m_statisticalLogicalDisks->Size(); i++)
+        {
+            std::wstring name;
+            m_statisticalLogicalDisks->GetInstance(i)->GetDiskName(name);
+            mountPoints.push_back(name);
+        }
+
+        std::vector<MountProbe::Status> statuses;
+        m_mountProbe.Probe(mountPoints, statuses);
+        bool complete = std::find_if(statuses.begin(), statuses.end(), IsUnavailable) == statuses.end();
+        if (complete)
+        {
+            m_statisticalLogicalDisks->Update(true);
+        }
+
+        for (size_t i = 0; i < m_statisticalLogicalDisks->Size(); i++)
+        {
+            SCXHandle<StatisticalLogicalDiskInstance> inst = m_statisticalLogicalDisks->GetInstance(i);
+
+            // The file systems found again by a complete update all responded
+            bool responding = complete || MountProbe::eAvailable == statuses[i];
+            if (responding)
+            {
+                inst->Update();
+            }
+            snapshot->AddInstance(DiskStatisticsSnapshotInstance(inst, responding));
+        }
+
+        SCXHandle<StatisticalLogicalDiskInstance> totalInst = m_statisticalLogicalDisks->GetTotalInstance();
+        if (totalInst != NULL)
+        {
+            if (complete)
+            {
+                totalInst->Update();
+            }
+            snapshot->SetTotalInstance(DiskStatisticsSnapshotInstance(totalInst));
+        }
+
+        SCX_LOGTRACE(m_log, StrAppend(L"FileSystemProvider::TakeStatisticsSnapshot() - new snapshot, number of instances = ", snapshot->Size()));
+        return snapshot;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot containing (at least) the statistics of one file system
+
+        If the shared snapshot is recent enough it is returned as is. Otherwise
+        only the requested file system is refreshed, and a private snapshot holding
+        just that file system is returned (it is not published since it is incomplete).
+        If the file system isn't found, or doesn't respond (it can't be refreshed
+        without blocking), a snapshot of all file systems is returned.
+
+        \param[in]     name   Name of the file system of interest
+        \returns      Snapshot holding the file system, if it exists
+    */
+    SCXHandle<DiskStatisticsSnapshot> FileSystemProvider::GetStatisticsSnapshot(const std::wstring& name)
+    {
+        scxulong now = GetSnapshotTime();
+        SCXHandle<DiskStatisticsSnapshot> shared = m_statisticsSnapshots.Get(now, m_snapshotMaxAge);
+        if (shared != NULL)
+        {
+            return shared;
+        }
+
+        if (MountProbe::eAvailable == m_mountProbe.Probe(name))
+        {
+            SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+
+            size_t instancePos = (size_t)-1;
+            m_statisticalLogicalDisks->UpdateSpecific(name, &instancePos);
+            if (instancePos != (size_t)-1)
+            {
+                SCXHandle<StatisticalLogicalDiskInstance> inst = m_statisticalLogicalDisks->GetInstance(instancePos);
+                inst->Update();
+
+                SCXHandle<DiskStatisticsSnapshot> snapshot(new DiskStatisticsSnapshot(now));
+                snapshot->AddInstance(DiskStatisticsSnapshotInstance(inst));
+                return snapshot;
+            }
+        }
+
+        return GetStatisticsSnapshot();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Remove a file system from the statistics (see RemoveByName() of the class provider)
+
+        The shared snapshot is dropped, so that no request sees the file system afterwards.
+
+        \param[in]     name   Name of the file system to remove
+        \returns      true if the file system was removed
+    */
+    bool FileSystemProvider::RemoveStatisticalInstance(const std::wstring& name)
+    {
+        SCXCoreLib::SCXThreadLock refreshLock(m_statisticsSnapshots.GetRefreshLock());
+
+        bool removed = m_statisticalLogicalDisks->RemoveInstanceById(name);
+        m_statisticsSnapshots.Publish(SCXHandle<DiskStatisticsSnapshot>(0));
+        return removed;
+    }
+
     // Only construct FileSystemProvider class once - installation date/version never changes!
     SCXCore::FileSystemProvider g_FileSystemProvider;
     int SCXCore::FileSystemProvider::ms_loadCount = 0;
@@ -14,6 +14,7 @@
 #ifndef FILESYSTEMPROVIDER_H
 #define FILESYSTEMPROVIDER_H
 
+#include <scxcorelib/scxconfigfile.h>
 #include <scxcorelib/scxlog.h>
 #include "startuplog.h"
 #include <scxsystemlib/diskdepend.h>
@@ -21,6 +22,10 @@
 #include <scxsystemlib/staticlogicaldiskenumeration.h>
 #include <scxsystemlib/statisticallogicaldiskenumeration.h>
 #include <scxcorelib/scxhandle.h>
+#include "diskstatisticssnapshot.h"
+#include "mountprobe.h"
+#include "samplingscheduler.h"
+#include "snapshotpublisher.h"
 
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
@@ -35,9 +40,17 @@ namespace SCXCore
     class FileSystemProvider
     {
     public:
+        //! Default maximum age (in milliseconds) of a shared statistics snapshot
+        static const scxulong cDefaultSnapshotMaxAge = 1000;
+        //! Default interval (in milliseconds) of the background refresh of the statistics snapshot
+        static const scxulong cDefaultSampleInterval = cDefaultSnapshotMaxAge / 2;
+
         FileSystemProvider()
             : m_staticLogicaldeps(0),
-              m_statisticalLogicaldeps(0) { };
+              m_statisticalLogicaldeps(0),
+              m_statisticsSnapshots(L"SCXCore::FileSystemProvider::Statistics"),
+              m_snapshotMaxAge(cDefaultSnapshotMaxAge),
+              m_sampleInterval(cDefaultSampleInterval) { };
         virtual ~FileSystemProvider() { };
         virtual void UpdateDependency(SCXHandle<SCXSystemLib::DiskDepend> staticLogicaldeps,
                                       SCXHandle<SCXSystemLib::DiskDepend> statisticalLogicaldeps) 
@@ -60,6 +73,17 @@ namespace SCXCore
             return m_staticLogicalDisks;
         }
 
+        SCXHandle<DiskStatisticsSnapshot> GetStatisticsSnapshot();
+        SCXHandle<DiskStatisticsSnapshot> GetStatisticsSnapshot(const std::wstring& name);
+        bool RemoveStatisticalInstance(const std::wstring& name);
+        void SetSnapshotMaxAge(scxulong maxAge) { m_snapshotMaxAge = maxAge; }
+        scxulong GetSnapshotMaxAge() const { return m_snapshotMaxAge; }
+        void Sample();
+
+        //! Probe telling which mount points may be updated without blocking
+        //! \returns The probe of the mount points
+        MountProbe& GetMountProbe() { return m_mountProbe; }
+
         private:
             SCXHandle<SCXSystemLib::DiskDepend> m_staticLogicaldeps, m_statisticalLogicaldeps;
             SCXCoreLib::SCXLogHandle m_log;
@@ -69,6 +93,18 @@ namespace SCXCore
             SCXHandle<SCXSystemLib::StatisticalLogicalDiskEnumeration> m_statisticalLogicalDisks;
             //! PAL implementation retrieving static logical disk information for local host
             SCXHandle<SCXSystemLib::StaticLogicalDiskEnumeration> m_staticLogicalDisks;
+            //! Most recent complete snapshot of the statistics, shared by all requests
+            SnapshotPublisher<DiskStatisticsSnapshot> m_statisticsSnapshots;
+            //! Maximum age (in milliseconds) before the shared snapshot is refreshed
+            scxulong m_snapshotMaxAge;
+            //! Interval (in milliseconds) of the background refresh of the snapshot
+            scxulong m_sampleInterval;
+            //! Probe of the mount points, run before the PAL updates them
+            MountProbe m_mountProbe;
+
+            SCXHandle<DiskStatisticsSnapshot> TakeStatisticsSnapshot();
+            void ReadConfiguration();
+            void ReadULong(SCXCoreLib::SCXConfigFile& conf, const std::wstring& key, scxulong& value);
     };
 
     extern SCXCore::FileSystemProvider g_FileSystemProvider;
@@ -0,0 +1,450 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilematcher.cpp
+
+    \brief     Combined matcher for the regular expressions of a log file rule set
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+
+#include <algorithm>
+#include <queue>
+#include <wctype.h>
+
+#include "logfilematcher.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Longest literal used (any prefix of a required literal is required too)
+    const size_t cMaxLiteralLength = 16;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Find the end of a bracket expression
+
+       \param[in] expression  Regular expression
+       \param[in] pos         Position of the opening '['
+       \returns   Position following the closing ']', or npos if there is none
+    */
+    size_t SkipBracket(const std::wstring& expression, size_t pos)
+    {
+        pos++;
+        if (pos < expression.size() && L'^' == expression[pos])
+        {
+            pos++;
+        }
+        // A ']' first in the list is part of the list
+        if (pos < expression.size() && L']' == expression[pos])
+        {
+            pos++;
+        }
+
+        while (pos < expression.size())
+        {
+            if (L'[' == expression[pos] && pos + 1 < expression.size()
+                && (L':' == expression[pos + 1] || L'=' == expression[pos + 1] || L'.' == expression[pos + 1]))
+            {
+                // Character class, equivalence class or collating symbol: "[:alpha:]" etc.
+                wchar_t delimiter = expression[pos + 1];
+                size_t end = pos + 2;
+                while (end + 1 < expression.size() && !(delimiter == expression[end] && L']' == expression[end + 1]))
+                {
+                    end++;
+                }
+                if (end + 1 >= expression.size())
+                {
+                    return std::wstring::npos;
+                }
+                pos = end + 2;
+            }
+            else if (L']' == expression[pos])
+            {
+                return pos + 1;
+            }
+            else
+            {
+                pos++;
+            }
+        }
+
+        return std::wstring::npos;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Find the end of a parenthesized subexpression
+
+       \param[in] expression  Regular expression
+       \param[in] pos         Position of the opening '('
+       \returns   Position following the matching ')', or npos if there is none
+    */
+    size_t SkipGroup(const std::wstring& expression, size_t pos)
+    {
+        int depth = 0;
+        while (pos < expression.size())
+        {
+            switch (expression[pos])
+            {
+            case L'\\':
+                pos += 2;
+                break;
+            case L'[':
+                pos = SkipBracket(expression, pos);
+                break;
+            case L'(':
+                depth++;
+                pos++;
+                break;
+            case L')':
+                pos++;
+                if (0 == --depth)
+                {
+                    return pos;
+                }
+                break;
+            default:
+                pos++;
+                break;
+            }
+        }
+
+        return std::wstring::npos;
+    }
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] regexps          Expressions of the rule set
+       \param[in] asciiCompatible  Does the encoding of the log file map ASCII
+                                   bytes to the same characters? If not, no
+                                   lines are filtered out by Prefilter().
+    */
+    LogFileMatcher::LogFileMatcher(const std::vector<SCXRegexWithIndex>& regexps, bool asciiCompatible) :
+        m_Regexps(regexps),
+        m_AsciiCompatible(asciiCompatible),
+        m_Literals(regexps.size()),
+        m_Seen(regexps.size(), 0),
+        m_Stamp(0)
+    {
+        // State 0 is the root of the automaton
+        m_Goto.assign(cAlphabetSize, 0);
+        m_Output.resize(1);
+
+        for (size_t i = 0; i < regexps.size(); i++)
+        {
+            m_Expressions.push_back(regexps[i].regex->Get());
+
+            if (m_AsciiCompatible)
+            {
+                m_Literals[i] = GetRequiredLiteral(m_Expressions[i]).substr(0, cMaxLiteralLength);
+            }
+
+            if (m_Literals[i].empty())
+            {
+                m_Unfiltered.push_back(i);
+            }
+            else
+            {
+                AddLiteral(m_Literals[i], i);
+            }
+        }
+
+        BuildAutomaton();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check if the matcher was built for a given rule set
+
+       \param[in] regexps          Expressions of the rule set
+       \param[in] asciiCompatible  See constructor
+       \returns   true if the matcher can be used for the rule set
+    */
+    bool LogFileMatcher::IsSameRules(const std::vector<SCXRegexWithIndex>& regexps, bool asciiCompatible) const
+    {
+        if (asciiCompatible != m_AsciiCompatible || regexps.size() != m_Regexps.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < regexps.size(); i++)
+        {
+            if (regexps[i].index != m_Regexps[i].index || regexps[i].regex->Get() != m_Expressions[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Find the expressions that may match a line
+
+       The candidates are kept for the following call to Match().
+
+       \param[in] line    Start of the line (not decoded)
+       \param[in] length  Length of the line
+       \returns   false if no expression can match the line
+    */
+    bool LogFileMatcher::Prefilter(const char* line, size_t length)
+    {
+        m_Candidates.clear();
+
+        if (m_Unfiltered.size() < m_Regexps.size())
+        {
+            if (0 == ++m_Stamp)
+            {
+                std::fill(m_Seen.begin(), m_Seen.end(), 0);
+                m_Stamp = 1;
+            }
+
+            size_t filtered = m_Regexps.size() - m_Unfiltered.size();
+            int state = 0;
+            for (size_t i = 0; i < length && m_Candidates.size() < filtered; i++)
+            {
+                state = m_Goto[state * cAlphabetSize + static_cast<unsigned char>(line[i])];
+
+                const std::vector<size_t>& output = m_Output[state];
+                for (std::vector<size_t>::const_iterator it = output.begin(); it != output.end(); ++it)
+                {
+                    if (m_Seen[*it] != m_Stamp)
+                    {
+                        m_Seen[*it] = m_Stamp;
+                        m_Candidates.push_back(*it);
+                    }
+                }
+            }
+        }
+
+        if (m_Candidates.empty())
+        {
+            m_Candidates = m_Unfiltered;
+        }
+        else if (!m_Unfiltered.empty() || m_Candidates.size() > 1)
+        {
+            m_Candidates.insert(m_Candidates.end(), m_Unfiltered.begin(), m_Unfiltered.end());
+            std::sort(m_Candidates.begin(), m_Candidates.end());
+        }
+
+        return !m_Candidates.empty();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Evaluate the candidates found by the last call to Prefilter()
+
+       \param[in]  line     The line passed to Prefilter(), decoded
+       \param[out] matches  Positions (in the rule set) of the matching expressions, ascending
+    */
+    void LogFileMatcher::Match(const std::wstring& line, std::vector<size_t>& matches) const
+    {
+        matches.clear();
+
+        for (std::vector<size_t>::const_iterator it = m_Candidates.begin(); it != m_Candidates.end(); ++it)
+        {
+            if (m_Regexps[*it].regex->IsMatch(line))
+            {
+                matches.push_back(*it);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a literal that is part of any text matched by an expression
+
+       The expression is parsed conservatively as a POSIX extended regular
+       expression; anything not understood ends the current literal. Of the
+       literals found, the longest is returned.
+
+       \param[in] expression  Regular expression
+       \returns   Literal (ASCII only), or empty if none was found
+    */
+    std::string LogFileMatcher::GetRequiredLiteral(const std::wstring& expression)
+    {
+        std::string best;
+        std::string current;
+        size_t pos = 0;
+
+        while (pos < expression.size())
+        {
+            wchar_t c = expression[pos];
+            bool literal = false;
+            size_t next = pos + 1;
+
+            switch (c)
+            {
+            case L'|':
+                // Alternation at the top level: no single literal is required
+                return std::string();
+            case L'[':
+                next = SkipBracket(expression, pos);
+                break;
+            case L'(':
+                next = SkipGroup(expression, pos);
+                break;
+            case L'{':
+                next = expression.find(L'}', pos);
+                next = (std::wstring::npos == next) ? next : next + 1;
+                break;
+            case L'*':
+            case L'?':
+            case L'+':
+            case L'.':
+            case L'^':
+            case L'$':
+            case L')':
+                break;
+            case L'\\':
+                next = pos + 2;
+                if (next > expression.size())
+                {
+                    return std::string();
+                }
+                c = expression[pos + 1];
+                // Escaped letters and digits are classes, anchors or back references
+                literal = (c > 0x20 && c < 0x7f && !iswalnum(c)
+                           && L'<' != c && L'>' != c && L'`' != c && L'\'' != c);
+                break;
+            default:
+                literal = (c > 0 && c < 0x80);
+                break;
+            }
+
+            if (std::wstring::npos == next)
+            {
+                // Unbalanced expression; let the regular expression deal with it
+                return std::string();
+            }
+
+            // An item followed by a quantifier other than '+' is optional
+            if (literal && next < expression.size()
+                && (L'*' == expression[next] || L'?' == expression[next] || L'{' == expression[next]))
+            {
+                literal = false;
+            }
+
+            if (literal)
+            {
+                current += static_cast<char>(c);
+            }
+            else
+            {
+                if (current.size() > best.size())
+                {
+                    best = current;
+                }
+                current.clear();
+            }
+
+            // A literal followed by '+' is required once, but not next to what follows
+            if (literal && next < expression.size() && L'+' == expression[next])
+            {
+                if (current.size() > best.size())
+                {
+                    best = current;
+                }
+                current.clear();
+            }
+
+            pos = next;
+        }
+
+        if (current.size() > best.size())
+        {
+            best = current;
+        }
+
+        return best;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add a literal to the trie of the automaton
+
+       \param[in] literal  Literal to add
+       \param[in] pos      Position of the expression requiring the literal
+    */
+    void LogFileMatcher::AddLiteral(const std::string& literal, size_t pos)
+    {
+        int state = 0;
+        for (size_t i = 0; i < literal.size(); i++)
+        {
+            size_t slot = state * cAlphabetSize + static_cast<unsigned char>(literal[i]);
+            if (0 == m_Goto[slot])
+            {
+                m_Goto[slot] = static_cast<int>(m_Output.size());
+                m_Goto.resize(m_Goto.size() + cAlphabetSize, 0);
+                m_Output.resize(m_Output.size() + 1);
+            }
+            state = m_Goto[slot];
+        }
+
+        m_Output[state].push_back(pos);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Turn the trie into a deterministic automaton
+
+       Missing transitions are replaced by the transitions of the failure state
+       (the longest proper suffix that is also in the trie), and the outputs of
+       the failure state are merged into each state, so matching never needs to
+       follow failure links.
+    */
+    void LogFileMatcher::BuildAutomaton()
+    {
+        std::vector<int> fail(m_Output.size(), 0);
+        std::queue<int> pending;
+
+        for (size_t c = 0; c < cAlphabetSize; c++)
+        {
+            if (0 != m_Goto[c])
+            {
+                pending.push(m_Goto[c]);
+            }
+        }
+
+        // Breadth first, so the failure state of a state is complete before the state
+        while (!pending.empty())
+        {
+            int state = pending.front();
+            pending.pop();
+
+            const std::vector<size_t>& failOutput = m_Output[fail[state]];
+            m_Output[state].insert(m_Output[state].end(), failOutput.begin(), failOutput.end());
+
+            for (size_t c = 0; c < cAlphabetSize; c++)
+            {
+                int& next = m_Goto[state * cAlphabetSize + c];
+                int failNext = m_Goto[fail[state] * cAlphabetSize + c];
+                if (0 != next)
+                {
+                    fail[next] = failNext;
+                    pending.push(next);
+                }
+                else
+                {
+                    next = failNext;
+                }
+            }
+        }
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
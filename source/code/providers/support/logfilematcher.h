@@ -0,0 +1,86 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilematcher.h
+
+    \brief     Combined matcher for the regular expressions of a log file rule set
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef LOGFILEMATCHER_H
+#define LOGFILEMATCHER_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxregex.h>
+
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Combined matcher for the regular expressions of one GetMatchedRows rule set
+
+       Testing every expression against every line makes the cost per line grow
+       with the number of expressions. When the matcher is built, a literal
+       that any match must contain is extracted from each expression, and all
+       literals are compiled into one Aho-Corasick automaton. For each line,
+       one pass of the automaton over the raw bytes tells which expressions
+       can possibly match; only those are evaluated, and lines that no
+       expression can match don't need to be decoded at all.
+
+       Expressions without a usable literal (for example ".*", or expressions
+       with top level alternation) are evaluated for every line. Literals are
+       only used if they are plain ASCII and the log file encoding maps ASCII
+       to itself (see LogFileReader::LogFileLineDecoder).
+
+       Build once, use for many lines. Not thread safe.
+    */
+    class LogFileMatcher
+    {
+    public:
+        LogFileMatcher(const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps, bool asciiCompatible);
+
+        bool IsSameRules(const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps, bool asciiCompatible) const;
+
+        bool Prefilter(const char* line, size_t length);
+        void Match(const std::wstring& line, std::vector<size_t>& matches) const;
+
+        //! Get the expressions of the rule set
+        //! \returns Expressions, in rule set order
+        const std::vector<SCXCoreLib::SCXRegexWithIndex>& GetRegexps() const { return m_Regexps; }
+
+        //! Get the literal required by an expression (for test purposes)
+        //! \param[in] pos  Position of the expression in the rule set
+        //! \returns    Literal, or empty if the expression is evaluated for every line
+        const std::string& GetLiteral(size_t pos) const { return m_Literals[pos]; }
+
+        static std::string GetRequiredLiteral(const std::wstring& expression);
+
+    private:
+        void AddLiteral(const std::string& literal, size_t pos);
+        void BuildAutomaton();
+
+        static const size_t cAlphabetSize = 256;    //!< Automaton works on bytes
+
+        std::vector<SCXCoreLib::SCXRegexWithIndex> m_Regexps;   //!< Expressions of the rule set
+        std::vector<std::wstring> m_Expressions;                //!< Source of m_Regexps (to compare rule sets)
+        bool m_AsciiCompatible;                                 //!< Were literals allowed when built?
+        std::vector<std::string> m_Literals;                    //!< Required literal per expression
+        std::vector<size_t> m_Unfiltered;                       //!< Expressions evaluated for every line
+
+        std::vector<int> m_Goto;                                //!< Automaton transitions (state * cAlphabetSize + byte)
+        std::vector<std::vector<size_t> > m_Output;             //!< Expressions whose literal ends in a state
+
+        std::vector<size_t> m_Candidates;                       //!< Expressions to evaluate for the current line
+        std::vector<unsigned int> m_Seen;                       //!< Line stamp per expression (avoids duplicates)
+        unsigned int m_Stamp;                                   //!< Stamp of the current line
+    };
+}
+
+#endif /* LOGFILEMATCHER_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
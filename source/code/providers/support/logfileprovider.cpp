@@ -18,6 +18,7 @@
 #include <scxcorelib/scxmarshal.h>
 #include <scxcorelib/scxprocess.h>
 #include <scxsystemlib/scxsysteminfo.h>
+#include "source/code/scxcorelib/util/persist/scxfilepersistmedia.h"
 
 #include <errno.h>
 #include <stdlib.h>
@@ -26,6 +27,11 @@
 #include "logfileutils.h"
 #include "startuplog.h"
 
+// dynamic_cast fix - wi 11220
+#ifdef dynamic_cast
+#undef dynamic_cast
+#endif
+
 using namespace SCXCoreLib;
 using namespace std;
 
@@ -39,13 +45,19 @@ namespace SCXCore {
        Default constructor
     */
     LogFileProvider::LogFileProvider() :
-        m_pLogFileReader(NULL)
+        m_pLogFileReader(NULL),
+        m_pElevatedServer(NULL),
+        m_serverFailureTime(0),
+        m_fRunReaderPerRequest(false)
     {
         // Assuming we have one global object - initialized at load time
     }
 
     LogFileProvider::LogFileProvider(SCXCoreLib::SCXHandle<LogFileReader> pLogFileReader)
-        : m_pLogFileReader(pLogFileReader)
+        : m_pLogFileReader(pLogFileReader),
+          m_pElevatedServer(NULL),
+          m_serverFailureTime(0),
+          m_fRunReaderPerRequest(false)
     {
         // Assuming we have one global object - initialized at load time
     }
@@ -73,6 +85,21 @@ namespace SCXCore {
             if (NULL == m_pLogFileReader)
             {
                 m_pLogFileReader = new LogFileReader();
+
+                // Under testrunner, keep state files where "scxlogfilereader -t" keeps them
+                if (NULL != getenv("SCX_TESTRUN_ACTIVE"))
+                {
+                    SCXHandle<SCXPersistMedia> pmedia = GetPersistMedia();
+                    SCXFilePersistMedia* m = dynamic_cast<SCXFilePersistMedia*> (pmedia.GetData());
+                    SCXASSERT(m != 0);
+                    m->SetBasePath(L"./");
+                    m_pLogFileReader->SetPersistMedia(pmedia);
+                    m_pLogFileReader->UseStateStore(L"./");
+                }
+                else
+                {
+                    m_pLogFileReader->UseStateStore(L"/var/opt/microsoft/scx/lib/state/");
+                }
             }
         }
     }
@@ -85,6 +112,10 @@ namespace SCXCore {
         if ( 0 == --ms_loadCount )
         {
             m_pLogFileReader = NULL;
+
+            // Closing the connection makes the elevated server exit
+            m_pElevatedServer = NULL;
+            m_serverFailureTime = 0;
         }
     }
 
@@ -105,13 +136,92 @@ namespace SCXCore {
 
     /*----------------------------------------------------------------------------*/
     /**
-        Invoke the logfileread CLI (command line) program, with elevation if needed
+        Build the command line to run the logfilereader CLI (command line) program
+
+        \param[in]     option            Option selecting the operation (-p, -r or -d)
+        \param[in]     performElevation  Perform elevation when running the command
+
+        \returns       Command line to run
+    */
+    std::wstring LogFileProvider::GetLogFileReaderCommand(const std::wstring& option, bool fPerformElevation) const
+    {
+        // Test to see if we're running under testrunner.  This makes it easy
+        // to know where to launch our test program, allowing unit tests to
+        // test all the way through to the CLI.
+
+        wstring programName;
+        char *testrunFlag = getenv("SCX_TESTRUN_ACTIVE");
+        if (NULL != testrunFlag)
+        {
+            programName = L"testfiles/scxlogfilereader-test -t ";
+        }
+        else
+        {
+            programName = L"/opt/microsoft/scx/bin/scxlogfilereader ";
+        }
+        programName.append(option);
+
+        // Elevate the command if that's called for
+        if (fPerformElevation)
+        {
+            SCXSystemLib::SystemInfo si;
+            programName = si.GetElevatedCommand(programName);
+        }
+
+        return programName;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the elevated scxlogfilereader server, creating it if needed
+
+        \returns       The server, or NULL if it shouldn't be used right now
+    */
+    SCXHandle<LogFileReaderClient> LogFileProvider::GetElevatedServer()
+    {
+        // Servers stopped by earlier requests are reaped once they have exited
+        if (NULL != m_pElevatedServer)
+        {
+            m_pElevatedServer->ReapStoppedServers();
+        }
+
+        if (m_fRunReaderPerRequest)
+        {
+            return SCXHandle<LogFileReaderClient>(NULL);
+        }
+
+        // Don't try to start a failing server (sudo may not allow it) for every request
+        if (0 != m_serverFailureTime)
+        {
+            time_t now = time(NULL);
+            if (now >= m_serverFailureTime && now - m_serverFailureTime < cServerRetryInterval)
+            {
+                return SCXHandle<LogFileReaderClient>(NULL);
+            }
+            m_serverFailureTime = 0;
+        }
+
+        if (NULL == m_pElevatedServer)
+        {
+            m_pElevatedServer = new LogFileReaderClient(GetLogFileReaderCommand(L"-d", true));
+        }
+
+        return m_pElevatedServer;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read a log file, with elevation if needed
 
         \param[in]     filename          Filename to scan for matches
         \param[in]     qid               QID used for state file handling
         \param[in]     regexps           List of regular expressions to look for
-        \param[in]     performElevation  Perform elevation when running the command
+        \param[in]     performElevation  Perform elevation when reading the file
         \param[out]    matchedLines      Resulting matched lines, if any, from log file
+        \param[in]     maxRows           Max number of matched lines to return (see LogFileReader::ReadLogFile)
+        \param[in]     maxBytes          Max size of the matched lines to return
+        \param[in,out] resumePosition    Resume position to start at, and of this read
+                                         (see LogFileReader::ReadLogFile), or NULL
 
         \returns       Boolean flag to indicate if partial matches were returned
     */
@@ -120,10 +230,195 @@ namespace SCXCore {
         const std::wstring& qid,
         const std::vector<SCXRegexWithIndex>& regexps,
         bool fPerformElevation,
-        std::vector<std::wstring>& matchedLines)
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows /* = LogFileReader::cDefaultMaxRows */,
+        size_t maxBytes /* = LogFileReader::cDefaultMaxBytes */,
+        std::wstring* resumePosition /* = NULL */)
     {
         SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeLogFileReader");
 
+        if (m_fRunReaderPerRequest)
+        {
+            return RunLogFileReader(filename, qid, regexps, fPerformElevation, matchedLines, maxRows, maxBytes, resumePosition);
+        }
+
+        if (fPerformElevation)
+        {
+            return ReadLogFileElevated(filename, qid, regexps, matchedLines, maxRows, maxBytes, resumePosition);
+        }
+
+        return ReadLogFileInProcess(filename, qid, regexps, matchedLines, maxRows, maxBytes, resumePosition);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read a log file in the provider process (no elevation)
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     regexps           List of regular expressions to look for
+        \param[out]    matchedLines      Resulting matched lines, if any, from log file
+        \param[in]     maxRows           Max number of matched lines to return (see LogFileReader::ReadLogFile)
+        \param[in]     maxBytes          Max size of the matched lines to return
+        \param[in,out] resumePosition    Resume position to start at, and of this read
+                                         (see LogFileReader::ReadLogFile), or NULL
+
+        \returns       Boolean flag to indicate if partial matches were returned
+    */
+    bool LogFileProvider::ReadLogFileInProcess(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        const std::vector<SCXRegexWithIndex>& regexps,
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows,
+        size_t maxBytes,
+        std::wstring* resumePosition)
+    {
+        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeLogFileReader - Reading in-process");
+
+        try
+        {
+            return m_pLogFileReader->ReadLogFile(filename, qid, regexps, matchedLines, maxRows, maxBytes, resumePosition);
+        }
+        catch (SCXFilePathNotFoundException& e)
+        {
+            // Same outcome as when scxlogfilereader returns ENOENT
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeLogFileReader - File not found: ", filename).append(L", exception: ").append(e.What()));
+            return false;
+        }
+        catch (SCXCoreLib::SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeLogFileReader - Exception: ", e.What()));
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read a log file through the elevated scxlogfilereader server
+
+        Falls back to running scxlogfilereader for this request if the server
+        can't be used. A server that failed may have persisted the new state of
+        the file before its response was lost, so the fallback read resumes where
+        the failed read started: at the resume position of the caller, if any,
+        else where the previous elevated read of the file stopped.
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     regexps           List of regular expressions to look for
+        \param[out]    matchedLines      Resulting matched lines, if any, from log file
+        \param[in]     maxRows           Max number of matched lines to return (see LogFileReader::ReadLogFile)
+        \param[in]     maxBytes          Max size of the matched lines to return
+        \param[in,out] resumePosition    Resume position to start at, and of this read
+                                         (see LogFileReader::ReadLogFile), or NULL
+
+        \returns       Boolean flag to indicate if partial matches were returned
+    */
+    bool LogFileProvider::ReadLogFileElevated(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        const std::vector<SCXRegexWithIndex>& regexps,
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows,
+        size_t maxBytes,
+        std::wstring* resumePosition)
+    {
+        // Where this read starts (empty if at the persisted state of the file)
+        std::pair<std::wstring, std::wstring> key(filename, qid);
+        std::wstring startPosition;
+        std::map<std::pair<std::wstring, std::wstring>, std::wstring>::const_iterator recorded = m_elevatedPositions.find(key);
+        if (NULL != resumePosition && ! resumePosition->empty())
+        {
+            startPosition = *resumePosition;
+        }
+        else if (m_elevatedPositions.end() != recorded)
+        {
+            startPosition = recorded->second;
+        }
+        if (m_elevatedPositions.end() == recorded && m_elevatedPositions.size() >= cMaxElevatedPositions)
+        {
+            m_elevatedPositions.clear();
+        }
+
+        SCXHandle<LogFileReaderClient> server = GetElevatedServer();
+        std::wstring position(NULL != resumePosition ? *resumePosition : L"");
+        bool wasPartialRead = false;
+        int status = ENOENT;
+        try
+        {
+            if (NULL != server)
+            {
+                status = server->ReadLogFile(filename, qid, regexps, wasPartialRead, matchedLines, maxRows, maxBytes, &position);
+            }
+        }
+        catch (SCXCoreLib::SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeLogFileReader - Elevated server failed, running scxlogfilereader per request: ", e.What()));
+            m_serverFailureTime = time(NULL);
+            server = NULL;
+            matchedLines.clear();
+            position = startPosition;
+        }
+
+        if (NULL == server)
+        {
+            wasPartialRead = RunLogFileReader(filename, qid, regexps, true, matchedLines, maxRows, maxBytes, &position);
+            status = 0;
+        }
+
+        if (0 == status)
+        {
+            m_elevatedPositions[key] = position;
+            if (NULL != resumePosition)
+            {
+                *resumePosition = position;
+            }
+        }
+
+        SCX_LOGTRACE(m_log, StrAppend(L"SCXLogFileProvider InvokeLogFileReader - Server result ", status));
+
+        switch (status)
+        {
+            case 0:
+                return wasPartialRead;
+            case ENOENT:
+                // Log file didn't exist - scxlogfilereader logged message about it
+                return false;
+            default:
+                wstringstream errorMsg;
+                errorMsg << L"Unexpected status from scxlogfilereader server: " << status;
+                throw SCXInternalErrorException(errorMsg.str(), SCXSRCLOCATION);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Invoke the logfileread CLI (command line) program, with elevation if needed
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     regexps           List of regular expressions to look for
+        \param[in]     performElevation  Perform elevation when running the command
+        \param[out]    matchedLines      Resulting matched lines, if any, from log file
+        \param[in]     maxRows           Max number of matched lines to return (see LogFileReader::ReadLogFile)
+        \param[in]     maxBytes          Max size of the matched lines to return
+        \param[in,out] resumePosition    Resume position to start at, and of this read
+                                         (see LogFileReader::ReadLogFile), or NULL
+
+        \returns       Boolean flag to indicate if partial matches were returned
+    */
+    bool LogFileProvider::RunLogFileReader(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        const std::vector<SCXRegexWithIndex>& regexps,
+        bool fPerformElevation,
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows,
+        size_t maxBytes,
+        std::wstring* resumePosition)
+    {
+        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeLogFileReader - Running scxlogfilereader");
+
         // Process of log file was called by something like:
         //
         // bPartial = m_pLFR->ReadLogFile(filename, qid, regexps, matchedLines);
@@ -137,34 +432,27 @@ namespace SCXCore {
 
         SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeLogFileReader - Marshaling");
 
+        // The limits (and the resume position) are only sent when not the
+        // defaults, as older versions of scxlogfilereader don't expect them
+        bool fResume = (NULL != resumePosition && ! resumePosition->empty());
         Marshal send(processInput);
         send.Write(filename);
         send.Write(qid);
         send.Write(regexps);
-        send.Flush();
-
-        // Test to see if we're running under testrunner.  This makes it easy
-        // to know where to launch our test program, allowing unit tests to
-        // test all the way through to the CLI.
-
-        wstring programName;
-        char *testrunFlag = getenv("SCX_TESTRUN_ACTIVE");
-        if (NULL != testrunFlag)
+        if (LogFileReader::cDefaultMaxRows != maxRows || LogFileReader::cDefaultMaxBytes != maxBytes || fResume)
         {
-            programName = L"testfiles/scxlogfilereader-test -t -p";
+            int maxRows_asint = static_cast<int>(maxRows);
+            int maxBytes_asint = static_cast<int>(maxBytes);
+            send.Write(maxRows_asint);
+            send.Write(maxBytes_asint);
         }
-        else
+        if (fResume)
         {
-            programName = L"/opt/microsoft/scx/bin/scxlogfilereader -p";
+            send.Write(*resumePosition);
         }
+        send.Flush();
 
-        // Elevate the command if that's called for
-        SCXSystemLib::SystemInfo si;
-
-        if (fPerformElevation)
-        {
-            programName = si.GetElevatedCommand(programName);
-        }
+        wstring programName = GetLogFileReaderCommand(L"-p", fPerformElevation);
 
         // Call the log file reader (CLI) program
 
@@ -217,12 +505,135 @@ namespace SCXCore {
         UnMarshal receive(processOutput);
         receive.Read(wasPartialRead);
         receive.Read(matchedLines);
+        if (NULL != resumePosition)
+        {
+            resumePosition->clear();
+            if (EOF != processOutput.peek())
+            {
+                receive.Read(*resumePosition);
+            }
+        }
 
         SCX_LOGTRACE(m_log, StrAppend(L"SCXLogFileProvider InvokeLogFileReader - Returning: ", (0 != wasPartialRead)));
 
         return (0 != wasPartialRead);
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Reset a specific state file, with elevation if needed
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     resetOnRead       Rather than reset now, reset on next logfile read
+        \param[in]     performElevation  Perform elevation when resetting the state file
+
+        \returns       Result status (if operation was successful or not)
+    */
+    int LogFileProvider::InvokeResetStateFile(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        int resetOnRead,
+        bool fPerformElevation)
+    {
+        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeResetStateFile");
+
+        // Elevated reads of the file no longer start where the last one stopped
+        m_elevatedPositions.erase(std::make_pair(filename, qid));
+
+        if (m_fRunReaderPerRequest)
+        {
+            return RunResetStateFile(filename, qid, resetOnRead, fPerformElevation);
+        }
+
+        if (fPerformElevation)
+        {
+            return ResetStateFileElevated(filename, qid, resetOnRead);
+        }
+
+        return ResetStateFileInProcess(filename, qid, resetOnRead);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Reset a specific state file in the provider process (no elevation)
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     resetOnRead       Rather than reset now, reset on next logfile read
+
+        \returns       Result status (if operation was successful or not)
+    */
+    int LogFileProvider::ResetStateFileInProcess(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        int resetOnRead)
+    {
+        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeResetStateFile - Resetting in-process");
+
+        try
+        {
+            return m_pLogFileReader->ResetLogFileState(filename, qid, (resetOnRead ? true : false));
+        }
+        catch (SCXFilePathNotFoundException& e)
+        {
+            // Same outcome as when scxlogfilereader returns ENOENT
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeResetStateFile - File not found: ", filename).append(L", exception: ").append(e.What()));
+            return ENOENT;
+        }
+        catch (SCXCoreLib::SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeResetStateFile - Exception: ", e.What()));
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Reset a specific state file through the elevated scxlogfilereader server
+
+        Falls back to running scxlogfilereader for this request if the server
+        can't be used.
+
+        \param[in]     filename          Filename to scan for matches
+        \param[in]     qid               QID used for state file handling
+        \param[in]     resetOnRead       Rather than reset now, reset on next logfile read
+
+        \returns       Result status (if operation was successful or not)
+    */
+    int LogFileProvider::ResetStateFileElevated(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        int resetOnRead)
+    {
+        SCXHandle<LogFileReaderClient> server = GetElevatedServer();
+        if (NULL == server)
+        {
+            return RunResetStateFile(filename, qid, resetOnRead, true);
+        }
+
+        int status;
+        try
+        {
+            status = server->ResetLogFileState(filename, qid, resetOnRead);
+        }
+        catch (SCXCoreLib::SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider InvokeResetStateFile - Elevated server failed, running scxlogfilereader per request: ", e.What()));
+            m_serverFailureTime = time(NULL);
+            return RunResetStateFile(filename, qid, resetOnRead, true);
+        }
+
+        SCX_LOGTRACE(m_log, StrAppend(L"SCXLogFileProvider InvokeResetStateFile - Server result ", status));
+
+        if (EINTR == status)
+        {
+            throw SCXInternalErrorException(L"scxlogfilereader server failed to reset state file", SCXSRCLOCATION);
+        }
+
+        return status;
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
         Invoke the logfilereader CLI (command line) program, with elevation if needed,
@@ -235,13 +646,13 @@ namespace SCXCore {
 
         \returns       Result status (if operation was successful or not)
     */
-    int LogFileProvider::InvokeResetStateFile(
+    int LogFileProvider::RunResetStateFile(
         const std::wstring& filename,
         const std::wstring& qid,
         int resetOnRead,
         bool fPerformElevation)
     {
-        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeResetStateFile");
+        SCX_LOGTRACE(m_log, L"SCXLogFileProvider InvokeResetStateFile - Running scxlogfilereader");
 
         // Marshal our data to send along to the subprocess
 
@@ -257,28 +668,7 @@ namespace SCXCore {
         send.Write(resetOnRead);
         send.Flush();
 
-        // Test to see if we're running under testrunner.  This makes it easy
-        // to know where to launch our test program, allowing unit tests to
-        // test all the way through to the CLI.
-
-        wstring programName;
-        char *testrunFlag = getenv("SCX_TESTRUN_ACTIVE");
-        if (NULL != testrunFlag)
-        {
-            programName = L"testfiles/scxlogfilereader-test -t -r";
-        }
-        else
-        {
-            programName = L"/opt/microsoft/scx/bin/scxlogfilereader -r";
-        }
-
-        // Elevate the command if that's called for
-        SCXSystemLib::SystemInfo si;
-
-        if (fPerformElevation)
-        {
-            programName = si.GetElevatedCommand(programName);
-        }
+        wstring programName = GetLogFileReaderCommand(L"-r", fPerformElevation);
 
         // Call the log file reader (CLI) program
 
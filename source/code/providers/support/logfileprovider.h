@@ -14,17 +14,31 @@
 #ifndef LOGFILEPROVIDER_H
 #define LOGFILEPROVIDER_H
 
+#include "logfilereaderclient.h"
 #include "logfileutils.h"
 
+#include <map>
+#include <time.h>
+
 namespace SCXCore
 {
     /*----------------------------------------------------------------------------*/
     /**
        LogFile provider
+
+       Log files that can be read without elevation are read in-process. Log
+       files that need elevation are read by one long-lived, elevated
+       scxlogfilereader server (see LogFileReaderClient), falling back to
+       running scxlogfilereader once per request if the server can't be used.
     */
     class LogFileProvider
     {
     public:
+        //! Time (in seconds) to wait before retrying a failed elevated server
+        static const time_t cServerRetryInterval = 300;
+        //! Max number of files and qids whose last elevated read position is kept
+        static const size_t cMaxElevatedPositions = 100;
+
         LogFileProvider();
         LogFileProvider(SCXCoreLib::SCXHandle<LogFileReader> pReader);
         ~LogFileProvider();
@@ -39,15 +53,64 @@ namespace SCXCore
                                  const std::wstring& qid,
                                  const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
                                  bool fPerformElevation,
-                                 std::vector<std::wstring>& matchedLines);
+                                 std::vector<std::wstring>& matchedLines,
+                                 size_t maxRows = LogFileReader::cDefaultMaxRows,
+                                 size_t maxBytes = LogFileReader::cDefaultMaxBytes,
+                                 std::wstring* resumePosition = NULL);
 
         int InvokeResetStateFile(const std::wstring& filename,
                                  const std::wstring& qid,
                                  int resetOnRead,
                                  bool fPerformElevation);
 
+        //! Run scxlogfilereader once per request rather than reading in-process
+        //! or through the elevated server (the behavior of earlier versions)
+        //! \param[in] fSet  true to run scxlogfilereader once per request
+        void SetRunReaderPerRequest(bool fSet) { m_fRunReaderPerRequest = fSet; }
+
     private:
+        std::wstring GetLogFileReaderCommand(const std::wstring& option, bool fPerformElevation) const;
+        SCXCoreLib::SCXHandle<LogFileReaderClient> GetElevatedServer();
+
+        bool ReadLogFileInProcess(const std::wstring& filename,
+                                  const std::wstring& qid,
+                                  const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
+                                  std::vector<std::wstring>& matchedLines,
+                                  size_t maxRows,
+                                  size_t maxBytes,
+                                  std::wstring* resumePosition);
+        bool ReadLogFileElevated(const std::wstring& filename,
+                                 const std::wstring& qid,
+                                 const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
+                                 std::vector<std::wstring>& matchedLines,
+                                 size_t maxRows,
+                                 size_t maxBytes,
+                                 std::wstring* resumePosition);
+        bool RunLogFileReader(const std::wstring& filename,
+                              const std::wstring& qid,
+                              const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
+                              bool fPerformElevation,
+                              std::vector<std::wstring>& matchedLines,
+                              size_t maxRows,
+                              size_t maxBytes,
+                              std::wstring* resumePosition);
+
+        int ResetStateFileInProcess(const std::wstring& filename,
+                                    const std::wstring& qid,
+                                    int resetOnRead);
+        int ResetStateFileElevated(const std::wstring& filename,
+                                   const std::wstring& qid,
+                                   int resetOnRead);
+        int RunResetStateFile(const std::wstring& filename,
+                              const std::wstring& qid,
+                              int resetOnRead,
+                              bool fPerformElevation);
+
         SCXCoreLib::SCXHandle<LogFileReader> m_pLogFileReader;
+        SCXCoreLib::SCXHandle<LogFileReaderClient> m_pElevatedServer;  //!< Elevated scxlogfilereader server (started on demand)
+        time_t m_serverFailureTime;                                     //!< Time the elevated server last failed (0 if never)
+        bool m_fRunReaderPerRequest;                                    //!< Run scxlogfilereader once per request?
+        std::map<std::pair<std::wstring, std::wstring>, std::wstring> m_elevatedPositions; //!< Position following the last elevated read, per file and qid
         SCXCoreLib::SCXLogHandle m_log;
         static int ms_loadCount;
     };
@@ -23,6 +23,7 @@
 #include <unistd.h>
 
 #include "buildversion.h"
+#include "logfilereaderclient.h"
 #include "logfileutils.h"
 
 // dynamic_cast fix - wi 11220
@@ -51,13 +52,14 @@ static void show_version();
 static void PerformMarshalTest();
 static int ReadLogFile_Interactive();
 static int ReadLogFile_Provider();
+static int ReadLogFile_Server();
 static int ResetLogFileState();
 static int ResetAllLogFileStates(bool fResetOnRead);
 static void ReadLogFile_TestSetup();
 
 SCXHandle<SCXPersistMedia> s_pmedia;
 SCXCoreLib::SCXHandle<LogFileReader> s_pReader;
-wstring s_basePath;
+wstring s_basePath(L"/var/opt/microsoft/scx/lib/state/");
 
 const int EXIT_LOGIC_ERROR = 64; /* Random exit code that is not ENOENT */
 static bool s_fTestMode = false;
@@ -106,6 +108,7 @@ int main(int argc, char * const argv[])
         Reset_All_Files,
         Read_Log_File_Interactive,
         Read_Log_File,
+        Read_Log_File_Server,
         Show_Version
     } operation = UNSET;
 
@@ -116,10 +119,18 @@ int main(int argc, char * const argv[])
     // ourselves via the opterr variable.
 
     opterr = 0;                 // Disable printing errors for bad options
-    while ((c = getopt(argc, argv, "hi?g:mprtv")) != -1) {
+    while ((c = getopt(argc, argv, "dhi?g:mprtv")) != -1) {
         const char * parameter = NULL;
 
         switch(c) {
+            case 'd':                   /* Provider entry (serve requests until EOF) */
+                if (UNSET != operation)
+                {
+                    cerr << argv[0] << ": Parsing error - operation already specified (" << operation << ")" << endl;
+                    usage(argv[0], true, EXIT_LOGIC_ERROR);
+                }
+                operation = Read_Log_File_Server;
+                break;
             case 'h':                   /* Show extended help information */
                 usage(argv[0], false, 0);
                 /*NOTREACHED*/
@@ -237,6 +248,10 @@ int main(int argc, char * const argv[])
             exitStatus = ReadLogFile_Provider();
             break;
 
+        case Read_Log_File_Server:
+            exitStatus = ReadLogFile_Server();
+            break;
+
         case Show_Version:
             show_version();
             break;
@@ -273,6 +288,7 @@ static void usage(char const * const name, bool fBrief, int exitValue)
               << endl
               << L"Options:" << endl
               << L"  -h:\tDisplay detailed help information" << endl
+              << L"  -d:\tProvider server interface (for internal use only)" << endl
               << L"  -g:\tReset all log file states (for internal use only)" << endl
               << L"     \t(Requires parameter for ResetOnRead: 1/true/0/false)" << endl
               << L"  -i:\tInteractive use (for debugging purposes only)" << endl
@@ -430,6 +446,7 @@ int ReadLogFile_Interactive()
 
         s_pReader = new LogFileReader();
         s_pReader->SetPersistMedia(s_pmedia);
+        s_pReader->UseStateStore(s_basePath);
         bool bPartial = s_pReader->ReadLogFile(filename, qid, regexps,
                                                matchedLines);
 
@@ -465,10 +482,14 @@ int ReadLogFile_Interactive()
      filename:       Filename to be read
      qid:            ID (from property)
      regexps:        Regular expressions to search for
+     maxRows:        [Optional] Max number of matched lines to return
+     maxBytes:       [Optional] Max size of the matched lines to return
+     resumePosition: [Optional] Resume position to start at (with maxRows and maxBytes)
 
    Output parameters are:
      wasPartialRead: This is incomplete (more data exists to return)
      matchedLines:   Resulting lines that match the regular expressions
+     resumePosition: Resume position of this read
 
    \return Resulting status (exit status for scxlogfilereader executable)
 */
@@ -480,6 +501,7 @@ int ReadLogFile_Provider()
         ReadLogFile_TestSetup();
         logFileReader->SetPersistMedia(s_pmedia);
     }
+    logFileReader->UseStateStore(s_basePath);
 
     SCXLogHandle logH = SCXLogHandleFactory::GetLogHandle(L"scx.logfilereader.ReadLogFile");
 
@@ -488,17 +510,32 @@ int ReadLogFile_Provider()
     wstring filename;
     wstring qid;
     vector<SCXRegexWithIndex> regexps;
+    int maxRows = 0;
+    int maxBytes = 0;
+    wstring resumePosition;
 
     UnMarshal receive(cin);
     receive.Read(filename);
     receive.Read(qid);
     receive.Read(regexps);
+    if (EOF != cin.peek())
+    {
+        receive.Read(maxRows);
+        receive.Read(maxBytes);
+    }
+    if (EOF != cin.peek())
+    {
+        receive.Read(resumePosition);
+    }
 
     try
     {
         vector<wstring> matchedLines;
         bool bWasPartialRead = logFileReader->ReadLogFile(filename, qid, regexps,
-                                                          matchedLines);
+                                                          matchedLines,
+                                                          static_cast<size_t>(maxRows),
+                                                          static_cast<size_t>(maxBytes),
+                                                          &resumePosition);
 
         // Marshal the results
 
@@ -506,6 +543,7 @@ int ReadLogFile_Provider()
         Marshal send(cout);
         send.Write(wasPartialRead);
         send.Write(matchedLines);
+        send.Write(resumePosition);
         send.Flush();
     }
     catch (SCXFilePathNotFoundException& e)
@@ -525,6 +563,125 @@ int ReadLogFile_Provider()
     return 0;
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+   Implementation for provider server interface to read log files.
+
+   Like ReadLogFile_Provider() and ResetLogFileState(), but serves any number
+   of requests from STDIN until it is closed. This lets the log file provider
+   keep one (elevated) scxlogfilereader running rather than starting one per
+   request (see LogFileReaderClient).
+
+   Each request starts with the operation (LogFileReaderClient::cOperation*),
+   followed by the input parameters of that operation. Each response starts
+   with a status (what the -p or -r modes would return as exit status),
+   followed by the output parameters when the status is 0 (read requests
+   only).
+
+   \return Resulting status (exit status for scxlogfilereader executable)
+*/
+int ReadLogFile_Server()
+{
+    SCXHandle<LogFileReader> logFileReader(new LogFileReader());
+    if (s_fTestMode)
+    {
+        ReadLogFile_TestSetup();
+        logFileReader->SetPersistMedia(s_pmedia);
+    }
+    logFileReader->UseStateStore(s_basePath);
+
+    SCXLogHandle logH = SCXLogHandleFactory::GetLogHandle(L"scx.logfilereader.Server");
+
+    while (EOF != cin.peek())
+    {
+        int operation;
+        wstring filename;
+        wstring qid;
+
+        UnMarshal receive(cin);
+        receive.Read(operation);
+
+        Marshal send(cout);
+        if (LogFileReaderClient::cOperationReadLogFile == operation)
+        {
+            vector<SCXRegexWithIndex> regexps;
+            int maxRows;
+            int maxBytes;
+            wstring resumePosition;
+            receive.Read(filename);
+            receive.Read(qid);
+            receive.Read(regexps);
+            receive.Read(maxRows);
+            receive.Read(maxBytes);
+            receive.Read(resumePosition);
+
+            try
+            {
+                vector<wstring> matchedLines;
+                int wasPartialRead = logFileReader->ReadLogFile(filename, qid, regexps,
+                                                                matchedLines,
+                                                                static_cast<size_t>(maxRows),
+                                                                static_cast<size_t>(maxBytes),
+                                                                &resumePosition);
+
+                int status = 0;
+                send.Write(status);
+                send.Write(wasPartialRead);
+                send.Write(matchedLines);
+                send.Write(resumePosition);
+            }
+            catch (SCXFilePathNotFoundException& e)
+            {
+                SCX_LOGWARNING(logH, StrAppend(L"scxlogfilereader - File not found: ", filename).append(L", exception: ").append(e.What()));
+
+                int status = ENOENT;
+                send.Write(status);
+            }
+            catch (SCXException &e)
+            {
+                SCX_LOGWARNING(logH, StrAppend(L"scxlogfilereader - Unexpected exception: ", e.What()));
+
+                int status = EINTR;
+                send.Write(status);
+            }
+        }
+        else if (LogFileReaderClient::cOperationResetLogFileState == operation)
+        {
+            int resetOnRead_asint;
+            receive.Read(filename);
+            receive.Read(qid);
+            receive.Read(resetOnRead_asint);
+
+            int status;
+            try
+            {
+                status = logFileReader->ResetLogFileState(filename, qid, (resetOnRead_asint ? true : false));
+            }
+            catch (SCXFilePathNotFoundException& e)
+            {
+                SCX_LOGWARNING(logH, StrAppend(L"scxlogfilereader - File not found: ", filename).append(L", exception: ").append(e.What()));
+                status = ENOENT;
+            }
+            catch (SCXException &e)
+            {
+                SCX_LOGWARNING(logH, StrAppend(L"scxlogfilereader - Unexpected exception: ", e.What()));
+                status = EINTR;
+            }
+            send.Write(status);
+        }
+        else
+        {
+            // Out of step with the provider; it will start a new server
+            SCX_LOGWARNING(logH, StrAppend(L"scxlogfilereader - Invalid server operation: ", operation));
+            return EXIT_LOGIC_ERROR;
+        }
+
+        send.Flush();
+    }
+
+    return 0;
+}
+
 /*----------------------------------------------------------------------------*/
 /**
    Implementation for provider interface to reset the state of a log file.
@@ -551,6 +708,7 @@ int ResetLogFileState()
         ReadLogFile_TestSetup();
         logFileReader->SetPersistMedia(s_pmedia);
     }
+    logFileReader->UseStateStore(s_basePath);
 
     SCXLogHandle logH = SCXLogHandleFactory::GetLogHandle(L"scx.logfilereader.resetLogfilestate");
 
@@ -611,10 +769,7 @@ int ResetAllLogFileStates(bool fResetOnRead)
         ReadLogFile_TestSetup();
         logFileReader->SetPersistMedia(s_pmedia);
     }
-    else
-    {
-        s_basePath = L"/var/opt/microsoft/scx/lib/state/";
-    }
+    logFileReader->UseStateStore(s_basePath);
 
     return logFileReader->ResetAllLogFileStates(s_basePath, fResetOnRead);
 }
@@ -0,0 +1,481 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilereaderclient.cpp
+
+    \brief     Client side of the scxlogfilereader server mode
+
+    \date      2026-10-17 10:00:00
+
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxmarshal.h>
+#include <scxcorelib/stringaid.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "logfilereaderclient.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    // Don't let a server that went away raise SIGPIPE in the agent
+#if defined(MSG_NOSIGNAL)
+    const int cSendFlags = MSG_NOSIGNAL;
+#else
+    const int cSendFlags = 0;
+#endif
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] fd  Socket to read from and write to (not owned)
+    */
+    LogFileReaderStreamBuf::LogFileReaderStreamBuf(int fd) :
+        m_fd(fd),
+        m_timedOut(false)
+    {
+        setg(m_inBuffer, m_inBuffer, m_inBuffer);
+        // Leave room for the character passed to overflow()
+        setp(m_outBuffer, m_outBuffer + sizeof(m_outBuffer) - 1);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Refill the input buffer from the socket
+
+       \returns  Next character, or EOF if the socket is closed, failed or timed out
+    */
+    LogFileReaderStreamBuf::int_type LogFileReaderStreamBuf::underflow()
+    {
+        if (gptr() < egptr())
+        {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        ssize_t count;
+        do
+        {
+            count = recv(m_fd, m_inBuffer, sizeof(m_inBuffer), 0);
+        } while (count < 0 && EINTR == errno);
+
+        if (count <= 0)
+        {
+            m_timedOut = count < 0 && (EAGAIN == errno || EWOULDBLOCK == errno);
+            return traits_type::eof();
+        }
+
+        setg(m_inBuffer, m_inBuffer, m_inBuffer + count);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Send the output buffer when it is full
+
+       \param[in] c  Character that didn't fit in the buffer (or EOF)
+       \returns  Anything but EOF on success, EOF on failure
+    */
+    LogFileReaderStreamBuf::int_type LogFileReaderStreamBuf::overflow(int_type c)
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+
+        return FlushOutput() ? traits_type::not_eof(c) : traits_type::eof();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Send any buffered output
+
+       \returns  0 on success, -1 on failure
+    */
+    int LogFileReaderStreamBuf::sync()
+    {
+        return FlushOutput() ? 0 : -1;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write the output buffer to the socket
+
+       \returns  true on success, false if the socket failed or timed out
+    */
+    bool LogFileReaderStreamBuf::FlushOutput()
+    {
+        const char* data = pbase();
+        size_t remaining = pptr() - pbase();
+
+        while (remaining > 0)
+        {
+            ssize_t count = send(m_fd, data, remaining, cSendFlags);
+            if (count < 0)
+            {
+                if (EINTR == errno)
+                {
+                    continue;
+                }
+                m_timedOut = EAGAIN == errno || EWOULDBLOCK == errno;
+                return false;
+            }
+
+            data += count;
+            remaining -= count;
+        }
+
+        setp(m_outBuffer, m_outBuffer + sizeof(m_outBuffer) - 1);
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       The server isn't started until the first request is made.
+
+       \param[in] command  Command line starting scxlogfilereader in server mode
+                           (including any elevation)
+       \param[in] timeout  Time (in seconds) the server may stay silent during a request
+    */
+    LogFileReaderClient::LogFileReaderClient(const std::wstring& command, unsigned int timeout) :
+        m_command(command),
+        m_timeout(timeout),
+        m_pid(0),
+        m_fd(-1)
+    {
+        m_log = SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.logfileprovider.client");
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Destructor - stops the server if it is running
+    */
+    LogFileReaderClient::~LogFileReaderClient()
+    {
+        Stop();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Ask the server to read a log file (see LogFileReader::ReadLogFile)
+
+       \param[in]     filename          Filename to scan for matches
+       \param[in]     qid               QID used for state file handling
+       \param[in]     regexps           List of regular expressions to look for
+       \param[out]    wasPartialRead    Set if more matches exist than were returned
+       \param[out]    matchedLines      Resulting matched lines, if any, from log file
+       \param[in]     maxRows           Max number of matched lines to return
+       \param[in]     maxBytes          Max size of the matched lines to return
+       \param[in,out] resumePosition    Resume position to start at, and of this read
+                                        (see LogFileReader::ReadLogFile), or NULL
+
+       \returns       0 on success, ENOENT if the log file doesn't exist, EINTR
+                      if the server failed to read the log file
+       \throws        SCXException if the server can't be reached
+    */
+    int LogFileReaderClient::ReadLogFile(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        const std::vector<SCXRegexWithIndex>& regexps,
+        bool& wasPartialRead,
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows /* = LogFileReader::cDefaultMaxRows */,
+        size_t maxBytes /* = LogFileReader::cDefaultMaxBytes */,
+        std::wstring* resumePosition /* = NULL */)
+    {
+        if (!IsRunning())
+        {
+            Start();
+        }
+
+        try
+        {
+            int operation = cOperationReadLogFile;
+            std::wstring position(NULL != resumePosition ? *resumePosition : L"");
+            Marshal send(*m_stream);
+            send.Write(operation);
+            send.Write(filename);
+            send.Write(qid);
+            send.Write(regexps);
+            int maxRows_asint = static_cast<int>(maxRows);
+            int maxBytes_asint = static_cast<int>(maxBytes);
+            send.Write(maxRows_asint);
+            send.Write(maxBytes_asint);
+            send.Write(position);
+            send.Flush();
+            CheckStream(L"ReadLogFile request");
+
+            int status = -1;
+            UnMarshal receive(*m_stream);
+            receive.Read(status);
+            if (0 == status)
+            {
+                // Note that we can't marshal/unmarshal a bool, so we treat as int
+                int partialRead = 0;
+                receive.Read(partialRead);
+                receive.Read(matchedLines);
+                receive.Read(position);
+                wasPartialRead = (0 != partialRead);
+            }
+            CheckStream(L"ReadLogFile response");
+
+            // Only once the response is complete: the caller retries from the same position otherwise
+            if (0 == status && NULL != resumePosition)
+            {
+                *resumePosition = position;
+            }
+
+            return status;
+        }
+        catch (SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileReaderClient ReadLogFile - Exception: ", e.What()));
+            Stop();
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Ask the server to reset the state of a log file (see LogFileReader::ResetLogFileState)
+
+       \param[in]     filename          Filename to reset the state for
+       \param[in]     qid               QID used for state file handling
+       \param[in]     resetOnRead       Rather than reset now, reset on next logfile read
+
+       \returns       Result of the reset, ENOENT if the log file doesn't exist,
+                      EINTR if the server failed to reset the state
+       \throws        SCXException if the server can't be reached
+    */
+    int LogFileReaderClient::ResetLogFileState(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        int resetOnRead)
+    {
+        if (!IsRunning())
+        {
+            Start();
+        }
+
+        try
+        {
+            int operation = cOperationResetLogFileState;
+            Marshal send(*m_stream);
+            send.Write(operation);
+            send.Write(filename);
+            send.Write(qid);
+            send.Write(resetOnRead);
+            send.Flush();
+            CheckStream(L"ResetLogFileState request");
+
+            int status = -1;
+            UnMarshal receive(*m_stream);
+            receive.Read(status);
+            CheckStream(L"ResetLogFileState response");
+
+            return status;
+        }
+        catch (SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileReaderClient ResetLogFileState - Exception: ", e.What()));
+            Stop();
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Start the server, connected to us through a socket pair
+
+       \throws  SCXErrnoException if the socket or the process can't be created
+    */
+    void LogFileReaderClient::Start()
+    {
+        SCX_LOGTRACE(m_log, StrAppend(L"LogFileReaderClient Start - Running ", m_command));
+
+        ReapStoppedServers();
+
+        // Everything the child needs is prepared before fork(); only
+        // async-signal-safe calls may be made in the child of a threaded process
+        std::string command = StrToMultibyte(m_command);
+
+        // None of the descriptors may leak into processes forked by other threads
+        // (like RunAs commands): a copy of the server end of the socket would keep
+        // the server from seeing EOF when we stop it. dup2() clears the flag for
+        // the standard descriptors of the server.
+        int fds[2];
+#if defined(SOCK_CLOEXEC)
+        if (0 != socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds))
+#else
+        if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fds))
+#endif
+        {
+            throw SCXErrnoException(L"socketpair", errno, SCXSRCLOCATION);
+        }
+#if !defined(SOCK_CLOEXEC)
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+#if defined(SO_NOSIGPIPE)
+        int on = 1;
+        setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        // A hung server makes our calls fail instead of blocking (see CheckStream())
+        struct timeval timeout;
+        timeout.tv_sec = m_timeout;
+        timeout.tv_usec = 0;
+        setsockopt(fds[0], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+#if defined(O_CLOEXEC)
+        int devNull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+#else
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0)
+        {
+            fcntl(devNull, F_SETFD, FD_CLOEXEC);
+        }
+#endif
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            int forkErrno = errno;
+            close(fds[0]);
+            close(fds[1]);
+            if (devNull >= 0)
+            {
+                close(devNull);
+            }
+            throw SCXErrnoException(L"fork", forkErrno, SCXSRCLOCATION);
+        }
+
+        if (0 == pid)
+        {
+            // Child: the server talks to us over standard input and output
+            dup2(fds[1], STDIN_FILENO);
+            dup2(fds[1], STDOUT_FILENO);
+            if (devNull >= 0)
+            {
+                dup2(devNull, STDERR_FILENO);
+            }
+            execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(NULL));
+            _exit(127);
+        }
+
+        close(fds[1]);
+        if (devNull >= 0)
+        {
+            close(devNull);
+        }
+
+        m_pid = pid;
+        m_fd = fds[0];
+        m_buf = new LogFileReaderStreamBuf(m_fd);
+        m_stream = new std::iostream(m_buf.GetData());
+
+        SCX_LOGTRACE(m_log, StrAppend(L"LogFileReaderClient Start - Started server with PID ", m_pid));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Stop the server
+
+       Closing the socket makes the server exit once it is done with the
+       current request. We can't signal the server since it may run with
+       elevated privileges, and the caller holds the provider lock, so we
+       don't wait for it: a server that hasn't exited yet is reaped by a
+       later call (see ReapStoppedServers()).
+    */
+    void LogFileReaderClient::Stop()
+    {
+        if (!IsRunning())
+        {
+            return;
+        }
+
+        m_stream = NULL;
+        m_buf = NULL;
+        close(m_fd);
+        m_fd = -1;
+
+        m_stoppedPids.push_back(m_pid);
+        m_pid = 0;
+
+        ReapStoppedServers();
+        if (!m_stoppedPids.empty())
+        {
+            SCX_LOGTRACE(m_log, StrAppend(L"LogFileReaderClient Stop - Servers not exited yet: ", m_stoppedPids.size()));
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Reap the stopped servers that have exited since, without waiting for the others
+    */
+    void LogFileReaderClient::ReapStoppedServers()
+    {
+        std::vector<pid_t>::iterator it = m_stoppedPids.begin();
+        while (it != m_stoppedPids.end())
+        {
+            pid_t result = waitpid(*it, NULL, WNOHANG);
+            if (0 == result || (result < 0 && EINTR == errno))
+            {
+                ++it;
+            }
+            else
+            {
+                // Reaped, or already reaped elsewhere (ECHILD, as when SIGCHLD is ignored)
+                it = m_stoppedPids.erase(it);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Verify that the conversation with the server is still intact
+
+       \param[in] operation  Description of what was done (for the error message)
+       \throws    SCXInternalErrorException if the server went away or didn't respond in time
+    */
+    void LogFileReaderClient::CheckStream(const wchar_t* operation)
+    {
+        if (m_buf->TimedOut())
+        {
+            throw SCXInternalErrorException(
+                StrAppend(StrAppend(std::wstring(L"scxlogfilereader did not respond during ").append(operation),
+                                    L" within (s): "), m_timeout),
+                SCXSRCLOCATION);
+        }
+
+        if (!m_stream->good())
+        {
+            throw SCXInternalErrorException(
+                std::wstring(L"Lost connection to scxlogfilereader during ").append(operation),
+                SCXSRCLOCATION);
+        }
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,141 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilereaderclient.h
+
+    \brief     Client side of the scxlogfilereader server mode
+
+    \date      2026-10-17 10:00:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef LOGFILEREADERCLIENT_H
+#define LOGFILEREADERCLIENT_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxlog.h>
+#include <scxcorelib/scxregex.h>
+
+#include "logfileutils.h"
+
+#include <iostream>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Stream buffer reading from and writing to a socket
+
+       The socket is expected to have receive and send timeouts: a call that
+       times out fails the stream, like a closed socket, and is remembered so
+       the client can tell a hung server from a dead one.
+    */
+    class LogFileReaderStreamBuf : public std::streambuf
+    {
+    public:
+        explicit LogFileReaderStreamBuf(int fd);
+
+        //! Did a receive or a send time out?
+        //! \returns true if the stream failed because the server didn't respond in time
+        bool TimedOut() const { return m_timedOut; }
+
+    protected:
+        virtual int_type underflow();
+        virtual int_type overflow(int_type c);
+        virtual int sync();
+
+    private:
+        bool FlushOutput();
+
+        int m_fd;                       //!< Socket connected to the server
+        bool m_timedOut;                //!< Did a receive or a send time out?
+        char m_inBuffer[4096];          //!< Data received but not yet consumed
+        char m_outBuffer[4096];         //!< Data not yet sent
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Client of a long-lived scxlogfilereader running in server mode (-d)
+
+       Running scxlogfilereader once per request means one fork/exec (and, for
+       elevated requests, one sudo) for every GetMatchedRows call. Instead, the
+       server is started once and then serves any number of requests over a
+       socket, using the same Marshal/UnMarshal encoding as the -p and -r
+       modes. Each request starts with the operation (cOperationReadLogFile or
+       cOperationResetLogFileState), followed by the parameters of that
+       operation; each response starts with a status (0, ENOENT or EINTR, as
+       the exit codes of the -p and -r modes), followed by the results.
+
+       The server exits when the socket is closed. If the server dies, stops
+       responding (nothing is received or sent for the timeout), or the
+       conversation gets out of step, the client stops the server and throws;
+       the next request starts a new server. A stopped server is reaped once
+       it has exited, by a later call, so stopping never waits for it. Callers hold the provider lock
+       while waiting, so a hung server must not block them for good.
+
+       This class is not thread safe; callers serialize requests.
+    */
+    class LogFileReaderClient
+    {
+    public:
+        //! Operation code of a ReadLogFile request
+        static const int cOperationReadLogFile = 'p';
+        //! Operation code of a ResetLogFileState request
+        static const int cOperationResetLogFileState = 'r';
+        //! Default time (in seconds) the server may stay silent during a request
+        static const unsigned int cDefaultTimeout = 120;
+
+        explicit LogFileReaderClient(const std::wstring& command, unsigned int timeout = cDefaultTimeout);
+        ~LogFileReaderClient();
+
+        int ReadLogFile(const std::wstring& filename,
+                        const std::wstring& qid,
+                        const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
+                        bool& wasPartialRead,
+                        std::vector<std::wstring>& matchedLines,
+                        size_t maxRows = LogFileReader::cDefaultMaxRows,
+                        size_t maxBytes = LogFileReader::cDefaultMaxBytes,
+                        std::wstring* resumePosition = NULL);
+
+        int ResetLogFileState(const std::wstring& filename,
+                              const std::wstring& qid,
+                              int resetOnRead);
+
+        //! Is the server currently running?
+        //! \returns true if the server has been started and not stopped since
+        bool IsRunning() const { return m_pid > 0; }
+
+        //! Process ID of the server (for test purposes)
+        //! \returns PID, or 0 if the server isn't running
+        pid_t GetPid() const { return m_pid; }
+
+        void Stop();
+        void ReapStoppedServers();
+
+        //! Number of stopped servers that haven't been reaped yet (for test purposes)
+        //! \returns Number of servers left to reap
+        size_t GetStoppedServerCount() const { return m_stoppedPids.size(); }
+
+    private:
+        void Start();
+        void CheckStream(const wchar_t* operation);
+
+        std::wstring m_command;                                 //!< Command line starting the server
+        unsigned int m_timeout;                                 //!< Time (s) the server may stay silent
+        pid_t m_pid;                                            //!< Process ID of the server
+        std::vector<pid_t> m_stoppedPids;                       //!< Stopped servers not reaped yet
+        int m_fd;                                               //!< Socket connected to the server
+        SCXCoreLib::SCXHandle<LogFileReaderStreamBuf> m_buf;    //!< Buffer on top of m_fd
+        SCXCoreLib::SCXHandle<std::iostream> m_stream;          //!< Stream on top of m_buf
+        SCXCoreLib::SCXLogHandle m_log;                         //!< Log handle
+    };
+}
+
+#endif /* LOGFILEREADERCLIENT_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,700 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilestatestore.cpp
+
+    \brief     Journal holding the positions of all log files read
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxuser.h>
+#include <scxcorelib/stringaid.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logfilestatestore.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Name of the journal in the state directory
+    const wchar_t* const cJournalName = L"LogFileProvider.journal";
+
+    //! Size of the chunks the journal is read in
+    const size_t cReadChunkSize = 64 * 1024;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Escape the characters that have a meaning in journal lines
+
+       \param[in] str  String to escape
+       \returns   Escaped string
+    */
+    std::wstring Escape(const std::wstring& str)
+    {
+        std::wstring result;
+        result.reserve(str.size());
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            switch (str[i])
+            {
+            case L'\\': result.append(L"\\\\"); break;
+            case L'\t': result.append(L"\\t"); break;
+            case L'\n': result.append(L"\\n"); break;
+            default:    result += str[i]; break;
+            }
+        }
+        return result;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Reverse Escape()
+
+       \param[in] str  Escaped string
+       \returns   Original string
+    */
+    std::wstring Unescape(const std::wstring& str)
+    {
+        std::wstring result;
+        result.reserve(str.size());
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            if (L'\\' == str[i] && i + 1 < str.size())
+            {
+                i++;
+                result += (L't' == str[i]) ? L'\t' : (L'n' == str[i]) ? L'\n' : str[i];
+            }
+            else
+            {
+                result += str[i];
+            }
+        }
+        return result;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write all of a buffer to a file
+
+       \param[in] fd      File to write to
+       \param[in] data    Data to write
+       \param[in] length  Length of the data
+       \throws    SCXErrnoException if the write fails
+    */
+    void WriteAll(int fd, const char* data, size_t length)
+    {
+        while (length > 0)
+        {
+            ssize_t count = write(fd, data, length);
+            if (count < 0)
+            {
+                if (EINTR == errno)
+                {
+                    continue;
+                }
+                throw SCXErrnoException(L"write", errno, SCXSRCLOCATION);
+            }
+            data += count;
+            length -= count;
+        }
+    }
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the path of the journal for the current user
+
+       Like SCXFilePersistMedia, users other than root keep their state in a
+       subdirectory of the base path.
+
+       \param[in] basePath  State directory (as set on SCXFilePersistMedia)
+       \returns   Path of the journal
+    */
+    SCXFilePath LogFileStateStore::GetJournalPath(const std::wstring& basePath)
+    {
+        SCXFilePath path(basePath);
+        SCXUser user;
+
+        if (!user.IsRoot())
+        {
+            path.AppendDirectory(user.GetName());
+        }
+        path.SetFilename(cJournalName);
+        return path;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       The journal isn't opened until Open() or the first access.
+
+       \param[in] path  Path of the journal
+    */
+    LogFileStateStore::LogFileStateStore(const SCXFilePath& path) :
+        m_Path(path),
+        m_fd(-1),
+        m_ReadOffset(0),
+        m_CompactedSize(0),
+        m_Unsynced(0),
+        m_LastSync(time(NULL))
+    {
+        m_log = SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.logfileprovider.statestore");
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Destructor - syncs any outstanding changes and closes the journal
+    */
+    LogFileStateStore::~LogFileStateStore()
+    {
+        if (m_fd >= 0)
+        {
+            if (m_Unsynced > 0)
+            {
+                fsync(m_fd);
+            }
+            close(m_fd);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Open the journal (creating it if needed), and read it
+
+       \throws  SCXErrnoException if the journal can't be opened or read
+    */
+    void LogFileStateStore::Open()
+    {
+        LockAndRefresh();
+        Unlock();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the state of a log file and qid
+
+       \param[in]  logfile  Log file
+       \param[in]  qid      QID
+       \param[out] entry    State (untouched if none is stored)
+       \returns    true if a state is stored
+       \throws     SCXErrnoException if the journal can't be read
+    */
+    bool LogFileStateStore::Get(const std::wstring& logfile, const std::wstring& qid, Entry& entry)
+    {
+        LockAndRefresh();
+        Unlock();
+
+        std::map<Key, Entry>::const_iterator it = m_Entries.find(Key(logfile, qid));
+        if (m_Entries.end() == it)
+        {
+            return false;
+        }
+
+        entry = it->second;
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Store the state of a log file and qid
+
+       \param[in] logfile  Log file
+       \param[in] qid      QID
+       \param[in] entry    State
+       \throws    SCXErrnoException if the journal can't be written
+    */
+    void LogFileStateStore::Put(const std::wstring& logfile, const std::wstring& qid, const Entry& entry)
+    {
+        Key key(logfile, qid);
+
+        LockAndRefresh();
+        try
+        {
+            Append(FormatPut(key, entry));
+            m_Entries[key] = entry;
+            CompactIfNeeded();
+        }
+        catch (SCXException&)
+        {
+            Unlock();
+            throw;
+        }
+        Unlock();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove the state of a log file and qid
+
+       \param[in] logfile  Log file
+       \param[in] qid      QID
+       \returns   false if no state was stored
+       \throws    SCXErrnoException if the journal can't be written
+    */
+    bool LogFileStateStore::Remove(const std::wstring& logfile, const std::wstring& qid)
+    {
+        Key key(logfile, qid);
+        bool found = false;
+
+        LockAndRefresh();
+        try
+        {
+            found = (m_Entries.erase(key) > 0);
+            if (found)
+            {
+                Append(FormatRemove(key));
+            }
+        }
+        catch (SCXException&)
+        {
+            Unlock();
+            throw;
+        }
+        Unlock();
+
+        return found;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the log files and qids that have a state
+
+       \param[out] keys  Log files and qids
+       \throws     SCXErrnoException if the journal can't be read
+    */
+    void LogFileStateStore::GetKeys(std::vector<Key>& keys)
+    {
+        LockAndRefresh();
+        Unlock();
+
+        keys.clear();
+        for (std::map<Key, Entry>::const_iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+        {
+            keys.push_back(it->first);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Sync the changes written so far to disk
+    */
+    void LogFileStateStore::Sync()
+    {
+        if (m_fd >= 0 && m_Unsynced > 0)
+        {
+            if (0 != fsync(m_fd))
+            {
+                SCX_LOGWARNING(m_log, StrAppend(L"LogFileStateStore Sync - fsync failed, errno: ", errno));
+            }
+        }
+
+        m_Unsynced = 0;
+        m_LastSync = time(NULL);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Rewrite the journal with only the current state of each log file and qid
+
+       The new journal is written to a temporary file, synced, and renamed over
+       the old one, so the journal is complete at any time. Other processes
+       notice the new journal the next time they lock it.
+
+       \throws  SCXErrnoException if the new journal can't be written
+    */
+    void LogFileStateStore::Compact()
+    {
+        LockAndRefresh();
+        std::string tmpPath = StrToMultibyte(m_Path.Get()) + StrToMultibyte(StrAppend(L".", getpid())) + ".tmp";
+        int fd = -1;
+
+        try
+        {
+            std::string contents;
+            for (std::map<Key, Entry>::const_iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+            {
+                contents.append(FormatPut(it->first, it->second));
+            }
+
+            fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+            if (fd < 0)
+            {
+                throw SCXErrnoException(L"open", errno, SCXSRCLOCATION);
+            }
+            WriteAll(fd, contents.c_str(), contents.size());
+            if (0 != fsync(fd))
+            {
+                throw SCXErrnoException(L"fsync", errno, SCXSRCLOCATION);
+            }
+            close(fd);
+            fd = -1;
+
+            if (0 != rename(tmpPath.c_str(), StrToMultibyte(m_Path.Get()).c_str()))
+            {
+                throw SCXErrnoException(L"rename", errno, SCXSRCLOCATION);
+            }
+
+            SCX_LOGTRACE(m_log, StrAppend(StrAppend(L"LogFileStateStore Compact - Compacted from ", m_ReadOffset),
+                                          L" to ").append(StrFrom(contents.size())));
+
+            // Closing the old journal also releases our lock on it
+            std::map<Key, Entry> entries;
+            entries.swap(m_Entries);
+            Reopen();
+            m_Entries.swap(entries);
+            m_ReadOffset = static_cast<off_t>(contents.size());
+            m_CompactedSize = m_ReadOffset;
+            m_Unsynced = 0;
+            m_LastSync = time(NULL);
+        }
+        catch (SCXException&)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            unlink(tmpPath.c_str());
+            Unlock();
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       (Re)open the journal, forgetting everything read so far
+
+       \throws  SCXErrnoException if the journal can't be opened
+    */
+    void LogFileStateStore::Reopen()
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+            m_fd = -1;
+        }
+        m_Entries.clear();
+        m_ReadOffset = 0;
+        m_CompactedSize = 0;
+
+        std::string path = StrToMultibyte(m_Path.Get());
+        int fd = open(path.c_str(), O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (fd < 0 && ENOENT == errno)
+        {
+            // The per-user state directory may not have been created yet
+            mkdir(StrToMultibyte(m_Path.GetDirectory()).c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+            fd = open(path.c_str(), O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        }
+        if (fd < 0)
+        {
+            throw SCXErrnoException(L"open", errno, SCXSRCLOCATION);
+        }
+
+        // Don't leak the journal into scxlogfilereader processes started by the provider
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        m_fd = fd;
+
+        // Assume the journal was compacted when written (it grows at most
+        // cCompactFactor times before it is compacted again)
+        struct stat fdStat;
+        if (0 == fstat(m_fd, &fdStat))
+        {
+            m_CompactedSize = fdStat.st_size;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Lock the journal
+
+       If the journal was replaced (compacted by another process) or removed
+       since it was opened, the current journal is opened instead.
+
+       \throws  SCXErrnoException if the journal can't be opened or locked
+    */
+    void LogFileStateStore::Lock()
+    {
+        std::string path = StrToMultibyte(m_Path.Get());
+
+        for (;;)
+        {
+            if (m_fd < 0)
+            {
+                Reopen();
+            }
+
+            struct flock lock;
+            memset(&lock, 0, sizeof(lock));
+            lock.l_type = F_WRLCK;
+            lock.l_whence = SEEK_SET;
+            while (0 != fcntl(m_fd, F_SETLKW, &lock))
+            {
+                if (EINTR != errno)
+                {
+                    throw SCXErrnoException(L"fcntl", errno, SCXSRCLOCATION);
+                }
+            }
+
+            struct stat pathStat;
+            struct stat fdStat;
+            if (0 == stat(path.c_str(), &pathStat) && 0 == fstat(m_fd, &fdStat)
+                && pathStat.st_dev == fdStat.st_dev && pathStat.st_ino == fdStat.st_ino)
+            {
+                return;
+            }
+
+            Unlock();
+            Reopen();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Lock the journal and apply what other processes appended to it
+
+       \throws  SCXErrnoException if the journal can't be opened, locked or read
+                (the journal is unlocked then)
+    */
+    void LogFileStateStore::LockAndRefresh()
+    {
+        Lock();
+        try
+        {
+            Refresh();
+        }
+        catch (SCXException&)
+        {
+            Unlock();
+            throw;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Unlock the journal
+    */
+    void LogFileStateStore::Unlock()
+    {
+        if (m_fd >= 0)
+        {
+            struct flock lock;
+            memset(&lock, 0, sizeof(lock));
+            lock.l_type = F_UNLCK;
+            lock.l_whence = SEEK_SET;
+            fcntl(m_fd, F_SETLK, &lock);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Apply what other processes appended to the journal since it was last read
+
+       Called with the journal locked. A last line without terminator is left
+       for later (it can only be the remains of a failed write).
+
+       \throws  SCXErrnoException if the journal can't be read
+    */
+    void LogFileStateStore::Refresh()
+    {
+        struct stat fdStat;
+        if (0 != fstat(m_fd, &fdStat))
+        {
+            throw SCXErrnoException(L"fstat", errno, SCXSRCLOCATION);
+        }
+
+        if (fdStat.st_size < m_ReadOffset)
+        {
+            // Truncated: start over
+            m_Entries.clear();
+            m_ReadOffset = 0;
+        }
+
+        std::string pending;
+        std::vector<char> buffer(cReadChunkSize);
+        off_t offset = m_ReadOffset;
+
+        while (offset < fdStat.st_size)
+        {
+            ssize_t count = pread(m_fd, &buffer[0], buffer.size(), offset);
+            if (count < 0)
+            {
+                if (EINTR == errno)
+                {
+                    continue;
+                }
+                throw SCXErrnoException(L"pread", errno, SCXSRCLOCATION);
+            }
+            if (0 == count)
+            {
+                break;
+            }
+            offset += count;
+            pending.append(&buffer[0], count);
+
+            size_t begin = 0;
+            size_t end;
+            while (std::string::npos != (end = pending.find('\n', begin)))
+            {
+                Apply(pending.substr(begin, end - begin));
+                begin = end + 1;
+            }
+            m_ReadOffset += begin;
+            pending.erase(0, begin);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Append a line to the journal
+
+       Called with the journal locked, and after Refresh().
+
+       \param[in] line  Line to append (including terminator)
+       \throws    SCXErrnoException if the journal can't be written
+    */
+    void LogFileStateStore::Append(const std::string& line)
+    {
+        struct stat fdStat;
+        if (0 != fstat(m_fd, &fdStat))
+        {
+            throw SCXErrnoException(L"fstat", errno, SCXSRCLOCATION);
+        }
+
+        // Terminate the remains of a failed write, so they don't spoil this line
+        std::string data;
+        if (fdStat.st_size > 0)
+        {
+            char last = '\n';
+            if (1 == pread(m_fd, &last, 1, fdStat.st_size - 1) && '\n' != last)
+            {
+                data = "\n";
+            }
+        }
+        data.append(line);
+
+        WriteAll(m_fd, data.c_str(), data.size());
+
+        // No need to read back our own line, unless something else is pending
+        if (m_ReadOffset == fdStat.st_size)
+        {
+            m_ReadOffset += static_cast<off_t>(data.size());
+        }
+
+        m_Unsynced++;
+        if (m_Unsynced >= cSyncBatch || time(NULL) - m_LastSync >= cSyncInterval)
+        {
+            Sync();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Compact the journal if it has grown well beyond its live contents
+
+       Called with the journal locked, and after Refresh().
+
+       \throws  SCXErrnoException if the new journal can't be written
+    */
+    void LogFileStateStore::CompactIfNeeded()
+    {
+        struct stat fdStat;
+        if (0 == fstat(m_fd, &fdStat)
+            && fdStat.st_size >= cCompactMinSize
+            && fdStat.st_size >= cCompactFactor * m_CompactedSize)
+        {
+            // Compact() locks again, which is a no-op for a lock we already hold
+            Compact();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Apply one line of the journal to the current state
+
+       Lines that can't be parsed are ignored.
+
+       \param[in] line  Line (without terminator)
+    */
+    void LogFileStateStore::Apply(const std::string& line)
+    {
+        try
+        {
+            std::vector<std::wstring> fields;
+            StrTokenize(StrFromUTF8(line), fields, L"\t", false, true);
+
+            if (7 == fields.size() && L"P" == fields[0])
+            {
+                Entry entry;
+                entry.resetOnRead = (0 != StrToULong(fields[1]));
+                entry.pos = static_cast<std::streamoff>(StrToULong(fields[2]));
+                entry.stIno = StrToULong(fields[3]);
+                entry.stSize = StrToULong(fields[4]);
+                m_Entries[Key(Unescape(fields[5]), Unescape(fields[6]))] = entry;
+            }
+            else if (3 == fields.size() && L"D" == fields[0])
+            {
+                m_Entries.erase(Key(Unescape(fields[1]), Unescape(fields[2])));
+            }
+            else if (!line.empty())
+            {
+                SCX_LOGWARNING(m_log, L"LogFileStateStore Apply - Ignoring invalid line");
+            }
+        }
+        catch (SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileStateStore Apply - Ignoring invalid line: ", e.What()));
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Format a journal line storing a state
+
+       \param[in] key    Log file and qid
+       \param[in] entry  State
+       \returns   Journal line (UTF-8, including terminator)
+    */
+    std::string LogFileStateStore::FormatPut(const Key& key, const Entry& entry)
+    {
+        std::wstring line(L"P\t");
+        line.append(entry.resetOnRead ? L"1" : L"0").append(L"\t")
+            .append(StrFrom(static_cast<scxulong>(entry.pos))).append(L"\t")
+            .append(StrFrom(entry.stIno)).append(L"\t")
+            .append(StrFrom(entry.stSize)).append(L"\t")
+            .append(Escape(key.first)).append(L"\t")
+            .append(Escape(key.second)).append(L"\n");
+        return StrToUTF8(line);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Format a journal line removing a state
+
+       \param[in] key  Log file and qid
+       \returns   Journal line (UTF-8, including terminator)
+    */
+    std::string LogFileStateStore::FormatRemove(const Key& key)
+    {
+        std::wstring line(L"D\t");
+        line.append(Escape(key.first)).append(L"\t")
+            .append(Escape(key.second)).append(L"\n");
+        return StrToUTF8(line);
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
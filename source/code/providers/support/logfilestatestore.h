@@ -0,0 +1,114 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      logfilestatestore.h
+
+    \brief     Journal holding the positions of all log files read
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef LOGFILESTATESTORE_H
+#define LOGFILESTATESTORE_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxfilepath.h>
+#include <scxcorelib/scxlog.h>
+
+#include <ios>
+#include <map>
+#include <string>
+#include <sys/types.h>
+#include <time.h>
+#include <utility>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Single store for the state (LogFilePositionRecord) of every log file and qid
+
+       Persisting each record through SCXPersistMedia means writing a separate
+       file for every log file and qid on every read. Instead, all records of
+       a user are kept in one journal file: every change appends one line, and
+       the journal is rewritten (to a temporary file that is then renamed over
+       it) once it has grown well beyond its live contents. Changes are written
+       immediately, so other processes (the provider and scxlogfilereader)
+       see them, but only synced to disk every cSyncBatch changes or
+       cSyncInterval seconds, and when the store is destroyed.
+
+       Journal lines are tab separated, in UTF-8:
+         P <reset> <pos> <st_ino> <st_size> <log file> <qid>    record changed
+         D <log file> <qid>                                     record removed
+
+       All access to the journal is done under an fcntl() lock, so several
+       processes can share it. The store itself is not thread safe.
+    */
+    class LogFileStateStore
+    {
+    public:
+        //! State of one log file and qid
+        struct Entry
+        {
+            Entry() : resetOnRead(false), pos(0), stIno(0), stSize(0) { }
+
+            bool resetOnRead;           //!< ResetOnRead flag
+            std::streamoff pos;         //!< Position following the last read
+            scxulong stIno;             //!< st_ino of the log file
+            scxulong stSize;            //!< st_size of the log file
+        };
+
+        //! Key of an entry: log file and qid
+        typedef std::pair<std::wstring, std::wstring> Key;
+
+        static const size_t cSyncBatch = 64;            //!< Changes between syncs
+        static const time_t cSyncInterval = 5;          //!< Max seconds between syncs
+        static const off_t cCompactMinSize = 64 * 1024; //!< Journals smaller than this aren't compacted
+        static const off_t cCompactFactor = 4;          //!< Compact when this many times the compacted size
+
+        static SCXCoreLib::SCXFilePath GetJournalPath(const std::wstring& basePath);
+
+        explicit LogFileStateStore(const SCXCoreLib::SCXFilePath& path);
+        ~LogFileStateStore();
+
+        void Open();
+        bool Get(const std::wstring& logfile, const std::wstring& qid, Entry& entry);
+        void Put(const std::wstring& logfile, const std::wstring& qid, const Entry& entry);
+        bool Remove(const std::wstring& logfile, const std::wstring& qid);
+        void GetKeys(std::vector<Key>& keys);
+        void Sync();
+        void Compact();
+
+        //! Path of the journal
+        //! \returns Path
+        const SCXCoreLib::SCXFilePath& GetPath() const { return m_Path; }
+
+    private:
+        void Reopen();
+        void Lock();
+        void LockAndRefresh();
+        void Unlock();
+        void Refresh();
+        void Append(const std::string& line);
+        void CompactIfNeeded();
+        void Apply(const std::string& line);
+
+        static std::string FormatPut(const Key& key, const Entry& entry);
+        static std::string FormatRemove(const Key& key);
+
+        SCXCoreLib::SCXFilePath m_Path;     //!< Path of the journal
+        int m_fd;                           //!< Journal (opened for append), or -1
+        off_t m_ReadOffset;                 //!< Journal contents applied to m_Entries so far
+        off_t m_CompactedSize;              //!< Size of the journal when last compacted
+        std::map<Key, Entry> m_Entries;     //!< Current state of all log files and qids
+        size_t m_Unsynced;                  //!< Changes written since the last sync
+        time_t m_LastSync;                  //!< Time of the last sync
+        SCXCoreLib::SCXLogHandle m_log;     //!< Log handle
+    };
+}
+
+#endif /* LOGFILESTATESTORE_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
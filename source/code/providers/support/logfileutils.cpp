@@ -14,9 +14,15 @@
 #include <scxcorelib/scxcmn.h>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <locale>
+#include <set>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <scxcorelib/scxexception.h>
 #include <scxcorelib/scxdirectoryinfo.h>
@@ -37,8 +43,7 @@ namespace SCXCore {
     const SCXCoreLib::SCXPatternFinder::SCXPatternCookie LogFileReader::s_patternID = 1;
     const std::wstring LogFileReader::s_pattern = L"SELECT * FROM SCX_LogFileRecord WHERE FileName=%PATH";
     const std::wstring LogFileReader::s_patternParameter = L"PATH";
-    const unsigned int cMaxMatchedRows = 500;   //!< max number of matched log rows return limit, 1000 rows from scx log file does not work, 750 does
-    const size_t cMaxTotalBytes = 60 * 1024;    //!< max number of bytes to return in a single instance
+    const size_t cMaxCachedMatchers = 64;       //!< max number of rule sets (and readers) to keep track of
 
     /*----------------------------------------------------------------------------*/
     /* LogFileReader::LogFilePositionRecord                                     */
@@ -52,12 +57,15 @@ namespace SCXCore {
         \param[in] logfile Log file for this record.
         \param[in] qid Q ID of this record.
         \param[in] persistMedia Used to inject persistence media to use for persisting this record. 
+        \param[in] stateStore State store to keep this record in, or NULL to use persistMedia.
     */
     LogFileReader::LogFilePositionRecord::LogFilePositionRecord(
         const SCXCoreLib::SCXFilePath& logfile,
         const std::wstring& qid,
-        SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia /* =  SCXCoreLib::GetPersistMedia()*/)
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia /* =  SCXCoreLib::GetPersistMedia()*/,
+        SCXCoreLib::SCXHandle<LogFileStateStore> stateStore /* = 0 */)
         : m_PersistMedia(persistMedia),
+          m_StateStore(stateStore),
           m_LogFile(logfile),
           m_Qid(qid),
           m_ResetOnRead(false),
@@ -169,6 +177,18 @@ namespace SCXCore {
         {
             m_StSize = static_cast<scxulong>(m_Pos);
         }
+
+        if (NULL != m_StateStore.GetData())
+        {
+            LogFileStateStore::Entry entry;
+            entry.resetOnRead = m_ResetOnRead;
+            entry.pos = m_Pos;
+            entry.stIno = m_StIno;
+            entry.stSize = m_StSize;
+            m_StateStore->Put(m_LogFile.Get(), m_Qid, entry);
+            return;
+        }
+
         SCXHandle<SCXPersistDataWriter> pwriter = m_PersistMedia->CreateWriter(m_IdString, 1);
         pwriter->WriteValue(L"Filename", SCXCoreLib::StrFrom(m_LogFile.Get()));
         pwriter->WriteValue(L"QID", SCXCoreLib::StrFrom(m_Qid));
@@ -187,6 +207,44 @@ namespace SCXCore {
         \returns false if no data had previously been persisted.
     */
     bool LogFileReader::LogFilePositionRecord::Recover()
+    {
+        if (NULL == m_StateStore.GetData())
+        {
+            return RecoverPersisted();
+        }
+
+        LogFileStateStore::Entry entry;
+        if (m_StateStore->Get(m_LogFile.Get(), m_Qid, entry))
+        {
+            m_ResetOnRead = entry.resetOnRead;
+            m_Pos = entry.pos;
+            m_StIno = entry.stIno;
+            m_StSize = entry.stSize;
+            return true;
+        }
+
+        // Not in the state store yet: move data persisted by an earlier version there
+        if ( ! RecoverPersisted() )
+        {
+            return false;
+        }
+        Persist();
+        try
+        {
+            m_PersistMedia->UnPersist(m_IdString);
+        }
+        catch (PersistDataNotFoundException&)
+        {
+        }
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Recover data persisted through the persistence media
+        \returns false if no data had previously been persisted.
+    */
+    bool LogFileReader::LogFilePositionRecord::RecoverPersisted()
     {
         try
         {
@@ -240,6 +298,13 @@ namespace SCXCore {
     */
     bool LogFileReader::LogFilePositionRecord::UnPersist()
     {
+        bool found = false;
+        if (NULL != m_StateStore.GetData())
+        {
+            found = m_StateStore->Remove(m_LogFile.Get(), m_Qid);
+        }
+
+        // Data persisted by an earlier version may not have been moved yet
         try
         {
             m_PersistMedia->UnPersist(m_IdString);
@@ -247,7 +312,7 @@ namespace SCXCore {
         catch (PersistDataNotFoundException&)
         {
             // No persisted data found.
-            return false;
+            return found;
         }
         return true;
     }
@@ -263,42 +328,64 @@ namespace SCXCore {
         \param[in] logfile Log file for this record.
         \param[in] qid Q ID of this record.
         \param[in] persistMedia Used to inject persistence media to use for persisting this record. 
+        \param[in] stateStore State store to keep the record in, or NULL to use persistMedia.
         \throws SCXFilePathNotFoundException if log file does not exist.
     */
     LogFileReader::LogFileStreamPositioner::LogFileStreamPositioner(
         const SCXCoreLib::SCXFilePath& logfile,
         const std::wstring& qid,
-        SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia /* =  SCXCoreLib::GetPersistMedia()*/)
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia /* =  SCXCoreLib::GetPersistMedia()*/,
+        SCXCoreLib::SCXHandle<LogFileStateStore> stateStore /* = 0 */)
         : m_Record(0),
           m_Stream(0),
+          m_StartPos(0),
           m_log(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.logfileprovider.logfilestreampositioner"))
     {
-        m_Record = new LogFilePositionRecord(logfile, qid, persistMedia);
-        m_Stream = SCXFile::OpenWFstream(logfile, std::ios_base::in);
+        m_Record = new LogFilePositionRecord(logfile, qid, persistMedia, stateStore);
 
-        // Set the locale on the stream to the system locale (based on environment variables)
-        // Note: This overrides SCXLocale settings (which is used for everything else)
-        //
-        // If we get an exception, just let it fly (hopefully things will still work okay)
-        // This is better than dying because some bizarre locale is set
+        SCXFileSystem::SCXStatStruct statstruct;
+        SCXFileSystem::Stat(logfile, &statstruct);
+        Position(statstruct.st_ino, statstruct.st_size);
+    }
 
-        try {
-            std::locale newLocale("");
-            m_Stream->imbue(newLocale);
-        }
-        catch (...)
-        {
-        }
+    /*----------------------------------------------------------------------------*/
+    /**
+        Constructor for a log file being read by a LogFileLineScanner
 
-        // On all platforms (even Linux), tellg() can return -1 (see test case testTellgBehavior() in unit test).
-        // To try and protect against that, we position to EOF and save the position, and we'll use that position
-        // if tellg() returns -1.
-        //
-        // There's a race condition here were we can return the same lines multiple times depending on concurrency
-        // issues.  And there's a WI for that, wi 16772.
+        \param[in] logfile Log file for this record.
+        \param[in] qid Q ID of this record.
+        \param[in] scanner Scanner that opened the log file (and took its size and inode).
+        \param[in] persistMedia Used to inject persistence media to use for persisting this record. 
+        \param[in] stateStore State store to keep the record in, or NULL to use persistMedia.
+    */
+    LogFileReader::LogFileStreamPositioner::LogFileStreamPositioner(
+        const SCXCoreLib::SCXFilePath& logfile,
+        const std::wstring& qid,
+        const LogFileLineScanner& scanner,
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia,
+        SCXCoreLib::SCXHandle<LogFileStateStore> stateStore)
+        : m_Record(0),
+          m_Stream(0),
+          m_StartPos(0),
+          m_log(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.logfileprovider.logfilestreampositioner"))
+    {
+        m_Record = new LogFilePositionRecord(logfile, qid, persistMedia, stateStore);
+        Position(scanner.GetStatStIno(), scanner.GetStatStSize());
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Find where reading should start, and record the file as read up to its end
 
-        m_Stream->seekg(0, std::ios_base::end);
-        std::streamoff pos = m_Stream->tellg();
+        \param[in] st_ino Inode of the log file.
+        \param[in] st_size Size of the log file.
+    */
+    void LogFileReader::LogFileStreamPositioner::Position(scxulong st_ino, scxulong st_size)
+    {
+        // The size of the file is its end position (tellg() after seeking to the
+        // end may even return -1, see test case testTellgBehavior() in unit test)
+        std::streamoff pos = static_cast<std::streamoff>(st_size);
+        m_StartPos = pos;
 
         if ( ! m_Record->Recover() )
         {
@@ -315,34 +402,59 @@ namespace SCXCore {
                 SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider OpenStream last pos = ", pos));
                 m_Record->SetResetOnRead(false);
             }
-            else if ( ! IsFileNew() )
+            else if ( ! IsFileNew(st_ino, st_size) )
             {
                 // File has not wrapped so we seek to last position.
                 SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider OpenLogFile " + m_Record->GetLogFile().Get()
                                               + L"- Seek to: ", m_Record->GetPos()));
-                SCXFile::SeekG(*m_Stream, m_Record->GetPos());
+                m_StartPos = m_Record->GetPos();
             }
             else
             {
                 // File has wrapped so we find new last position.
                 SCX_LOGTRACE(m_log, L"LogFileProvider OpenLogFile " + m_Record->GetLogFile().Get() + L" - File has wrapped");
-                SCXFile::SeekG(*m_Stream, 0);
+                m_StartPos = 0;
                 SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider OpenStream save last pos = ", pos));
             }
         }
 
         m_Record->SetPos(pos);
-        UpdateStatData();
+        m_Record->SetStatStIno(st_ino);
+        m_Record->SetStatStSize(st_size);
     }
 
     /*----------------------------------------------------------------------------*/
     /**
         Return a stream pointing at the correct reading position.
 
+        The stream is opened on the first call.
+
         \returns       Handle to stream opened at the correct position.
+        \throws SCXFilePathNotFoundException if log file does not exist.
     */
     SCXHandle<std::wfstream> LogFileReader::LogFileStreamPositioner::GetStream()
     {
+        if (NULL == m_Stream)
+        {
+            m_Stream = SCXFile::OpenWFstream(m_Record->GetLogFile(), std::ios_base::in);
+
+            // Set the locale on the stream to the system locale (based on environment variables)
+            // Note: This overrides SCXLocale settings (which is used for everything else)
+            //
+            // If we get an exception, just let it fly (hopefully things will still work okay)
+            // This is better than dying because some bizarre locale is set
+
+            try {
+                std::locale newLocale("");
+                m_Stream->imbue(newLocale);
+            }
+            catch (...)
+            {
+            }
+
+            SCXFile::SeekG(*m_Stream, m_StartPos);
+        }
+
         return m_Stream;
     }
 
@@ -352,17 +464,15 @@ namespace SCXCore {
     */
     void LogFileReader::LogFileStreamPositioner::PersistState()
     {
-        std::streamoff pos = m_Stream->tellg();
+        // Where the stream returned by GetStream() is, if it was asked for
+        std::streamoff pos = (NULL != m_Stream) ? static_cast<std::streamoff>(m_Stream->tellg()) : m_StartPos;
         SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider PersistState() - pos = ", pos));
 
         // Never persist -1, happens on some platforms (AIX) when reading past end of file.  It can
         // even happen on Linux platforms in certain cases (see unit test testTellgBehavior()).
         //
-        // Real end of file position has been saved when opening the file.  If we can't get the true
-        // current location, we fall back to the size of the file at open() time.
-        //
-        // Note: We could use the size from SCXFileSystem::Stat(), but this is non-atomic. Safer to
-        // use the actual file size from the file at the time that we've opened it.
+        // Real end of file position has been saved when positioning.  If we can't get the true
+        // current location, we fall back to the size of the file at that time.
 
         if (pos > 0)
         {
@@ -371,28 +481,41 @@ namespace SCXCore {
         m_Record->Persist();
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Save the state of a logfile that was read up to a known position
+        (rather than through the stream returned by GetStream()).
+
+        \param[in] pos Position following the last line read.
+    */
+    void LogFileReader::LogFileStreamPositioner::PersistState(std::streamoff pos)
+    {
+        SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider PersistState(pos) - pos = ", pos));
+
+        m_Record->SetPos(pos);
+        m_Record->Persist();
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
         Check if the log file is actually a new file with the same name.
         This will happen if the file has wrapped since last update for example.
 
+        \param[in] st_ino Inode of the log file.
+        \param[in] st_size Size of the log file.
         \returns true if the file is actually a new file.
-        \throws SCXFilePathNotFoundException if log file does not exist.
     */
-    bool LogFileReader::LogFileStreamPositioner::IsFileNew() const
+    bool LogFileReader::LogFileStreamPositioner::IsFileNew(scxulong st_ino, scxulong st_size) const
     {
-        SCXFileSystem::SCXStatStruct statstruct;
-        SCXFileSystem::Stat(m_Record->GetLogFile(), &statstruct);
-         
         // If inode has changed it is a new file
-        if (statstruct.st_ino != m_Record->GetStatStIno())
+        if (st_ino != m_Record->GetStatStIno())
         {
             SCX_LOGTRACE(m_log, L"IsNewFile - inode changed - new file");
             return true;
         }
 
         // If the new size is smaller it is a new file
-        if ((scxulong) statstruct.st_size < m_Record->GetStatStSize())
+        if (st_size < m_Record->GetStatStSize())
         {
             SCX_LOGTRACE(m_log, L"IsNewFile - size smaller - new file");
             return true;
@@ -403,18 +526,287 @@ namespace SCXCore {
         return false;
     }
 
+    /*----------------------------------------------------------------------------*/
+    /* LogFileReader::LogFileLineScanner                                          */
+    /*----------------------------------------------------------------------------*/
+
     /*----------------------------------------------------------------------------*/
     /**
-        Update stat fields in record with values read from disk.
+        Constructor
+
+        \param[in] logfile Log file to read.
+        \param[in] pos Position to start reading at (see LogFileStreamPositioner::GetStartPos()).
+        \param[in] blockSize Size of the blocks read from the file.
         \throws SCXFilePathNotFoundException if log file does not exist.
     */
-    void LogFileReader::LogFileStreamPositioner::UpdateStatData()
+    LogFileReader::LogFileLineScanner::LogFileLineScanner(
+        const SCXCoreLib::SCXFilePath& logfile,
+        std::streamoff pos,
+        size_t blockSize /* = cDefaultBlockSize */)
+        : m_Fd(-1),
+          m_StDev(0),
+          m_StIno(0),
+          m_StSize(0),
+          m_Buffer(blockSize > 0 ? blockSize : 1),
+          m_Begin(0),
+          m_End(0),
+          m_Pos(pos),
+          m_Eof(false)
     {
-        SCXFileSystem::SCXStatStruct statstruct;
-        SCXFileSystem::Stat(m_Record->GetLogFile(), &statstruct);
-         
-        m_Record->SetStatStIno(statstruct.st_ino);
-        m_Record->SetStatStSize(statstruct.st_size);
+#if defined(O_CLOEXEC)
+        m_Fd = open(StrToMultibyte(logfile.Get()).c_str(), O_RDONLY | O_CLOEXEC);
+#else
+        m_Fd = open(StrToMultibyte(logfile.Get()).c_str(), O_RDONLY);
+#endif
+        if (m_Fd < 0)
+        {
+            if (ENOENT == errno)
+            {
+                throw SCXFilePathNotFoundException(logfile, SCXSRCLOCATION);
+            }
+            throw SCXErrnoException(L"open", errno, SCXSRCLOCATION);
+        }
+
+        struct stat statstruct;
+        if (0 != fstat(m_Fd, &statstruct))
+        {
+            int fstatErrno = errno;
+            close(m_Fd);
+            throw SCXErrnoException(L"fstat", fstatErrno, SCXSRCLOCATION);
+        }
+        m_StDev = static_cast<scxulong>(statstruct.st_dev);
+        m_StIno = static_cast<scxulong>(statstruct.st_ino);
+        m_StSize = static_cast<scxulong>(statstruct.st_size);
+
+        Seek(pos);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Destructor
+    */
+    LogFileReader::LogFileLineScanner::~LogFileLineScanner()
+    {
+        close(m_Fd);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Continue reading at another position, dropping what was read ahead.
+
+        \param[in] pos Position to continue reading at.
+    */
+    void LogFileReader::LogFileLineScanner::Seek(std::streamoff pos)
+    {
+        m_Begin = 0;
+        m_End = 0;
+        m_Pos = pos;
+        m_Eof = (static_cast<off_t>(-1) == lseek(m_Fd, static_cast<off_t>(pos), SEEK_SET));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the next line.
+
+        A last line without terminator is returned as well (and consumed), as
+        the previous wfstream based reader did.
+
+        \param[out] line Start of the line (valid until the next call).
+        \param[out] length Length of the line, excluding "\n" or "\r\n".
+        \returns false if there are no more lines.
+    */
+    bool LogFileReader::LogFileLineScanner::NextLine(const char*& line, size_t& length)
+    {
+        for (;;)
+        {
+            const char* begin = &m_Buffer[0] + m_Begin;
+            size_t available = m_End - m_Begin;
+            const char* newline = static_cast<const char*>(memchr(begin, '\n', available));
+
+            if (NULL != newline || (m_Eof && available > 0))
+            {
+                size_t consumed = (NULL != newline) ? static_cast<size_t>(newline - begin) + 1 : available;
+
+                line = begin;
+                length = (NULL != newline) ? consumed - 1 : consumed;
+                if (length > 0 && '\r' == line[length - 1])
+                {
+                    length--;
+                }
+
+                m_Begin += consumed;
+                m_Pos += consumed;
+                return true;
+            }
+
+            if (!Fill())
+            {
+                return false;
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Check if all of the file has been read.
+
+        \returns true if there are no more lines.
+    */
+    bool LogFileReader::LogFileLineScanner::AtEnd()
+    {
+        return m_Begin == m_End && !Fill();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read the next block of the file, keeping any unscanned data.
+        The buffer is grown if a single line doesn't fit.
+
+        \returns false if end of file was reached before anything could be read.
+    */
+    bool LogFileReader::LogFileLineScanner::Fill()
+    {
+        if (m_Eof)
+        {
+            return false;
+        }
+
+        if (m_Begin > 0)
+        {
+            memmove(&m_Buffer[0], &m_Buffer[0] + m_Begin, m_End - m_Begin);
+            m_End -= m_Begin;
+            m_Begin = 0;
+        }
+
+        if (m_End == m_Buffer.size())
+        {
+            m_Buffer.resize(m_Buffer.size() * 2);
+        }
+
+        ssize_t count;
+        do
+        {
+            count = read(m_Fd, &m_Buffer[0] + m_End, m_Buffer.size() - m_End);
+        } while (count < 0 && EINTR == errno);
+        if (count <= 0)
+        {
+            m_Eof = true;
+            // Let NextLine() return a last line without terminator
+            return m_End > m_Begin;
+        }
+
+        m_End += static_cast<size_t>(count);
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /* LogFileReader::LogFileLineDecoder                                          */
+    /*----------------------------------------------------------------------------*/
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Constructor
+
+        Uses the system locale (based on environment variables). If that can't
+        be created, the classic locale is used.
+    */
+    LogFileReader::LogFileLineDecoder::LogFileLineDecoder()
+        : m_Locale(std::locale::classic()),
+          m_Codecvt(NULL),
+          m_AsciiCompatible(false)
+    {
+        try {
+            m_Locale = std::locale("");
+        }
+        catch (...)
+        {
+        }
+
+        m_Codecvt = &std::use_facet<Codecvt>(m_Locale);
+
+        // Most log files are mostly ASCII. If the encoding is stateless and
+        // maps every ASCII byte to the same wide character, ASCII bytes can be
+        // copied without going through the facet.
+        m_AsciiCompatible = (-1 != m_Codecvt->encoding());
+        for (int c = 1; c < 0x80 && m_AsciiCompatible; c++)
+        {
+            char from = static_cast<char>(c);
+            const char* fromNext = NULL;
+            wchar_t to = 0;
+            wchar_t* toNext = NULL;
+            mbstate_t state;
+            memset(&state, 0, sizeof(state));
+
+            m_AsciiCompatible = (std::codecvt_base::ok == m_Codecvt->in(state, &from, &from + 1, fromNext, &to, &to + 1, toNext)
+                                 && toNext == &to + 1
+                                 && static_cast<wchar_t>(c) == to);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Convert a line to a wide string.
+
+        \param[in] line Start of the line.
+        \param[in] length Length of the line.
+        \param[out] wline Converted line.
+    */
+    void LogFileReader::LogFileLineDecoder::Decode(const char* line, size_t length, std::wstring& wline)
+    {
+        // No multibyte sequence converts to more than one wide character
+        if (m_Buffer.size() < length + 1)
+        {
+            m_Buffer.resize(length + 1);
+        }
+
+        mbstate_t state;
+        memset(&state, 0, sizeof(state));
+
+        const char* from = line;
+        const char* fromEnd = line + length;
+        wchar_t* to = &m_Buffer[0];
+        wchar_t* toEnd = &m_Buffer[0] + m_Buffer.size();
+
+        while (from < fromEnd)
+        {
+            if (m_AsciiCompatible)
+            {
+                while (from < fromEnd && 0 == (*from & 0x80))
+                {
+                    *to++ = static_cast<wchar_t>(*from++);
+                }
+                if (from == fromEnd)
+                {
+                    break;
+                }
+            }
+
+            const char* fromNext = from;
+            wchar_t* toNext = to;
+            std::codecvt_base::result result = m_Codecvt->in(state, from, fromEnd, fromNext, to, toEnd, toNext);
+            bool progressed = (fromNext != from);
+
+            if (std::codecvt_base::noconv == result)
+            {
+                for ( ; from < fromEnd; ++from)
+                {
+                    *to++ = static_cast<unsigned char>(*from);
+                }
+                break;
+            }
+
+            from = fromNext;
+            to = toNext;
+
+            if (from < fromEnd && (std::codecvt_base::ok != result || !progressed))
+            {
+                // Invalid or truncated sequence: keep the byte as is and resynchronize
+                *to++ = static_cast<unsigned char>(*from++);
+                memset(&state, 0, sizeof(state));
+            }
+        }
+
+        wline.assign(&m_Buffer[0], to - &m_Buffer[0]);
     }
 
     /*----------------------------------------------------------------------------*/
@@ -529,69 +921,385 @@ namespace SCXCore {
         m_persistMedia = persistMedia; 
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Keep the state of all log files in one journal (see LogFileStateStore)
+        rather than in one persisted file per log file and qid.
+
+        If the journal can't be opened, the persist media keeps being used.
+
+        \param[in]     basePath     State directory (as set on the persist media)
+    */
+    void LogFileReader::UseStateStore(const std::wstring& basePath)
+    {
+        SCXHandle<LogFileStateStore> stateStore(new LogFileStateStore(LogFileStateStore::GetJournalPath(basePath)));
+
+        try
+        {
+            stateStore->Open();
+            m_stateStore = stateStore;
+        }
+        catch (SCXException& e)
+        {
+            SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider UseStateStore - Unable to open journal ", stateStore->GetPath().Get())
+                           .append(L", exception: ").append(e.What()));
+            m_stateStore = NULL;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the matcher for the rule set of a log file and qid
+
+        The rule set of a log file and qid rarely changes between reads, so the
+        matcher is built once and kept until the rule set changes. If too many
+        log files are monitored, all matchers are dropped and built again as needed.
+
+        \param[in]     filename         Log file the rule set is used for
+        \param[in]     qid              QID the rule set is used for
+        \param[in]     regexps          Regular expressions of the rule set
+        \param[in]     asciiCompatible  See LogFileLineDecoder::IsAsciiCompatible()
+
+        \returns       Matcher for the rule set
+    */
+    SCXHandle<LogFileMatcher> LogFileReader::GetMatcher(
+        const std::wstring& filename,
+        const std::wstring& qid,
+        const std::vector<SCXRegexWithIndex>& regexps,
+        bool asciiCompatible)
+    {
+        std::pair<std::wstring, std::wstring> key(filename, qid);
+        std::map<std::pair<std::wstring, std::wstring>, SCXHandle<LogFileMatcher> >::iterator it = m_matchers.find(key);
+
+        if (it != m_matchers.end() && it->second->IsSameRules(regexps, asciiCompatible))
+        {
+            return it->second;
+        }
+
+        SCX_LOGTRACE(m_log, StrAppend(StrAppend(L"LogFileProvider GetMatcher - Building matcher for ", filename), L", qid: ").append(qid));
+
+        if (it == m_matchers.end() && m_matchers.size() >= cMaxCachedMatchers)
+        {
+            m_matchers.clear();
+        }
+
+        SCXHandle<LogFileMatcher> matcher(new LogFileMatcher(regexps, asciiCompatible));
+        m_matchers[key] = matcher;
+        return matcher;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Match a decoded line and build its result row
+
+        \param[in]     matcher         Matcher, after a successful Prefilter() of the line
+        \param[in]     line            Decoded line
+        \param[in]     rowNumber       Number of the line in this read (for logging)
+        \param[out]    row             Indexes of the matching expressions, followed by the line
+
+        \returns       true if any expression matched
+    */
+    bool LogFileReader::MatchLine(
+        const LogFileMatcher& matcher,
+        const std::wstring& line,
+        unsigned int rowNumber,
+        std::wstring& row)
+    {
+        std::vector<size_t> matches;
+        matcher.Match(line, matches);
+
+        row.clear();
+        for (size_t j=0; j<matches.size(); j++)
+        {
+            size_t index = matcher.GetRegexps()[matches[j]].index;
+            SCX_LOGHYSTERICAL(m_log, StrAppend(StrAppend(StrAppend(L"LogFileProvider DoInvokeMethod - row: ", rowNumber), 
+                                                         L" Matched regexp: "), index));
+            row = StrAppend(StrAppend(row, row.length()>0?L" ":L""), index);
+        }
+
+        if (matches.empty())
+        {
+            return false;
+        }
+
+        row.reserve(row.size() + 1 + line.size());
+        row.append(L";").append(line);
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Build the resume position of a read: where the next read of the file starts
+
+        \param[in]     dev             Device of the log file
+        \param[in]     ino             Inode of the log file
+        \param[in]     pos             Position following the last line read
+
+        \returns       Resume position, as "<device>:<inode>:<position>"
+    */
+    std::wstring LogFileReader::FormatResumePosition(scxulong dev, scxulong ino, std::streamoff pos)
+    {
+        std::wostringstream ss;
+        ss << dev << L":" << ino << L":" << static_cast<scxulong>(pos);
+        return ss.str();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Parse a resume position returned by an earlier read
+
+        \param[in]     resumePosition  Resume position (see FormatResumePosition)
+        \param[in]     dev             Device of the log file now
+        \param[in]     ino             Inode of the log file now
+        \param[out]    pos             Position to resume at
+
+        \returns       true if the resume position is valid and refers to the same file
+    */
+    bool LogFileReader::ParseResumePosition(const std::wstring& resumePosition, scxulong dev, scxulong ino, std::streamoff& pos)
+    {
+        std::wistringstream ss(resumePosition);
+        scxulong resumeDev, resumeIno, resumePos;
+        wchar_t sep1, sep2;
+        if ( ! (ss >> resumeDev >> sep1 >> resumeIno >> sep2 >> resumePos)
+             || L':' != sep1 || L':' != sep2 || ! ss.eof()
+             || resumeDev != dev || resumeIno != ino)
+        {
+            return false;
+        }
+
+        pos = static_cast<std::streamoff>(resumePos);
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read new lines of a log file and return those matching any of the regular expressions
+
+        The file is read in large blocks by a LogFileLineScanner. A LogFileMatcher
+        tells which expressions may match each line; lines that no expression
+        can match are skipped without being decoded. Other lines are decoded
+        into a reused buffer, and result rows are only built for lines that match.
+
+        Lines read are also matched for the other qids reading the same file
+        whose next read would cover them (see SCXLogFileConsumer). When these
+        qids read the file, they start with those rows and only read what was
+        added since, so each line is read once however many qids watch the file.
+
+        \param[in]     filename        Log file to read
+        \param[in]     qid             QID used for state file handling
+        \param[in]     regexps         Regular expressions to match
+        \param[out]    matchedLines    Matched lines, each prefixed by the indexes of the matching expressions
+        \param[in]     maxRows         Stop after this many matched lines (0 for cDefaultMaxRows,
+                                       at most cMaxRowsLimit)
+        \param[in]     maxBytes        Stop once the matched lines are this large (0 for
+                                       cDefaultMaxBytes, at most cMaxBytesLimit)
+        \param[in,out] resumePosition  If not NULL: on input, the resume position of an earlier
+                                       read of this file to start at rather than where the last
+                                       read stopped (ignored if empty or for another file); on
+                                       output, the resume position of this read
+
+        \returns       true if more matching lines may be available than were returned
+        \throws        SCXFilePathNotFoundException if log file does not exist.
+    */
     bool LogFileReader::ReadLogFile(
         const std::wstring& filename,
         const std::wstring& qid,
         const std::vector<SCXRegexWithIndex>& regexps,
-        std::vector<std::wstring>& matchedLines)
+        std::vector<std::wstring>& matchedLines,
+        size_t maxRows /* = cDefaultMaxRows */,
+        size_t maxBytes /* = cDefaultMaxBytes */,
+        std::wstring* resumePosition /* = NULL */)
     {
-        LogFileStreamPositioner positioner(filename, qid, m_persistMedia);
-        SCXHandle<std::wfstream> logfile = positioner.GetStream();
+        if (0 == maxRows)
+        {
+            maxRows = cDefaultMaxRows;
+        }
+        else if (maxRows > cMaxRowsLimit)
+        {
+            maxRows = cMaxRowsLimit;
+        }
+        if (0 == maxBytes)
+        {
+            maxBytes = cDefaultMaxBytes;
+        }
+        else if (maxBytes > cMaxBytesLimit)
+        {
+            maxBytes = cMaxBytesLimit;
+        }
+
+        // The file is opened once: where to start, and its identity and size,
+        // all describe the file read, even if it is rotated meanwhile
+        LogFileLineScanner scanner(filename, 0);
+        LogFileStreamPositioner positioner(filename, qid, scanner, m_persistMedia, m_stateStore);
+        LogFileLineDecoder decoder;
+        SCXHandle<LogFileMatcher> matcher = GetMatcher(filename, qid, regexps, decoder.IsAsciiCompatible());
+
+        scxulong dev = scanner.GetStatStDev();
+        scxulong ino = scanner.GetStatStIno();
+        std::streamoff size = static_cast<std::streamoff>(scanner.GetStatStSize());
+
+        std::pair<std::wstring, std::wstring> key(filename, qid);
+        if (m_consumers.end() == m_consumers.find(key) && m_consumers.size() >= cMaxCachedMatchers)
+        {
+            m_consumers.clear();
+        }
+        SCXLogFileConsumer& self = m_consumers[key];
 
         bool partialRead = false;
 
         unsigned int rows = 0;
-        unsigned int matched_rows = 0;
+        size_t matched_rows = 0;
         size_t total_bytes = 0;
+        std::streamoff startPos = positioner.GetStartPos();
+
+        // A caller that lost the rows of a read asks for them again by resuming where it started
+        if (NULL != resumePosition && ! resumePosition->empty())
+        {
+            std::streamoff resumePos;
+            if (ParseResumePosition(*resumePosition, dev, ino, resumePos)
+                && resumePos <= size)
+            {
+                startPos = resumePos;
+            }
+            else
+            {
+                SCX_LOGTRACE(m_log, StrAppend(L"LogFileProvider ReadLogFile - Ignoring resume position: ", *resumePosition));
+            }
+        }
+
+        // Start with the rows read on our behalf, if they start where we are
+        // (and fit in this read; pending rows are collected with the default limits)
+        if (self.pendingStart >= 0 && self.pendingStart == startPos
+            && self.matcher.GetData() == matcher.GetData()
+            && self.dev == dev && self.ino == ino
+            && size >= self.pendingEnd
+            && self.pendingLines.size() <= maxRows && self.pendingBytes <= maxBytes)
+        {
+            SCX_LOGTRACE(m_log, StrAppend(StrAppend(L"LogFileProvider ReadLogFile - Using pending rows: ", self.pendingLines.size()),
+                                          L", up to position: ").append(StrFrom(self.pendingEnd)));
+            matchedLines.insert(matchedLines.end(), self.pendingLines.begin(), self.pendingLines.end());
+            matched_rows = self.pendingLines.size();
+            total_bytes = self.pendingBytes;
+            startPos = self.pendingEnd;
+        }
+        self.ClearPending();
+
+        scanner.Seek(startPos);
+
+        // Other readers of this file whose next read starts within what we read
+        std::vector<SCXLogFileConsumer*> others;
+        for (std::map<std::pair<std::wstring, std::wstring>, SCXLogFileConsumer>::iterator it = m_consumers.begin();
+             it != m_consumers.end(); ++it)
+        {
+            SCXLogFileConsumer& other = it->second;
+            std::streamoff otherPos = (other.pendingStart >= 0) ? other.pendingEnd : other.pos;
+            if (&other != &self && other.dev == dev && other.ino == ino
+                && NULL != other.matcher.GetData() && ! other.pendingFull && otherPos >= startPos)
+            {
+                others.push_back(&other);
+            }
+        }
+        std::vector<bool> collecting(others.size(), false);
+
+        const char* bytes;
+        size_t length;
+        wstring line;
+        wstring res;
 
         // Read rows from log file
-        while ((matched_rows < cMaxMatchedRows && total_bytes < cMaxTotalBytes)
-               && SCXStream::IsGood(*logfile))
+        while (matched_rows < maxRows && total_bytes < maxBytes)
         {
-            wstring line;
-            SCXStream::NLF nlf;
+            std::streamoff lineStart = scanner.GetPos();
+            if ( ! scanner.NextLine(bytes, length))
+            {
+                break;
+            }
 
             rows++;
 
             SCX_LOGHYSTERICAL(m_log, StrAppend(L"LogFileProvider DoInvokeMethod - Reading row: ", rows));
 
-            SCXStream::ReadLine(*logfile, line, nlf);
+            // Lines are decoded when the first matcher needs them
+            bool decoded = false;
 
             // Check line against regular expressions and add to result if any matches
-            std::wstring res(L"");
-            int matches = 0;
-
-            for (size_t j=0; j<regexps.size(); j++)
+            if (matcher->Prefilter(bytes, length))
             {
-                if (regexps[j].regex->IsMatch(line))
+                decoder.Decode(bytes, length, line);
+                decoded = true;
+
+                if (MatchLine(*matcher, line, rows, res))
                 {
-                    SCX_LOGHYSTERICAL(m_log, StrAppend(StrAppend(StrAppend(L"LogFileProvider DoInvokeMethod - row: ", rows), 
-                                                                 L" Matched regexp: "), regexps[j].index));
-                    matches++;
-                    res = StrAppend(StrAppend(res, res.length()>0?L" ":L""), regexps[j].index);
+                    total_bytes += res.size();
+                    matchedLines.push_back(res);
+                    matched_rows++;
                 }
             }
 
-            if (matches > 0)
+            for (size_t i = 0; i < others.size(); i++)
             {
-                wstring retEntry = StrAppend(StrAppend(res, L";"), line);
-                matchedLines.push_back(retEntry);
-                matched_rows++;
-                total_bytes += retEntry.size();
+                SCXLogFileConsumer& other = *others[i];
+
+                if ( ! collecting[i])
+                {
+                    std::streamoff otherPos = (other.pendingStart >= 0) ? other.pendingEnd : other.pos;
+                    if (otherPos != lineStart)
+                    {
+                        continue;
+                    }
+
+                    collecting[i] = true;
+                    if (other.pendingStart < 0)
+                    {
+                        other.pendingStart = lineStart;
+                    }
+                }
+
+                if (other.pendingFull)
+                {
+                    continue;
+                }
+
+                if (other.matcher->Prefilter(bytes, length))
+                {
+                    if ( ! decoded)
+                    {
+                        decoder.Decode(bytes, length, line);
+                        decoded = true;
+                    }
+
+                    if (MatchLine(*other.matcher, line, rows, res))
+                    {
+                        other.pendingBytes += res.size();
+                        other.pendingLines.push_back(res);
+                    }
+                }
+
+                other.pendingEnd = scanner.GetPos();
+                other.pendingFull = (other.pendingLines.size() >= cDefaultMaxRows || other.pendingBytes >= cDefaultMaxBytes);
             }
         }
 
         // Check if we read all rows, if not add special row to beginning of result
-        if ((matched_rows >= cMaxMatchedRows || total_bytes >= cMaxTotalBytes)
-            && SCXStream::IsGood(*logfile))
+        if ((matched_rows >= maxRows || total_bytes >= maxBytes)
+            && ! scanner.AtEnd())
         {
 //TODO: logging policy not set so by default may write into stdout and therefore interfere with the normal operation.
-//          SCX_LOGINFO(m_log, StrAppend(L"LogFileProvider DoInvokeMethod - Breaking after matching max number of rows : ", cMaxMatchedRows));
+//          SCX_LOGINFO(m_log, StrAppend(L"LogFileProvider DoInvokeMethod - Breaking after matching max number of rows : ", maxRows));
 
             partialRead = true;
         }
 
-        positioner.PersistState();
+        self.dev = dev;
+        self.ino = ino;
+        self.pos = scanner.GetPos();
+        self.matcher = matcher;
+
+        positioner.PersistState(scanner.GetPos());
+        if (NULL != resumePosition)
+        {
+            *resumePosition = FormatResumePosition(dev, ino, scanner.GetPos());
+        }
         return partialRead;
     }
 
@@ -607,7 +1315,10 @@ namespace SCXCore {
            << L", resetOnRead: " << resetOnRead;
         SCX_LOGTRACE(m_log, ss.str())
 
-        LogFileStreamPositioner positioner(filename, qid, m_persistMedia);
+        // What we know about the reads of this qid no longer applies
+        m_consumers.erase(std::pair<std::wstring, std::wstring>(filename, qid));
+
+        LogFileStreamPositioner positioner(filename, qid, m_persistMedia, m_stateStore);
         SCXHandle<std::wfstream> logfile = positioner.GetStream();
 
         if (false == resetOnRead)
@@ -656,6 +1367,7 @@ namespace SCXCore {
             exitStatus = EINTR;
         }
 
+        std::set<LogFileStateStore::Key> states;
         for (vector<SCXFilePath>::iterator i(items.begin()); i != items.end(); ++i)
         {
             const std::wstring stateFilename = i->GetFilename();
@@ -699,32 +1411,56 @@ namespace SCXCore {
             // If we found the data that we needed, then reset the log file
             if (filename.length() && qid.length())
             {
-                SCX_LOGTRACE(m_log, StrAppend(StrAppend(L"LogFileProvider ResetAllLogFileStates - Filename: ", filename).append(L", QID: "), qid));
+                states.insert(LogFileStateStore::Key(filename, qid));
+            }
+        }
 
-                try
-                {
-                    int localStatus = ResetLogFileState(filename, qid, resetOnRead);
+        // States kept in the journal (see UseStateStore)
+        if (NULL != m_stateStore.GetData())
+        {
+            try
+            {
+                vector<LogFileStateStore::Key> keys;
+                m_stateStore->GetKeys(keys);
+                states.insert(keys.begin(), keys.end());
+            }
+            catch (SCXException &e)
+            {
+                SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider ResetAllLogFileStates - Unable to read journal: ", e.What()));
+                exitStatus = EINTR;
+            }
+        }
 
-                    if (localStatus != 0)
-                    {
-                        exitStatus = localStatus;
-                    }
-                }
-                catch (SCXFilePathNotFoundException& e)
-                {
-                    SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider ResetAllLogFileStates - File not found: ", filename).append(L", exception: ").append(e.What()));
+        for (std::set<LogFileStateStore::Key>::const_iterator state = states.begin(); state != states.end(); ++state)
+        {
+            const wstring& filename = state->first;
+            const wstring& qid = state->second;
 
-                    // Return a special exit code so we know that the log file wasn't found
-                    exitStatus = ENOENT;
-                }
-                catch (SCXException &e)
-                {
-                    SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider ResetAllLogFileStates - Unexpected exception: ", e.What()));
+            SCX_LOGTRACE(m_log, StrAppend(StrAppend(L"LogFileProvider ResetAllLogFileStates - Filename: ", filename).append(L", QID: "), qid));
+
+            try
+            {
+                int localStatus = ResetLogFileState(filename, qid, resetOnRead);
 
-                    // Return a special exit code so we know that an exception occurred
-                    exitStatus = EINTR;
+                if (localStatus != 0)
+                {
+                    exitStatus = localStatus;
                 }
             }
+            catch (SCXFilePathNotFoundException& e)
+            {
+                SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider ResetAllLogFileStates - File not found: ", filename).append(L", exception: ").append(e.What()));
+
+                // Return a special exit code so we know that the log file wasn't found
+                exitStatus = ENOENT;
+            }
+            catch (SCXException &e)
+            {
+                SCX_LOGWARNING(m_log, StrAppend(L"LogFileProvider ResetAllLogFileStates - Unexpected exception: ", e.What()));
+
+                // Return a special exit code so we know that an exception occurred
+                exitStatus = EINTR;
+            }
         }
 
         SCX_LOGTRACE(m_log, L"LogFileProvider ResetAllLogFileStates - exit");
@@ -15,15 +15,22 @@
 
 #include <sys/stat.h>
 
+#include <fstream>
 #include <string>
 #include <vector>
 #include <istream>
+#include <locale>
+#include <map>
+#include <utility>
 
 #include <scxcorelib/scxlog.h>
 #include <scxcorelib/scxpersistence.h>
 #include <scxcorelib/scxpatternfinder.h>
 #include <scxcorelib/scxregex.h>
 
+#include "logfilematcher.h"
+#include "logfilestatestore.h"
+
 namespace SCXCore
 {
     class LogFileReader
@@ -32,13 +39,18 @@ namespace SCXCore
         /**
            Persistable representation of a log file with a current position.
            The persistence key is the logfile path together with the qid.
+
+           If a state store is given, the record is kept there; records
+           persisted through the persistence media by earlier versions are
+           moved to the state store when recovered.
         */
         class LogFilePositionRecord
         {
         public:
             LogFilePositionRecord(const SCXCoreLib::SCXFilePath& logfile,
                                   const std::wstring& qid,
-                                  SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia = SCXCoreLib::GetPersistMedia());
+                                  SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia = SCXCoreLib::GetPersistMedia(),
+                                  SCXCoreLib::SCXHandle<LogFileStateStore> stateStore = SCXCoreLib::SCXHandle<LogFileStateStore>(0));
             const SCXCoreLib::SCXFilePath& GetLogFile() const;
             bool GetResetOnRead() const;
             void SetResetOnRead(bool fSet);
@@ -54,7 +66,10 @@ namespace SCXCore
             bool UnPersist();
 
         private:
+            bool RecoverPersisted();
+
             SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> m_PersistMedia; //!< Handle to persistence framework.
+            SCXCoreLib::SCXHandle<LogFileStateStore> m_StateStore; //!< State store, if used instead of m_PersistMedia.
             const SCXCoreLib::SCXFilePath m_LogFile; //!< Log file path.
             std::wstring m_Qid;      //!< Query ID
             bool m_ResetOnRead;      //!< ResetOnRead flag
@@ -65,30 +80,142 @@ namespace SCXCore
             scxulong m_StSize;      //!< st_size field of a stat struct.
         };
 
+        class LogFileLineScanner;
+
         /**
            Class with responsibility of maintaining opening a log file at the correct
            position depending on information in a LogFilePositionRecord.
+
+           The positions are derived from the size and inode of the log file, taken
+           from the LogFileLineScanner reading it if there is one (so that they
+           describe the file actually read), else from one stat() of the file. The
+           file is only opened as a wfstream if GetStream() is called.
         */
         class LogFileStreamPositioner
         {
         public:
             LogFileStreamPositioner(const SCXCoreLib::SCXFilePath& logfile,
                                     const std::wstring& qid,
-                                    SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia = SCXCoreLib::GetPersistMedia());
+                                    SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia = SCXCoreLib::GetPersistMedia(),
+                                    SCXCoreLib::SCXHandle<LogFileStateStore> stateStore = SCXCoreLib::SCXHandle<LogFileStateStore>(0));
+            LogFileStreamPositioner(const SCXCoreLib::SCXFilePath& logfile,
+                                    const std::wstring& qid,
+                                    const LogFileLineScanner& scanner,
+                                    SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia,
+                                    SCXCoreLib::SCXHandle<LogFileStateStore> stateStore);
             SCXCoreLib::SCXHandle<std::wfstream> GetStream();
             void SetResetOnRead(bool fSet) { m_Record->SetResetOnRead(fSet); }
             void PersistState();
+            void PersistState(std::streamoff pos);
+
+            //! Position where reading should start
+            //! \returns File position
+            std::streamoff GetStartPos() const { return m_StartPos; }
 
         private:
             SCXCoreLib::SCXHandle<LogFilePositionRecord> m_Record; //!< Handle to record with persistable data.
             SCXCoreLib::SCXHandle<std::wfstream> m_Stream; //!< Handle to currently open stream.
+            std::streamoff m_StartPos; //!< Position where reading should start
             SCXCoreLib::SCXLogHandle m_log; //!< Handle to log framework.
 
-            bool IsFileNew() const;
-            void UpdateStatData();
+            void Position(scxulong st_ino, scxulong st_size);
+            bool IsFileNew(scxulong st_ino, scxulong st_size) const;
+        };
+
+        /**
+           Reads the lines of a log file from a given position, in large blocks.
+
+           Lines are found with memchr() and returned as pointers into the block
+           buffer, so nothing is decoded or allocated per line. A returned line
+           excludes its terminator and is only valid until the next call.
+
+           The identity and size of the file are taken with fstat() when it is
+           opened, so they describe the file read even if it is rotated meanwhile.
+        */
+        class LogFileLineScanner
+        {
+        public:
+            //! Default size (in bytes) of the blocks read from the file
+            static const size_t cDefaultBlockSize = 256 * 1024;
+
+            LogFileLineScanner(const SCXCoreLib::SCXFilePath& logfile,
+                               std::streamoff pos,
+                               size_t blockSize = cDefaultBlockSize);
+            ~LogFileLineScanner();
+            void Seek(std::streamoff pos);
+            bool NextLine(const char*& line, size_t& length);
+            bool AtEnd();
+
+            //! Position following the last line returned
+            //! \returns File position
+            std::streamoff GetPos() const { return m_Pos; }
+
+            //! st_dev of the file, when it was opened
+            //! \returns Device ID
+            scxulong GetStatStDev() const { return m_StDev; }
+            //! st_ino of the file, when it was opened
+            //! \returns Inode
+            scxulong GetStatStIno() const { return m_StIno; }
+            //! st_size of the file, when it was opened
+            //! \returns Size (in bytes)
+            scxulong GetStatStSize() const { return m_StSize; }
+
+        private:
+            LogFileLineScanner(const LogFileLineScanner&);              //!< Not copyable (owns m_Fd)
+            LogFileLineScanner& operator=(const LogFileLineScanner&);   //!< Not copyable (owns m_Fd)
+
+            bool Fill();
+
+            int m_Fd;                   //!< Log file
+            scxulong m_StDev;           //!< st_dev of the file, when it was opened
+            scxulong m_StIno;           //!< st_ino of the file, when it was opened
+            scxulong m_StSize;          //!< st_size of the file, when it was opened
+            std::vector<char> m_Buffer; //!< Block buffer
+            size_t m_Begin;             //!< Start of unscanned data in m_Buffer
+            size_t m_End;               //!< End of unscanned data in m_Buffer
+            std::streamoff m_Pos;       //!< File position of m_Begin
+            bool m_Eof;                 //!< Has end of file been reached?
+        };
+
+        /**
+           Converts lines to wide strings using the system locale (based on
+           environment variables), like the locale imbued by LogFileStreamPositioner.
+
+           Invalid sequences are converted byte by byte rather than ending the
+           read. Buffers are reused between lines.
+        */
+        class LogFileLineDecoder
+        {
+        public:
+            LogFileLineDecoder();
+            void Decode(const char* line, size_t length, std::wstring& wline);
+
+            //! Are ASCII bytes decoded to the same characters (see LogFileMatcher)?
+            //! \returns true if the encoding is ASCII compatible
+            bool IsAsciiCompatible() const { return m_AsciiCompatible; }
+
+        private:
+            typedef std::codecvt<wchar_t, char, mbstate_t> Codecvt;
+
+            std::locale m_Locale;               //!< Locale to decode with
+            const Codecvt* m_Codecvt;           //!< Conversion facet of m_Locale
+            bool m_AsciiCompatible;             //!< Can ASCII bytes be copied as is?
+            std::vector<wchar_t> m_Buffer;      //!< Conversion buffer
         };
 
     public:
+        //! Default max number of matched rows returned by a read (what fits in one
+        //! response: 1000 rows from scx log file does not work, 750 does)
+        static const size_t cDefaultMaxRows = 500;
+        //! Default max number of bytes returned by a read
+        static const size_t cDefaultMaxBytes = 60 * 1024;
+        //! Largest number of rows a caller may ask for in one read: what still
+        //! fits in one response (a burst is drained in several reads, each
+        //! resuming where the previous one stopped)
+        static const size_t cMaxRowsLimit = 750;
+        //! Largest number of bytes a caller may ask for in one read
+        static const size_t cMaxBytesLimit = 2 * cDefaultMaxBytes;
+
         LogFileReader();
         ~LogFileReader() {}
 
@@ -96,7 +223,10 @@ namespace SCXCore
             const std::wstring& filename,
             const std::wstring& qid,
             const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
-            std::vector<std::wstring>& matchedLines);
+            std::vector<std::wstring>& matchedLines,
+            size_t maxRows = cDefaultMaxRows,
+            size_t maxBytes = cDefaultMaxBytes,
+            std::wstring* resumePosition = NULL);
 
         int ResetLogFileState(
             const std::wstring& filename,
@@ -105,8 +235,15 @@ namespace SCXCore
 
         int ResetAllLogFileStates(const std::wstring& path, bool resetOnRead);
 
+        void UseStateStore(const std::wstring& basePath);
+
         // Public solely for unit tests ...
         void SetPersistMedia(SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> persistMedia);
+        SCXCoreLib::SCXHandle<LogFileMatcher> GetMatcher(
+            const std::wstring& filename,
+            const std::wstring& qid,
+            const std::vector<SCXCoreLib::SCXRegexWithIndex>& regexps,
+            bool asciiCompatible);
 
     protected:
         /**
@@ -121,15 +258,55 @@ namespace SCXCore
             bool statvalid;          //!< statinfo valid flag
         };
 
+        /**
+            A reader of a log file (a log file and qid), as of its last read.
+
+            While one qid reads a log file, the new lines are also matched for
+            the other qids reading the same file (by device and inode), and the
+            resulting rows are kept as pending until those qids read the file
+            themselves. Their state isn't persisted until then, so pending rows
+            are only used if the qid resumes exactly where they start.
+        */
+        class SCXLogFileConsumer
+        {
+        public:
+            SCXLogFileConsumer() : dev(0), ino(0), pos(0), pendingStart(-1), pendingEnd(-1), pendingBytes(0), pendingFull(false) {}
+
+            //! Drop any pending rows
+            void ClearPending()
+            {
+                pendingStart = pendingEnd = -1;
+                pendingLines.clear();
+                pendingBytes = 0;
+                pendingFull = false;
+            }
+
+            scxulong dev;                                   //!< st_dev of the file at the last read
+            scxulong ino;                                   //!< st_ino of the file at the last read
+            std::streamoff pos;                             //!< Position following the last read
+            SCXCoreLib::SCXHandle<LogFileMatcher> matcher;  //!< Matcher of the last read
+            std::streamoff pendingStart;                    //!< Position of the first pending line (-1 if none)
+            std::streamoff pendingEnd;                      //!< Position following the last pending line
+            std::vector<std::wstring> pendingLines;         //!< Pending rows (as returned by ReadLogFile)
+            size_t pendingBytes;                            //!< Size of the pending rows
+            bool pendingFull;                               //!< Was the size limit of a read reached?
+        };
+
     private:
         std::wstring GetFileName(const std::wstring& query);
         SCXLogFile* GetLogFile(const std::wstring& filename);
         bool CheckFileWrap(const struct stat64& oldstatinfo, const struct stat64& newstatinfo);
+        bool MatchLine(const LogFileMatcher& matcher, const std::wstring& line, unsigned int rowNumber, std::wstring& row);
+        static std::wstring FormatResumePosition(scxulong dev, scxulong ino, std::streamoff pos);
+        static bool ParseResumePosition(const std::wstring& resumePosition, scxulong dev, scxulong ino, std::streamoff& pos);
 
         std::vector<SCXLogFile> m_files;   //!< log files
+        std::map<std::pair<std::wstring, std::wstring>, SCXCoreLib::SCXHandle<LogFileMatcher> > m_matchers; //!< Matchers by log file and qid
+        std::map<std::pair<std::wstring, std::wstring>, SCXLogFileConsumer> m_consumers; //!< Readers by log file and qid
 
         SCXCoreLib::SCXLogHandle m_log; //!< Handle to log framework.
         SCXCoreLib::SCXHandle<SCXCoreLib::SCXPersistMedia> m_persistMedia; //!< Persist media to use
+        SCXCoreLib::SCXHandle<LogFileStateStore> m_stateStore; //!< State store to use (if any) rather than m_persistMedia
         SCXCoreLib::SCXPatternFinder m_cqlPatterns; //!< Supported cql patterns finder.
         static const SCXCoreLib::SCXPatternFinder::SCXPatternCookie s_patternID; //!< Supported pattern identifier.
         static const std::wstring s_pattern; //!< The actual pattern supported
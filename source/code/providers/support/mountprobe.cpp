@@ -0,0 +1,336 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      mountprobe.cpp
+
+    \brief     Probing of mount points with a deadline, so a hung (typically NFS
+               or CIFS) file system doesn't block the file system providers
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/logsuppressor.h>
+#include <scxcorelib/scxassert.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxlog.h>
+#include <scxcorelib/stringaid.h>
+
+#include <sys/statvfs.h>
+
+#include "mountprobe.h"
+#include "snapshotpublisher.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Time (in milliseconds) after which a request waiting for probes checks its deadline
+    const scxulong cWaitTick = 50;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Probe a mount point like the PAL does when it updates a file system
+
+       The result doesn't matter: a mount point that fails right away is not
+       hung, and the PAL reports the failure itself.
+
+       \param[in] path  Mount point to probe
+    */
+    void StatVfs(const std::string& path)
+    {
+        struct statvfs buf;
+        ::statvfs(path.c_str(), &buf);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parameter of a probe thread of a MountProbe
+    */
+    class MountProbeThreadParam : public SCXThreadParam
+    {
+    public:
+        //! Constructor
+        //! \param[in] probe       Probe to report to
+        //! \param[in] function    Function probing the mount point
+        //! \param[in] mountPoint  Mount point to probe
+        MountProbeThreadParam(SCXCore::MountProbe* probe, SCXCore::MountProbe::ProbeFunction function,
+                              const std::wstring& mountPoint) :
+            SCXThreadParam(), m_probe(probe), m_function(function), m_mountPoint(mountPoint)
+        {
+        }
+
+        SCXCore::MountProbe* m_probe;                   //!< Probe to report to
+        SCXCore::MountProbe::ProbeFunction m_function;  //!< Function probing the mount point
+        std::wstring m_mountPoint;                      //!< Mount point to probe
+    };
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - nothing is known of the mount point
+    */
+    MountProbe::MountState::MountState() :
+        probing(false), late(false), started(0), responded(0), timeouts(0), quarantinedUntil(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - the probe has the default limits, and probes with statvfs()
+    */
+    MountProbe::MountProbe() :
+        m_function(StatVfs),
+        m_timeout(cDefaultTimeout),
+        m_maxTimeouts(cDefaultMaxTimeouts),
+        m_quarantine(cDefaultQuarantine),
+        m_responseMaxAge(cDefaultResponseMaxAge)
+    {
+        m_cond.SetSleep(cWaitTick);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the limits of the probes
+
+       \param[in] timeout         Time (in milliseconds) a probe may take
+       \param[in] maxTimeouts     Number of missed deadlines in a row before a mount
+                                  point is quarantined (0 to never quarantine)
+       \param[in] quarantine      Time (in milliseconds) a mount point stays quarantined
+       \param[in] responseMaxAge  Time (in milliseconds) a response is trusted without
+                                  probing again (0 to probe on every request)
+    */
+    void MountProbe::SetLimits(scxulong timeout, unsigned int maxTimeouts, scxulong quarantine, scxulong responseMaxAge)
+    {
+        SCXConditionHandle h(m_cond);
+        m_timeout = timeout;
+        m_maxTimeouts = maxTimeouts;
+        m_quarantine = quarantine;
+        m_responseMaxAge = responseMaxAge;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the function probing the mount points (for tests)
+
+       \param[in] function  Function called on the probe threads
+    */
+    void MountProbe::SetProbeFunction(ProbeFunction function)
+    {
+        SCXConditionHandle h(m_cond);
+        m_function = function;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Probe one mount point
+
+       \param[in] mountPoint  Mount point to probe
+       \returns   State of the mount point
+    */
+    MountProbe::Status MountProbe::Probe(const std::wstring& mountPoint)
+    {
+        std::vector<std::wstring> mountPoints(1, mountPoint);
+        std::vector<Status> statuses;
+        Probe(mountPoints, statuses);
+        return statuses[0];
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Probe mount points, all at the same time
+
+       Returns once every probe has returned, or at the deadline (whichever
+       comes first): a request waits at most for one timeout, whatever the
+       number of mount points.
+
+       \param[in]  mountPoints  Mount points to probe
+       \param[out] statuses     State of each mount point, in the same order
+    */
+    void MountProbe::Probe(const std::vector<std::wstring>& mountPoints, std::vector<Status>& statuses)
+    {
+        statuses.assign(mountPoints.size(), eAvailable);
+        std::vector<size_t> waiting;
+
+        SCXConditionHandle h(m_cond);
+        scxulong now = GetSnapshotTime();
+        for (size_t i = 0; i < mountPoints.size(); i++)
+        {
+            MountState& state = m_mounts[mountPoints[i]];
+            if (now < state.quarantinedUntil)
+            {
+                statuses[i] = eQuarantined;
+            }
+            else if (state.probing)
+            {
+                // Don't wait again for a probe that has already missed its deadline
+                if (state.late)
+                {
+                    statuses[i] = eUnresponsive;
+                }
+                else
+                {
+                    waiting.push_back(i);
+                }
+            }
+            else if (0 == state.responded || now < state.responded || now - state.responded >= m_responseMaxAge)
+            {
+                state.probing = true;
+                state.late = false;
+                state.started = now;
+
+                // The thread runs detached: it may outlive the request, and even never return
+                SCXThread(ThreadBody, new MountProbeThreadParam(this, m_function, mountPoints[i]));
+                waiting.push_back(i);
+            }
+        }
+
+        scxulong deadline = now + m_timeout;
+        for (;;)
+        {
+            bool done = true;
+            for (std::vector<size_t>::const_iterator it = waiting.begin(); done && it != waiting.end(); ++it)
+            {
+                done = !m_mounts[mountPoints[*it]].probing;
+            }
+            if (done || GetSnapshotTime() >= deadline)
+            {
+                break;
+            }
+            h.Wait();
+        }
+
+        now = GetSnapshotTime();
+        for (std::vector<size_t>::const_iterator it = waiting.begin(); it != waiting.end(); ++it)
+        {
+            MountState& state = m_mounts[mountPoints[*it]];
+            if (state.probing)
+            {
+                Missed(mountPoints[*it], state, now);
+                statuses[*it] = now < state.quarantinedUntil ? eQuarantined : eUnresponsive;
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Forget the mount points, except for the ones still being probed (their
+       probe thread reports to them, and no other may be started meanwhile)
+    */
+    void MountProbe::Clear()
+    {
+        SCXConditionHandle h(m_cond);
+        std::map<std::wstring, MountState>::iterator it = m_mounts.begin();
+        while (it != m_mounts.end())
+        {
+            std::map<std::wstring, MountState>::iterator current = it++;
+            if (!current->second.probing)
+            {
+                m_mounts.erase(current);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Name of a state, for the instances of the providers and for the log
+
+       \param[in] status  State of a mount point
+       \returns   Name of the state
+    */
+    const char* MountProbe::GetStatusName(Status status)
+    {
+        switch (status)
+        {
+        case eAvailable:
+            return "Available";
+        case eUnresponsive:
+            return "Unresponsive";
+        case eQuarantined:
+            return "Quarantined";
+        }
+        return "Unknown";
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Account for a probe that missed its deadline, quarantining the mount
+       point if it missed too many in a row
+
+       Caller holds m_cond.
+
+       \param[in]     mountPoint  Mount point probed
+       \param[in,out] state       What is known of the mount point
+       \param[in]     now         Current time (see GetSnapshotTime())
+    */
+    void MountProbe::Missed(const std::wstring& mountPoint, MountState& state, scxulong now)
+    {
+        // Requests waiting together for the same probe count it once
+        if (state.late)
+        {
+            return;
+        }
+        state.late = true;
+        state.timeouts++;
+
+        SCXLogHandle log = SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.mountprobe");
+        if (m_maxTimeouts > 0 && state.timeouts >= m_maxTimeouts)
+        {
+            state.quarantinedUntil = now + m_quarantine;
+            state.timeouts = 0;
+            SCX_LOGWARNING(log, StrAppend(StrAppend(StrAppend(L"Mount point " + mountPoint + L" missed ", m_maxTimeouts),
+                                                    L" deadlines in a row, not probing it for (ms): "), m_quarantine));
+        }
+        else
+        {
+            static LogSuppressor suppressor(eWarning, eTrace);
+            SCX_LOG(log, suppressor.GetSeverity(mountPoint),
+                    StrAppend(L"Mount point " + mountPoint + L" did not respond within (ms): ", m_timeout));
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Body of a probe thread
+
+       \param[in] param  A MountProbeThreadParam
+    */
+    void MountProbe::ThreadBody(SCXThreadParamHandle& param)
+    {
+        MountProbeThreadParam* p = static_cast<MountProbeThreadParam*>(param.GetData());
+        SCXASSERT(NULL != p);
+
+        try
+        {
+            p->m_function(StrToMultibyte(p->m_mountPoint));
+        }
+        catch (const SCXException& e)
+        {
+            SCX_LOGWARNING(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.mountprobe"),
+                           StrAppend(L"Probe of " + p->m_mountPoint + L" failed: ", e.What()));
+        }
+
+        MountProbe* probe = p->m_probe;
+        SCXConditionHandle h(probe->m_cond);
+        MountState& state = probe->m_mounts[p->m_mountPoint];
+        state.probing = false;
+
+        // Only a response in time ends a series of missed deadlines, and is trusted:
+        // a slow mount point is probed again, until it is quarantined
+        if (!state.late)
+        {
+            state.responded = GetSnapshotTime();
+            state.timeouts = 0;
+        }
+        state.late = false;
+        h.Broadcast();
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
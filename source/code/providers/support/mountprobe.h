@@ -0,0 +1,119 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      mountprobe.h
+
+    \brief     Probing of mount points with a deadline, so a hung (typically NFS
+               or CIFS) file system doesn't block the file system providers
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef MOUNTPROBE_H
+#define MOUNTPROBE_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxcondition.h>
+#include <scxcorelib/scxthread.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Tells whether mount points respond, before the PAL is asked to update them
+
+       The PAL updates a file system with statvfs(), which doesn't return while
+       the server of a network file system is unreachable. Each mount point is
+       therefore probed first with the same call, on a thread of its own, and
+       only mount points whose probe returned before the deadline are updated.
+
+       A probe that misses the deadline is left running (there is no way to
+       interrupt it), and no other probe of the same mount point is started
+       until it returns: requests see the mount point as unresponsive right
+       away instead of waiting for it again. There is thus at most one probe
+       thread per mount point. A mount point missing the deadline several
+       times in a row (a slow rather than a dead server) is quarantined for a
+       while: it isn't probed at all and is reported as such.
+
+       A mount point that responded recently is not probed again, so that
+       back-to-back requests don't start threads for nothing.
+
+       This class is thread safe.
+    */
+    class MountProbe
+    {
+    public:
+        //! State of a mount point, as seen by the last probe
+        enum Status
+        {
+            eAvailable,         //!< The mount point responded in time
+            eUnresponsive,      //!< The probe missed the deadline (and may still be running)
+            eQuarantined        //!< The mount point missed too many deadlines, and isn't probed for now
+        };
+
+        //! Function probing a mount point (::statvfs() unless testing)
+        //! \param[in] path  Mount point to probe
+        typedef void (*ProbeFunction)(const std::string& path);
+
+        //! Default time (in milliseconds) a probe may take
+        static const scxulong cDefaultTimeout = 2000;
+        //! Default number of missed deadlines in a row before a mount point is quarantined
+        static const unsigned int cDefaultMaxTimeouts = 3;
+        //! Default time (in milliseconds) a mount point stays quarantined
+        static const scxulong cDefaultQuarantine = 300000;
+        //! Default time (in milliseconds) a response is trusted without probing again
+        static const scxulong cDefaultResponseMaxAge = 1000;
+
+        MountProbe();
+
+        void SetLimits(scxulong timeout, unsigned int maxTimeouts, scxulong quarantine, scxulong responseMaxAge);
+        void SetProbeFunction(ProbeFunction function);
+
+        Status Probe(const std::wstring& mountPoint);
+        void Probe(const std::vector<std::wstring>& mountPoints, std::vector<Status>& statuses);
+        void Clear();
+
+        static const char* GetStatusName(Status status);
+
+    private:
+        //! What is known of a mount point
+        struct MountState
+        {
+            MountState();
+
+            bool probing;               //!< Is a probe running?
+            bool late;                  //!< Has the running probe missed its deadline?
+            scxulong started;           //!< Time (ms) when the running probe started
+            scxulong responded;         //!< Time (ms) of the last response (0 for none)
+            unsigned int timeouts;      //!< Number of deadlines missed in a row
+            scxulong quarantinedUntil;  //!< Time (ms) when the quarantine ends (0 for none)
+        };
+
+        //! Not copyable
+        MountProbe(const MountProbe&);
+        MountProbe& operator=(const MountProbe&);
+
+        void Missed(const std::wstring& mountPoint, MountState& state, scxulong now);
+
+        static void ThreadBody(SCXCoreLib::SCXThreadParamHandle& param);
+
+        //! Guards all members below, and wakes up the requests waiting for probes
+        SCXCoreLib::SCXCondition m_cond;
+
+        std::map<std::wstring, MountState> m_mounts;    //!< Known mount points
+        ProbeFunction m_function;                       //!< Function probing a mount point
+        scxulong m_timeout;                             //!< Time (ms) a probe may take
+        unsigned int m_maxTimeouts;                     //!< Missed deadlines in a row before quarantine
+        scxulong m_quarantine;                          //!< Time (ms) a mount point stays quarantined
+        scxulong m_responseMaxAge;                      //!< Time (ms) a response is trusted
+    };
+}
+
+#endif /* MOUNTPROBE_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
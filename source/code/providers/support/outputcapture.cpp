@@ -0,0 +1,182 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     outputcapture.cpp
+
+    \brief    Bounded capture of the output of the RunAs commands
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/stringaid.h>
+
+#include "outputcapture.h"
+
+#include <langinfo.h>
+#include <string.h>
+
+using namespace std;
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] capacity  Maximum number of bytes kept
+    */
+    CaptureBuffer::CaptureBuffer(size_t capacity) :
+        m_capacity(capacity),
+        m_discarded(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write one character (the buffer has no put area, every write ends here
+       or in xsputn())
+
+       \param[in] c  Character written
+       \returns   c, or not_eof(c) for EOF: writes never fail, even when discarded
+    */
+    CaptureBuffer::int_type CaptureBuffer::overflow(int_type c)
+    {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            return traits_type::not_eof(c);
+        }
+
+        if (m_data.size() < m_capacity)
+        {
+            m_data.push_back(traits_type::to_char_type(c));
+        }
+        else
+        {
+            m_discarded++;
+        }
+        return c;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write a block of characters
+
+       \param[in] s  Characters written
+       \param[in] n  Number of characters written
+       \returns   n: writes never fail, even when discarded
+    */
+    std::streamsize CaptureBuffer::xsputn(const char* s, std::streamsize n)
+    {
+        size_t room = m_capacity - m_data.size();
+        size_t kept = static_cast<size_t>(n) < room ? static_cast<size_t>(n) : room;
+
+        m_data.append(s, kept);
+        m_discarded += static_cast<size_t>(n) - kept;
+        return n;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] capacity  Maximum number of bytes kept
+    */
+    OutputCapture::OutputCapture(size_t capacity) :
+        std::ostream(NULL),
+        m_buffer(capacity)
+    {
+        // The buffer is constructed after the base class
+        rdbuf(&m_buffer);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Bytes kept, as UTF-8 (what OMI expects)
+
+       The output is passed through as is when our locale encoding is UTF-8,
+       and converted from the locale encoding otherwise.
+
+       \returns Bytes kept, in UTF-8
+    */
+    std::string OutputCapture::UTF8Str() const
+    {
+        if (IsUTF8Locale())
+        {
+            return Str();
+        }
+
+        try
+        {
+            return SCXCoreLib::StrToUTF8(SCXCoreLib::StrFromMultibyte(Str()));
+        }
+        catch (SCXCoreLib::SCXException&)
+        {
+            // Not in the locale encoding after all: better as is than nothing
+            return Str();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is the encoding of our locale (that commands are run with) UTF-8?
+
+       \returns true if the locale encoding is UTF-8
+    */
+    bool OutputCapture::IsUTF8Locale()
+    {
+        const char* codeset = nl_langinfo(CODESET);
+        return NULL != codeset
+            && (0 == strcasecmp(codeset, "UTF-8") || 0 == strcasecmp(codeset, "UTF8"));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Truncate a UTF-8 string, without splitting a character
+
+       A character already split at the end of the string (as when a capture
+       dropped the rest of the output) is removed too.
+
+       \param[in,out] str   String to truncate
+       \param[in]     size  Maximum size (in bytes) of the string
+       \returns       true if the string was truncated
+    */
+    bool OutputCapture::Truncate(std::string& str, size_t size)
+    {
+        if (size > str.size())
+        {
+            size = str.size();
+        }
+
+        // Back off to the first byte of the last character kept
+        size_t start = size;
+        while (start > 0 && 0x80 == (static_cast<unsigned char>(str[start - 1]) & 0xC0))
+        {
+            start--;
+        }
+
+        // Drop that character if it doesn't end within the size
+        if (start > 0)
+        {
+            unsigned char lead = static_cast<unsigned char>(str[start - 1]);
+            size_t length = (lead < 0x80) ? 1 : (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+            if (start - 1 + length > size)
+            {
+                size = start - 1;
+            }
+        }
+
+        if (str.size() == size)
+        {
+            return false;
+        }
+        str.erase(size);
+        return true;
+    }
+
+} // End of namespace SCXCore
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
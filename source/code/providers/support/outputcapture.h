@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     outputcapture.h
+
+    \brief    Bounded capture of the output of the RunAs commands
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef OUTPUTCAPTURE_H
+#define OUTPUTCAPTURE_H
+
+#include <scxcorelib/scxcmn.h>
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Stream buffer keeping the first bytes written to it, up to a fixed
+       capacity, and counting the bytes discarded beyond
+    */
+    class CaptureBuffer : public std::streambuf
+    {
+    public:
+        explicit CaptureBuffer(size_t capacity);
+
+        //! Bytes kept
+        //! \returns Bytes kept
+        const std::string& Str() const { return m_data; }
+        //! Number of bytes discarded because the buffer was full
+        //! \returns Number of bytes discarded
+        scxulong Discarded() const { return m_discarded; }
+
+    protected:
+        virtual int_type overflow(int_type c);
+        virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+    private:
+        std::string m_data;         //!< Bytes kept
+        size_t m_capacity;          //!< Maximum number of bytes kept
+        scxulong m_discarded;       //!< Number of bytes discarded
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Output stream handed to SCXProcess::Run for the stdout or stderr of a
+       RunAs command, instead of an ostringstream
+
+       A chatty command can't make the agent hold more than the capacity of
+       the stream: the first bytes are kept, the rest is read from the child
+       (so that it doesn't block on a full pipe) and dropped. The bytes kept
+       are the output of the command as is, in the encoding of our locale;
+       UTF8Str() only converts them when that encoding isn't UTF-8 already.
+    */
+    class OutputCapture : public std::ostream
+    {
+    public:
+        explicit OutputCapture(size_t capacity);
+
+        //! Bytes kept
+        //! \returns Bytes kept
+        const std::string& Str() const { return m_buffer.Str(); }
+        std::string UTF8Str() const;
+        //! Was any output dropped?
+        //! \returns true if the command wrote more than the capacity
+        bool Truncated() const { return m_buffer.Discarded() > 0; }
+
+        static bool Truncate(std::string& str, size_t size);
+        static bool IsUTF8Locale();
+
+    private:
+        CaptureBuffer m_buffer;     //!< Buffer of the stream
+    };
+
+} // End of namespace SCXCore
+
+#endif /* OUTPUTCAPTURE_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
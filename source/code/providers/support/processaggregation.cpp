@@ -0,0 +1,445 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     processaggregation.cpp
+
+    \brief    Roll-up of process statistics per user, per process name and per process tree.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/stringaid.h>
+
+#include "processaggregation.h"
+
+#include <map>
+#include <pwd.h>
+#include <sys/types.h>
+
+using namespace SCXCoreLib;
+
+namespace
+{
+    //! Prefixes of the group names, by SCXCore::ProcessGroup::GroupType
+    const char* const s_typeNames[] = { "User", "Name", "Tree" };
+
+    //! Children of each process, by parent process ID
+    typedef std::map<scxulong, std::vector<const SCXCore::ProcessSnapshotInstance*> > ChildMap;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check that a string is a decimal number, as formatted by StrFrom()
+
+       \param[in]  str  String to check
+       \returns    true if str is digits only, without leading zeros
+    */
+    bool IsNumber(const std::string& str)
+    {
+        if (str.empty() || (str.size() > 1 && '0' == str[0]))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < str.size(); i++)
+        {
+            if (str[i] < '0' || str[i] > '9')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the parent of a process, if it is in the snapshot
+
+       \param[in]  snapshot  Process snapshot
+       \param[in]  inst      Process
+       \param[in]  pid       Process ID of inst
+       \param[out] ppid      Parent process ID
+       \returns    true if the parent of the process is another process of the snapshot
+    */
+    bool GetParentInSnapshot(const SCXCore::ProcessSnapshot& snapshot,
+                             const SCXCore::ProcessSnapshotInstance& inst,
+                             scxulong pid, scxulong& ppid)
+    {
+        int parent = 0;
+        if (!inst.GetParentProcessID(parent) || parent <= 0)
+        {
+            return false;
+        }
+        ppid = static_cast<scxulong>(parent);
+        return ppid != pid && snapshot.GetInstanceByPid(ppid) != NULL;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is a process the root of a top-level process tree?
+
+       \param[in]  snapshot  Process snapshot
+       \param[in]  inst      Process
+       \param[out] pid       Process ID
+       \returns    true for a process other than init, started (or adopted) by
+                   init or whose parent isn't in the snapshot
+    */
+    bool IsTreeRoot(const SCXCore::ProcessSnapshot& snapshot,
+                    const SCXCore::ProcessSnapshotInstance& inst,
+                    scxulong& pid)
+    {
+        scxulong ppid = 0;
+        return inst.GetPID(pid) && 1 != pid
+            && (!GetParentInSnapshot(snapshot, inst, pid, ppid) || 1 == ppid);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Index the processes of a snapshot by parent
+
+       \param[in]  snapshot  Process snapshot
+       \param[out] children  Children of each process
+    */
+    void GetChildren(const SCXCore::ProcessSnapshot& snapshot, ChildMap& children)
+    {
+        for (size_t i = 0; i < snapshot.Size(); i++)
+        {
+            const SCXCore::ProcessSnapshotInstance& inst = snapshot.GetInstance(i);
+            scxulong pid = 0, ppid = 0;
+            if (inst.GetPID(pid) && GetParentInSnapshot(snapshot, inst, pid, ppid))
+            {
+                children[ppid].push_back(&inst);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add a process and all its descendants to a group
+
+       \param[in]  snapshot  Process snapshot
+       \param[in]  children  Children of each process
+       \param[in]  root      Root process of the tree
+       \param[out] group     Group to add the processes to
+
+       Parent process IDs are read one process at a time, so a snapshot taken
+       while processes come and go may contain a loop; at most Size() processes
+       are added.
+    */
+    void AddTree(const SCXCore::ProcessSnapshot& snapshot, const ChildMap& children,
+                 const SCXCore::ProcessSnapshotInstance* root, SCXCore::ProcessGroup& group)
+    {
+        std::vector<const SCXCore::ProcessSnapshotInstance*> pending(1, root);
+        size_t added = 0;
+        while (!pending.empty() && added < snapshot.Size())
+        {
+            const SCXCore::ProcessSnapshotInstance& inst = *pending.back();
+            pending.pop_back();
+            group.Add(inst);
+            added++;
+
+            scxulong pid = 0;
+            ChildMap::const_iterator it = children.end();
+            if (inst.GetPID(pid))
+            {
+                it = children.find(pid);
+            }
+            if (it != children.end())
+            {
+                pending.insert(pending.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor of an empty group
+
+       \param[in]  type   Kind of group
+       \param[in]  value  User ID, process name or root process ID
+    */
+    ProcessGroup::ProcessGroup(GroupType type, const std::string& value) :
+        m_type(type),
+        m_value(value),
+        m_processes(0)
+    {
+        for (size_t i = 0; i < eValueCount; i++)
+        {
+            m_sums[i] = 0;
+            m_present[i] = false;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add the values of a process to the group
+
+       \param[in]  inst  Process to add
+    */
+    void ProcessGroup::Add(const ProcessSnapshotInstance& inst)
+    {
+        scxulong values[eValueCount];
+        bool present[eValueCount];
+        present[ePercentUserTime] = inst.GetPercentUserTime(values[ePercentUserTime]);
+        present[ePercentPrivilegedTime] = inst.GetPercentPrivilegedTime(values[ePercentPrivilegedTime]);
+        present[eUsedMemory] = inst.GetUsedMemory(values[eUsedMemory]);
+        present[ePercentUsedMemory] = inst.GetPercentUsedMemory(values[ePercentUsedMemory]);
+        present[eBlockReadsPerSecond] = inst.GetBlockReadsPerSecond(values[eBlockReadsPerSecond]);
+        present[eBlockWritesPerSecond] = inst.GetBlockWritesPerSecond(values[eBlockWritesPerSecond]);
+        present[eBlockTransfersPerSecond] = inst.GetBlockTransfersPerSecond(values[eBlockTransfersPerSecond]);
+
+        for (size_t i = 0; i < eValueCount; i++)
+        {
+            if (present[i])
+            {
+                m_sums[i] += values[i];
+                m_present[i] = true;
+            }
+        }
+
+        if (0 == m_processes && eTree == m_type)
+        {
+            inst.GetName(m_rootName);
+        }
+        m_processes++;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the name of the group, as published in the Name key
+
+       \returns   "<type>:<value>"
+    */
+    std::string ProcessGroup::GetName() const
+    {
+        return GetTypeName() + ":" + m_value;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the name of the kind of group
+
+       \returns   "User", "Name" or "Tree"
+    */
+    std::string ProcessGroup::GetTypeName() const
+    {
+        return s_typeNames[m_type];
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a readable name for the group
+
+       \param[out] elementName  User name, process name or name of the root process
+       \returns    true if the group has a readable name
+
+       The user name is looked up when asked for, so that enumerations not
+       requesting it don't read the password database.
+    */
+    bool ProcessGroup::GetElementName(std::string& elementName) const
+    {
+        switch (m_type)
+        {
+        case eUser:
+        {
+            struct passwd pwbuf;
+            char buf[1024];
+            struct passwd* pw = NULL;
+            uid_t uid = static_cast<uid_t>(StrToULong(StrFromUTF8(m_value)));
+
+#if defined(sun)
+            if ((pw = getpwuid_r(uid, &pwbuf, buf, sizeof(buf))) == NULL)
+#else
+            if (getpwuid_r(uid, &pwbuf, buf, sizeof(buf), &pw) != 0 || !pw)
+#endif
+            {
+                return false;
+            }
+            elementName = pw->pw_name;
+            return true;
+        }
+        case eName:
+            elementName = m_value;
+            return true;
+        case eTree:
+            elementName = m_rootName;
+            return !m_rootName.empty();
+        }
+        return false;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the sum of a value over the processes of the group
+
+       \param[in]  value  Value to get
+       \param[out] sum    Sum over the processes that have the value
+       \returns    false if no process of the group has the value
+    */
+    bool ProcessGroup::GetSum(Value value, scxulong& sum) const
+    {
+        sum = m_sums[value];
+        return m_present[value];
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse the name of a group
+
+       \param[in]  name   Group name, "<type>:<value>"
+       \param[out] type   Kind of group
+       \param[out] value  User ID, process name or root process ID
+       \returns    false if name is not the name of a group
+    */
+    bool ProcessGroup::ParseName(const std::string& name, GroupType& type, std::string& value)
+    {
+        size_t colon = name.find(':');
+        if (std::string::npos == colon)
+        {
+            return false;
+        }
+
+        std::string typeName = name.substr(0, colon);
+        value = name.substr(colon + 1);
+        for (size_t i = 0; i < sizeof(s_typeNames) / sizeof(s_typeNames[0]); i++)
+        {
+            if (typeName == s_typeNames[i])
+            {
+                type = static_cast<GroupType>(i);
+                return eName == type ? !value.empty() : IsNumber(value);
+            }
+        }
+        return false;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Roll up the processes of a snapshot in all groups
+
+       \param[in]  snapshot  Process snapshot
+       \param[out] groups    One group per user, per process name and per top-level process tree
+
+       Each process is in exactly one group of each kind, except init, which is
+       in no tree.
+    */
+    void ProcessGroup::Aggregate(const ProcessSnapshot& snapshot, std::vector<ProcessGroup>& groups)
+    {
+        std::map<scxulong, ProcessGroup> users;
+        std::map<std::string, ProcessGroup> names;
+        std::vector<const ProcessSnapshotInstance*> roots;
+
+        for (size_t i = 0; i < snapshot.Size(); i++)
+        {
+            const ProcessSnapshotInstance& inst = snapshot.GetInstance(i);
+
+            scxulong uid = 0;
+            if (inst.GetRealUserID(uid))
+            {
+                std::map<scxulong, ProcessGroup>::iterator it = users.find(uid);
+                if (it == users.end())
+                {
+                    it = users.insert(std::make_pair(uid, ProcessGroup(eUser, StrToUTF8(StrFrom(uid))))).first;
+                }
+                it->second.Add(inst);
+            }
+
+            std::string name;
+            if (inst.GetName(name) && !name.empty())
+            {
+                std::map<std::string, ProcessGroup>::iterator it = names.find(name);
+                if (it == names.end())
+                {
+                    it = names.insert(std::make_pair(name, ProcessGroup(eName, name))).first;
+                }
+                it->second.Add(inst);
+            }
+
+            scxulong pid = 0;
+            if (IsTreeRoot(snapshot, inst, pid))
+            {
+                roots.push_back(&inst);
+            }
+        }
+
+        ChildMap children;
+        GetChildren(snapshot, children);
+
+        groups.clear();
+        groups.reserve(users.size() + names.size() + roots.size());
+        for (std::map<scxulong, ProcessGroup>::const_iterator it = users.begin(); it != users.end(); ++it)
+        {
+            groups.push_back(it->second);
+        }
+        for (std::map<std::string, ProcessGroup>::const_iterator it = names.begin(); it != names.end(); ++it)
+        {
+            groups.push_back(it->second);
+        }
+        for (std::vector<const ProcessSnapshotInstance*>::const_iterator it = roots.begin(); it != roots.end(); ++it)
+        {
+            scxulong pid = 0;
+            (*it)->GetPID(pid);
+            groups.push_back(ProcessGroup(eTree, StrToUTF8(StrFrom(pid))));
+            AddTree(snapshot, children, *it, groups.back());
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Roll up the processes of one group
+
+       \param[in]  snapshot  Process snapshot
+       \param[in]  name      Name of the group, "<type>:<value>"
+       \param[out] group     The group
+       \returns    false if name is not a group name or no process is in the group
+
+       Like with Aggregate(), a tree is only a group if rooted at a top-level
+       process.
+    */
+    bool ProcessGroup::Aggregate(const ProcessSnapshot& snapshot, const std::string& name, ProcessGroup& group)
+    {
+        GroupType type = eUser;
+        std::string value;
+        if (!ParseName(name, type, value))
+        {
+            return false;
+        }
+
+        group = ProcessGroup(type, value);
+        if (eTree == type)
+        {
+            scxulong pid = StrToULong(StrFromUTF8(value));
+            const ProcessSnapshotInstance* root = snapshot.GetInstanceByPid(pid);
+            if (NULL == root || !IsTreeRoot(snapshot, *root, pid))
+            {
+                return false;
+            }
+
+            ChildMap children;
+            GetChildren(snapshot, children);
+            AddTree(snapshot, children, root, group);
+        }
+        else
+        {
+            for (size_t i = 0; i < snapshot.Size(); i++)
+            {
+                const ProcessSnapshotInstance& inst = snapshot.GetInstance(i);
+                scxulong uid = 0;
+                std::string processName;
+                if (eUser == type ? (inst.GetRealUserID(uid) && StrToUTF8(StrFrom(uid)) == value)
+                                  : (inst.GetName(processName) && processName == value))
+                {
+                    group.Add(inst);
+                }
+            }
+        }
+
+        return group.GetNumberOfProcesses() > 0;
+    }
+
+} // End of namespace SCXCore
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,100 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     processaggregation.h
+
+    \brief    Roll-up of process statistics per user, per process name and per process tree.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef PROCESSAGGREGATION_H
+#define PROCESSAGGREGATION_H
+
+#include <scxcorelib/scxcmn.h>
+#include "processsnapshot.h"
+
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Statistics summed over a group of processes of a process snapshot
+
+       A group is either all processes of one real user, all processes with
+       the same name, or a process tree: a process and all its descendants.
+       Groups are named "<type>:<value>", for instance "User:0", "Name:httpd"
+       or "Tree:1234", which is the key published by the CIM class.
+
+       The tree groups returned by Aggregate() are rooted at the top-level
+       processes, i.e. the ones started (or adopted) by init and the ones
+       whose parent isn't in the snapshot; init itself is not reported as a
+       tree, since its tree would be the whole system.
+    */
+    class ProcessGroup
+    {
+    public:
+        //! Kind of group
+        enum GroupType
+        {
+            eUser = 0,  //!< All processes of a real user ID
+            eName,      //!< All processes with the same name
+            eTree       //!< A process and all its descendants
+        };
+
+        //! Values summed over the processes of the group
+        enum Value
+        {
+            ePercentUserTime = 0,
+            ePercentPrivilegedTime,
+            eUsedMemory,
+            ePercentUsedMemory,
+            eBlockReadsPerSecond,
+            eBlockWritesPerSecond,
+            eBlockTransfersPerSecond,
+            eValueCount         //!< Number of values (not a value)
+        };
+
+        ProcessGroup(GroupType type, const std::string& value);
+
+        void Add(const ProcessSnapshotInstance& inst);
+
+        //! Kind of group
+        //! \returns Group type
+        GroupType GetType() const { return m_type; }
+
+        //! User ID, process name or root process ID of the group
+        //! \returns Group value
+        const std::string& GetValue() const { return m_value; }
+
+        //! Number of processes in the group
+        //! \returns Number of processes
+        unsigned int GetNumberOfProcesses() const { return m_processes; }
+
+        std::string GetName() const;
+        std::string GetTypeName() const;
+        bool GetElementName(std::string& elementName) const;
+        bool GetSum(Value value, scxulong& sum) const;
+
+        static bool ParseName(const std::string& name, GroupType& type, std::string& value);
+
+        static void Aggregate(const ProcessSnapshot& snapshot, std::vector<ProcessGroup>& groups);
+        static bool Aggregate(const ProcessSnapshot& snapshot, const std::string& name, ProcessGroup& group);
+
+    private:
+        GroupType m_type;                   //!< Kind of group
+        std::string m_value;                //!< User ID, process name or root process ID
+        std::string m_rootName;             //!< Name of the root process (tree groups only)
+        unsigned int m_processes;           //!< Number of processes added
+        scxulong m_sums[eValueCount];       //!< Sum of each value over the processes that have it
+        bool m_present[eValueCount];        //!< Whether any process had the value
+    };
+
+} // End of namespace SCXCore
+
+#endif /* PROCESSAGGREGATION_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
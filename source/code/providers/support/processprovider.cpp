@@ -15,6 +15,7 @@
 #include <scxcorelib/scxlog.h>
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxthreadlock.h>
 #include <scxcorelib/stringaid.h>
 
 #include <sstream>
@@ -27,33 +28,124 @@ using namespace SCXCoreLib;
 
 namespace SCXCore
 {
+    /*----------------------------------------------------------------------------*/
+    /**
+        Sampler of the process provider (see SamplingScheduler)
+    */
+    static void SampleProcesses()
+    {
+        g_ProcessProvider.Sample();
+    }
 
     /*----------------------------------------------------------------------------*/
     /**
-        Struct used for sorting on a specific value
+        Compare two resource consumers, for a heap keeping the largest consumers
+
+        \param[in]     c1   First consumer to compare
+        \param[in]     c2   Second consumer to compare
+
+        \returns       true if c1 uses more of the resource than c2
     */
-    struct ProcessInstanceSort 
+    static bool CompareConsumers(const ProcessProvider::ResourceConsumer& c1, const ProcessProvider::ResourceConsumer& c2)
     {
-        ProcessInstanceSort() : procinst(0), value(0){}
+        return c1.value > c2.value;
+    }
 
-        //! Pointer to instance containing all values
-        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> procinst;
-        //! Copy of value to sort on
-        scxulong value;
+    //! Resources processes can be ranked on (see TopResourceConsumers)
+    enum Resource
+    {
+        eCPUTime,
+        eBlockReadsPerSecond,
+        eBlockWritesPerSecond,
+        eBlockTransfersPerSecond,
+        ePercentUserTime,
+        ePercentPrivilegedTime,
+        eUsedMemory,
+        ePercentUsedMemory,
+        ePagesReadPerSec
     };
 
+    //! Names of the resources
+    static const struct
+    {
+        const wchar_t* name;    //!< Name of the resource, as passed to TopResourceConsumers
+        Resource resource;      //!< The resource
+    } s_resourceNames[] =
+    {
+        { L"CPUTime",                   eCPUTime },
+        { L"BlockReadsPerSecond",       eBlockReadsPerSecond },
+        { L"BlockWritesPerSecond",      eBlockWritesPerSecond },
+        { L"BlockTransfersPerSecond",   eBlockTransfersPerSecond },
+        { L"PercentUserTime",           ePercentUserTime },
+        { L"PercentPrivilegedTime",     ePercentPrivilegedTime },
+        { L"UsedMemory",                eUsedMemory },
+        { L"PercentUsedMemory",         ePercentUsedMemory },
+        { L"PagesReadPerSec",           ePagesReadPerSec }
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the value of a resource for a process
+
+        \param[in]     resource      Resource to get
+        \param[in]     processinst   Process to get the resource of
+        \param[out]    value         Value of the resource
+
+        \returns       true if the process has a value for the resource
+    */
+    static bool GetResourceValue(Resource resource, const ProcessSnapshotInstance& processinst, scxulong& value)
+    {
+        switch (resource)
+        {
+        case eCPUTime:
+        {
+            unsigned int cputime = 0;
+            bool gotResource = processinst.GetCPUTime(cputime);
+            value = static_cast<scxulong>(cputime);
+            return gotResource;
+        }
+        case eBlockReadsPerSecond:
+            return processinst.GetBlockReadsPerSecond(value);
+        case eBlockWritesPerSecond:
+            return processinst.GetBlockWritesPerSecond(value);
+        case eBlockTransfersPerSecond:
+            return processinst.GetBlockTransfersPerSecond(value);
+        case ePercentUserTime:
+            return processinst.GetPercentUserTime(value);
+        case ePercentPrivilegedTime:
+            return processinst.GetPercentPrivilegedTime(value);
+        case eUsedMemory:
+            return processinst.GetUsedMemory(value);
+        case ePercentUsedMemory:
+            return processinst.GetPercentUsedMemory(value);
+        case ePagesReadPerSec:
+            return processinst.GetPagesReadPerSec(value);
+        }
+
+        return false;
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
-        Compare two ProcessInstanceSort structs
+        Look up a resource by name (case insensitive)
 
-        \param[in]     p1   First struct to comapare
-        \param[in]     p2   Second struct to compare
+        \param[in]     name      Name of the resource
 
-        \returns       true if value in p1 is greater then in p2
+        \returns       The resource
+
+        \throws        ProcessProvider::UnknownResourceException    If no resource has this name
     */
-    static bool CompareProcSort(ProcessInstanceSort p1, ProcessInstanceSort p2)
+    static Resource GetResourceByName(const std::wstring& name)
     {
-        return p1.value > p2.value;
+        for (size_t i = 0; i < sizeof(s_resourceNames) / sizeof(s_resourceNames[0]); i++)
+        {
+            if (StrCompare(name, s_resourceNames[i].name, true) == 0)
+            {
+                return s_resourceNames[i].resource;
+            }
+        }
+
+        throw ProcessProvider::UnknownResourceException(name, SCXSRCLOCATION);
     }
 
     void ProcessProvider::Load()
@@ -65,10 +157,17 @@ namespace SCXCore
             LogStartup();
             SCX_LOGTRACE(m_log, L"ProcessProvider::Load()");
 
+            ReadConfiguration();
+
             // UnixProcess provider
             SCXASSERT( NULL == m_processes );
             m_processes = new ProcessEnumeration();
             m_processes->Init();
+
+            if (0 != m_sampleInterval)
+            {
+                g_SamplingScheduler.Register(L"ProcessProvider", SampleProcesses, m_sampleInterval);
+            }
         }
     }
 
@@ -79,112 +178,298 @@ namespace SCXCore
         SCXASSERT( ms_loadCount >= 1 );
         if ( 0 == --ms_loadCount )
         {
+            g_SamplingScheduler.Unregister(L"ProcessProvider");
+
+            // Requests no longer hold the ProcessProvider lock while refreshing
+            SCXCoreLib::SCXThreadLock lock(m_snapshots.GetRefreshLock());
+
             if (m_processes != NULL)
             {
                 m_processes->CleanUp();
                 m_processes = NULL;
             }
+
+            m_snapshots.Publish(SCXHandle<ProcessSnapshot>(0));
+            m_lastSnapshot = NULL;
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read provider settings from the SCX configuration file
+        (ProcessProvider_SnapshotMaxAgeMs and ProcessProvider_SampleIntervalMs,
+        see ReadSamplingConfiguration())
+    */
+    void ProcessProvider::ReadConfiguration()
+    {
+        m_snapshotMaxAge = cDefaultSnapshotMaxAge;
+        m_sampleInterval = cDefaultSampleInterval;
+        ReadSamplingConfiguration(m_log, L"ProcessProvider", m_snapshotMaxAge, m_sampleInterval);
+    }
 
     /*----------------------------------------------------------------------------*/
     /**
-        Get the value for the spcified resource from a specified instance
+        Get a snapshot of all processes, shared by the requests while it is
+        younger than the configured maximum age
 
-        \param[in]     resource      Name of resource to get
-        \param[in]     processinst   Instance to get resource from
+        The caller need not hold the ProcessProvider lock.
 
-        \returns       Value for specifed resource
+        \returns      Snapshot of all processes
+    */
+    SCXHandle<ProcessSnapshot> ProcessProvider::GetSnapshot()
+    {
+        return m_snapshots.GetOrRefresh(GetSnapshotTime(), m_snapshotMaxAge,
+                                        MakeSnapshotTaker(this, &ProcessProvider::TakeSnapshot));
+    }
 
-        \throws        SCXInternalErrorException    If given resource not handled
+    /*----------------------------------------------------------------------------*/
+    /**
+        Refresh the snapshot in the background (called by g_SamplingScheduler)
     */
-    scxulong ProcessProvider::GetResource(const std::wstring &resource, SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processinst)
+    void ProcessProvider::Sample()
     {
+        m_snapshots.SampleIfNeeded(m_snapshotMaxAge, m_sampleInterval, SamplingScheduler::cDemandTimeout,
+                                   MakeSnapshotTaker(this, &ProcessProvider::TakeSnapshot));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Walk the process table into a new snapshot, tracking the changes since the previous one
 
-        scxulong res = 0;
-        bool gotResource = false;
+        Caller must hold the refresh lock of the snapshots.
 
-        if (StrCompare(resource, L"CPUTime", true) == 0)
-        {
-            unsigned int cputime;
-            gotResource = processinst->GetCPUTime(cputime);
-            res = static_cast<scxulong>(cputime);
-        }
-        else if (StrCompare(resource, L"BlockReadsPerSecond", true) == 0)
+        \returns      Snapshot of all processes
+    */
+    SCXHandle<ProcessSnapshot> ProcessProvider::TakeSnapshot()
+    {
+        SCXHandle<ProcessSnapshot> snapshot(new ProcessSnapshot(GetSnapshotTime()));
         {
-            gotResource = processinst->GetBlockReadsPerSecond(res);
+            SCXCoreLib::SCXThreadLock lock(m_processes->GetLockHandle());
+
+            m_processes->UpdateNoLock();
+            for (size_t i = 0; i < m_processes->Size(); i++)
+            {
+                snapshot->AddInstance(m_processes->GetInstance(i), m_processes->GetLockHandle());
+            }
         }
-        else if (StrCompare(resource, L"BlockWritesPerSecond", true) == 0)
+
+        // Generations follow the clock so that they keep growing across restarts of the agent
+        scxulong generation = snapshot->GetSampleTime();
+        if (m_lastSnapshot != NULL && generation <= m_lastSnapshot->GetGeneration())
         {
-            gotResource = processinst->GetBlockWritesPerSecond(res);
+            generation = m_lastSnapshot->GetGeneration() + 1;
         }
-        else if (StrCompare(resource, L"BlockTransfersPerSecond", true) == 0)
+        snapshot->TrackChanges(m_lastSnapshot.GetData(), generation);
+        m_lastSnapshot = snapshot;
+
+        SCX_LOGTRACE(m_log, StrAppend(L"ProcessProvider::TakeSnapshot() - new snapshot, number of processes = ", snapshot->Size()));
+        return snapshot;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot containing (at least) one specific process
+
+        The caller need not hold the ProcessProvider lock.
+
+        \param[in]     pid   Process ID of the process of interest
+        \returns      Snapshot holding the process, if it exists
+    */
+    SCXHandle<ProcessSnapshot> ProcessProvider::GetSnapshot(scxulong pid)
+    {
+        std::set<scxulong> pids;
+        pids.insert(pid);
+        return GetSnapshot(pids);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get a snapshot containing (at least) some specific processes
+
+        If the shared snapshot is recent enough it is returned as is. Otherwise
+        only the requested processes are refreshed, and a private snapshot holding
+        just those processes is returned (it is not published since it is incomplete).
+
+        The caller need not hold the ProcessProvider lock.
+
+        \param[in]     pids   Process IDs of the processes of interest
+        \returns      Snapshot holding the processes that exist
+    */
+    SCXHandle<ProcessSnapshot> ProcessProvider::GetSnapshot(const std::set<scxulong>& pids)
+    {
+        scxulong now = GetSnapshotTime();
+        SCXHandle<ProcessSnapshot> shared = m_snapshots.Get(now, m_snapshotMaxAge);
+        if (shared != NULL)
         {
-            gotResource = processinst->GetBlockTransfersPerSecond(res);
+            return shared;
         }
-        else if (StrCompare(resource, L"PercentUserTime", true) == 0)
+
+        // Updating a single process still changes the process enumeration
+        SCXCoreLib::SCXThreadLock refreshLock(m_snapshots.GetRefreshLock());
+
+        for (std::set<scxulong>::const_iterator it = pids.begin(); it != pids.end(); ++it)
         {
-            gotResource = processinst->GetPercentUserTime(res);
+            m_processes->UpdateSpecific(static_cast<int>(*it));
         }
-        else if (StrCompare(resource, L"PercentPrivilegedTime", true) == 0)
+
+        SCXHandle<ProcessSnapshot> snapshot(new ProcessSnapshot(now));
+        SCXCoreLib::SCXThreadLock lock(m_processes->GetLockHandle());
+        for (size_t i = 0; i < m_processes->Size() && snapshot->Size() < pids.size(); i++)
         {
-            gotResource = processinst->GetPercentPrivilegedTime(res);
+            SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> inst = m_processes->GetInstance(i);
+            scxulong instPid = 0;
+            if (inst->GetPID(instPid) && pids.find(instPid) != pids.end())
+            {
+                snapshot->AddInstance(inst, m_processes->GetLockHandle());
+            }
         }
-        else if (StrCompare(resource, L"UsedMemory", true) == 0)
+
+        return snapshot;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Find all processes with a given name
+
+        Used by other providers (e.g. application server discovery) so that they
+        reuse the sample taken for the process providers instead of walking the
+        process table on their own. The process table is only walked again when
+        the shared snapshot is older than the configured maximum age.
+
+        The caller need not hold the ProcessProvider lock.
+
+        \param[in]     name   Name of the processes to find
+        \returns      Processes with the given name (use GetParameters() to read them)
+    */
+    std::vector<SCXHandle<ProcessInstance> > ProcessProvider::FindProcesses(const std::wstring& name)
+    {
+        GetSnapshot();
+
+        return m_processes->Find(name);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the command line parameters of a process returned by FindProcesses()
+
+        The instances are owned by the process enumeration and are updated in
+        place, so they are only read while holding the enumeration lock.
+
+        \param[in]     inst     Process to get the parameters of
+        \param[out]    params   Command line parameters
+        \returns      true if the parameters are supported
+    */
+    bool ProcessProvider::GetParameters(SCXHandle<ProcessInstance> inst, std::vector<std::string>& params)
+    {
+        SCXCoreLib::SCXThreadLock lock(m_processes->GetLockHandle());
+        return inst->GetParameters(params);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Find the processes using most of each of several resources
+
+        The snapshot is walked once for all resources. For each resource, a heap
+        holds the largest consumers seen so far, so only those (at most count)
+        are ever sorted rather than the whole process table.
+
+        Does not require the ProcessProvider lock; the snapshot is immutable.
+
+        \param[in]     snapshot    Snapshot of the processes to consider
+        \param[in]     resources   Names of the resources to rank processes on
+        \param[in]     count       Maximum number of processes per resource
+        \param[out]    consumers   Largest consumers of each resource (in the order
+                                   of resources), largest first
+
+        \throws        UnknownResourceException    If a given resource is not handled
+        \throws        SCXInternalErrorException   If a process has no value for a resource
+    */
+    void ProcessProvider::GetTopResourceConsumers(SCXCoreLib::SCXHandle<ProcessSnapshot> snapshot,
+                                                  const std::vector<std::wstring>& resources, unsigned int count,
+                                                  std::vector<std::vector<ResourceConsumer> >& consumers)
+    {
+        // Look up the resources once, not once per process
+        std::vector<Resource> ids;
+        for (size_t r = 0; r < resources.size(); r++)
         {
-            gotResource = processinst->GetUsedMemory(res);
+            ids.push_back(GetResourceByName(resources[r]));
         }
-        else if (StrCompare(resource, L"PercentUsedMemory", true) == 0)
+
+        consumers.assign(resources.size(), std::vector<ResourceConsumer>());
+        if (0 == count)
         {
-            gotResource = processinst->GetPercentUsedMemory(res);
+            return;
         }
-        else if (StrCompare(resource, L"PagesReadPerSec", true) == 0)
+
+        for (size_t r = 0; r < resources.size(); r++)
         {
-            gotResource = processinst->GetPagesReadPerSec(res);
+            consumers[r].reserve(std::min(static_cast<size_t>(count), snapshot->Size()));
         }
-        else
+
+        for (size_t i = 0; i < snapshot->Size(); i++)
         {
-            throw UnknownResourceException(resource, SCXSRCLOCATION);
+            ResourceConsumer consumer;
+            consumer.procinst = &snapshot->GetInstance(i);
+
+            for (size_t r = 0; r < ids.size(); r++)
+            {
+                if ( ! GetResourceValue(ids[r], *consumer.procinst, consumer.value))
+                {
+                    throw SCXInternalErrorException(StrAppend(L"GetResource: Failed to get resouce: ", resources[r]), SCXSRCLOCATION);
+                }
+
+                // Min-heap of the largest consumers: the smallest of them is at the front
+                std::vector<ResourceConsumer>& top = consumers[r];
+                if (top.size() < count)
+                {
+                    top.push_back(consumer);
+                    std::push_heap(top.begin(), top.end(), CompareConsumers);
+                }
+                else if (consumer.value > top.front().value)
+                {
+                    std::pop_heap(top.begin(), top.end(), CompareConsumers);
+                    top.back() = consumer;
+                    std::push_heap(top.begin(), top.end(), CompareConsumers);
+                }
+            }
         }
 
-        if ( ! gotResource)
+        for (size_t r = 0; r < consumers.size(); r++)
         {
-            throw SCXInternalErrorException(StrAppend(L"GetResource: Failed to get resouce: ", resource), SCXSRCLOCATION);
+            // Sorting a min-heap with the same comparison puts the largest first
+            std::sort_heap(consumers[r].begin(), consumers[r].end(), CompareConsumers);
         }
-
-        return res;
     }
 
-    void ProcessProvider::GetTopResourceConsumers(const std::wstring &resource, unsigned int count, std::wstring &result)
-    {
-        SCX_LOGTRACE(m_log, L"SCXProcessProvider GetTopResourceConsumers");
-
-        std::wstringstream ss;
-        std::vector<ProcessInstanceSort> procsort;
-
-        SCXCoreLib::SCXThreadLock lock(m_processes->GetLockHandle());
+    /*----------------------------------------------------------------------------*/
+    /**
+        Format a table of the processes using most of a resource
 
-        m_processes->UpdateNoLock();
+        Does not require the ProcessProvider lock; the snapshot is immutable.
 
-        // Build separate vector for sorting
-        for(size_t i=0; i<m_processes->Size(); i++)
-        {
-            ProcessInstanceSort p;
+        \param[in]     snapshot   Snapshot of the processes to consider
+        \param[in]     resource   Name of resource to sort on
+        \param[in]     count      Maximum number of processes to list
+        \param[out]    result     Formatted table
 
-            p.procinst = m_processes->GetInstance(i);
-            p.value = GetResource(resource, p.procinst);
-            procsort.push_back(p);
-        }
+        \throws        UnknownResourceException    If given resource not handled
+    */
+    void ProcessProvider::GetTopResourceConsumers(SCXCoreLib::SCXHandle<ProcessSnapshot> snapshot,
+                                                  const std::wstring &resource, unsigned int count, std::wstring &result)
+    {
+        SCX_LOGTRACE(m_log, L"SCXProcessProvider GetTopResourceConsumers");
 
-        std::sort(procsort.begin(), procsort.end(), CompareProcSort);
+        std::vector<std::vector<ResourceConsumer> > consumers;
+        GetTopResourceConsumers(snapshot, std::vector<std::wstring>(1, resource), count, consumers);
 
+        std::wstringstream ss;
         ss << std::endl << L"PID   Name                 " << resource << std::endl;
         ss << L"-------------------------------------------------------------" << std::endl;
 
-        for(size_t i=0; i<procsort.size() && i<count; i++)
+        const std::vector<ResourceConsumer>& top = consumers[0];
+        for(size_t i=0; i<top.size(); i++)
         {
-            const ProcessInstanceSort* processinst = &procsort[i];
+            const ResourceConsumer* processinst = &top[i];
 
             scxulong pid;
 
@@ -15,8 +15,13 @@
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/scxlog.h>
 #include <scxsystemlib/processenumeration.h>
+#include "processsnapshot.h"
+#include "samplingscheduler.h"
+#include "snapshotpublisher.h"
 #include "startuplog.h"
 
+#include <set>
+
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
 
@@ -56,7 +61,28 @@ namespace SCXCore
             std::wstring   m_resource;
         };
 
-        ProcessProvider() : m_processes(NULL) { }
+        /*----------------------------------------------------------------------------*/
+        /**
+            A process and how much of a resource it uses (see GetTopResourceConsumers())
+        */
+        struct ResourceConsumer
+        {
+            ResourceConsumer() : procinst(NULL), value(0) {}
+
+            //! The process (owned by the snapshot it was found in)
+            const ProcessSnapshotInstance* procinst;
+            //! How much of the resource the process uses
+            scxulong value;
+        };
+
+        //! Default maximum age (in milliseconds) of a shared process snapshot
+        static const scxulong cDefaultSnapshotMaxAge = 1000;
+
+        //! Default interval (in milliseconds) of the background refresh of the snapshot
+        static const scxulong cDefaultSampleInterval = cDefaultSnapshotMaxAge / 2;
+
+        ProcessProvider() : m_processes(NULL), m_snapshots(L"SCXCore::ProcessProvider"),
+                            m_snapshotMaxAge(cDefaultSnapshotMaxAge), m_sampleInterval(cDefaultSampleInterval) { }
         virtual ~ProcessProvider() { };
         
         void Load();
@@ -64,16 +90,40 @@ namespace SCXCore
         SCXHandle<SCXSystemLib::ProcessEnumeration> GetProcessEnumerator() { return m_processes; }
         SCXLogHandle& GetLogHandle(){ return m_log; }
 
-        void GetTopResourceConsumers(const std::wstring &resource, unsigned int count, std::wstring &result);
+        SCXCoreLib::SCXHandle<ProcessSnapshot> GetSnapshot();
+        SCXCoreLib::SCXHandle<ProcessSnapshot> GetSnapshot(scxulong pid);
+        SCXCoreLib::SCXHandle<ProcessSnapshot> GetSnapshot(const std::set<scxulong>& pids);
+        void SetSnapshotMaxAge(scxulong maxAge) { m_snapshotMaxAge = maxAge; }
+        scxulong GetSnapshotMaxAge() const { return m_snapshotMaxAge; }
+        void Sample();
+
+        std::vector<SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> > FindProcesses(const std::wstring& name);
+        bool GetParameters(SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> inst, std::vector<std::string>& params);
+
+        void GetTopResourceConsumers(SCXCoreLib::SCXHandle<ProcessSnapshot> snapshot,
+                                     const std::wstring &resource, unsigned int count, std::wstring &result);
+        void GetTopResourceConsumers(SCXCoreLib::SCXHandle<ProcessSnapshot> snapshot,
+                                     const std::vector<std::wstring>& resources, unsigned int count,
+                                     std::vector<std::vector<ResourceConsumer> >& consumers);
 
     private:
         //! PAL implementation retrieving processes information for local host
         SCXCoreLib::SCXHandle<SCXSystemLib::ProcessEnumeration> m_processes;
 
+        //! Most recent complete snapshot of the process table, shared by all requests
+        SnapshotPublisher<ProcessSnapshot> m_snapshots;
+        //! Maximum age (in milliseconds) before the shared snapshot is refreshed
+        scxulong m_snapshotMaxAge;
+        //! Interval (in milliseconds) of the background refresh of the snapshot (0 if none)
+        scxulong m_sampleInterval;
+        //! Last complete snapshot taken, the base for tracking changes (guarded by the refresh lock)
+        SCXCoreLib::SCXHandle<ProcessSnapshot> m_lastSnapshot;
+
         static int ms_loadCount;
         SCXCoreLib::SCXLogHandle m_log; //!< Handle to log file.
 
-        scxulong GetResource(const std::wstring &resource, SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> processinst);
+        void ReadConfiguration();
+        SCXCoreLib::SCXHandle<ProcessSnapshot> TakeSnapshot();
     };
 
     extern ProcessProvider g_ProcessProvider;
@@ -0,0 +1,333 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     processsnapshot.cpp
+
+    \brief    Implementation of the immutable process snapshot shared by the process providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include "processsnapshot.h"
+
+#include <sstream>
+
+using namespace SCXCoreLib;
+using namespace SCXSystemLib;
+
+namespace
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check if a value of a process differs between two snapshots
+
+       \param[in] value     Value in the current snapshot
+       \param[in] previous  Value in the previous snapshot
+       \returns   true if the value appeared, disappeared or changed
+    */
+    template <typename T> bool Differs(const SCXCore::SnapshotValue<T>& value, const SCXCore::SnapshotValue<T>& previous)
+    {
+        return value.m_valid != previous.m_valid || (value.m_valid && !(value.m_value == previous.m_value));
+    }
+}
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - copies the published values out of a process instance,
+       except for the costly ones (read when asked for)
+
+       \param[in] inst  Process instance to copy (caller holds the enumeration lock)
+       \param[in] lock  Lock of the process enumeration
+    */
+    ProcessSnapshotInstance::ProcessSnapshotInstance(SCXHandle<ProcessInstance> inst, SCXThreadLockHandle lock) :
+        m_generation(0),
+        m_inst(inst),
+        m_lock(lock)
+    {
+        m_pid.m_valid = inst->GetPID(m_pid.m_value);
+        m_name.m_valid = inst->GetName(m_name.m_value);
+        m_otherExecutionDescription.m_valid = inst->GetOtherExecutionDescription(m_otherExecutionDescription.m_value);
+        m_kernelModeTime.m_valid = inst->GetKernelModeTime(m_kernelModeTime.m_value);
+        m_userModeTime.m_valid = inst->GetUserModeTime(m_userModeTime.m_value);
+        m_workingSetSize.m_valid = inst->GetWorkingSetSize(m_workingSetSize.m_value);
+        m_processSessionID.m_valid = inst->GetProcessSessionID(m_processSessionID.m_value);
+        m_processWaitingForEvent.m_valid = inst->GetProcessWaitingForEvent(m_processWaitingForEvent.m_value);
+        m_normalizedWin32Priority.m_valid = inst->GetNormalizedWin32Priority(m_normalizedWin32Priority.m_value);
+        m_executionState.m_valid = inst->GetExecutionState(m_executionState.m_value);
+        m_creationDate.m_valid = inst->GetCreationDate(m_creationDate.m_value);
+        m_terminationDate.m_valid = inst->GetTerminationDate(m_terminationDate.m_value);
+        m_parentProcessID.m_valid = inst->GetParentProcessID(m_parentProcessID.m_value);
+        m_realUserID.m_valid = inst->GetRealUserID(m_realUserID.m_value);
+        m_processGroupID.m_valid = inst->GetProcessGroupID(m_processGroupID.m_value);
+        m_processNiceValue.m_valid = inst->GetProcessNiceValue(m_processNiceValue.m_value);
+        m_percentUserTime.m_valid = inst->GetPercentUserTime(m_percentUserTime.m_value);
+        m_percentPrivilegedTime.m_valid = inst->GetPercentPrivilegedTime(m_percentPrivilegedTime.m_value);
+        m_usedMemory.m_valid = inst->GetUsedMemory(m_usedMemory.m_value);
+        m_percentUsedMemory.m_valid = inst->GetPercentUsedMemory(m_percentUsedMemory.m_value);
+        m_realText.m_valid = inst->GetRealText(m_realText.m_value);
+        m_realData.m_valid = inst->GetRealData(m_realData.m_value);
+        m_realStack.m_valid = inst->GetRealStack(m_realStack.m_value);
+        m_virtualText.m_valid = inst->GetVirtualText(m_virtualText.m_value);
+        m_virtualData.m_valid = inst->GetVirtualData(m_virtualData.m_value);
+        m_virtualStack.m_valid = inst->GetVirtualStack(m_virtualStack.m_value);
+        m_virtualMemoryMappedFileSize.m_valid = inst->GetVirtualMemoryMappedFileSize(m_virtualMemoryMappedFileSize.m_value);
+        m_virtualSharedMemory.m_valid = inst->GetVirtualSharedMemory(m_virtualSharedMemory.m_value);
+        m_cpuTimeDeadChildren.m_valid = inst->GetCpuTimeDeadChildren(m_cpuTimeDeadChildren.m_value);
+        m_systemTimeDeadChildren.m_valid = inst->GetSystemTimeDeadChildren(m_systemTimeDeadChildren.m_value);
+        m_cpuTime.m_valid = inst->GetCPUTime(m_cpuTime.m_value);
+        m_blockReadsPerSecond.m_valid = inst->GetBlockReadsPerSecond(m_blockReadsPerSecond.m_value);
+        m_blockWritesPerSecond.m_valid = inst->GetBlockWritesPerSecond(m_blockWritesPerSecond.m_value);
+        m_blockTransfersPerSecond.m_valid = inst->GetBlockTransfersPerSecond(m_blockTransfersPerSecond.m_value);
+        m_pagesReadPerSec.m_valid = inst->GetPagesReadPerSec(m_pagesReadPerSec.m_value);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the terminal of the process, read from the process instance
+
+       \param[out] tty  Terminal of the process
+       \returns    true if supported
+    */
+    bool ProcessSnapshotInstance::GetProcessTTY(std::string& tty) const
+    {
+        SCXThreadLock lock(m_lock);
+        return m_inst->GetProcessTTY(tty);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the path of the executable of the process, read from the process instance
+
+       \param[out] path  Path of the executable
+       \returns    true if supported
+    */
+    bool ProcessSnapshotInstance::GetModulePath(std::string& path) const
+    {
+        SCXThreadLock lock(m_lock);
+        return m_inst->GetModulePath(path);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the command line parameters of the process, read from the process instance
+
+       \param[out] params  Command line parameters
+       \returns    true if supported
+    */
+    bool ProcessSnapshotInstance::GetParameters(std::vector<std::string>& params) const
+    {
+        SCXThreadLock lock(m_lock);
+        return m_inst->GetParameters(params);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check if the process changed enough since a previous snapshot to be reported again
+
+       The identity of the process (name, parent, creation date), its state and
+       its nice value are compared exactly. The used memory and the CPU usage
+       change in every sample, so only changes of at least
+       ProcessSnapshot::cSignificantMemoryChange percent of the memory and
+       ProcessSnapshot::cSignificantCpuChange percent points of CPU are counted.
+
+       \param[in] previous  The same process in the previous snapshot
+       \returns   true if the process changed significantly
+    */
+    bool ProcessSnapshotInstance::ChangedSignificantly(const ProcessSnapshotInstance& previous) const
+    {
+        if (Differs(m_name, previous.m_name)
+            || Differs(m_executionState, previous.m_executionState)
+            || Differs(m_parentProcessID, previous.m_parentProcessID)
+            || Differs(m_creationDate, previous.m_creationDate)
+            || Differs(m_processNiceValue, previous.m_processNiceValue)
+            || m_usedMemory.m_valid != previous.m_usedMemory.m_valid)
+        {
+            return true;
+        }
+
+        if (m_usedMemory.m_valid)
+        {
+            scxulong delta = m_usedMemory.m_value > previous.m_usedMemory.m_value
+                ? m_usedMemory.m_value - previous.m_usedMemory.m_value
+                : previous.m_usedMemory.m_value - m_usedMemory.m_value;
+            if (delta * 100 > previous.m_usedMemory.m_value * ProcessSnapshot::cSignificantMemoryChange)
+            {
+                return true;
+            }
+        }
+
+        scxulong cpu = (m_percentUserTime.m_valid ? m_percentUserTime.m_value : 0)
+            + (m_percentPrivilegedTime.m_valid ? m_percentPrivilegedTime.m_value : 0);
+        scxulong previousCpu = (previous.m_percentUserTime.m_valid ? previous.m_percentUserTime.m_value : 0)
+            + (previous.m_percentPrivilegedTime.m_valid ? previous.m_percentPrivilegedTime.m_value : 0);
+        return (cpu > previousCpu ? cpu - previousCpu : previousCpu - cpu) >= ProcessSnapshot::cSignificantCpuChange;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] sampleTime  Time (in milliseconds) when the snapshot is taken
+    */
+    ProcessSnapshot::ProcessSnapshot(scxulong sampleTime) :
+        m_sampleTime(sampleTime),
+        m_generation(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add a process to the snapshot
+
+       Only to be called while the snapshot is being built, before it is handed
+       out to any reader.
+
+       \param[in] inst  Process instance to copy (caller holds the enumeration lock)
+       \param[in] lock  Lock of the process enumeration
+    */
+    void ProcessSnapshot::AddInstance(SCXHandle<ProcessInstance> inst, SCXThreadLockHandle lock)
+    {
+        m_instances.push_back(ProcessSnapshotInstance(inst, lock));
+
+        scxulong pid = 0;
+        if (m_instances.back().GetPID(pid))
+        {
+            m_positions[pid] = m_instances.size() - 1;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a process by its handle (the process ID as a string)
+
+       \param[in] handle  Handle of the process to find
+       \returns   Pointer to the process (owned by the snapshot), or NULL if not found
+    */
+    const ProcessSnapshotInstance* ProcessSnapshot::GetInstance(const std::wstring& handle) const
+    {
+        scxulong pid = 0;
+        return ParseHandle(handle, pid) ? GetInstanceByPid(pid) : NULL;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a process by its process ID
+
+       \param[in] pid  Process ID of the process to find
+       \returns   Pointer to the process (owned by the snapshot), or NULL if not found
+    */
+    const ProcessSnapshotInstance* ProcessSnapshot::GetInstanceByPid(scxulong pid) const
+    {
+        std::map<scxulong, size_t>::const_iterator it = m_positions.find(pid);
+        return it != m_positions.end() ? &m_instances[it->second] : NULL;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Convert the handle of a process (its process ID as a string) to a process ID
+
+       \param[in]  handle  Handle to convert
+       \param[out] pid     Process ID
+       \returns    true if the handle is a process ID (only digits)
+    */
+    bool ProcessSnapshot::ParseHandle(const std::wstring& handle, scxulong& pid)
+    {
+        if (handle.empty() || handle.find_first_not_of(L"0123456789") != std::wstring::npos)
+        {
+            return false;
+        }
+
+        std::wistringstream ss(handle);
+        ss >> pid;
+        return !ss.fail();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check if the snapshot is too old to be shared
+
+       \param[in] now     Current time in milliseconds
+       \param[in] maxAge  Maximum age in milliseconds
+       \returns   true if the snapshot is older than the maximum age
+    */
+    bool ProcessSnapshot::IsStale(scxulong now, scxulong maxAge) const
+    {
+        // A clock that moves backwards also makes the snapshot stale
+        return now < m_sampleTime || now - m_sampleTime >= maxAge;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Assign generations to the processes, relative to the previous snapshot
+
+       Every process keeps the generation it had in the previous snapshot,
+       unless it is new or changed significantly, in which case it gets the
+       generation of this snapshot. A client that remembers the highest
+       generation it has seen can thereby ask for the processes that changed
+       since. Processes of the previous snapshot that are gone are remembered
+       as terminated, along with the ones the previous snapshot remembered,
+       for cTerminatedMaxAge milliseconds of sample time (at most cMaxTerminated
+       of them).
+
+       Only to be called while the snapshot is being built, before it is handed
+       out to any reader.
+
+       \param[in] previous    Previous complete snapshot (NULL if none)
+       \param[in] generation  Generation of this snapshot, higher than the one of the previous snapshot
+    */
+    void ProcessSnapshot::TrackChanges(const ProcessSnapshot* previous, scxulong generation)
+    {
+        m_generation = generation;
+
+        for (size_t i = 0; i < m_instances.size(); i++)
+        {
+            ProcessSnapshotInstance& inst = m_instances[i];
+            const ProcessSnapshotInstance* old = NULL;
+            scxulong pid = 0;
+            if (previous != NULL && inst.GetPID(pid))
+            {
+                old = previous->GetInstanceByPid(pid);
+            }
+
+            inst.m_generation = (old != NULL && 0 != old->m_generation && !inst.ChangedSignificantly(*old))
+                ? old->m_generation : generation;
+        }
+
+        if (previous == NULL)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < previous->Size() && m_terminated.size() < cMaxTerminated; i++)
+        {
+            TerminatedProcess terminated;
+            if (previous->m_instances[i].GetPID(terminated.pid) && m_positions.find(terminated.pid) == m_positions.end())
+            {
+                previous->m_instances[i].GetName(terminated.name);
+                terminated.generation = generation;
+                terminated.time = m_sampleTime;
+                m_terminated.push_back(terminated);
+            }
+        }
+
+        for (size_t i = 0; i < previous->m_terminated.size() && m_terminated.size() < cMaxTerminated; i++)
+        {
+            const TerminatedProcess& terminated = previous->m_terminated[i];
+
+            // Aged by sample time: generations only follow the clock as long as it doesn't go back.
+            // A process ID that is in use again belongs to a new process
+            if ((m_sampleTime < terminated.time || m_sampleTime - terminated.time < cTerminatedMaxAge)
+                && m_positions.find(terminated.pid) == m_positions.end())
+            {
+                m_terminated.push_back(terminated);
+            }
+        }
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
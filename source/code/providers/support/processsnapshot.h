@@ -0,0 +1,225 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     processsnapshot.h
+
+    \brief    Declarations of the immutable process snapshot shared by the process providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef PROCESSSNAPSHOT_H
+#define PROCESSSNAPSHOT_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/scxtime.h>
+#include <scxsystemlib/processenumeration.h>
+#include <scxsystemlib/processinstance.h>
+#include "snapshotpublisher.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Copy of all values of one process that are published by the process providers
+
+       The getters mirror the ones of SCXSystemLib::ProcessInstance, but return
+       the values captured when the snapshot was taken. Objects of this class are
+       never modified after construction, so they can be read without any lock.
+
+       The TTY, module path and parameters are costly to get and seldom
+       requested: they aren't captured, but read from the process instance
+       when asked for (see GetProcessTTY(), GetModulePath() and GetParameters()).
+    */
+    class ProcessSnapshotInstance
+    {
+    public:
+        ProcessSnapshotInstance(SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> inst,
+                                SCXCoreLib::SCXThreadLockHandle lock);
+
+        bool GetPID(scxulong& pid) const { return m_pid.Get(pid); }
+        bool GetName(std::string& name) const { return m_name.Get(name); }
+        bool GetOtherExecutionDescription(std::wstring& descr) const { return m_otherExecutionDescription.Get(descr); }
+        bool GetKernelModeTime(scxulong& t) const { return m_kernelModeTime.Get(t); }
+        bool GetUserModeTime(scxulong& t) const { return m_userModeTime.Get(t); }
+        bool GetWorkingSetSize(scxulong& size) const { return m_workingSetSize.Get(size); }
+        bool GetProcessSessionID(scxulong& id) const { return m_processSessionID.Get(id); }
+        bool GetProcessTTY(std::string& tty) const;
+        bool GetModulePath(std::string& path) const;
+        bool GetParameters(std::vector<std::string>& params) const;
+        bool GetProcessWaitingForEvent(std::string& event) const { return m_processWaitingForEvent.Get(event); }
+        bool GetNormalizedWin32Priority(unsigned int& prio) const { return m_normalizedWin32Priority.Get(prio); }
+        bool GetExecutionState(unsigned short& state) const { return m_executionState.Get(state); }
+        bool GetCreationDate(SCXCoreLib::SCXCalendarTime& date) const { return m_creationDate.Get(date); }
+        bool GetTerminationDate(SCXCoreLib::SCXCalendarTime& date) const { return m_terminationDate.Get(date); }
+        bool GetParentProcessID(int& ppid) const { return m_parentProcessID.Get(ppid); }
+        bool GetRealUserID(scxulong& uid) const { return m_realUserID.Get(uid); }
+        bool GetProcessGroupID(scxulong& gid) const { return m_processGroupID.Get(gid); }
+        bool GetProcessNiceValue(unsigned int& nice) const { return m_processNiceValue.Get(nice); }
+        bool GetPercentUserTime(scxulong& pct) const { return m_percentUserTime.Get(pct); }
+        bool GetPercentPrivilegedTime(scxulong& pct) const { return m_percentPrivilegedTime.Get(pct); }
+        bool GetUsedMemory(scxulong& mem) const { return m_usedMemory.Get(mem); }
+        bool GetPercentUsedMemory(scxulong& pct) const { return m_percentUsedMemory.Get(pct); }
+        bool GetRealText(scxulong& size) const { return m_realText.Get(size); }
+        bool GetRealData(scxulong& size) const { return m_realData.Get(size); }
+        bool GetRealStack(scxulong& size) const { return m_realStack.Get(size); }
+        bool GetVirtualText(scxulong& size) const { return m_virtualText.Get(size); }
+        bool GetVirtualData(scxulong& size) const { return m_virtualData.Get(size); }
+        bool GetVirtualStack(scxulong& size) const { return m_virtualStack.Get(size); }
+        bool GetVirtualMemoryMappedFileSize(scxulong& size) const { return m_virtualMemoryMappedFileSize.Get(size); }
+        bool GetVirtualSharedMemory(scxulong& size) const { return m_virtualSharedMemory.Get(size); }
+        bool GetCpuTimeDeadChildren(scxulong& t) const { return m_cpuTimeDeadChildren.Get(t); }
+        bool GetSystemTimeDeadChildren(scxulong& t) const { return m_systemTimeDeadChildren.Get(t); }
+        bool GetCPUTime(unsigned int& t) const { return m_cpuTime.Get(t); }
+        bool GetBlockReadsPerSecond(scxulong& rate) const { return m_blockReadsPerSecond.Get(rate); }
+        bool GetBlockWritesPerSecond(scxulong& rate) const { return m_blockWritesPerSecond.Get(rate); }
+        bool GetBlockTransfersPerSecond(scxulong& rate) const { return m_blockTransfersPerSecond.Get(rate); }
+        bool GetPagesReadPerSec(scxulong& rate) const { return m_pagesReadPerSec.Get(rate); }
+
+        //! Generation in which the process last changed significantly (see ProcessSnapshot::TrackChanges())
+        //! \returns Generation, or 0 if changes are not tracked for the snapshot
+        scxulong GetGeneration() const { return m_generation; }
+
+    private:
+        friend class ProcessSnapshot;
+
+        bool ChangedSignificantly(const ProcessSnapshotInstance& previous) const;
+
+        SnapshotValue<scxulong> m_pid;
+        SnapshotValue<std::string> m_name;
+        SnapshotValue<std::wstring> m_otherExecutionDescription;
+        SnapshotValue<scxulong> m_kernelModeTime;
+        SnapshotValue<scxulong> m_userModeTime;
+        SnapshotValue<scxulong> m_workingSetSize;
+        SnapshotValue<scxulong> m_processSessionID;
+        SnapshotValue<std::string> m_processWaitingForEvent;
+        SnapshotValue<unsigned int> m_normalizedWin32Priority;
+        SnapshotValue<unsigned short> m_executionState;
+        SnapshotValue<SCXCoreLib::SCXCalendarTime> m_creationDate;
+        SnapshotValue<SCXCoreLib::SCXCalendarTime> m_terminationDate;
+        SnapshotValue<int> m_parentProcessID;
+        SnapshotValue<scxulong> m_realUserID;
+        SnapshotValue<scxulong> m_processGroupID;
+        SnapshotValue<unsigned int> m_processNiceValue;
+        SnapshotValue<scxulong> m_percentUserTime;
+        SnapshotValue<scxulong> m_percentPrivilegedTime;
+        SnapshotValue<scxulong> m_usedMemory;
+        SnapshotValue<scxulong> m_percentUsedMemory;
+        SnapshotValue<scxulong> m_realText;
+        SnapshotValue<scxulong> m_realData;
+        SnapshotValue<scxulong> m_realStack;
+        SnapshotValue<scxulong> m_virtualText;
+        SnapshotValue<scxulong> m_virtualData;
+        SnapshotValue<scxulong> m_virtualStack;
+        SnapshotValue<scxulong> m_virtualMemoryMappedFileSize;
+        SnapshotValue<scxulong> m_virtualSharedMemory;
+        SnapshotValue<scxulong> m_cpuTimeDeadChildren;
+        SnapshotValue<scxulong> m_systemTimeDeadChildren;
+        SnapshotValue<unsigned int> m_cpuTime;
+        SnapshotValue<scxulong> m_blockReadsPerSecond;
+        SnapshotValue<scxulong> m_blockWritesPerSecond;
+        SnapshotValue<scxulong> m_blockTransfersPerSecond;
+        SnapshotValue<scxulong> m_pagesReadPerSec;
+        scxulong m_generation;
+
+        //! Process instance to read the costly values from
+        SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> m_inst;
+        //! Lock of the process enumeration, held while reading m_inst
+        SCXCoreLib::SCXThreadLockHandle m_lock;
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       A process that terminated, as remembered by the snapshots taken after it
+    */
+    struct TerminatedProcess
+    {
+        TerminatedProcess() : pid(0), generation(0), time(0) {}
+
+        //! Process ID of the process
+        scxulong pid;
+        //! Name of the process
+        std::string name;
+        //! Generation of the first snapshot the process was missing from
+        scxulong generation;
+        //! Sample time (in milliseconds) of the first snapshot the process was missing from
+        scxulong time;
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Immutable sample of the process table
+
+       A snapshot is filled in by the ProcessProvider while it holds the lock of
+       the process enumeration, and is never modified once it has been handed
+       out. Any number of requests may therefore read the same snapshot
+       concurrently without holding any lock; the snapshot lives for as long as
+       a request holds a handle to it.
+    */
+    class ProcessSnapshot
+    {
+    public:
+        explicit ProcessSnapshot(scxulong sampleTime);
+
+        void AddInstance(SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> inst,
+                         SCXCoreLib::SCXThreadLockHandle lock);
+
+        //! Number of processes in the snapshot
+        //! \returns Number of processes
+        size_t Size() const { return m_instances.size(); }
+
+        //! Get a process by position
+        //! \param[in] pos  Position in the snapshot (0 .. Size() - 1)
+        //! \returns    The process at the given position
+        const ProcessSnapshotInstance& GetInstance(size_t pos) const { return m_instances[pos]; }
+
+        const ProcessSnapshotInstance* GetInstance(const std::wstring& handle) const;
+        const ProcessSnapshotInstance* GetInstanceByPid(scxulong pid) const;
+
+        static bool ParseHandle(const std::wstring& handle, scxulong& pid);
+
+        //! Time (in milliseconds) when the snapshot was taken
+        //! \returns Sample time
+        scxulong GetSampleTime() const { return m_sampleTime; }
+
+        bool IsStale(scxulong now, scxulong maxAge) const;
+
+        void TrackChanges(const ProcessSnapshot* previous, scxulong generation);
+
+        //! Generation of the snapshot (see TrackChanges())
+        //! \returns Generation, or 0 if changes are not tracked for the snapshot
+        scxulong GetGeneration() const { return m_generation; }
+
+        //! Processes that terminated recently, most recent first (see TrackChanges())
+        //! \returns Terminated processes
+        const std::vector<TerminatedProcess>& GetTerminated() const { return m_terminated; }
+
+        //! Minimum change of the used memory (in percent) that is reported as a change
+        static const scxulong cSignificantMemoryChange = 10;
+        //! Minimum change of the CPU usage (in percent points) that is reported as a change
+        static const scxulong cSignificantCpuChange = 5;
+        //! Time (in milliseconds) during which terminated processes are remembered
+        static const scxulong cTerminatedMaxAge = 3600000;
+        //! Maximum number of terminated processes remembered
+        static const size_t cMaxTerminated = 4096;
+
+    private:
+        std::vector<ProcessSnapshotInstance> m_instances;  //!< The processes in the snapshot
+        std::map<scxulong, size_t> m_positions;             //!< Position in m_instances by process ID
+        scxulong m_sampleTime;                              //!< Time (ms) when the snapshot was taken
+        scxulong m_generation;                              //!< Generation of the snapshot (0 if untracked)
+        std::vector<TerminatedProcess> m_terminated;       //!< Recently terminated processes, most recent first
+    };
+
+} // End of namespace SCXCore
+
+#endif /* PROCESSSNAPSHOT_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,288 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      providerstatistics.cpp
+
+    \brief     Call statistics of the providers, published through SCX_Agent
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthreadlock.h>
+
+#include "providerstatistics.h"
+
+#include <pthread.h>
+#include <sstream>
+#include <string.h>
+#include <sys/time.h>
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Upper limits (microseconds) of the histogram buckets but the last, which has none
+    const scxulong cBucketLimits[SCXCore::ProviderStatistics::cHistogramBuckets - 1] =
+        { 1000, 10000, 100000, 1000000, 10000000 };
+
+    //! Key of the timer of the current thread
+    pthread_key_t s_timerKey;
+    //! Makes sure s_timerKey is created once
+    pthread_once_t s_timerKeyOnce = PTHREAD_ONCE_INIT;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get a monotonic enough time, for timing calls
+
+       \returns   Time in microseconds
+    */
+    scxulong GetMicroseconds()
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return static_cast<scxulong>(tv.tv_sec) * 1000000 + static_cast<scxulong>(tv.tv_usec);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Difference between two times, for times taken by GetMicroseconds()
+
+       \param[in] from  Earlier time
+       \param[in] to    Later time
+       \returns   Microseconds from 'from' to 'to', or 0 if the clock went backwards
+    */
+    scxulong Elapsed(scxulong from, scxulong to)
+    {
+        return to > from ? to - from : 0;
+    }
+}
+
+extern "C"
+{
+    //! Create the key of the timer of the current thread (through pthread_once())
+    static void CreateTimerKey()
+    {
+        pthread_key_create(&s_timerKey, NULL);
+    }
+}
+
+namespace SCXCore
+{
+    //! Statistics of all providers
+    ProviderStatistics g_ProviderStatistics;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+    */
+    ProviderStatistics::Counters::Counters() :
+        calls(0),
+        totalMicroseconds(0),
+        maxMicroseconds(0),
+        lockWaitMicroseconds(0),
+        maxLockWaitMicroseconds(0),
+        instances(0),
+        bytes(0)
+    {
+        memset(histogram, 0, sizeof(histogram));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the upper limit of a histogram bucket
+
+       A call falls in the first bucket whose limit is greater than the duration of the call.
+
+       \param[in] bucket  Bucket, less than cHistogramBuckets
+       \returns   Limit in microseconds, or 0 for the last bucket (which has no limit)
+    */
+    scxulong ProviderStatistics::GetBucketLimit(size_t bucket)
+    {
+        return bucket < cHistogramBuckets - 1 ? cBucketLimits[bucket] : 0;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Record a call
+
+       \param[in] className             Class of the call (for instance "SCX_Agent")
+       \param[in] operation             Operation called (for instance "EnumerateInstances")
+       \param[in] microseconds          Duration of the call
+       \param[in] lockWaitMicroseconds  Time spent waiting for the provider lock
+       \param[in] instances             Number of instances posted
+       \param[in] bytes                 Length of the text posted
+    */
+    void ProviderStatistics::Record(const char* className, const char* operation,
+                                    scxulong microseconds, scxulong lockWaitMicroseconds,
+                                    scxulong instances, scxulong bytes)
+    {
+        size_t bucket = 0;
+        while (bucket < cHistogramBuckets - 1 && microseconds >= cBucketLimits[bucket])
+        {
+            bucket++;
+        }
+
+        std::string key(className);
+        key.append(".").append(operation);
+
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ProviderStatistics::Lock"));
+
+        Counters& counters = m_Counters[key];
+        counters.calls++;
+        counters.totalMicroseconds += microseconds;
+        if (microseconds > counters.maxMicroseconds)
+        {
+            counters.maxMicroseconds = microseconds;
+        }
+        counters.lockWaitMicroseconds += lockWaitMicroseconds;
+        if (lockWaitMicroseconds > counters.maxLockWaitMicroseconds)
+        {
+            counters.maxLockWaitMicroseconds = lockWaitMicroseconds;
+        }
+        counters.instances += instances;
+        counters.bytes += bytes;
+        counters.histogram[bucket]++;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the statistics of all operations called so far
+
+       \param[out] counters  Statistics by "class.operation"
+    */
+    void ProviderStatistics::GetCounters(std::map<std::string, Counters>& counters) const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ProviderStatistics::Lock"));
+        counters = m_Counters;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Format the statistics of all operations called so far, one line per
+       class and operation, like:
+
+         SCX_Agent.EnumerateInstances Calls=2 TotalMicroseconds=1830 MaxMicroseconds=1412
+           LockWaitMicroseconds=3 MaxLockWaitMicroseconds=2 Instances=2 Bytes=0 Histogram=0,2,0,0,0,0
+
+       (all on one line). Histogram is the number of calls in each bucket
+       (see GetBucketLimit()).
+
+       \param[out] lines  Formatted statistics, sorted by class and operation
+    */
+    void ProviderStatistics::Format(std::vector<std::string>& lines) const
+    {
+        std::map<std::string, Counters> counters;
+        GetCounters(counters);
+
+        lines.clear();
+        lines.reserve(counters.size());
+        for (std::map<std::string, Counters>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+        {
+            const Counters& c = it->second;
+            std::ostringstream line;
+            line << it->first
+                 << " Calls=" << c.calls
+                 << " TotalMicroseconds=" << c.totalMicroseconds
+                 << " MaxMicroseconds=" << c.maxMicroseconds
+                 << " LockWaitMicroseconds=" << c.lockWaitMicroseconds
+                 << " MaxLockWaitMicroseconds=" << c.maxLockWaitMicroseconds
+                 << " Instances=" << c.instances
+                 << " Bytes=" << c.bytes
+                 << " Histogram=";
+            for (size_t bucket = 0; bucket < cHistogramBuckets; bucket++)
+            {
+                line << (bucket ? "," : "") << c.histogram[bucket];
+            }
+            lines.push_back(line.str());
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Forget all calls recorded so far
+    */
+    void ProviderStatistics::Reset()
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ProviderStatistics::Lock"));
+        m_Counters.clear();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor, starts timing a call
+
+       \param[in] className  Class of the call; must outlive the timer
+       \param[in] operation  Operation called; must outlive the timer
+    */
+    ProviderCallTimer::ProviderCallTimer(const char* className, const char* operation) :
+        m_ClassName(className),
+        m_Operation(operation),
+        m_Start(GetMicroseconds()),
+        m_LockWait(0),
+        m_Locked(false),
+        m_Instances(0),
+        m_Bytes(0)
+    {
+        pthread_once(&s_timerKeyOnce, CreateTimerKey);
+        m_Previous = static_cast<ProviderCallTimer*>(pthread_getspecific(s_timerKey));
+        pthread_setspecific(s_timerKey, this);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Destructor, records the call
+    */
+    ProviderCallTimer::~ProviderCallTimer()
+    {
+        pthread_setspecific(s_timerKey, m_Previous);
+
+        try
+        {
+            g_ProviderStatistics.Record(m_ClassName, m_Operation,
+                                        Elapsed(m_Start, GetMicroseconds()), m_LockWait,
+                                        m_Instances, m_Bytes);
+        }
+        catch (...)
+        {
+            // Statistics are best effort; never let them fail a call
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Note that the provider lock is held; the time since the timer was
+       created is recorded as lock wait
+    */
+    void ProviderCallTimer::LockAcquired()
+    {
+        if (!m_Locked)
+        {
+            m_LockWait = Elapsed(m_Start, GetMicroseconds());
+            m_Locked = true;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Count an instance posted by the call timed on the current thread (if any)
+
+       \param[in] bytes  Length of the text posted with the instance, if known
+    */
+    void ProviderCallTimer::InstancePosted(size_t bytes)
+    {
+        pthread_once(&s_timerKeyOnce, CreateTimerKey);
+        ProviderCallTimer* timer = static_cast<ProviderCallTimer*>(pthread_getspecific(s_timerKey));
+        if (NULL != timer)
+        {
+            timer->m_Instances++;
+            timer->m_Bytes += bytes;
+        }
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
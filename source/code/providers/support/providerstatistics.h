@@ -0,0 +1,108 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      providerstatistics.h
+
+    \brief     Call statistics of the providers, published through SCX_Agent
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef PROVIDERSTATISTICS_H
+#define PROVIDERSTATISTICS_H
+
+#include <scxcorelib/scxcmn.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Call statistics of the providers, by class and operation
+
+       Every EnumerateInstances, GetInstance and Invoke_* call of a provider is
+       timed by a ProviderCallTimer, which records it here when the call ends.
+       The statistics are published by SCX_Agent (property ProviderStatistics),
+       so the provider keeping a loaded host busy can be found without a profiler.
+
+       This class is thread safe.
+    */
+    class ProviderStatistics
+    {
+    public:
+        //! Number of buckets of the latency histogram
+        static const size_t cHistogramBuckets = 6;
+
+        //! Statistics of one operation of one class
+        struct Counters
+        {
+            Counters();
+
+            scxulong calls;                             //!< Number of calls
+            scxulong totalMicroseconds;                 //!< Total duration of the calls
+            scxulong maxMicroseconds;                   //!< Longest call
+            scxulong lockWaitMicroseconds;              //!< Total time spent waiting for the provider lock
+            scxulong maxLockWaitMicroseconds;           //!< Longest wait for the provider lock
+            scxulong instances;                         //!< Number of instances posted
+            scxulong bytes;                             //!< Length of the text posted by methods
+            scxulong histogram[cHistogramBuckets];      //!< Number of calls by duration (see GetBucketLimit())
+        };
+
+        static scxulong GetBucketLimit(size_t bucket);
+
+        void Record(const char* className, const char* operation,
+                    scxulong microseconds, scxulong lockWaitMicroseconds,
+                    scxulong instances, scxulong bytes);
+        void GetCounters(std::map<std::string, Counters>& counters) const;
+        void Format(std::vector<std::string>& lines) const;
+        void Reset();
+
+    private:
+        std::map<std::string, Counters> m_Counters;     //!< Statistics by "class.operation"
+    };
+
+    extern SCXCore::ProviderStatistics g_ProviderStatistics;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Times a provider operation, and records it in g_ProviderStatistics
+       when destroyed
+
+       Create the timer first thing in the operation, and call LockAcquired()
+       once the provider lock is held. Instances are counted by calling
+       InstancePosted() when posting them; it applies to the timer of the
+       current thread, so helpers posting instances need no access to it.
+    */
+    class ProviderCallTimer
+    {
+    public:
+        ProviderCallTimer(const char* className, const char* operation);
+        ~ProviderCallTimer();
+
+        void LockAcquired();
+
+        static void InstancePosted(size_t bytes = 0);
+
+    private:
+        //! Not copyable
+        ProviderCallTimer(const ProviderCallTimer&);
+        ProviderCallTimer& operator=(const ProviderCallTimer&);
+
+        const char* m_ClassName;        //!< Class of the operation
+        const char* m_Operation;        //!< Name of the operation
+        scxulong m_Start;               //!< Start of the call (microseconds)
+        scxulong m_LockWait;            //!< Time spent waiting for the provider lock (microseconds)
+        bool m_Locked;                  //!< Has LockAcquired() been called?
+        scxulong m_Instances;           //!< Instances posted
+        scxulong m_Bytes;               //!< Bytes posted
+        ProviderCallTimer* m_Previous;  //!< Timer of the thread when this one was created
+    };
+}
+
+#endif /* PROVIDERSTATISTICS_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
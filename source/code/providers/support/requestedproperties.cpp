@@ -0,0 +1,83 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     requestedproperties.cpp
+
+    \brief    Implementation of the set of properties requested by a client.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include "requestedproperties.h"
+
+#include <strings.h>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - all properties are requested until one is added
+    */
+    RequestedProperties::RequestedProperties()
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Add a requested property
+
+       \param[in] name  Name of the property
+    */
+    void RequestedProperties::Add(const std::string& name)
+    {
+        // While the set is empty, everything counts as requested
+        if (!name.empty() && (AreAllRequested() || !IsRequested(name.c_str())))
+        {
+            m_names.push_back(name);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is a property requested?
+
+       \param[in] name  Name of the property (as in the MOF)
+       \returns   true if the property is requested, or if all properties are
+    */
+    bool RequestedProperties::IsRequested(const char* name) const
+    {
+        if (AreAllRequested())
+        {
+            return true;
+        }
+
+        for (std::vector<std::string>::const_iterator it = m_names.begin(); it != m_names.end(); ++it)
+        {
+            if (0 == strcasecmp(it->c_str(), name))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is any of two properties requested?
+
+       For getters returning the values of two properties at once.
+
+       \param[in] name1  Name of the first property
+       \param[in] name2  Name of the second property
+       \returns   true if either property is requested
+    */
+    bool RequestedProperties::IsAnyRequested(const char* name1, const char* name2) const
+    {
+        return IsRequested(name1) || IsRequested(name2);
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
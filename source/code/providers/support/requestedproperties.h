@@ -0,0 +1,60 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     requestedproperties.h
+
+    \brief    Declarations of the set of properties requested by a client, used to
+              skip computing properties that are not returned anyway.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef REQUESTEDPROPERTIES_H
+#define REQUESTEDPROPERTIES_H
+
+#include <scxcorelib/scxcmn.h>
+
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Properties requested by a client
+
+       OMI passes the properties a client asked for (like the projection of
+       "select Name, PercentBusyTime from SCX_UnixProcess") in a PropertySet.
+       The EnumerateOneInstance functions of the providers consult this class
+       to skip the getters and string conversions of properties that would be
+       dropped before reaching the client.
+
+       Property names are compared case insensitively, like CIM does. An empty
+       set means "all properties", which is what OMI passes for "select *".
+       Key properties must always be set, whether requested or not.
+    */
+    class RequestedProperties
+    {
+    public:
+        RequestedProperties();
+
+        void Add(const std::string& name);
+
+        bool IsRequested(const char* name) const;
+        bool IsAnyRequested(const char* name1, const char* name2) const;
+
+        //! Are all properties requested?
+        //! \returns true if no specific property was requested
+        bool AreAllRequested() const { return m_names.empty(); }
+
+    private:
+        //! Names of the requested properties; projections are short, so a
+        //! linear search without allocation beats building a lookup key
+        std::vector<std::string> m_names;
+    };
+}
+
+#endif /* REQUESTEDPROPERTIES_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -10,6 +10,7 @@
 */
 /*----------------------------------------------------------------------------*/
 
+#include <scxcorelib/scxconfigfile.h>
 #include <scxcorelib/scxfile.h>
 #include <scxcorelib/scxprocess.h>
 #include <scxcorelib/scxdirectoryinfo.h>
@@ -18,9 +19,17 @@
 #include "startuplog.h"
 #include "scxrunasconfigurator.h"
 #include "runasprovider.h"
+#include "commandpool.h"
+#include "outputcapture.h"
+
+#include <unistd.h>
 
 const std::wstring s_defaultTmpDir = L"/etc/opt/microsoft/scx/conf/tmpdir/";
 
+// Limit stdout/stderr length to avoid bumping up against OMI's 64k limit per instance
+// (Not a whole lot of sense in raising that, since WS-Man has a limit as well)
+const size_t s_maxOutputSize = 60*1024;
+
 using namespace SCXSystemLib;
 using namespace SCXCoreLib;
 
@@ -45,6 +54,8 @@ namespace SCXCore
             // every ExecuteScript call. Check for existence of directory will be done in
             // ExecuteScript method so that latest state is taken.
             m_defaultTmpDir = s_defaultTmpDir;
+
+            ReadConfiguration();
         }
     }
 
@@ -55,10 +66,98 @@ namespace SCXCore
         SCXASSERT( ms_loadCount >= 1 );
         if (0 == --ms_loadCount)
         {
+            // Commands already accepted still run; their threads exit when done
+            g_CommandPool.Stop(false);
+            m_scripts.Clear();
+            m_results.Clear();
             m_Configurator = NULL;
         }
     }
 
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read the sizes of the pool running the RunAs methods, and of the caches of
+        script files and command results, from the SCX configuration file
+
+        Supported settings:
+          RunAsProvider_MaxConcurrentCommands         - Number of commands run at the same time
+          RunAsProvider_MaxQueuedCommands             - Number of commands waiting to run; more are refused
+          RunAsProvider_MaxConcurrentElevatedCommands - Number of sudo commands run at the same time
+                                                        (0 for no limit but the one of all commands)
+          RunAsProvider_MaxCachedScripts              - Number of script files kept for ExecuteScript
+                                                        (0 to write a new file for each script run)
+          RunAsProvider_MaxCachedScriptBytes          - Size (in bytes) of all script files kept
+          RunAsProvider_MaxCachedResults              - Number of command results kept for callers passing
+                                                        MaxAge (0 to always run the commands)
+          RunAsProvider_MaxCachedResultBytes          - Size (in bytes) of the output of all results kept
+          RunAsProvider_MaxCachedResultAge            - Age (in seconds) over which a result is never served
+    */
+    void RunAsProvider::ReadConfiguration()
+    {
+        size_t workers = CommandPool::cDefaultWorkers;
+        size_t queueSize = CommandPool::cDefaultQueueSize;
+        size_t elevatedWorkers = CommandPool::cDefaultElevatedWorkers;
+        size_t maxScripts = ScriptCache::cDefaultMaxScripts;
+        size_t maxScriptBytes = ScriptCache::cDefaultMaxBytes;
+        size_t maxResults = CommandResultCache::cDefaultMaxResults;
+        size_t maxResultBytes = CommandResultCache::cDefaultMaxBytes;
+        size_t maxResultAge = CommandResultCache::cDefaultMaxAge;
+
+        SCXConfigFile conf(SCXConfFile);
+        try {
+            conf.LoadConfig();
+
+            ReadSize(conf, L"RunAsProvider_MaxConcurrentCommands", workers);
+            ReadSize(conf, L"RunAsProvider_MaxQueuedCommands", queueSize);
+            ReadSize(conf, L"RunAsProvider_MaxConcurrentElevatedCommands", elevatedWorkers);
+            ReadSize(conf, L"RunAsProvider_MaxCachedScripts", maxScripts);
+            ReadSize(conf, L"RunAsProvider_MaxCachedScriptBytes", maxScriptBytes);
+            ReadSize(conf, L"RunAsProvider_MaxCachedResults", maxResults);
+            ReadSize(conf, L"RunAsProvider_MaxCachedResultBytes", maxResultBytes);
+            ReadSize(conf, L"RunAsProvider_MaxCachedResultAge", maxResultAge);
+        }
+        catch (SCXFilePathNotFoundException&)
+        {
+        }
+
+        g_CommandPool.Configure(workers, queueSize);
+        g_CommandPool.SetLimit(L"sudo", elevatedWorkers);
+        m_scripts.SetLimits(maxScripts, maxScriptBytes);
+        m_results.SetLimits(maxResults, maxResultBytes, static_cast<unsigned>(maxResultAge));
+
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max concurrent commands = ", workers));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max queued commands = ", queueSize));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max concurrent elevated commands = ", elevatedWorkers));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max cached scripts = ", maxScripts));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max cached script bytes = ", maxScriptBytes));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max cached results = ", maxResults));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max cached result bytes = ", maxResultBytes));
+        SCX_LOGTRACE(m_log, StrAppend(L"RunAsProvider parameters: Max cached result age = ", maxResultAge));
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Read a size from the SCX configuration file
+
+        \param[in]     conf   Loaded configuration file
+        \param[in]     key    Name of the setting
+        \param[in,out] value  Value of the setting; untouched if missing or invalid
+    */
+    void RunAsProvider::ReadSize(SCXConfigFile& conf, const std::wstring& key, size_t& value)
+    {
+        std::wstring str;
+        if (conf.GetValue(key, str))
+        {
+            try {
+                value = StrToULong(str);
+            }
+            catch (SCXException&)
+            {
+                SCX_LOGWARNING(m_log, L"Invalid " + key + L" value in configuration file: " + str);
+            }
+        }
+    }
+
     /*----------------------------------------------------------------------------*/
     /**
         Execute a command
@@ -69,11 +168,14 @@ namespace SCXCore
         \param[out]    returncode       Return code from command
         \param[in]     timeout          Accepted number of seconds to wait
         \param[in]     elevationtype    Elevation type 
+        \param[in]     maxAge           Age (in seconds) of the result of an identical command accepted
+                                        instead of running the command (0 to always run it)
         \returns       true if command succeeded, else false
         \throws SCXAccessViolationException If execution is prohibited by configuration
     */
-    bool RunAsProvider::ExecuteCommand(const std::wstring &command, std::wstring &resultOut, std::wstring &resultErr,
-                                       int& returncode, unsigned timeout, const std::wstring &elevationtype)
+    bool RunAsProvider::ExecuteCommand(const std::wstring &command, std::string &resultOut, std::string &resultErr,
+                                       int& returncode, unsigned timeout, const std::wstring &elevationtype,
+                                       unsigned maxAge)
     {
         SCX_LOGTRACE(m_log, L"RunAsProvider ExecuteCommand");
 
@@ -86,9 +188,17 @@ namespace SCXCore
             }
         }
 
+        // Serve the result of an identical command run recently enough, if the caller accepts it
+        const std::wstring key = CommandResultCache::Key(L"ExecuteCommand", command, elevationtype, geteuid());
+        if (GetCachedResult(key, maxAge, resultOut, resultErr, returncode))
+        {
+            return (returncode == 0);
+        }
+
+        // Chatty commands can't make us hold more than we may post
         std::istringstream processInput;
-        std::ostringstream processOutput;
-        std::ostringstream processError;
+        OutputCapture processOutput(s_maxOutputSize);
+        OutputCapture processError(s_maxOutputSize);
         
         // Construct the command by considering the elevation type. It simply returns the command
         // when elevation type is not empty or the current user is already privilege.
@@ -100,21 +210,26 @@ namespace SCXCore
             returncode = SCXCoreLib::SCXProcess::Run(elecommand, processInput, processOutput, processError, timeout * 1000,
                 m_Configurator->GetCWD(), m_Configurator->GetChRootPath());
             SCX_LOGHYSTERICAL(m_log, L"\"" + elecommand + L"\" returned " + StrFrom(returncode));
-            resultOut = StrFromMultibyte(processOutput.str());
-            SCX_LOGHYSTERICAL(m_log, L"stdout: " + resultOut);
-            resultErr = StrFromMultibyte(processError.str());
-            SCX_LOGHYSTERICAL(m_log, L"stderr: " + resultErr);
+            resultOut = processOutput.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stdout: " + StrFromUTF8(resultOut));
+            resultErr = processError.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stderr: " + StrFromUTF8(resultErr));
 
             // Trim output if necessary
-            if ( OutputLimiter(resultOut, resultErr) )
+            if ( OutputLimiter(processOutput, processError, resultOut, resultErr) )
             {
                 SCX_LOGWARNING(m_log, StrAppend(L"ExecuteCommand: Exceeded maximum output size for provider (64k), output truncated. Monitoring will not be reliable! Command executed: ", command));
             }
+
+            if (maxAge > 0)
+            {
+                PutCachedResult(key, resultOut, resultErr, returncode);
+            }
         }
         catch (SCXCoreLib::SCXException& e)
         {
-            resultOut = StrFromMultibyte(processOutput.str());
-            resultErr = StrFromMultibyte(processError.str()) + e.What();
+            resultOut = processOutput.UTF8Str();
+            resultErr = processError.UTF8Str() + StrToUTF8(e.What());
             returncode = -1;
         }
 
@@ -131,11 +246,14 @@ namespace SCXCore
         \param[out]    returncode       Return code from command
         \param[in]     timeout          Accepted number of seconds to wait
         \param[in]     elevationtype    Elevation type
+        \param[in]     maxAge           Age (in seconds) of the result of an identical command accepted
+                                        instead of running the command (0 to always run it)
         \returns       true if command succeeded, else false
         \throws SCXAccessViolationException If execution is prohibited by configuration
     */
-    bool RunAsProvider::ExecuteShellCommand(const std::wstring &command, std::wstring &resultOut, std::wstring &resultErr,
-                                            int& returncode, unsigned timeout, const std::wstring &elevationtype)
+    bool RunAsProvider::ExecuteShellCommand(const std::wstring &command, std::string &resultOut, std::string &resultErr,
+                                            int& returncode, unsigned timeout, const std::wstring &elevationtype,
+                                            unsigned maxAge)
     {
         SCX_LOGTRACE(m_log, L"RunAsProvider ExecuteShellCommand");
 
@@ -148,9 +266,17 @@ namespace SCXCore
             }
         }
 
+        // Serve the result of an identical command run recently enough, if the caller accepts it
+        const std::wstring key = CommandResultCache::Key(L"ExecuteShellCommand", command, elevationtype, geteuid());
+        if (GetCachedResult(key, maxAge, resultOut, resultErr, returncode))
+        {
+            return (returncode == 0);
+        }
+
+        // Chatty commands can't make us hold more than we may post
         std::istringstream processInput;
-        std::ostringstream processOutput;
-        std::ostringstream processError;
+        OutputCapture processOutput(s_maxOutputSize);
+        OutputCapture processError(s_maxOutputSize);
        
         // Construct the shell command with the given command and elevation type.
         // Please be noted that the constructed shell command use the single quotes. Hence,
@@ -164,21 +290,26 @@ namespace SCXCore
                 timeout * 1000, m_Configurator->GetCWD(), m_Configurator->GetChRootPath());
 
             SCX_LOGHYSTERICAL(m_log, L"\"" + shellcommand + L"\" returned " + StrFrom(returncode));
-            resultOut = StrFromMultibyte(processOutput.str());
-            SCX_LOGHYSTERICAL(m_log, L"stdout: " + resultOut);
-            resultErr = StrFromMultibyte(processError.str());
-            SCX_LOGHYSTERICAL(m_log, L"stderr: " + resultErr);
+            resultOut = processOutput.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stdout: " + StrFromUTF8(resultOut));
+            resultErr = processError.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stderr: " + StrFromUTF8(resultErr));
 
             // Trim output if necessary
-            if ( OutputLimiter(resultOut, resultErr) )
+            if ( OutputLimiter(processOutput, processError, resultOut, resultErr) )
             {
                 SCX_LOGWARNING(m_log, StrAppend(L"ExecuteShellCommand: Exceeded maximum output size for provider (64k), output truncated. Monitoring will not be reliable! Command executed: ", command));
             }
+
+            if (maxAge > 0)
+            {
+                PutCachedResult(key, resultOut, resultErr, returncode);
+            }
         }
         catch (SCXCoreLib::SCXException& e)
         {
-            resultOut = L"";
-            resultErr = e.What();
+            resultOut = "";
+            resultErr = StrToUTF8(e.What());
             returncode = -1;
         }
 
@@ -199,8 +330,8 @@ namespace SCXCore
 
         \returns       true if script succeeded, else false
         \throws SCXAccessViolationException If execution is prohibited by configuration    */
-    bool RunAsProvider::ExecuteScript(const std::wstring &script, const std::wstring &arguments, std::wstring &resultOut,
-                                      std::wstring &resultErr, int& returncode, unsigned timeout,
+    bool RunAsProvider::ExecuteScript(const std::wstring &script, const std::wstring &arguments, std::string &resultOut,
+                                      std::string &resultErr, int& returncode, unsigned timeout,
                                       const std::wstring &elevationtype)
     {
         SCX_LOGTRACE(m_log, L"SCXRunAsProvider ExecuteScript");
@@ -214,10 +345,12 @@ namespace SCXCore
             }
         }
 
+        // Chatty commands can't make us hold more than we may post
         std::istringstream processInput;
-        std::ostringstream processOutput;
-        std::ostringstream processError;
+        OutputCapture processOutput(s_maxOutputSize);
+        OutputCapture processError(s_maxOutputSize);
         SCXFilePath scriptfile;
+        bool cached = false;
         std::wstring command;
 
         try
@@ -229,10 +362,15 @@ namespace SCXCore
                 SCX_LOG(m_log, suppressor.GetSeverity(m_defaultTmpDir), L"Default tmp Directory does not exist. Falling back to /tmp");
             }
 
-            scriptfile = SCXFile::CreateTempFile(script, tmpDir);
-            SCXFileSystem::Attributes attribs = SCXFileSystem::GetAttributes(scriptfile);
-            attribs.insert(SCXFileSystem::eUserExecute);
-            SCXFile::SetAttributes(scriptfile, attribs);
+            // The same scripts are sent over and over: reuse their files when cached
+            cached = m_scripts.Acquire(tmpDir, StrToMultibyte(script), scriptfile);
+            if (!cached)
+            {
+                scriptfile = SCXFile::CreateTempFile(script, tmpDir);
+                SCXFileSystem::Attributes attribs = SCXFileSystem::GetAttributes(scriptfile);
+                attribs.insert(SCXFileSystem::eUserExecute);
+                SCXFile::SetAttributes(scriptfile, attribs);
+            }
 
             command = scriptfile.Get();
             command.append(L" ").append(arguments);
@@ -243,16 +381,17 @@ namespace SCXCore
             returncode = SCXCoreLib::SCXProcess::Run(command,
                 processInput, processOutput, processError, timeout * 1000,
                 m_Configurator->GetCWD(), m_Configurator->GetChRootPath());
-            SCXFile::Delete(scriptfile);
+            ReleaseScript(scriptfile, cached);
+            scriptfile = SCXFilePath();
 
             SCX_LOGHYSTERICAL(m_log, L"\"" + command + L"\" returned " + StrFrom(returncode));
-            resultOut = StrFromMultibyte(processOutput.str());
-            SCX_LOGHYSTERICAL(m_log, L"stdout: " + resultOut);
-            resultErr = StrFromMultibyte(processError.str());
-            SCX_LOGHYSTERICAL(m_log, L"stderr: " + resultErr);
+            resultOut = processOutput.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stdout: " + StrFromUTF8(resultOut));
+            resultErr = processError.UTF8Str();
+            SCX_LOGHYSTERICAL(m_log, L"stderr: " + StrFromUTF8(resultErr));
 
             // Trim output if necessary
-            if ( OutputLimiter(resultOut, resultErr) )
+            if ( OutputLimiter(processOutput, processError, resultOut, resultErr) )
             {
                 SCX_LOGWARNING(m_log, L"ExecuteScript: Exceeded maximum output size for provider (64k), output truncated. Monitoring will not be reliable! Script contents logged only with hysterical logging.");
             }
@@ -264,17 +403,82 @@ namespace SCXCore
             // Delete the script file if one was created
             if ( ! scriptfile.Get().empty() )
             {
-                SCXFile::Delete(scriptfile);
+                ReleaseScript(scriptfile, cached);
             }
 
-            resultOut = L"";
-            resultErr = e.What();
+            resultOut = "";
+            resultErr = StrToUTF8(e.What());
             returncode = -1;
         }
 
         return (returncode == 0);
     }
     
+    /*----------------------------------------------------------------------------*/
+    /**
+        Get the result of a command run recently enough
+
+        \param[in]     key              Key of the command (see CommandResultCache::Key())
+        \param[in]     maxAge           Age (in seconds) of the result accepted (0 for none)
+        \param[out]    resultOut        Result string from stdout
+        \param[out]    resultErr        Result string from stderr
+        \param[out]    returncode       Return code from command
+        \returns       true if the result is provided
+    */
+    bool RunAsProvider::GetCachedResult(const std::wstring& key, unsigned maxAge, std::string &resultOut,
+                                        std::string &resultErr, int& returncode)
+    {
+        CommandResultCache::Result result;
+        if ( ! m_results.Get(key, maxAge, result) )
+        {
+            return false;
+        }
+
+        SCX_LOGHYSTERICAL(m_log, StrAppend(L"Result served from cache, max age ", maxAge));
+        resultOut = result.resultOut;
+        resultErr = result.resultErr;
+        returncode = result.returncode;
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Keep the result of a command, for callers accepting a recent result
+
+        \param[in]     key              Key of the command (see CommandResultCache::Key())
+        \param[in]     resultOut        Result string from stdout
+        \param[in]     resultErr        Result string from stderr
+        \param[in]     returncode       Return code from command
+    */
+    void RunAsProvider::PutCachedResult(const std::wstring& key, const std::string &resultOut,
+                                        const std::string &resultErr, int returncode)
+    {
+        CommandResultCache::Result result;
+        result.resultOut = resultOut;
+        result.resultErr = resultErr;
+        result.returncode = returncode;
+        m_results.Put(key, result);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+        Done with the file of a script run by ExecuteScript
+
+        \param[in]     scriptfile       File of the script
+        \param[in]     cached           Does the file come from the cache of scripts?
+    */
+    void RunAsProvider::ReleaseScript(const SCXFilePath& scriptfile, bool cached)
+    {
+        if (cached)
+        {
+            m_scripts.Release(scriptfile);
+        }
+        else
+        {
+            SCXFile::Delete(scriptfile);
+        }
+    }
+
     std::wstring RunAsProvider::ConstructCommandWithElevation(const std::wstring &command, 
                                                               const std::wstring &elevationtype)
     {
@@ -311,36 +515,55 @@ namespace SCXCore
         return newCommand;
     }
 
-    // Limit stdout/stderr length to avoid bumping up against OMI's 64k limit per instance
-    // (Not a whole lot of sense in raising that, since WS-Man has a limit as well)
-    bool RunAsProvider::OutputLimiter(std::wstring& resultOut, std::wstring& resultErr)
+    /*----------------------------------------------------------------------------*/
+    /**
+        Limit stdout/stderr length to avoid bumping up against OMI's 64k limit per instance
+
+        \param[in]     processOutput    Capture of stdout
+        \param[in]     processError     Capture of stderr
+        \param[in,out] resultOut        Result string from stdout
+        \param[in,out] resultErr        Result string from stderr
+        \returns       true if output was dropped
+    */
+    bool RunAsProvider::OutputLimiter(const OutputCapture& processOutput, const OutputCapture& processError,
+                                      std::string& resultOut, std::string& resultErr)
     {
-        const size_t maxOutputSize = 60*1024;
+        // Output beyond the capacity of the captures is already gone, possibly
+        // in the middle of a character
+        bool truncated = processOutput.Truncated() || processError.Truncated();
+        if ( processOutput.Truncated() )
+        {
+            OutputCapture::Truncate(resultOut, resultOut.size());
+        }
+        if ( processError.Truncated() )
+        {
+            OutputCapture::Truncate(resultErr, resultErr.size());
+        }
 
         // Do we need to truncate the output?
-        if (resultOut.size() + resultErr.size() <= maxOutputSize)
+        if (resultOut.size() + resultErr.size() <= s_maxOutputSize)
         {
             // Nope, we're good
-            return false;
+            return truncated;
         }
 
         if ( resultErr.size() == 0 )
         {
             // Truncate stdout only
-            resultOut = resultOut.substr(0, maxOutputSize-1);
+            OutputCapture::Truncate(resultOut, s_maxOutputSize-1);
         }
         else if ( resultOut.size() == 0 )
         {
             // Truncate stderr only
-            resultErr = resultErr.substr(0, maxOutputSize-1);
+            OutputCapture::Truncate(resultErr, s_maxOutputSize-1);
         }
         else
         {
             // They are both non-zero in size. There are a number of ways to do
             // this, but PM said to keep it simple and do this ...
 
-            resultOut = resultOut.substr(0, maxOutputSize - 1 - 1024);
-            resultErr = resultErr.substr(0, 1024 - 1);
+            OutputCapture::Truncate(resultOut, s_maxOutputSize - 1 - 1024);
+            OutputCapture::Truncate(resultErr, 1024 - 1);
         }
 
         return true;
@@ -14,8 +14,13 @@
 #define RUNASPROVIDER_H
 
 #include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxconfigfile.h>
 #include <scxcorelib/scxlog.h>
 
+#include "commandresultcache.h"
+#include "outputcapture.h"
+#include "scriptcache.h"
+
 using namespace SCXCoreLib;
 
 namespace SCXCore
@@ -30,22 +35,26 @@ namespace SCXCore
     class RunAsProvider
     {
     public:
-        RunAsProvider() : m_Configurator(NULL) { }
+        RunAsProvider() :
+            m_Configurator(NULL),
+            m_scripts(L"SCXCore::RunAsProvider::ScriptCache"),
+            m_results(L"SCXCore::RunAsProvider::CommandResultCache")
+        { }
         ~RunAsProvider() { };
 
         void Load();
         void Unload();
 
-        bool ExecuteCommand(const std::wstring &command, std::wstring &resultOut,
-                            std::wstring &resultErr, int& returncode, unsigned timeout = 0,
-                            const std::wstring &elevationtype = L"");
+        bool ExecuteCommand(const std::wstring &command, std::string &resultOut,
+                            std::string &resultErr, int& returncode, unsigned timeout = 0,
+                            const std::wstring &elevationtype = L"", unsigned maxAge = 0);
 
-        bool ExecuteShellCommand(const std::wstring &command, std::wstring &resultOut,
-                                 std::wstring &resultErr, int& returncode, unsigned timeout = 0,
-                                 const std::wstring &elevationtype = L"");
+        bool ExecuteShellCommand(const std::wstring &command, std::string &resultOut,
+                                 std::string &resultErr, int& returncode, unsigned timeout = 0,
+                                 const std::wstring &elevationtype = L"", unsigned maxAge = 0);
 
         bool ExecuteScript(const std::wstring &script, const std::wstring &arguments,
-                           std::wstring &resultOut, std::wstring &resultErr,
+                           std::string &resultOut, std::string &resultErr,
                            int& returncode, unsigned timeout = 0, const std::wstring &elevationtype = L"");
         
         SCXLogHandle& GetLogHandle() { return m_log; }
@@ -62,16 +71,26 @@ namespace SCXCore
 
     private:
         void ParseConfiguration() { m_Configurator->Parse(); }
+        void ReadConfiguration();
+        void ReadSize(SCXCoreLib::SCXConfigFile& conf, const std::wstring& key, size_t& value);
+        void ReleaseScript(const SCXCoreLib::SCXFilePath& scriptfile, bool cached);
+        bool GetCachedResult(const std::wstring& key, unsigned maxAge, std::string &resultOut,
+                             std::string &resultErr, int& returncode);
+        void PutCachedResult(const std::wstring& key, const std::string &resultOut,
+                             const std::string &resultErr, int returncode);
 
         std::wstring ConstructCommandWithElevation(const std::wstring &command, const std::wstring &elevationtype);
         std::wstring ConstructShellCommandWithElevation(const std::wstring &command, const std::wstring &elevationtype);
-        bool OutputLimiter(std::wstring& resultOut, std::wstring& resultErr);
+        bool OutputLimiter(const OutputCapture& processOutput, const OutputCapture& processError,
+                           std::string& resultOut, std::string& resultErr);
 
         //! Configurator.
         SCXCoreLib::SCXHandle<RunAsConfigurator> m_Configurator;
 
         SCXCoreLib::SCXLogHandle m_log;
         std::wstring m_defaultTmpDir;
+        ScriptCache m_scripts;          //!< Files of the scripts run by ExecuteScript
+        CommandResultCache m_results;   //!< Recent results of ExecuteCommand and ExecuteShellCommand
         static int ms_loadCount;
     };
 
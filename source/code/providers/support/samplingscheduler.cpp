@@ -0,0 +1,275 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      samplingscheduler.cpp
+
+    \brief     Background sampling of provider data, off the OMI request threads
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxcondition.h>
+#include <scxcorelib/scxconfigfile.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxlog.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+
+#include "samplingscheduler.h"
+#include "snapshotpublisher.h"
+#include "startuplog.h"
+
+#include <vector>
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parameter of the thread of a SamplingScheduler
+    */
+    class SamplingSchedulerThreadParam : public SCXThreadParam
+    {
+    public:
+        //! Constructor
+        //! \param[in] scheduler  Scheduler whose samplers the thread runs
+        explicit SamplingSchedulerThreadParam(SCXCore::SamplingScheduler* scheduler) :
+            SCXThreadParam(), m_scheduler(scheduler)
+        {
+        }
+
+        SCXCore::SamplingScheduler* m_scheduler;    //!< Scheduler whose samplers the thread runs
+    };
+}
+
+namespace SCXCore
+{
+    //! Scheduler of all providers
+    SamplingScheduler g_SamplingScheduler;
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] runThread  Start a thread to run the samplers? (if not, RunDue()
+                             must be called explicitly, like the unit tests do)
+    */
+    SamplingScheduler::SamplingScheduler(bool runThread) :
+        m_runThread(runThread),
+        m_thread(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Destructor
+    */
+    SamplingScheduler::~SamplingScheduler()
+    {
+        if (m_thread != NULL)
+        {
+            m_thread->RequestTerminate();
+            m_thread->Wait();
+            m_thread = NULL;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Register a sampler, replacing any sampler of the same name
+
+       The first sample is taken one interval after registration: the provider
+       being loaded is about to serve a request, which refreshes its data anyway.
+
+       \param[in] name      Name of the sampler (like L"ProcessProvider")
+       \param[in] function  Function taking a sample
+       \param[in] interval  Interval (in milliseconds) between samples; rounded up to cTick
+    */
+    void SamplingScheduler::Register(const std::wstring& name, SampleFunction function, scxulong interval)
+    {
+        Entry entry;
+        entry.function = function;
+        entry.interval = interval < cTick ? cTick : interval;
+        entry.next = GetSnapshotTime() + entry.interval;
+
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Lock"));
+        m_entries[name] = entry;
+
+        if (m_runThread && (m_thread == NULL || !m_thread->IsAlive()))
+        {
+            m_thread = new SCXThread(ThreadBody, new SamplingSchedulerThreadParam(this));
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Unregister a sampler
+
+       When this returns, the sampler isn't running and won't be called again,
+       so the data it samples may be released. Must not be called by a sampler.
+
+       \param[in] name  Name of the sampler
+    */
+    void SamplingScheduler::Unregister(const std::wstring& name)
+    {
+        SCXHandle<SCXThread> thread(0);
+        {
+            SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Lock"));
+            m_entries.erase(name);
+            if (m_entries.empty())
+            {
+                thread = m_thread;
+                m_thread = NULL;
+            }
+        }
+
+        // Wait for a pass in progress, which may still be running the sampler
+        {
+            SCXThreadLock runLock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Run"));
+        }
+
+        if (thread != NULL)
+        {
+            thread->RequestTerminate();
+            thread->Wait();
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is a sampler registered?
+
+       \param[in] name  Name of the sampler
+       \returns   true if registered
+    */
+    bool SamplingScheduler::IsRegistered(const std::wstring& name) const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Lock"));
+        return m_entries.find(name) != m_entries.end();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Run the samplers that are due
+
+       \param[in] now  Current time (in milliseconds, see GetSnapshotTime())
+       \returns   Number of samplers run
+    */
+    size_t SamplingScheduler::RunDue(scxulong now)
+    {
+        SCXThreadLock runLock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Run"));
+
+        std::vector<SampleFunction> due;
+        {
+            SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::SamplingScheduler::Lock"));
+            for (std::map<std::wstring, Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (it->second.next <= now)
+                {
+                    due.push_back(it->second.function);
+                    it->second.next = now + it->second.interval;
+                }
+            }
+        }
+
+        for (std::vector<SampleFunction>::const_iterator it = due.begin(); it != due.end(); ++it)
+        {
+            try
+            {
+                (*it)();
+            }
+            catch (const SCXException& e)
+            {
+                SCX_LOGWARNING(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.samplingscheduler"),
+                               StrAppend(L"Sampler failed: ", e.What()));
+            }
+        }
+
+        return due.size();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Body of the thread running the samplers
+
+       \param[in] param  A SamplingSchedulerThreadParam
+    */
+    void SamplingScheduler::ThreadBody(SCXThreadParamHandle& param)
+    {
+        SamplingSchedulerThreadParam* p = static_cast<SamplingSchedulerThreadParam*>(param.GetData());
+        SCXASSERT(NULL != p);
+
+        p->m_cond.SetSleep(cTick);
+        SCXConditionHandle h(p->m_cond);
+        while (!p->GetTerminateFlag())
+        {
+            h.Unlock();
+            p->m_scheduler->RunDue(GetSnapshotTime());
+            h.Lock();
+
+            if (!p->GetTerminateFlag())
+            {
+                h.Wait();
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Read the sampling settings of a provider from the SCX configuration file
+
+       Supported settings (with <provider> the name of the provider):
+         <provider>_SnapshotMaxAgeMs - Maximum age (in milliseconds) of the shared
+                                       snapshot (0 disables sharing)
+         <provider>_SampleIntervalMs - Interval (in milliseconds) at which the
+                                       snapshot is refreshed in the background
+                                       (0 disables background sampling)
+
+       Settings missing or invalid keep the value passed in.
+
+       \param[in]     log             Log handle of the provider
+       \param[in]     provider        Name of the provider (e.g. "ProcessProvider")
+       \param[in,out] snapshotMaxAge  Maximum age (in milliseconds) of the snapshot
+       \param[in,out] sampleInterval  Interval (in milliseconds) of the background sampling
+    */
+    void ReadSamplingConfiguration(SCXLogHandle& log, const std::wstring& provider,
+                                   scxulong& snapshotMaxAge, scxulong& sampleInterval)
+    {
+        SCXConfigFile conf(SCXConfFile);
+        try {
+            conf.LoadConfig();
+        }
+        catch (SCXFilePathNotFoundException&)
+        {
+            return;
+        }
+
+        const std::wstring keys[] = { provider + L"_SnapshotMaxAgeMs", provider + L"_SampleIntervalMs" };
+        scxulong* values[] = { &snapshotMaxAge, &sampleInterval };
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+        {
+            std::wstring value;
+            if (conf.GetValue(keys[i], value))
+            {
+                try {
+                    *values[i] = StrToULong(value);
+                }
+                catch (SCXException&)
+                {
+                    SCX_LOGWARNING(log, L"Invalid " + keys[i] + L" value in configuration file: " + value);
+                }
+            }
+        }
+
+        SCX_LOGTRACE(log, StrAppend(provider + L" parameters: Snapshot max age (ms) = ", snapshotMaxAge));
+        SCX_LOGTRACE(log, StrAppend(provider + L" parameters: Sample interval (ms) = ", sampleInterval));
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
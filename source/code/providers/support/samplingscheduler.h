@@ -0,0 +1,91 @@
+/*------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+
+*/
+/**
+    \file      samplingscheduler.h
+
+    \brief     Background sampling of provider data, off the OMI request threads
+
+    \date      2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef SAMPLINGSCHEDULER_H
+#define SAMPLINGSCHEDULER_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxlog.h>
+#include <scxcorelib/scxthread.h>
+
+#include <map>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Runs the samplers of the providers on a single background thread
+
+       A provider registers a sample function when loaded, with the interval it
+       wants to be called at, and unregisters it when unloaded. The function
+       typically refreshes a snapshot published through a SnapshotPublisher,
+       so EnumerateInstances finds a recent snapshot and never pays for the
+       refresh on the OMI request thread.
+
+       All samplers run on the same thread, one after the other, and samplers
+       due at the same time run in the same pass. A sampler that overruns its
+       interval is simply called again at the next pass: calls never pile up.
+       The thread is started by the first registration and stopped when the
+       last sampler is unregistered.
+
+       This class is thread safe.
+    */
+    class SamplingScheduler
+    {
+    public:
+        //! Function taking a sample
+        typedef void (*SampleFunction)();
+
+        //! Resolution (in milliseconds) of the scheduling
+        static const scxulong cTick = 250;
+        //! How long (in milliseconds) a sampler keeps sampling after the data was last requested
+        static const scxulong cDemandTimeout = 10 * 60 * 1000;
+
+        explicit SamplingScheduler(bool runThread = true);
+        ~SamplingScheduler();
+
+        void Register(const std::wstring& name, SampleFunction function, scxulong interval);
+        void Unregister(const std::wstring& name);
+        bool IsRegistered(const std::wstring& name) const;
+
+        size_t RunDue(scxulong now);
+
+    private:
+        //! A registered sampler
+        struct Entry
+        {
+            SampleFunction function;    //!< Function taking the sample
+            scxulong interval;          //!< Interval (in milliseconds) between samples
+            scxulong next;              //!< Time (in milliseconds) of the next sample
+        };
+
+        //! Not copyable
+        SamplingScheduler(const SamplingScheduler&);
+        SamplingScheduler& operator=(const SamplingScheduler&);
+
+        static void ThreadBody(SCXCoreLib::SCXThreadParamHandle& param);
+
+        const bool m_runThread;                             //!< Should a thread be started to run the samplers?
+        std::map<std::wstring, Entry> m_entries;            //!< Samplers by name
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXThread> m_thread; //!< Thread running the samplers (if started)
+    };
+
+    extern SCXCore::SamplingScheduler g_SamplingScheduler;
+
+    void ReadSamplingConfiguration(SCXCoreLib::SCXLogHandle& log, const std::wstring& provider,
+                                   scxulong& snapshotMaxAge, scxulong& sampleInterval);
+}
+
+#endif /* SAMPLINGSCHEDULER_H */
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
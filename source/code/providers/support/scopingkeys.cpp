@@ -0,0 +1,236 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     scopingkeys.cpp
+
+    \brief    Implementation of the cache of CIM scoping keys shared by all providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxnameresolver.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+#include <scxsystemlib/scxostypeinfo.h>
+
+#include "scopingkeys.h"
+
+#include <sstream>
+
+using namespace SCXCoreLib;
+
+namespace SCXCore
+{
+    const char* const ScopingKeys::cCSCreationClassName = "SCX_ComputerSystem";
+    const char* const ScopingKeys::cOSCreationClassName = "SCX_OperatingSystem";
+
+    //
+    // Scoping keys dependencies implementation
+    //
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Resolve the host/domain name of the local host
+
+       \returns  Fully qualified host name
+       \throws   SCXException if the name can't be resolved
+    */
+    std::wstring ScopingKeysDependencies::GetHostDomainname() const
+    {
+        NameResolver mi;
+        return mi.GetHostDomainname();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Resolve the (compatibility) name of the operating system
+
+       \returns  OS name as used in the OSName scoping key
+       \throws   SCXException if the name can't be resolved
+    */
+    std::wstring ScopingKeysDependencies::GetOSName() const
+    {
+        SCXSystemLib::SCXOSTypeInfo osinfo;
+        return osinfo.GetOSName(true);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the current time
+
+       \returns  Current time in seconds since the epoch
+    */
+    time_t ScopingKeysDependencies::GetCurrentTime() const
+    {
+        return time(NULL);
+    }
+
+    //
+    // Scoping keys implementation
+    //
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] deps  Dependencies to use (injectable for testing)
+    */
+    ScopingKeys::ScopingKeys(SCXHandle<ScopingKeysDependencies> deps) :
+        m_deps(deps),
+        m_csNameValid(false),
+        m_osNameValid(false),
+        m_refreshTime(0),
+        m_maxAge(cDefaultMaxAge),
+        m_invalidated(true),
+        m_refreshCount(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the host/domain name (CSName/SystemName scoping key)
+
+       \param[out] csName  Host/domain name of the local host
+       \returns    true if the name could be resolved, false otherwise
+    */
+    bool ScopingKeys::GetCSName(std::string& csName)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ScopingKeys::Lock"));
+        RefreshIfStale();
+
+        if (m_csNameValid)
+        {
+            csName = m_csName;
+        }
+        return m_csNameValid;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the operating system name (OSName scoping key)
+
+       \param[out] osName  Name of the operating system
+       \returns    true if the name could be resolved, false otherwise
+    */
+    bool ScopingKeys::GetOSName(std::string& osName)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ScopingKeys::Lock"));
+        RefreshIfStale();
+
+        if (m_osNameValid)
+        {
+            osName = m_osName;
+        }
+        return m_osNameValid;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Force the cached values to be resolved again on the next request
+
+       Not called by the providers, which rely on the maximum age alone (see
+       the description of the class).
+    */
+    void ScopingKeys::Invalidate()
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ScopingKeys::Lock"));
+        m_invalidated = true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the maximum age of the cached values
+
+       \param[in] maxAge  Maximum age in seconds (0 resolves the values on every request)
+    */
+    void ScopingKeys::SetMaxAge(time_t maxAge)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ScopingKeys::Lock"));
+        m_maxAge = maxAge;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the number of times the cached values have been resolved
+
+       \returns  Refresh count since construction
+    */
+    scxulong ScopingKeys::GetRefreshCount() const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(L"SCXCore::ScopingKeys::Lock"));
+        return m_refreshCount;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Format the refresh count for SCX_Agent, like "ScopingKeys Refreshes=3"
+
+       \returns  Formatted refresh count
+    */
+    std::string ScopingKeys::Format() const
+    {
+        std::ostringstream line;
+        line << "ScopingKeys Refreshes=" << GetRefreshCount();
+        return line.str();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Resolve the cached values if they are stale, invalidated or unresolved
+
+       Must be called with the scoping keys lock held.
+    */
+    void ScopingKeys::RefreshIfStale()
+    {
+        time_t now = m_deps->GetCurrentTime();
+
+        // A clock that moves backwards also makes the cache stale
+        bool stale = m_invalidated || now < m_refreshTime || now - m_refreshTime >= m_maxAge;
+        if (!stale && m_csNameValid && m_osNameValid)
+        {
+            return;
+        }
+
+        SCXLogHandle log = SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.scopingkeys");
+
+        if (stale || !m_csNameValid)
+        {
+            try {
+                m_csName = StrToMultibyte(m_deps->GetHostDomainname());
+                m_csNameValid = true;
+            } catch (SCXException& e) {
+                m_csNameValid = false;
+                SCX_LOGWARNING(log, StrAppend(
+                                   StrAppend(L"Can't read host/domainname because ", e.What()),
+                                   e.Where()));
+            }
+        }
+
+        if (stale || !m_osNameValid)
+        {
+            try {
+                m_osName = StrToMultibyte(m_deps->GetOSName());
+                m_osNameValid = true;
+            } catch (SCXException& e) {
+                m_osNameValid = false;
+                SCX_LOGWARNING(log, StrAppend(
+                                   StrAppend(L"Can't read OS name because ", e.What()),
+                                   e.Where()));
+            }
+        }
+
+        m_refreshTime = now;
+        m_invalidated = false;
+        ++m_refreshCount;
+
+        SCX_LOGTRACE(log, StrAppend(L"ScopingKeys refreshed, refresh count = ", m_refreshCount));
+    }
+
+    ScopingKeys g_ScopingKeys;
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,104 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     scopingkeys.h
+
+    \brief    Declarations of the cache of CIM scoping keys shared by all providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef SCOPINGKEYS_H
+#define SCOPINGKEYS_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxlog.h>
+
+#include <string>
+#include <time.h>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    //! Encapsulates the dependencies of the scoping keys cache
+    //!
+    class ScopingKeysDependencies
+    {
+    public:
+        virtual std::wstring GetHostDomainname() const;
+        virtual std::wstring GetOSName() const;
+        virtual time_t GetCurrentTime() const;
+
+        //! Virtual destructor preparing for subclasses
+        virtual ~ScopingKeysDependencies() { }
+    }; // End of class ScopingKeysDependencies
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Cache of the CIM scoping keys
+
+       Most provider classes are scoped by the computer system and/or the
+       operating system, so every instance posted carries the host/domain name
+       (CSName or SystemName) and the OS name (OSName) as part of its key.
+       Resolving those values is costly (name lookups, reading release files),
+       so they are resolved once and shared by all providers.
+
+       The cached values are refreshed when they are older than the maximum age,
+       or on the next request after Invalidate() has been called. Lookups that
+       fail are not cached; they are retried on the next request.
+
+       The providers don't watch for hostname or configuration changes (they
+       read their configuration when loaded), so in production the maximum
+       age (cDefaultMaxAge, 300 seconds) is the only invalidation: after a
+       hostname change, instances may carry the old CSName/SystemName for up
+       to that long. Invalidate() is there for callers that know a value
+       changed, such as tests.
+
+       This class is thread safe; it is used under several different provider locks.
+    */
+    class ScopingKeys
+    {
+    public:
+        //! Default maximum age (in seconds) of the cached values
+        static const time_t cDefaultMaxAge = 300;
+
+        //! Creation class name of the scoping computer system
+        static const char* const cCSCreationClassName;
+        //! Creation class name of the scoping operating system
+        static const char* const cOSCreationClassName;
+
+        ScopingKeys(SCXCoreLib::SCXHandle<ScopingKeysDependencies> deps =
+                    SCXCoreLib::SCXHandle<ScopingKeysDependencies>(new ScopingKeysDependencies()));
+        virtual ~ScopingKeys() { }
+
+        bool GetCSName(std::string& csName);
+        bool GetOSName(std::string& osName);
+
+        void Invalidate();
+        void SetMaxAge(time_t maxAge);
+        scxulong GetRefreshCount() const;
+        std::string Format() const;
+
+    private:
+        void RefreshIfStale();
+
+        SCXCoreLib::SCXHandle<ScopingKeysDependencies> m_deps; //!< External functionality the cache is dependent upon.
+
+        std::string m_csName;           //!< Cached host/domain name
+        std::string m_osName;           //!< Cached OS name
+        bool m_csNameValid;             //!< Is m_csName resolved?
+        bool m_osNameValid;             //!< Is m_osName resolved?
+        time_t m_refreshTime;           //!< Time of the last refresh
+        time_t m_maxAge;                //!< Maximum age (in seconds) of the cached values
+        bool m_invalidated;             //!< Force a refresh on next request?
+        scxulong m_refreshCount;        //!< Number of refreshes performed (for diagnostics)
+    };
+
+    extern ScopingKeys g_ScopingKeys;
+} // End of namespace SCXCore
+
+#endif /* SCOPINGKEYS_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,438 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     scriptcache.cpp
+
+    \brief    Cache of the script files run by RunAsProvider::ExecuteScript, by content
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/logsuppressor.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxlog.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include "scriptcache.h"
+
+using namespace SCXCoreLib;
+using namespace std;
+
+namespace
+{
+    //! Prefix of the names of the cached script files
+    const wchar_t* const cFilePrefix = L"script-";
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write a whole buffer to a file
+
+       \param[in] fd    File descriptor
+       \param[in] data  Data to write
+       \param[in] size  Number of bytes to write
+       \throws    SCXErrnoException if the write fails
+    */
+    void WriteAll(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written = write(fd, data, size);
+            if (written < 0)
+            {
+                if (EINTR == errno)
+                {
+                    continue;
+                }
+                throw SCXErrnoException(L"write", errno, SCXSRCLOCATION);
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+}
+
+namespace SCXCore
+{
+    const wchar_t* const ScriptCache::cSubdirectory = L"scripts-";
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] lockName  Name of the lock guarding the cache
+    */
+    ScriptCache::ScriptCache(const std::wstring& lockName) :
+        m_lockName(lockName),
+        m_maxScripts(cDefaultMaxScripts),
+        m_maxBytes(cDefaultMaxBytes),
+        m_bytes(0),
+        m_uses(0)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Set the size of the cache, removing scripts if it is now too large
+
+       \param[in] maxScripts  Maximum number of scripts cached (0 disables the cache)
+       \param[in] maxBytes    Maximum size (in bytes) of all scripts cached
+    */
+    void ScriptCache::SetLimits(size_t maxScripts, size_t maxBytes)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        m_maxScripts = maxScripts;
+        m_maxBytes = maxBytes;
+        Evict();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get an executable file holding a script, writing it only if not cached yet
+
+       \param[in]  tmpDir  Temporary directory of the RunAs provider
+       \param[in]  script  Contents of the script
+       \param[out] path    File holding the script; to be released with Release() once run
+       \returns    true if the file is provided; false if the script isn't cached
+                   (cache disabled or too small, file not writable), and the caller
+                   must write it on its own
+    */
+    bool ScriptCache::Acquire(const std::wstring& tmpDir, const std::string& script, SCXFilePath& path)
+    {
+        std::wstring directory = Directory(tmpDir);
+        std::wstring file = directory + cFilePrefix + StrFromUTF8(Hash(script));
+
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+
+        // Leave room for a few scripts: a single one may not fill the cache
+        if (0 == m_maxScripts || script.size() > m_maxBytes / 4)
+        {
+            return false;
+        }
+
+        std::map<std::wstring, Entry>::iterator it = m_entries.find(file);
+        if (it != m_entries.end())
+        {
+            if (it->second.script == script && IsUnchanged(it->second))
+            {
+                it->second.users++;
+                it->second.lastUse = ++m_uses;
+                path = SCXFilePath(file);
+                return true;
+            }
+
+            // Another script with the same hash, or a file modified behind our back
+            if (it->second.users > 0)
+            {
+                return false;
+            }
+            Remove(it);
+        }
+
+        Entry entry;
+        entry.script = script;
+        entry.path = file;
+        entry.users = 1;
+        entry.lastUse = ++m_uses;
+        try
+        {
+            PrepareDirectory(StrToMultibyte(directory));
+            Write(entry);
+        }
+        catch (SCXException& e)
+        {
+            static LogSuppressor suppressor(eWarning, eTrace);
+            SCX_LOG(SCXLogHandleFactory::GetLogHandle(L"scx.core.providers.runasprovider"), suppressor.GetSeverity(directory),
+                    StrAppend(L"Can't cache script in " + directory + L": ", e.What()));
+            return false;
+        }
+
+        m_entries[file] = entry;
+        m_bytes += script.size();
+        Evict();
+
+        path = SCXFilePath(file);
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Tell the cache a script file returned by Acquire() has run
+
+       \param[in] path  File returned by Acquire()
+    */
+    void ScriptCache::Release(const SCXFilePath& path)
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        std::map<std::wstring, Entry>::iterator it = m_entries.find(path.Get());
+        if (it != m_entries.end() && it->second.users > 0)
+        {
+            it->second.users--;
+        }
+
+        // Scripts over the limits that were running may go now
+        Evict();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove all cached scripts that aren't running
+    */
+    void ScriptCache::Clear()
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        std::map<std::wstring, Entry>::iterator it = m_entries.begin();
+        while (it != m_entries.end())
+        {
+            std::map<std::wstring, Entry>::iterator current = it++;
+            if (0 == current->second.users)
+            {
+                Remove(current);
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Number of scripts cached
+
+       \returns   Number of scripts
+    */
+    size_t ScriptCache::Size() const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        return m_entries.size();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Hash of a script, naming its file (64-bit FNV-1a)
+
+       \param[in] script  Contents of the script
+       \returns   Hash as 16 hexadecimal digits
+    */
+    std::string ScriptCache::Hash(const std::string& script)
+    {
+        scxulong hash = 14695981039346656037ULL;
+        for (std::string::const_iterator it = script.begin(); it != script.end(); ++it)
+        {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 1099511628211ULL;
+        }
+
+        std::ostringstream ss;
+        ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return ss.str();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Directory of the cached scripts of the effective user of the agent
+
+       \param[in] tmpDir  Temporary directory of the RunAs provider
+       \returns   Directory, ending with a '/'
+    */
+    std::wstring ScriptCache::Directory(const std::wstring& tmpDir)
+    {
+        std::wstring directory = tmpDir;
+        if (directory.empty() || L'/' != directory[directory.size() - 1])
+        {
+            directory.append(L"/");
+        }
+        return StrAppend(directory + cSubdirectory, geteuid()).append(L"/");
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Check that the file of a cached script is still the one written by the cache
+
+       Caller holds the lock of the cache.
+
+       \param[in] entry  Cached script
+       \returns   true if the file may be run
+    */
+    bool ScriptCache::IsUnchanged(const Entry& entry) const
+    {
+        struct stat st;
+        return 0 == lstat(StrToMultibyte(entry.path).c_str(), &st)
+            && S_ISREG(st.st_mode)
+            && st.st_uid == geteuid()
+            && S_IRWXU == (st.st_mode & 07777)
+            && static_cast<size_t>(st.st_size) == entry.script.size()
+            && st.st_dev == entry.device
+            && st.st_ino == entry.inode
+            && st.st_mtime == entry.mtime;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Create the directory of the cached scripts if missing, and check it is
+       private to the agent
+
+       The first time a directory is used, the script files left in it by an
+       earlier agent process are removed: nothing would ever remove them
+       otherwise. Caller holds the lock of the cache.
+
+       \param[in] directory  Directory of the cached scripts
+       \throws    SCXException if the directory isn't private or can't be created
+    */
+    void ScriptCache::PrepareDirectory(const std::string& directory)
+    {
+        if (0 != mkdir(directory.c_str(), S_IRWXU) && EEXIST != errno)
+        {
+            throw SCXErrnoException(L"mkdir", errno, SCXSRCLOCATION);
+        }
+
+        struct stat st;
+        if (0 != lstat(directory.c_str(), &st))
+        {
+            throw SCXErrnoException(L"lstat", errno, SCXSRCLOCATION);
+        }
+        if (!S_ISDIR(st.st_mode) || st.st_uid != geteuid() || 0 != (st.st_mode & (S_IRWXG | S_IRWXO)))
+        {
+            throw SCXInternalErrorException(L"Directory is not private to the agent", SCXSRCLOCATION);
+        }
+
+        if (m_purgedDirectories.find(directory) != m_purgedDirectories.end())
+        {
+            return;
+        }
+
+        DIR* dir = opendir(directory.c_str());
+        if (NULL == dir)
+        {
+            throw SCXErrnoException(L"opendir", errno, SCXSRCLOCATION);
+        }
+        std::string prefix = StrToMultibyte(cFilePrefix);
+        struct dirent* dirEntry;
+        while (NULL != (dirEntry = readdir(dir)))
+        {
+            // Complete files and temporary files of interrupted writes
+            if (0 == strncmp(dirEntry->d_name, prefix.c_str(), prefix.size()))
+            {
+                unlink((directory + dirEntry->d_name).c_str());
+            }
+        }
+        closedir(dir);
+
+        m_purgedDirectories.insert(directory);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Write the file of a script
+
+       The file is written under a temporary name and renamed, so a script is
+       never run half written. Caller holds the lock of the cache and has
+       prepared the directory of the file.
+
+       \param[in,out] entry  Cached script; the identity of the file is filled in
+       \throws        SCXException if the file can't be written
+    */
+    void ScriptCache::Write(Entry& entry) const
+    {
+        struct stat st;
+        std::string path = StrToMultibyte(entry.path);
+        std::string tmpPath = path + StrToMultibyte(StrAppend(L".", getpid())) + ".tmp";
+        int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRWXU);
+        if (fd < 0)
+        {
+            throw SCXErrnoException(L"open", errno, SCXSRCLOCATION);
+        }
+
+        try
+        {
+            WriteAll(fd, entry.script.c_str(), entry.script.size());
+
+            // The mode given to open() is subject to the umask
+            if (0 != fchmod(fd, S_IRWXU))
+            {
+                throw SCXErrnoException(L"fchmod", errno, SCXSRCLOCATION);
+            }
+            if (0 != fstat(fd, &st))
+            {
+                throw SCXErrnoException(L"fstat", errno, SCXSRCLOCATION);
+            }
+            close(fd);
+            fd = -1;
+
+            if (0 != rename(tmpPath.c_str(), path.c_str()))
+            {
+                throw SCXErrnoException(L"rename", errno, SCXSRCLOCATION);
+            }
+        }
+        catch (SCXException&)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            unlink(tmpPath.c_str());
+            throw;
+        }
+
+        entry.device = st.st_dev;
+        entry.inode = st.st_ino;
+        entry.mtime = st.st_mtime;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove the least recently used scripts that aren't running, until the
+       cache is within its limits
+
+       Caller holds the lock of the cache.
+    */
+    void ScriptCache::Evict()
+    {
+        while (m_entries.size() > m_maxScripts || m_bytes > m_maxBytes)
+        {
+            std::map<std::wstring, Entry>::iterator oldest = m_entries.end();
+            for (std::map<std::wstring, Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (0 == it->second.users && (oldest == m_entries.end() || it->second.lastUse < oldest->second.lastUse))
+                {
+                    oldest = it;
+                }
+            }
+
+            if (oldest == m_entries.end())
+            {
+                // Everything left is running
+                return;
+            }
+            Remove(oldest);
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Remove a cached script and its file
+
+       Caller holds the lock of the cache.
+
+       \param[in] it  Cached script
+    */
+    void ScriptCache::Remove(std::map<std::wstring, Entry>::iterator it)
+    {
+        unlink(StrToMultibyte(it->second.path).c_str());
+        m_bytes -= it->second.script.size();
+        m_entries.erase(it);
+    }
+
+} // End of namespace SCXCore
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
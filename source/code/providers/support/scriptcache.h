@@ -0,0 +1,112 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     scriptcache.h
+
+    \brief    Cache of the script files run by RunAsProvider::ExecuteScript, by content
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef SCRIPTCACHE_H
+#define SCRIPTCACHE_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxfilepath.h>
+
+#include <sys/types.h>
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Executable files holding the scripts run by ExecuteScript, reused while
+       the same script is sent again
+
+       Monitoring rules send the same scripts over and over; instead of writing,
+       chmod'ing and deleting a temporary file for each run, each script is
+       written once to a file named after the hash of its contents, in the
+       "scripts-<euid>" subdirectory of the RunAs temporary directory. The
+       directory and the files are private to the effective user of the agent
+       (mode 0700); agents running as other users get their own directory.
+
+       Files left in the directory by an earlier agent process are removed
+       the first time the cache uses the directory.
+
+       A cached file is only reused if it is still the file the cache wrote: same
+       inode, size, modification time, owner and mode. The contents are also
+       kept in memory, so two scripts with the same hash never share a file.
+
+       At most a configured number of scripts and bytes are cached; the least
+       recently used scripts that aren't running are removed first. A script
+       is running between Acquire() and Release(), and is never removed then.
+
+       This class is thread safe.
+    */
+    class ScriptCache
+    {
+    public:
+        //! Default maximum number of scripts cached
+        static const size_t cDefaultMaxScripts = 64;
+        //! Default maximum size (in bytes) of all scripts cached
+        static const size_t cDefaultMaxBytes = 4 * 1024 * 1024;
+        //! Prefix of the name of the subdirectory (of the temporary directory) holding the cached scripts
+        static const wchar_t* const cSubdirectory;
+
+        explicit ScriptCache(const std::wstring& lockName);
+
+        void SetLimits(size_t maxScripts, size_t maxBytes);
+
+        bool Acquire(const std::wstring& tmpDir, const std::string& script, SCXCoreLib::SCXFilePath& path);
+        void Release(const SCXCoreLib::SCXFilePath& path);
+        void Clear();
+
+        //! Number of scripts cached
+        //! \returns Number of scripts
+        size_t Size() const;
+
+        static std::string Hash(const std::string& script);
+        static std::wstring Directory(const std::wstring& tmpDir);
+
+    private:
+        //! A cached script
+        struct Entry
+        {
+            std::string script;         //!< Contents of the script
+            std::wstring path;          //!< File holding the script
+            dev_t device;               //!< Device of the file, when written
+            ino_t inode;                //!< Inode of the file, when written
+            time_t mtime;               //!< Modification time of the file, when written
+            size_t users;               //!< Number of runs using the file now
+            scxulong lastUse;           //!< When the file was last acquired (see m_uses)
+        };
+
+        //! Not copyable
+        ScriptCache(const ScriptCache&);
+        ScriptCache& operator=(const ScriptCache&);
+
+        bool IsUnchanged(const Entry& entry) const;
+        void PrepareDirectory(const std::string& directory);
+        void Write(Entry& entry) const;
+        void Evict();
+        void Remove(std::map<std::wstring, Entry>::iterator it);
+
+        const std::wstring m_lockName;                  //!< Name of the lock guarding the cache
+        size_t m_maxScripts;                            //!< Maximum number of scripts cached (0 disables the cache)
+        size_t m_maxBytes;                              //!< Maximum size of all scripts cached
+        std::map<std::wstring, Entry> m_entries;        //!< Cached scripts, by file
+        size_t m_bytes;                                 //!< Size of all scripts cached
+        scxulong m_uses;                                //!< Number of scripts acquired so far
+        std::set<std::string> m_purgedDirectories;      //!< Directories whose stale files were removed
+    };
+
+} // End of namespace SCXCore
+
+#endif /* SCRIPTCACHE_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
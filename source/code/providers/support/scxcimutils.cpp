@@ -12,6 +12,7 @@
 
 #include <scxcorelib/scxcmn.h>
 #include <scxcimutils.h>
+#include "wqlfiltercache.h"
 
 namespace CIMUtils
 {
@@ -30,4 +31,84 @@ namespace CIMUtils
 
         return true;
     }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the properties requested by a client
+
+       OMI evaluates the filter on the instances posted, after the projection:
+       the properties the where clause refers to are requested too, or no
+       instance would match.
+
+       \param[in] propertySet  Property set passed by OMI to the provider
+       \param[in] filter       Filter passed by OMI to the provider (may be NULL)
+       \returns   Requested properties (all of them if the set is empty or unreadable,
+                  or if the filter couldn't be analyzed)
+    */
+    SCXCore::RequestedProperties GetRequestedProperties( const mi::PropertySet& propertySet, const MI_Filter* filter )
+    {
+        SCXCore::RequestedProperties requested;
+
+        MI_Uint32 count = 0;
+        if ( MI_RESULT_OK != propertySet.GetElementCount(count) )
+        {
+            return requested;
+        }
+
+        for ( MI_Uint32 i = 0; i < count; i++ )
+        {
+            mi::String name;
+            if ( MI_RESULT_OK != propertySet.GetElementAt(i, name) )
+            {
+                // Can't tell what was requested: compute everything
+                return SCXCore::RequestedProperties();
+            }
+            requested.Add(name.Str());
+        }
+
+        std::string query;
+        if ( !requested.AreAllRequested() && GetFilterExpression(filter, query) )
+        {
+            SCXCoreLib::SCXHandle<SCXCore::WqlFilter> wql = SCXCore::g_WqlFilterCache.Get(query);
+            if ( !wql->IsValid() )
+            {
+                return SCXCore::RequestedProperties();
+            }
+
+            const std::set<std::wstring>& properties = wql->GetProperties();
+            for ( std::set<std::wstring>::const_iterator it = properties.begin(); it != properties.end(); ++it )
+            {
+                requested.Add(SCXCoreLib::StrToUTF8(*it));
+            }
+        }
+
+        return requested;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the query text of the filter passed to EnumerateInstances
+
+       \param[in]  filter      Filter passed by OMI to the provider (may be NULL)
+       \param[out] expression  Query text (UTF-8)
+       \returns    true if there is a filter and its text could be read
+    */
+    bool GetFilterExpression( const MI_Filter* filter, std::string& expression )
+    {
+        expression.clear();
+        if ( NULL == filter )
+        {
+            return false;
+        }
+
+        const MI_Char* language = NULL;
+        const MI_Char* text = NULL;
+        if ( MI_RESULT_OK != MI_Filter_GetExpression(filter, &language, &text) || NULL == text )
+        {
+            return false;
+        }
+
+        expression = text;
+        return true;
+    }
 }
@@ -19,10 +19,15 @@
 #include <scxcorelib/stringaid.h>
 
 #include <MI.h>
+#include <micxx/micxx.h>
+
+#include "requestedproperties.h"
 
 namespace CIMUtils
 {
     bool ConvertToCIMDatetime( MI_Datetime& outDT, SCXCoreLib::SCXCalendarTime& inTime );
+    SCXCore::RequestedProperties GetRequestedProperties( const mi::PropertySet& propertySet, const MI_Filter* filter = NULL );
+    bool GetFilterExpression( const MI_Filter* filter, std::string& expression );
 }
 
 
@@ -0,0 +1,274 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     snapshotpublisher.h
+
+    \brief    Publication of immutable snapshots shared by concurrent provider requests.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef SNAPSHOTPUBLISHER_H
+#define SNAPSHOTPUBLISHER_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+#include <scxcorelib/scxthreadlock.h>
+
+#include <string>
+#include <sys/time.h>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the current time, as used for the age of snapshots
+
+       \returns   Current time in milliseconds since the epoch
+    */
+    inline scxulong GetSnapshotTime()
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return static_cast<scxulong>(tv.tv_sec) * 1000 + static_cast<scxulong>(tv.tv_usec) / 1000;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       A single value copied out of a PAL instance into a snapshot, together
+       with a flag telling if the PAL was able to provide it.
+    */
+    template <typename T> class SnapshotValue
+    {
+    public:
+        SnapshotValue() : m_value(), m_valid(false) { }
+
+        //! Get the value
+        //! \param[out] value  Copy of the value (untouched if not valid)
+        //! \returns    true if the value is valid
+        bool Get(T& value) const
+        {
+            if (m_valid)
+            {
+                value = m_value;
+            }
+            return m_valid;
+        }
+
+        T m_value;      //!< The value itself
+        bool m_valid;   //!< Was the value supported by the PAL?
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Function object taking a new snapshot with a member function of a provider
+       (see SnapshotPublisher::GetOrRefresh() and SnapshotPublisher::SampleIfNeeded())
+    */
+    template <class P, class T> class SnapshotTaker
+    {
+    public:
+        //! Member function of the provider taking a new snapshot
+        typedef SCXCoreLib::SCXHandle<T> (P::*TakeFunction)();
+
+        //! Constructor
+        //! \param[in] provider  Provider taking the snapshots
+        //! \param[in] take      Member function of the provider taking a snapshot
+        SnapshotTaker(P* provider, TakeFunction take) : m_provider(provider), m_take(take) { }
+
+        //! Take a new snapshot
+        //! \returns The new snapshot
+        SCXCoreLib::SCXHandle<T> operator()() const { return (m_provider->*m_take)(); }
+
+    private:
+        P* m_provider;          //!< Provider taking the snapshots
+        TakeFunction m_take;    //!< Member function of the provider taking a snapshot
+    };
+
+    //! Build a SnapshotTaker, deducing its types
+    //! \param[in] provider  Provider taking the snapshots
+    //! \param[in] take      Member function of the provider taking a snapshot
+    //! \returns   Function object calling take on provider
+    template <class P, class T> SnapshotTaker<P, T> MakeSnapshotTaker(P* provider, SCXCoreLib::SCXHandle<T> (P::*take)())
+    {
+        return SnapshotTaker<P, T>(provider, take);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Holds the most recent snapshot taken by a provider, for requests to share
+
+       A snapshot (T) is filled in once and never modified after it has been
+       published, so requests read it without holding any lock. Only two
+       things are serialized:
+
+         - Getting or replacing the published snapshot, under the publication
+           lock, which is held for no longer than it takes to copy a handle.
+         - Taking a new snapshot, under the refresh lock (see GetRefreshLock()).
+           A request that finds the published snapshot too old takes the
+           refresh lock, then checks again, since another request (or the
+           background sampler) may have refreshed it in the meantime. This is
+           what GetOrRefresh() and SampleIfNeeded() do, so a provider only
+           supplies the function taking a new snapshot.
+
+       So a slow refresh only delays the requests that need a newer snapshot
+       of the same data, never the ones reading a snapshot already published.
+
+       T must provide bool IsStale(scxulong now, scxulong maxAge) const.
+    */
+    template <class T> class SnapshotPublisher
+    {
+    public:
+        /*----------------------------------------------------------------------------*/
+        /**
+           Constructor
+
+           \param[in] name  Name of the data (like L"SCXCore::ProcessProvider"),
+                            used to name the locks
+        */
+        explicit SnapshotPublisher(const std::wstring& name) :
+            m_publishLockName(name + L"::Publish"),
+            m_refreshLockName(name + L"::Refresh"),
+            m_snapshot(0),
+            m_lastRequest(0)
+        {
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Get the published snapshot, if recent enough
+
+           \param[in] now     Current time (in milliseconds, see GetSnapshotTime())
+           \param[in] maxAge  Maximum age (in milliseconds) of the snapshot
+           \returns   The published snapshot, or NULL if there is none or it is too old
+        */
+        SCXCoreLib::SCXHandle<T> Get(scxulong now, scxulong maxAge) const
+        {
+            SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(m_publishLockName));
+            m_lastRequest = now;
+            if (m_snapshot != NULL && !m_snapshot->IsStale(now, maxAge))
+            {
+                return m_snapshot;
+            }
+            return SCXCoreLib::SCXHandle<T>(0);
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Publish a new snapshot; requests already reading the previous one keep it
+
+           \param[in] snapshot  Snapshot to publish (NULL to drop the published one)
+        */
+        void Publish(SCXCoreLib::SCXHandle<T> snapshot)
+        {
+            SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(m_publishLockName));
+            m_snapshot = snapshot;
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Should a background sampler refresh the snapshot now? (see SamplingScheduler)
+
+           Only snapshots requested recently are kept fresh, and only when they
+           would otherwise be too old before the sampler runs again, so requests
+           find a recent snapshot without the data of an idle provider being
+           sampled forever.
+
+           \param[in] now            Current time (in milliseconds, see GetSnapshotTime())
+           \param[in] maxAge         Maximum age (in milliseconds) of the snapshot for requests
+           \param[in] interval       Interval (in milliseconds) until the sampler runs again
+           \param[in] demandTimeout  How long (in milliseconds) to refresh after the last request
+           \returns   true if the snapshot should be refreshed
+        */
+        bool NeedsRefresh(scxulong now, scxulong maxAge, scxulong interval, scxulong demandTimeout) const
+        {
+            SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(m_publishLockName));
+            if (0 == m_lastRequest || now < m_lastRequest || now - m_lastRequest >= demandTimeout)
+            {
+                return false;
+            }
+            return m_snapshot == NULL || m_snapshot->IsStale(now + interval, maxAge);
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Get the published snapshot if recent enough, or else take and publish a new one
+
+           \param[in] now     Current time (in milliseconds, see GetSnapshotTime())
+           \param[in] maxAge  Maximum age (in milliseconds) of the snapshot
+           \param[in] take    Function object taking a new snapshot (called with the
+                              refresh lock held)
+           \returns   A snapshot no older than maxAge
+        */
+        template <class Take> SCXCoreLib::SCXHandle<T> GetOrRefresh(scxulong now, scxulong maxAge, Take take)
+        {
+            SCXCoreLib::SCXHandle<T> snapshot = Get(now, maxAge);
+            if (snapshot != NULL)
+            {
+                return snapshot;
+            }
+
+            SCXCoreLib::SCXThreadLock refreshLock(GetRefreshLock());
+
+            // Another request may have refreshed the snapshot while we were waiting
+            // (after now: read the time again, or that snapshot would seem to be from the future)
+            snapshot = Get(GetSnapshotTime(), maxAge);
+            if (snapshot == NULL)
+            {
+                snapshot = take();
+                Publish(snapshot);
+            }
+            return snapshot;
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Refresh the snapshot for a background sampler, if requests need it (see NeedsRefresh())
+
+           \param[in] maxAge         Maximum age (in milliseconds) of the snapshot for requests
+           \param[in] interval       Interval (in milliseconds) until the sampler runs again
+           \param[in] demandTimeout  How long (in milliseconds) to refresh after the last request
+           \param[in] take           Function object taking a new snapshot (called with the
+                                     refresh lock held)
+           \returns   true if a new snapshot was published
+        */
+        template <class Take> bool SampleIfNeeded(scxulong maxAge, scxulong interval, scxulong demandTimeout, Take take)
+        {
+            if (!NeedsRefresh(GetSnapshotTime(), maxAge, interval, demandTimeout))
+            {
+                return false;
+            }
+
+            SCXCoreLib::SCXThreadLock refreshLock(GetRefreshLock());
+
+            // A request may have refreshed the snapshot while we were waiting
+            if (!NeedsRefresh(GetSnapshotTime(), maxAge, interval, demandTimeout))
+            {
+                return false;
+            }
+            Publish(take());
+            return true;
+        }
+
+        /*----------------------------------------------------------------------------*/
+        /**
+           Get the lock serializing the refresh of the snapshot
+
+           \returns   Handle to the refresh lock
+        */
+        SCXCoreLib::SCXThreadLockHandle GetRefreshLock() const
+        {
+            return SCXCoreLib::ThreadLockHandleGet(m_refreshLockName);
+        }
+
+    private:
+        const std::wstring m_publishLockName;   //!< Name of the publication lock
+        const std::wstring m_refreshLockName;   //!< Name of the refresh lock
+        SCXCoreLib::SCXHandle<T> m_snapshot;    //!< Published snapshot (NULL if none)
+        mutable scxulong m_lastRequest;         //!< Time of the last request (0 if none)
+    };
+}
+
+#endif /* SNAPSHOTPUBLISHER_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
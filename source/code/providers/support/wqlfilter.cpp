@@ -0,0 +1,821 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     wqlfilter.cpp
+
+    \brief    Implementation of the analysis of the WQL filters passed to the providers.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/stringaid.h>
+#include "wqlfilter.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <iterator>
+#include <limits>
+#include <stdlib.h>
+#include <wctype.h>
+
+using namespace SCXCoreLib;
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Recursive descent parser of the subset of WQL used by OMI filters
+
+       query   := SELECT ( '*' | name { ',' name } ) FROM name [ WHERE or ]
+       or      := and { OR and }
+       and     := not { AND not }
+       not     := NOT not | '(' or ')' | operand [ NOT ] IN '(' literal { ',' literal } ')'
+                | operand IS [ NOT ] NULL | operand [ NOT ] LIKE operand | operand ISA operand
+                | operand compare operand
+    */
+    class WqlFilter::Parser
+    {
+    public:
+        //! Constructor
+        //! \param[in] query  Query to parse
+        explicit Parser(const std::wstring& query) :
+            m_query(query), m_pos(0), m_type(eEnd), m_failed(false)
+        {
+            Next();
+        }
+
+        bool ParseQuery(std::wstring& className, SCXHandle<Node>& where);
+
+        //! Properties the where clause refers to (once parsed)
+        //! \returns Property names, as written in the query
+        const std::set<std::wstring>& GetProperties() const { return m_properties; }
+
+    private:
+        //! Kind of token
+        enum TokenType
+        {
+            eEnd,           //!< End of the query
+            eName,          //!< Name of a class or property, or keyword
+            eString,        //!< Quoted string (without the quotes)
+            eNumber,        //!< Number
+            eCompare,       //!< Comparison operator
+            eLeftParen,     //!< (
+            eRightParen,    //!< )
+            eComma,         //!< ,
+            eStar,          //!< *
+            eError          //!< Unexpected character
+        };
+
+        //! Kind of operand of a condition
+        enum OperandType
+        {
+            eProperty,      //!< Name of a property
+            eLiteral,       //!< String or number
+            eOther          //!< TRUE, FALSE or NULL
+        };
+
+        void Next();
+        bool IsKeyword(const wchar_t* keyword) const;
+        bool AcceptKeyword(const wchar_t* keyword);
+        bool Expect(TokenType type);
+
+        SCXHandle<Node> ParseOr();
+        SCXHandle<Node> ParseAnd();
+        SCXHandle<Node> ParseNot();
+        SCXHandle<Node> ParseCondition();
+        bool ParseOperand(OperandType& type, std::wstring& text);
+
+        static SCXHandle<Node> MakeNode(Node::Type type);
+
+        const std::wstring& m_query;    //!< Query parsed
+        size_t m_pos;                   //!< Position of the next token
+        TokenType m_type;               //!< Type of the current token
+        std::wstring m_text;            //!< Text of the current token
+        bool m_failed;                  //!< Did parsing fail?
+        std::set<std::wstring> m_properties;    //!< Properties the where clause refers to
+    };
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse the whole query
+
+       \param[out] className  Class selected from
+       \param[out] where      Where clause (NULL if none)
+       \returns    true if the query parsed
+    */
+    bool WqlFilter::Parser::ParseQuery(std::wstring& className, SCXHandle<Node>& where)
+    {
+        if (!AcceptKeyword(L"select"))
+        {
+            return false;
+        }
+
+        if (m_type == eStar)
+        {
+            Next();
+        }
+        else
+        {
+            for (;;)
+            {
+                if (m_type != eName)
+                {
+                    return false;
+                }
+                Next();
+                if (m_type != eComma)
+                {
+                    break;
+                }
+                Next();
+            }
+        }
+
+        if (!AcceptKeyword(L"from") || m_type != eName)
+        {
+            return false;
+        }
+        className = m_text;
+        Next();
+
+        where = NULL;
+        if (AcceptKeyword(L"where"))
+        {
+            where = ParseOr();
+        }
+
+        return !m_failed && m_type == eEnd;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Read the next token into m_type and m_text
+    */
+    void WqlFilter::Parser::Next()
+    {
+        while (m_pos < m_query.size() && iswspace(m_query[m_pos]))
+        {
+            m_pos++;
+        }
+
+        m_text.clear();
+        if (m_pos >= m_query.size())
+        {
+            m_type = eEnd;
+            return;
+        }
+
+        wchar_t c = m_query[m_pos];
+        if (iswalpha(c) || c == L'_')
+        {
+            size_t start = m_pos;
+            while (m_pos < m_query.size() && (iswalnum(m_query[m_pos]) || m_query[m_pos] == L'_'))
+            {
+                m_pos++;
+            }
+            m_type = eName;
+            m_text = m_query.substr(start, m_pos - start);
+        }
+        else if (iswdigit(c) || ((c == L'-' || c == L'+') && m_pos + 1 < m_query.size() && iswdigit(m_query[m_pos + 1])))
+        {
+            size_t start = m_pos++;
+            while (m_pos < m_query.size() && (iswdigit(m_query[m_pos]) || m_query[m_pos] == L'.'))
+            {
+                m_pos++;
+            }
+            m_type = eNumber;
+            m_text = m_query.substr(start, m_pos - start);
+        }
+        else if (c == L'\'' || c == L'"')
+        {
+            // Backslash escapes the quote and itself; other characters are kept as is
+            m_pos++;
+            while (m_pos < m_query.size() && m_query[m_pos] != c)
+            {
+                if (m_query[m_pos] == L'\\' && m_pos + 1 < m_query.size()
+                    && (m_query[m_pos + 1] == c || m_query[m_pos + 1] == L'\\'))
+                {
+                    m_pos++;
+                }
+                m_text += m_query[m_pos++];
+            }
+            if (m_pos >= m_query.size())
+            {
+                m_type = eError;
+                return;
+            }
+            m_pos++;
+            m_type = eString;
+        }
+        else if (c == L'=' || c == L'<' || c == L'>' || c == L'!')
+        {
+            size_t start = m_pos++;
+            if (m_pos < m_query.size() && (m_query[m_pos] == L'=' || (c == L'<' && m_query[m_pos] == L'>')))
+            {
+                m_pos++;
+            }
+            m_type = eCompare;
+            m_text = m_query.substr(start, m_pos - start);
+            if (m_text == L"!")
+            {
+                m_type = eError;
+            }
+        }
+        else
+        {
+            m_pos++;
+            switch (c)
+            {
+            case L'(':
+                m_type = eLeftParen;
+                break;
+            case L')':
+                m_type = eRightParen;
+                break;
+            case L',':
+                m_type = eComma;
+                break;
+            case L'*':
+                m_type = eStar;
+                break;
+            default:
+                m_type = eError;
+                break;
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Is the current token a given keyword?
+
+       \param[in] keyword  Keyword (lower case)
+       \returns   true if the current token is the keyword, in any case
+    */
+    bool WqlFilter::Parser::IsKeyword(const wchar_t* keyword) const
+    {
+        return m_type == eName && 0 == StrCompare(m_text, keyword, true);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Skip the current token if it is a given keyword
+
+       \param[in] keyword  Keyword (lower case)
+       \returns   true if the keyword was skipped
+    */
+    bool WqlFilter::Parser::AcceptKeyword(const wchar_t* keyword)
+    {
+        if (!IsKeyword(keyword))
+        {
+            return false;
+        }
+        Next();
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Skip the current token, which must be of a given type
+
+       \param[in] type  Expected type
+       \returns   true if the token was of the expected type (otherwise parsing fails)
+    */
+    bool WqlFilter::Parser::Expect(TokenType type)
+    {
+        if (m_type != type)
+        {
+            m_failed = true;
+            return false;
+        }
+        Next();
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse conditions joined by OR
+
+       \returns   Parsed node (NULL on failure)
+    */
+    SCXHandle<WqlFilter::Node> WqlFilter::Parser::ParseOr()
+    {
+        SCXHandle<Node> node = ParseAnd();
+        while (!m_failed && AcceptKeyword(L"or"))
+        {
+            SCXHandle<Node> orNode = MakeNode(Node::eOr);
+            orNode->left = node;
+            orNode->right = ParseAnd();
+            node = orNode;
+        }
+        return m_failed ? SCXHandle<Node>(NULL) : node;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse conditions joined by AND
+
+       \returns   Parsed node (NULL on failure)
+    */
+    SCXHandle<WqlFilter::Node> WqlFilter::Parser::ParseAnd()
+    {
+        SCXHandle<Node> node = ParseNot();
+        while (!m_failed && AcceptKeyword(L"and"))
+        {
+            SCXHandle<Node> andNode = MakeNode(Node::eAnd);
+            andNode->left = node;
+            andNode->right = ParseNot();
+            node = andNode;
+        }
+        return m_failed ? SCXHandle<Node>(NULL) : node;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse a possibly negated or parenthesized condition
+
+       \returns   Parsed node (NULL on failure)
+    */
+    SCXHandle<WqlFilter::Node> WqlFilter::Parser::ParseNot()
+    {
+        if (AcceptKeyword(L"not"))
+        {
+            // The negation of a constraint constrains nothing we can use
+            ParseNot();
+            return m_failed ? SCXHandle<Node>(NULL) : MakeNode(Node::eOpaque);
+        }
+
+        if (m_type == eLeftParen)
+        {
+            Next();
+            SCXHandle<Node> node = ParseOr();
+            Expect(eRightParen);
+            return m_failed ? SCXHandle<Node>(NULL) : node;
+        }
+
+        return ParseCondition();
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse a single condition on an operand
+
+       \returns   Parsed node (NULL on failure)
+    */
+    SCXHandle<WqlFilter::Node> WqlFilter::Parser::ParseCondition()
+    {
+        OperandType leftType = eOther;
+        std::wstring left;
+        if (!ParseOperand(leftType, left))
+        {
+            return SCXHandle<Node>(NULL);
+        }
+
+        bool negated = AcceptKeyword(L"not");
+        if (AcceptKeyword(L"in"))
+        {
+            SCXHandle<Node> node = MakeNode(Node::eIn);
+            node->property = left;
+            bool literals = true;
+
+            if (!Expect(eLeftParen))
+            {
+                return SCXHandle<Node>(NULL);
+            }
+            for (;;)
+            {
+                OperandType type = eOther;
+                std::wstring text;
+                if (!ParseOperand(type, text))
+                {
+                    return SCXHandle<Node>(NULL);
+                }
+                literals = literals && type == eLiteral;
+                node->literals.push_back(text);
+                if (m_type != eComma)
+                {
+                    break;
+                }
+                Next();
+            }
+            if (!Expect(eRightParen))
+            {
+                return SCXHandle<Node>(NULL);
+            }
+
+            return (negated || leftType != eProperty || !literals) ? MakeNode(Node::eOpaque) : node;
+        }
+
+        if (AcceptKeyword(L"like") || (!negated && AcceptKeyword(L"isa")))
+        {
+            OperandType type = eOther;
+            std::wstring text;
+            return ParseOperand(type, text) ? MakeNode(Node::eOpaque) : SCXHandle<Node>(NULL);
+        }
+
+        if (negated)
+        {
+            m_failed = true;
+            return SCXHandle<Node>(NULL);
+        }
+
+        if (AcceptKeyword(L"is"))
+        {
+            AcceptKeyword(L"not");
+            if (!AcceptKeyword(L"null"))
+            {
+                m_failed = true;
+                return SCXHandle<Node>(NULL);
+            }
+            return MakeNode(Node::eOpaque);
+        }
+
+        if (m_type != eCompare)
+        {
+            m_failed = true;
+            return SCXHandle<Node>(NULL);
+        }
+        std::wstring op = m_text;
+        Next();
+
+        OperandType rightType = eOther;
+        std::wstring right;
+        if (!ParseOperand(rightType, right))
+        {
+            return SCXHandle<Node>(NULL);
+        }
+
+        // Keep the property on the left, flipping the comparison if needed
+        if (leftType == eLiteral && rightType == eProperty)
+        {
+            std::swap(left, right);
+            std::swap(leftType, rightType);
+            if (op[0] == L'<' && op != L"<>")
+            {
+                op[0] = L'>';
+            }
+            else if (op[0] == L'>')
+            {
+                op[0] = L'<';
+            }
+        }
+
+        if (leftType != eProperty || rightType != eLiteral)
+        {
+            return MakeNode(Node::eOpaque);
+        }
+
+        SCXHandle<Node> node = MakeNode(Node::eCompare);
+        node->property = left;
+        node->op = op;
+        node->literals.push_back(right);
+        return node;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Parse an operand of a condition
+
+       \param[out] type  Kind of operand
+       \param[out] text  Property name or literal value
+       \returns    true if an operand was parsed (otherwise parsing fails)
+    */
+    bool WqlFilter::Parser::ParseOperand(OperandType& type, std::wstring& text)
+    {
+        switch (m_type)
+        {
+        case eName:
+            type = (IsKeyword(L"true") || IsKeyword(L"false") || IsKeyword(L"null")) ? eOther : eProperty;
+            if (type == eProperty)
+            {
+                m_properties.insert(m_text);
+            }
+            break;
+        case eString:
+        case eNumber:
+            type = eLiteral;
+            break;
+        default:
+            m_failed = true;
+            return false;
+        }
+
+        text = m_text;
+        Next();
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Create a node of the where clause
+
+       \param[in] type  Kind of node
+       \returns   New node
+    */
+    SCXHandle<WqlFilter::Node> WqlFilter::Parser::MakeNode(Node::Type type)
+    {
+        SCXHandle<Node> node(new Node);
+        node->type = type;
+        return node;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor - a filter that doesn't constrain anything
+    */
+    WqlFilter::WqlFilter() :
+        m_valid(false)
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] query  WQL query (as returned by MI_Filter_GetExpression())
+    */
+    WqlFilter::WqlFilter(const std::wstring& query) :
+        m_valid(false)
+    {
+        Parser parser(query);
+        m_valid = parser.ParseQuery(m_className, m_where);
+        if (m_valid)
+        {
+            m_properties = parser.GetProperties();
+        }
+        else
+        {
+            m_className.clear();
+            m_where = NULL;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the values of a property that an instance must have to match
+
+       \param[in]  property  Name of the property
+       \param[out] values    Values the property must have (empty if nothing can match)
+       \returns    true if the property is constrained; false if any value may match
+    */
+    bool WqlFilter::GetValues(const std::wstring& property, std::set<std::wstring>& values) const
+    {
+        values.clear();
+        return m_where != NULL && GetValues(m_where, property, values);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the values of a key property, if few enough to collect them one by one
+
+       \param[in]  property  Name of the key property
+       \param[out] values    Values the property must have (empty if nothing can match)
+       \returns    true if the instances with these values are all that can match,
+                   and there are no more than cMaxTargetedValues of them
+    */
+    bool WqlFilter::GetTargetValues(const std::wstring& property, std::set<std::wstring>& values) const
+    {
+        if (!GetValues(property, values) || values.size() > cMaxTargetedValues)
+        {
+            values.clear();
+            return false;
+        }
+        return true;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the range of integer values of a property that an instance must have to match
+
+       \param[in]  property  Name of the property
+       \param[out] low       Lowest value (inclusive)
+       \param[out] high      Highest value (inclusive); lower than low if nothing can match
+       \returns    true if the property is constrained; false if any value may match
+    */
+    bool WqlFilter::GetRange(const std::wstring& property, scxlong& low, scxlong& high) const
+    {
+        return m_where != NULL && GetRange(m_where, property, low, high);
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the values of a property that an instance must have to match a node
+
+       \param[in]  node      Node of the where clause
+       \param[in]  property  Name of the property
+       \param[out] values    Values the property must have
+       \returns    true if the property is constrained by the node
+    */
+    bool WqlFilter::GetValues(const SCXHandle<Node>& node, const std::wstring& property,
+                              std::set<std::wstring>& values) const
+    {
+        switch (node->type)
+        {
+        case Node::eCompare:
+            if (node->op != L"=" || 0 != StrCompare(node->property, property, true))
+            {
+                return false;
+            }
+            values.insert(node->literals[0]);
+            return true;
+
+        case Node::eIn:
+            if (0 != StrCompare(node->property, property, true))
+            {
+                return false;
+            }
+            values.insert(node->literals.begin(), node->literals.end());
+            return true;
+
+        case Node::eAnd:
+        case Node::eOr:
+        {
+            std::set<std::wstring> left, right;
+            bool leftConstrained = GetValues(node->left, property, left);
+            bool rightConstrained = GetValues(node->right, property, right);
+
+            if (node->type == Node::eOr)
+            {
+                // Unconstrained if either side is
+                if (!leftConstrained || !rightConstrained)
+                {
+                    return false;
+                }
+                values.insert(left.begin(), left.end());
+                values.insert(right.begin(), right.end());
+                return true;
+            }
+
+            if (leftConstrained && rightConstrained)
+            {
+                std::set_intersection(left.begin(), left.end(), right.begin(), right.end(),
+                                      std::inserter(values, values.end()));
+                return true;
+            }
+            if (leftConstrained || rightConstrained)
+            {
+                values = leftConstrained ? left : right;
+                return true;
+            }
+            return false;
+        }
+
+        case Node::eOpaque:
+        default:
+            return false;
+        }
+    }
+
+    namespace
+    {
+        /*----------------------------------------------------------------------------*/
+        /**
+           Convert a literal to an integer
+
+           \param[in]  text   Literal
+           \param[out] value  Integer value
+           \returns    true if the literal is an integer in range
+        */
+        bool ToInteger(const std::wstring& text, scxlong& value)
+        {
+            if (text.empty())
+            {
+                return false;
+            }
+
+            wchar_t* end = NULL;
+            errno = 0;
+            long long converted = wcstoll(text.c_str(), &end, 10);
+            if (errno != 0 || end == NULL || *end != L'\0')
+            {
+                return false;
+            }
+            value = static_cast<scxlong>(converted);
+            return true;
+        }
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the range of integer values of a property that an instance must have to match a node
+
+       \param[in]  node      Node of the where clause
+       \param[in]  property  Name of the property
+       \param[out] low       Lowest value (inclusive)
+       \param[out] high      Highest value (inclusive)
+       \returns    true if the property is constrained by the node
+    */
+    bool WqlFilter::GetRange(const SCXHandle<Node>& node, const std::wstring& property,
+                             scxlong& low, scxlong& high) const
+    {
+        const scxlong minValue = std::numeric_limits<scxlong>::min();
+        const scxlong maxValue = std::numeric_limits<scxlong>::max();
+
+        switch (node->type)
+        {
+        case Node::eCompare:
+        {
+            scxlong value = 0;
+            if (0 != StrCompare(node->property, property, true) || !ToInteger(node->literals[0], value))
+            {
+                return false;
+            }
+
+            low = minValue;
+            high = maxValue;
+            if (node->op == L"=")
+            {
+                low = high = value;
+            }
+            else if (node->op == L"<")
+            {
+                // Nothing is below the minimum: an empty range
+                low = (value == minValue) ? maxValue : minValue;
+                high = (value == minValue) ? minValue : value - 1;
+            }
+            else if (node->op == L"<=")
+            {
+                high = value;
+            }
+            else if (node->op == L">")
+            {
+                low = (value == maxValue) ? maxValue : value + 1;
+                high = (value == maxValue) ? minValue : maxValue;
+            }
+            else if (node->op == L">=")
+            {
+                low = value;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        case Node::eIn:
+        {
+            if (0 != StrCompare(node->property, property, true))
+            {
+                return false;
+            }
+
+            low = maxValue;
+            high = minValue;
+            for (std::vector<std::wstring>::const_iterator it = node->literals.begin(); it != node->literals.end(); ++it)
+            {
+                scxlong value = 0;
+                if (!ToInteger(*it, value))
+                {
+                    return false;
+                }
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+            return true;
+        }
+
+        case Node::eAnd:
+        case Node::eOr:
+        {
+            scxlong leftLow = 0, leftHigh = 0, rightLow = 0, rightHigh = 0;
+            bool leftConstrained = GetRange(node->left, property, leftLow, leftHigh);
+            bool rightConstrained = GetRange(node->right, property, rightLow, rightHigh);
+
+            if (node->type == Node::eOr)
+            {
+                if (!leftConstrained || !rightConstrained)
+                {
+                    return false;
+                }
+                low = std::min(leftLow, rightLow);
+                high = std::max(leftHigh, rightHigh);
+                return true;
+            }
+
+            if (leftConstrained && rightConstrained)
+            {
+                low = std::max(leftLow, rightLow);
+                high = std::min(leftHigh, rightHigh);
+                return true;
+            }
+            if (leftConstrained || rightConstrained)
+            {
+                low = leftConstrained ? leftLow : rightLow;
+                high = leftConstrained ? leftHigh : rightHigh;
+                return true;
+            }
+            return false;
+        }
+
+        case Node::eOpaque:
+        default:
+            return false;
+        }
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,110 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     wqlfilter.h
+
+    \brief    Declarations of the analysis of the WQL filters passed to the providers,
+              used to collect only the instances a query can match.
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef WQLFILTER_H
+#define WQLFILTER_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Analysis of a WQL query
+
+       Parses a query like "select * from SCX_UnixProcess where Handle='1' or
+       Handle='2'" and tells which values (or range of values) of a property an
+       instance must have to match the where clause. Providers use this to
+       collect only those instances (typically through UpdateSpecific) rather
+       than enumerating everything.
+
+       The analysis is conservative: it supports equality, IN lists, numeric
+       comparisons, AND, OR and parentheses; anything else (NOT, LIKE, <>,
+       comparisons between properties, or a query that doesn't parse) leaves
+       the property unconstrained. Since OMI still evaluates the filter on the
+       instances posted, a provider may post more instances than match, but
+       must never post fewer.
+
+       Property names are compared case insensitively, values case sensitively.
+       Objects of this class are immutable once constructed.
+    */
+    class WqlFilter
+    {
+    public:
+        //! Largest number of key values for which collecting the instances one by
+        //! one is expected to be cheaper than a full enumeration
+        static const size_t cMaxTargetedValues = 16;
+
+        WqlFilter();
+        explicit WqlFilter(const std::wstring& query);
+
+        //! Did the query parse?
+        //! \returns true if the query was understood
+        bool IsValid() const { return m_valid; }
+
+        //! Class the query selects from
+        //! \returns Class name (empty if the query didn't parse)
+        const std::wstring& GetClassName() const { return m_className; }
+
+        //! Properties the where clause refers to, whether they constrain the
+        //! instances or not (OMI needs them on the instances to evaluate the filter)
+        //! \returns Property names, as written in the query (empty if the query didn't parse)
+        const std::set<std::wstring>& GetProperties() const { return m_properties; }
+
+        bool GetValues(const std::wstring& property, std::set<std::wstring>& values) const;
+        bool GetTargetValues(const std::wstring& property, std::set<std::wstring>& values) const;
+        bool GetRange(const std::wstring& property, scxlong& low, scxlong& high) const;
+
+    private:
+        //! Node of the parsed where clause
+        struct Node
+        {
+            //! Kind of node
+            enum Type
+            {
+                eAnd,           //!< Both children must match
+                eOr,            //!< Either child must match
+                eOpaque,        //!< Condition that constrains no property
+                eCompare,       //!< Comparison of a property with a literal
+                eIn             //!< Property equal to one of a list of literals
+            };
+
+            Type type;                              //!< Kind of node
+            std::wstring property;                  //!< Property compared (eCompare, eIn)
+            std::wstring op;                        //!< Comparison operator, with the property on the left (eCompare)
+            std::vector<std::wstring> literals;     //!< Literal(s) compared with (eCompare, eIn)
+            SCXCoreLib::SCXHandle<Node> left;       //!< First child (eAnd, eOr)
+            SCXCoreLib::SCXHandle<Node> right;      //!< Second child (eAnd, eOr)
+        };
+
+        class Parser;
+
+        bool GetValues(const SCXCoreLib::SCXHandle<Node>& node, const std::wstring& property,
+                       std::set<std::wstring>& values) const;
+        bool GetRange(const SCXCoreLib::SCXHandle<Node>& node, const std::wstring& property,
+                      scxlong& low, scxlong& high) const;
+
+        bool m_valid;                           //!< Did the query parse?
+        std::wstring m_className;               //!< Class selected from
+        SCXCoreLib::SCXHandle<Node> m_where;    //!< Where clause (NULL if none)
+        std::set<std::wstring> m_properties;    //!< Properties the where clause refers to
+    };
+}
+
+#endif /* WQLFILTER_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
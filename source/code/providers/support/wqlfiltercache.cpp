@@ -0,0 +1,82 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     wqlfiltercache.cpp
+
+    \brief    Registry of the WQL filters already parsed, shared by all providers
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <scxcorelib/stringaid.h>
+
+#include "wqlfiltercache.h"
+
+using namespace SCXCoreLib;
+
+namespace SCXCore
+{
+    //! Registry shared by all providers
+    WqlFilterCache g_WqlFilterCache(L"SCXCore::WqlFilterCache");
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Constructor
+
+       \param[in] name  Name of the registry, used to name its lock
+    */
+    WqlFilterCache::WqlFilterCache(const std::wstring& name) :
+        m_lockName(name + L"::Lock")
+    {
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the parsed filter of a query, parsing it if not seen before
+
+       \param[in] query  Query text, as returned by MI_Filter_GetExpression()
+       \returns   Parsed filter (never NULL; check IsValid() for parse errors)
+
+       The query is parsed outside of the lock: two requests seeing the same new
+       query at the same time may both parse it, which is harmless.
+    */
+    SCXHandle<WqlFilter> WqlFilterCache::Get(const std::string& query)
+    {
+        {
+            SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+            std::map<std::string, SCXHandle<WqlFilter> >::const_iterator it = m_filters.find(query);
+            if (it != m_filters.end())
+            {
+                return it->second;
+            }
+        }
+
+        SCXHandle<WqlFilter> filter(new WqlFilter(StrFromUTF8(query)));
+
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        if (m_filters.size() >= cMaxFilters)
+        {
+            m_filters.clear();
+        }
+        m_filters[query] = filter;
+        return filter;
+    }
+
+    /*----------------------------------------------------------------------------*/
+    /**
+       Get the number of queries kept
+
+       \returns   Number of queries in the registry
+    */
+    size_t WqlFilterCache::Size() const
+    {
+        SCXThreadLock lock(ThreadLockHandleGet(m_lockName));
+        return m_filters.size();
+    }
+}
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -0,0 +1,65 @@
+/*--------------------------------------------------------------------------------
+ *        Copyright (c) Microsoft Corporation. All rights reserved. See license.txt for license information.
+*/
+/**
+    \file     wqlfiltercache.h
+
+    \brief    Registry of the WQL filters already parsed, shared by all providers
+
+    \date     2026-10-17 10:00:00
+*/
+/*----------------------------------------------------------------------------*/
+#ifndef WQLFILTERCACHE_H
+#define WQLFILTERCACHE_H
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxhandle.h>
+
+#include "wqlfilter.h"
+
+#include <map>
+#include <string>
+
+namespace SCXCore
+{
+    /*----------------------------------------------------------------------------*/
+    /**
+       Registry of parsed WQL filters, by query text
+
+       Monitoring tools send the same few queries over and over, so each query
+       is parsed once and the resulting WqlFilter (immutable, hence safe to
+       share between requests) is reused by every later request with the same
+       text. The query is looked up as received from OMI (UTF-8), so a request
+       for a known query doesn't even convert it.
+
+       The registry holds at most cMaxFilters queries; when full, it is
+       emptied before adding a new one.
+
+       This class is thread safe.
+    */
+    class WqlFilterCache
+    {
+    public:
+        //! Largest number of queries kept
+        static const size_t cMaxFilters = 64;
+
+        explicit WqlFilterCache(const std::wstring& name);
+
+        SCXCoreLib::SCXHandle<WqlFilter> Get(const std::string& query);
+        size_t Size() const;
+
+    private:
+        //! Not copyable
+        WqlFilterCache(const WqlFilterCache&);
+        WqlFilterCache& operator=(const WqlFilterCache&);
+
+        const std::wstring m_lockName;                                  //!< Name of the lock protecting m_filters
+        std::map<std::string, SCXCoreLib::SCXHandle<WqlFilter> > m_filters; //!< Parsed filters by query text
+    };
+
+    extern SCXCore::WqlFilterCache g_WqlFilterCache;
+}
+
+#endif /* WQLFILTERCACHE_H */
+
+/*----------------------------E-N-D---O-F---F-I-L-E---------------------------*/
@@ -155,6 +155,8 @@ private:
 class MockAppServerPALDependencies : public AppServerPALDependencies
 {
 public:
+
+    MockAppServerPALDependencies() : m_startTime(L"2011-05-18T12:00:00") {}
     
     /**************************************************************************************/
     // Mock Find method which emulated the ProcessEnumeration.Find method
@@ -204,6 +206,15 @@ public:
         return false;
     }
     
+    /**************************************************************************************/
+    // Mock PAL GetProcessIdentity method. All processes are started at m_startTime.
+    /**************************************************************************************/
+    bool GetProcessIdentity(SCXCoreLib::SCXHandle<ProcessInstance> inst, scxulong& pid, std::wstring& startTime)
+    {
+        startTime = m_startTime;
+        return inst->GetPID(pid);
+    }
+
     /**************************************************************************************/
     // Mock PAL GetWeblogicInstances method. This method creates WeblogicAppserverinstances 
     // 
@@ -226,6 +237,8 @@ public:
         }
     }
     
+    std::wstring m_startTime;
+
 private:
     std::vector<SCXCoreLib::SCXHandle<ProcessInstance> > m_Inst;
     std::vector<SCXCoreLib::SCXHandle<MockProcessInstance> > m_InstTest;
@@ -281,6 +294,8 @@ class AppServerEnumeration_Test : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( Weblogic_WebSphere_JBoss_Tomcat_Process_MixedGoodBad );
     
     CPPUNIT_TEST( UpdateInstances_Is_Not_Called );
+    CPPUNIT_TEST( Known_Process_Is_Not_Classified_Again );
+    CPPUNIT_TEST( Restarted_Process_Is_Classified_Again );
     
     
     CPPUNIT_TEST_SUITE_END();
@@ -2421,6 +2436,69 @@ public:
         asEnum.CleanUp();
     }
 
+    /**************************************************************************************/
+    //
+    // Verify that a process seen by a previous update (same pid, start time and
+    // command line) gives the very same instance, still marked as running
+    //
+    /**************************************************************************************/
+    void Known_Process_Is_Not_Classified_Again()
+    {
+        SCXCoreLib::SCXHandle<MockAppServerPALDependencies> pal = SCXCoreLib::SCXHandle<MockAppServerPALDependencies>(new MockAppServerPALDependencies());
+        TestSpyAppServerEnumeration asEnum(pal);
+
+        SCXCoreLib::SCXHandle<MockProcessInstance> inst;
+
+        inst = pal->CreateProcessInstance(1234, "1234");
+        inst->AddParameter("-Dcatalina.base=/opt/apache-tomcat-5.5.29/profile1");
+        inst->AddParameter("-Dcatalina.home=/opt/apache-tomcat-5.5.29/");
+        inst->AddParameter("org.apache.catalina.startup.Bootstrap");
+        inst->AddParameter("start");
+
+        asEnum.Update(false);
+        CPPUNIT_ASSERT(asEnum.Size() == 1);
+        SCXCoreLib::SCXHandle<AppServerInstance> first = *asEnum.Begin();
+
+        asEnum.Update(false);
+        CPPUNIT_ASSERT(asEnum.Size() == 1);
+        CPPUNIT_ASSERT(first.GetData() == (*asEnum.Begin()).GetData());
+        CPPUNIT_ASSERT((*asEnum.Begin())->GetIsRunning());
+
+        asEnum.CleanUp();
+    }
+
+    /**************************************************************************************/
+    //
+    // Verify that a process with the same pid but a different start time is
+    // classified again
+    //
+    /**************************************************************************************/
+    void Restarted_Process_Is_Classified_Again()
+    {
+        SCXCoreLib::SCXHandle<MockAppServerPALDependencies> pal = SCXCoreLib::SCXHandle<MockAppServerPALDependencies>(new MockAppServerPALDependencies());
+        TestSpyAppServerEnumeration asEnum(pal);
+
+        SCXCoreLib::SCXHandle<MockProcessInstance> inst;
+
+        inst = pal->CreateProcessInstance(1234, "1234");
+        inst->AddParameter("-Dcatalina.base=/opt/apache-tomcat-5.5.29/profile1");
+        inst->AddParameter("-Dcatalina.home=/opt/apache-tomcat-5.5.29/");
+        inst->AddParameter("org.apache.catalina.startup.Bootstrap");
+        inst->AddParameter("start");
+
+        asEnum.Update(false);
+        CPPUNIT_ASSERT(asEnum.Size() == 1);
+        SCXCoreLib::SCXHandle<AppServerInstance> first = *asEnum.Begin();
+
+        pal->m_startTime = L"2011-05-19T08:00:00";
+        asEnum.Update(false);
+        CPPUNIT_ASSERT(asEnum.Size() == 1);
+        CPPUNIT_ASSERT(first.GetData() != (*asEnum.Begin()).GetData());
+        CPPUNIT_ASSERT(L"/opt/apache-tomcat-5.5.29/profile1/" == (*asEnum.Begin())->GetId());
+        CPPUNIT_ASSERT((*asEnum.Begin())->GetIsRunning());
+
+        asEnum.CleanUp();
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( AppServerEnumeration_Test );
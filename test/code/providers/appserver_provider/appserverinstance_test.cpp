@@ -15,10 +15,27 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <fstream>
+#include <unistd.h>
+
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
 using namespace std;
 
+/*
+ * Application server instance giving access to the recording of configuration files
+ */
+class ConfigFileAppServerInstance : public AppServerInstance
+{
+public:
+    ConfigFileAppServerInstance() : AppServerInstance(L"id", L"type") {}
+
+    void Record(const wstring& filename)
+    {
+        RecordConfigFile(filename);
+    }
+};
+
 
 class AppServerInstance_Test : public CPPUNIT_NS::TestFixture
 {
@@ -38,6 +55,7 @@ class AppServerInstance_Test : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( testOperatorEqualsFalseOnType );
     CPPUNIT_TEST( testOperatorEqualsFalseOnVersion );
     CPPUNIT_TEST( testExtractMajorVersion );
+    CPPUNIT_TEST( testIsConfigurationChanged );
     CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -299,6 +317,41 @@ class AppServerInstance_Test : public CPPUNIT_NS::TestFixture
         CPPUNIT_ASSERT(asinst->GetMajorVersion() == L"10");
     }
 
+    /*-------------------------------------------------------------------*/
+    /**
+       Test that changes to recorded configuration files are detected
+    */
+    void testIsConfigurationChanged()
+    {
+        const char* filename = "appserverinstance_test_config.xml";
+        unlink(filename);
+
+        ConfigFileAppServerInstance asinst;
+
+        // Nothing recorded: always needs an update
+        CPPUNIT_ASSERT(asinst.IsConfigurationChanged());
+
+        // Missing file recorded: unchanged until it is created
+        asinst.Record(StrFromUTF8(filename));
+        CPPUNIT_ASSERT( ! asinst.IsConfigurationChanged());
+        {
+            ofstream out(filename);
+            out << "<Server port=\"8005\"/>" << endl;
+        }
+        CPPUNIT_ASSERT(asinst.IsConfigurationChanged());
+
+        // Existing file recorded: unchanged until it is modified
+        asinst.Record(StrFromUTF8(filename));
+        CPPUNIT_ASSERT( ! asinst.IsConfigurationChanged());
+        {
+            ofstream out(filename, ios::app);
+            out << "<Connector port=\"8080\"/>" << endl;
+        }
+        CPPUNIT_ASSERT(asinst.IsConfigurationChanged());
+
+        unlink(filename);
+    }
+
 
 };
 
@@ -17,6 +17,8 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <string.h>
+
 using namespace SCXCoreLib;
 using namespace SCXSystemLib;
 using namespace std;
@@ -30,7 +32,7 @@ public:
     TomcatAppServerInstanceTestPALDependencies() : 
         m_versionFilename(L""), m_xmlServerFilename(L""), m_noVersionFile(false), m_noVersion(false), 
         m_noServerFile(false), m_emptyVersionFile(false), m_emptyServerFile(false), m_badXmlServerFile(false),
-        m_NoProtocol(false), m_IncludeHTTPS(true), m_includeVersionScript(false)
+        m_NoProtocol(false), m_IncludeHTTPS(true), m_includeVersionScript(false), m_configFileSize(1)
     {}
 	
 	// Should the version script file be used when trying to determine version
@@ -87,6 +89,19 @@ public:
         m_IncludeHTTPS = includeHTTPS;
     }
 
+    // Size reported for all configuration files, to simulate their modification
+    void SetConfigFileSize(off_t configFileSize)
+    {
+        m_configFileSize = configFileSize;
+    }
+
+    virtual bool StatConfigFile(const wstring& filename, struct stat& buf)
+    {
+        memset(&buf, 0, sizeof(buf));
+        buf.st_size = m_configFileSize;
+        return true;
+    }
+
     virtual SCXHandle<std::istream> OpenVersionFile(wstring filename)
     {
         m_versionFilename = filename;
@@ -227,6 +242,7 @@ public:
     bool m_NoProtocol;
     bool m_IncludeHTTPS;
 	bool m_includeVersionScript;
+    off_t m_configFileSize;
 };
 
 class TomcatAppServerInstance_Test : public CPPUNIT_NS::TestFixture
@@ -243,6 +259,7 @@ class TomcatAppServerInstance_Test : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( testAllGoodTomcat5 );
     CPPUNIT_TEST( testAllGoodNoHTTPS );
 	CPPUNIT_TEST( testVersionScript );
+    CPPUNIT_TEST( testIsConfigurationChanged );
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -505,6 +522,22 @@ class TomcatAppServerInstance_Test : public CPPUNIT_NS::TestFixture
         CPPUNIT_ASSERT(deps->m_xmlServerFilename == L"id/conf/server.xml");
     }
 
+    // Test that the configuration files are checked through the dependencies
+    void testIsConfigurationChanged()
+    {
+        SCXHandle<TomcatAppServerInstanceTestPALDependencies> deps(new TomcatAppServerInstanceTestPALDependencies());
+        SCXHandle<TomcatAppServerInstance> asInstance( new TomcatAppServerInstance(L"id/", L"home/", deps) );
+
+        asInstance->Update();
+        CPPUNIT_ASSERT( ! asInstance->IsConfigurationChanged());
+
+        deps->SetConfigFileSize(2);
+        CPPUNIT_ASSERT(asInstance->IsConfigurationChanged());
+
+        asInstance->Update();
+        CPPUNIT_ASSERT( ! asInstance->IsConfigurationChanged());
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( TomcatAppServerInstance_Test );
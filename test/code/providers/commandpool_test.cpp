@@ -0,0 +1,166 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the bounded pool of threads running the RunAs methods
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthread.h>
+#include <testutils/scxunit.h>
+#include <commandpool.h>
+
+namespace
+{
+    //! Set to let the blocking jobs end
+    volatile bool s_release = false;
+
+    void RunQuickly(SCXCoreLib::SCXThreadParamHandle&)
+    {
+    }
+
+    void RunUntilReleased(SCXCoreLib::SCXThreadParamHandle&)
+    {
+        while (!s_release)
+        {
+            SCXCoreLib::SCXThread::Sleep(10);
+        }
+    }
+
+    //! Wait (at most 10 seconds) for the pool to have run a number of jobs and be running another number
+    bool WaitFor(const SCXCore::CommandPool& pool, scxulong completed, size_t running)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            SCXCore::CommandPool::Statistics s;
+            pool.GetStatistics(s);
+            if (s.completed == completed && s.running == running)
+            {
+                return true;
+            }
+            SCXCoreLib::SCXThread::Sleep(10);
+        }
+        return false;
+    }
+}
+
+class CommandPoolTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( CommandPoolTest );
+    CPPUNIT_TEST( TestJobsRun );
+    CPPUNIT_TEST( TestFullQueueRefusesJobs );
+    CPPUNIT_TEST( TestElevationLimit );
+    CPPUNIT_TEST( TestStoppedPoolRefusesJobs );
+    CPPUNIT_TEST( TestFormat );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void)
+    {
+        s_release = false;
+    }
+
+    void tearDown(void)
+    {
+        s_release = true;
+    }
+
+    void TestJobsRun()
+    {
+        SCXCore::CommandPool pool;
+        pool.Configure(2, 10);
+        for (int i = 0; i < 5; i++)
+        {
+            CPPUNIT_ASSERT(pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+        }
+        CPPUNIT_ASSERT(WaitFor(pool, 5, 0));
+
+        SCXCore::CommandPool::Statistics s;
+        pool.GetStatistics(s);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(5), s.submitted);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(0), s.rejected);
+        CPPUNIT_ASSERT(s.workers <= 2);
+    }
+
+    void TestFullQueueRefusesJobs()
+    {
+        SCXCore::CommandPool pool;
+        pool.Configure(1, 2);
+        CPPUNIT_ASSERT(pool.Submit(L"", RunUntilReleased, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(WaitFor(pool, 0, 1));
+
+        // The only worker is busy: two jobs may wait, the third is refused
+        CPPUNIT_ASSERT(pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(!pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+
+        SCXCore::CommandPool::Statistics s;
+        pool.GetStatistics(s);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), s.workers);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), s.queued);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), s.maxQueued);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(1), s.rejected);
+
+        s_release = true;
+        CPPUNIT_ASSERT(WaitFor(pool, 3, 0));
+    }
+
+    void TestElevationLimit()
+    {
+        SCXCore::CommandPool pool;
+        pool.Configure(3, 10);
+        pool.SetLimit(L"sudo", 1);
+        CPPUNIT_ASSERT(pool.Submit(L"sudo", RunUntilReleased, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(pool.Submit(L"sudo", RunUntilReleased, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(pool.Submit(L"", RunUntilReleased, new SCXCoreLib::SCXThreadParam()));
+
+        // The second elevated job waits, the job without elevation doesn't wait behind it
+        CPPUNIT_ASSERT(WaitFor(pool, 0, 2));
+        SCXCoreLib::SCXThread::Sleep(100);
+
+        SCXCore::CommandPool::Statistics s;
+        pool.GetStatistics(s);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), s.running);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), s.queued);
+
+        s_release = true;
+        CPPUNIT_ASSERT(WaitFor(pool, 3, 0));
+    }
+
+    void TestStoppedPoolRefusesJobs()
+    {
+        SCXCore::CommandPool pool;
+        pool.Configure(1, 10);
+        CPPUNIT_ASSERT(pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+        pool.Stop(true);
+
+        SCXCore::CommandPool::Statistics s;
+        pool.GetStatistics(s);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(1), s.completed);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), s.workers);
+        CPPUNIT_ASSERT(!pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+
+        // Configuring the pool again (the provider is loaded again) accepts jobs again
+        pool.Configure(1, 10);
+        CPPUNIT_ASSERT(pool.Submit(L"", RunQuickly, new SCXCoreLib::SCXThreadParam()));
+        CPPUNIT_ASSERT(WaitFor(pool, 2, 0));
+    }
+
+    void TestFormat()
+    {
+        SCXCore::CommandPool pool;
+        std::string line = pool.Format();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), line.find("CommandPool Workers=0 Running=0 Queued=0 "));
+        CPPUNIT_ASSERT(std::string::npos != line.find(" Rejected=0 "));
+        CPPUNIT_ASSERT(std::string::npos != line.find(" MaxWaitMilliseconds=0"));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CommandPoolTest );
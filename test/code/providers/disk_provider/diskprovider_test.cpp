@@ -27,6 +27,32 @@
 #include "SCX_FileSystem_Class_Provider.h"
 #include "SCX_FileSystemStatisticalInformation_Class_Provider.h"
 
+#include <scxcorelib/scxthread.h>
+#include <scxcorelib/stringaid.h>
+
+#include <fstream>
+#include <limits.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+namespace
+{
+    //! Mount point whose probes hang (see ProbeWithHungMount()) while s_hung is set
+    std::string s_hungMount;
+    volatile bool s_hung = false;
+
+    //! Probe of the mount points like the MountProbe does, except for s_hungMount
+    void ProbeWithHungMount(const std::string& path)
+    {
+        while (s_hung && path == s_hungMount)
+        {
+            SCXCoreLib::SCXThread::Sleep(10);
+        }
+        struct statvfs buf;
+        ::statvfs(path.c_str(), &buf);
+    }
+}
+
 class SCXDiskProviderTest : public CPPUNIT_NS::TestFixture
 {
     CPPUNIT_TEST_SUITE( SCXDiskProviderTest );
@@ -37,6 +63,10 @@ class SCXDiskProviderTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( RemoveTotalInstanceShouldFail );
     CPPUNIT_TEST( RemoveDiskDriveAlsoRemovesStatisticalInstance );
     CPPUNIT_TEST( RemoveFileSystemAlsoRemovesStatisticalInstance );
+    CPPUNIT_TEST( TestStatisticsSnapshotIsShared );
+    CPPUNIT_TEST( TestStatisticsSnapshotIsRefreshedWhenStale );
+    CPPUNIT_TEST( TestRemoveDropsStatisticsSnapshot );
+    CPPUNIT_TEST( TestHungFileSystemDoesNotFreezeOthers );
     
     SCXUNIT_TEST_ATTRIBUTE(TestEnumInstanceNamesSanity, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestPhysicalLogicalDiskDecoupled, SLOW);
@@ -44,6 +74,7 @@ class SCXDiskProviderTest : public CPPUNIT_NS::TestFixture
     SCXUNIT_TEST_ATTRIBUTE(TestVerifyKeyCompletePartial, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(RemoveDiskDriveAlsoRemovesStatisticalInstance, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(RemoveFileSystemAlsoRemovesStatisticalInstance, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestHungFileSystemDoesNotFreezeOthers, SLOW);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -247,6 +278,151 @@ public:
         CPPUNIT_ASSERT_EQUAL(fss.Size()-1, FSSCount());
     }
     
+    void TestStatisticsSnapshotIsShared()
+    {
+        scxulong oldDiskMaxAge = SCXCore::g_DiskProvider.GetSnapshotMaxAge();
+        scxulong oldFsMaxAge = SCXCore::g_FileSystemProvider.GetSnapshotMaxAge();
+        SCXCore::g_DiskProvider.SetSnapshotMaxAge(60 * 60 * 1000);
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(60 * 60 * 1000);
+
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> firstDisk = SCXCore::g_DiskProvider.GetStatisticsSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> secondDisk = SCXCore::g_DiskProvider.GetStatisticsSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> firstFs = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> secondFs = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+
+        SCXCore::g_DiskProvider.SetSnapshotMaxAge(oldDiskMaxAge);
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(oldFsMaxAge);
+
+        // Requests within the maximum age share the same snapshot
+        CPPUNIT_ASSERT(firstDisk.GetData() == secondDisk.GetData());
+        CPPUNIT_ASSERT(firstFs.GetData() == secondFs.GetData());
+
+        // Statistical collections always have a total instance
+        CPPUNIT_ASSERT(NULL != firstDisk->GetTotalInstance());
+        CPPUNIT_ASSERT(firstDisk->GetTotalInstance()->IsTotal());
+        CPPUNIT_ASSERT(NULL != firstFs->GetTotalInstance());
+        CPPUNIT_ASSERT(firstFs->GetTotalInstance()->IsTotal());
+
+        // A file system found in the snapshot is found by name (like GetInstance() does)
+        CPPUNIT_ASSERT(0 < firstFs->Size());
+        std::wstring name;
+        CPPUNIT_ASSERT(firstFs->GetInstance(0).GetDiskName(name));
+        CPPUNIT_ASSERT(&firstFs->GetInstance(0) == firstFs->GetInstance(name));
+        CPPUNIT_ASSERT(NULL == firstFs->GetInstance(L"/no/such/file/system"));
+    }
+
+    void TestStatisticsSnapshotIsRefreshedWhenStale()
+    {
+        scxulong oldMaxAge = SCXCore::g_FileSystemProvider.GetSnapshotMaxAge();
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(0);
+
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> first = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> second = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        // With no maximum age, every request takes a new snapshot; the old one stays readable
+        CPPUNIT_ASSERT(first.GetData() != second.GetData());
+        CPPUNIT_ASSERT(0 < first->Size());
+        CPPUNIT_ASSERT_EQUAL(first->Size(), second->Size());
+    }
+
+    void TestRemoveDropsStatisticsSnapshot()
+    {
+        std::wstring errMsg;
+
+        scxulong oldMaxAge = SCXCore::g_FileSystemProvider.GetSnapshotMaxAge();
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(60 * 60 * 1000);
+
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> before = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        CPPUNIT_ASSERT(0 < before->Size());
+        std::wstring name;
+        CPPUNIT_ASSERT(before->GetInstance(0).GetDiskName(name));
+        CPPUNIT_ASSERT(InvokeRemoveFileSystem(name, CALL_LOCATION(errMsg)));
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> after = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        // Removing a file system must not leave it in a snapshot shared with later requests
+        CPPUNIT_ASSERT(before.GetData() != after.GetData());
+    }
+
+    void TestHungFileSystemDoesNotFreezeOthers()
+    {
+        scxulong oldMaxAge = SCXCore::g_FileSystemProvider.GetSnapshotMaxAge();
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(0);
+        SCXCore::MountProbe& probe = SCXCore::g_FileSystemProvider.GetMountProbe();
+        probe.SetProbeFunction(ProbeWithHungMount);
+        probe.SetLimits(200, 0, SCXCore::MountProbe::cDefaultQuarantine, 0);
+
+        // The healthy file system is the one holding the working directory, any other one hangs
+        char cwd[PATH_MAX];
+        CPPUNIT_ASSERT(NULL != getcwd(cwd, sizeof(cwd)));
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> before = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        std::wstring healthy, hung;
+        for (size_t i = 0; i < before->Size(); i++)
+        {
+            std::wstring name;
+            CPPUNIT_ASSERT(before->GetInstance(i).GetDiskName(name));
+            std::string mount = SCXCoreLib::StrToMultibyte(name);
+            bool holdsCwd = 0 == std::string(cwd).compare(0, mount.size(), mount) &&
+                (mount == "/" || cwd[mount.size()] == '/' || cwd[mount.size()] == '\0');
+            if (holdsCwd && name.size() > healthy.size())
+            {
+                healthy = name;
+            }
+        }
+        for (size_t i = 0; i < before->Size() && hung.empty(); i++)
+        {
+            std::wstring name;
+            before->GetInstance(i).GetDiskName(name);
+            if (name != healthy)
+            {
+                hung = name;
+            }
+        }
+        if (healthy.empty() || hung.empty())
+        {
+            probe.SetLimits(SCXCore::MountProbe::cDefaultTimeout, SCXCore::MountProbe::cDefaultMaxTimeouts,
+                            SCXCore::MountProbe::cDefaultQuarantine, SCXCore::MountProbe::cDefaultResponseMaxAge);
+            SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(oldMaxAge);
+            SCXUNIT_WARNING(L"TestHungFileSystemDoesNotFreezeOthers needs two file systems, one holding the working directory");
+            return;
+        }
+
+        scxulong inodes = 0, freeBefore = 0, freeAfter = 0;
+        CPPUNIT_ASSERT(before->GetInstance(healthy)->GetInodeUsage(inodes, freeBefore));
+
+        s_hungMount = SCXCoreLib::StrToMultibyte(hung);
+        s_hung = true;
+
+        // Use up some inodes of the healthy file system while the other one hangs
+        const int cFiles = 32;
+        for (int i = 0; i < cFiles; i++)
+        {
+            std::ofstream(SCXCoreLib::StrToMultibyte(SCXCoreLib::StrAppend(L"./fsprovidertest_", i)).c_str());
+        }
+        SCXCoreLib::SCXHandle<SCXCore::DiskStatisticsSnapshot> after = SCXCore::g_FileSystemProvider.GetStatisticsSnapshot();
+        for (int i = 0; i < cFiles; i++)
+        {
+            unlink(SCXCoreLib::StrToMultibyte(SCXCoreLib::StrAppend(L"./fsprovidertest_", i)).c_str());
+        }
+
+        s_hung = false;
+        probe.SetLimits(SCXCore::MountProbe::cDefaultTimeout, SCXCore::MountProbe::cDefaultMaxTimeouts,
+                        SCXCore::MountProbe::cDefaultQuarantine, SCXCore::MountProbe::cDefaultResponseMaxAge);
+        SCXCore::g_FileSystemProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        // Only the hung file system is reported offline, the healthy one is updated
+        bool health = true;
+        CPPUNIT_ASSERT(after->GetInstance(hung)->GetHealthState(health));
+        CPPUNIT_ASSERT(!health);
+        CPPUNIT_ASSERT(after->GetInstance(healthy)->GetHealthState(health));
+        CPPUNIT_ASSERT(health);
+        CPPUNIT_ASSERT(after->GetInstance(healthy)->GetInodeUsage(inodes, freeAfter));
+        CPPUNIT_ASSERT(freeAfter != freeBefore);
+    }
+
     void TestPhysicalLogicalDiskDecoupled(void)
     {
         // This test ensures that DiskDrive and LogicalDisk providers are decoupled. No instances of
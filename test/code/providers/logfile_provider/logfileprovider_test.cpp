@@ -16,11 +16,16 @@
 
 #include <scxcorelib/scxexception.h>
 #include <scxcorelib/scxfile.h>
+#include <scxcorelib/scxfilesystem.h>
 #include <scxcorelib/scxprocess.h>
+#include <scxcorelib/scxstream.h>
+#include <scxcorelib/scxthread.h>
 #include <scxcorelib/stringaid.h>
 #include "source/code/scxcorelib/util/persist/scxfilepersistmedia.h"
 
 #include <support/logfileprovider.h>
+#include <support/logfilereaderclient.h>
+#include <support/logfilestatestore.h>
 #include <support/logfileutils.h>
 
 #include <cppunit/extensions/HelperMacros.h>
@@ -28,7 +33,11 @@
 #include <testutils/providertestutils.h>
 #include <testutils/scxtestutils.h>
 
+#include <errno.h>
+#include <fstream>
 #include <stdio.h>  // For fopen() in test testLocale8859_1
+#include <stdlib.h>
+#include <sys/time.h>
 #include <sys/wait.h>
 #if defined(aix)
 #include <unistd.h>
@@ -78,6 +87,9 @@ class LogFileProviderTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( testLogFilePositionRecordPersistable );
     CPPUNIT_TEST( testLogFilePositionRecordUnpersist );
     CPPUNIT_TEST( testLogFilePositionRecordConflictingPaths );
+    CPPUNIT_TEST( testLogFileStateStorePersistable );
+    CPPUNIT_TEST( testLogFileStateStoreMovesPersistedRecord );
+    CPPUNIT_TEST( testLogFileStateStoreCompaction );
     CPPUNIT_TEST( testLogFileStreamPositionerOpenNew );
     CPPUNIT_TEST( testLogFileStreamPositionerReOpen );
     // testTellgBehavior() exists to investigate WI 15418, and eventually WI 16772
@@ -87,23 +99,44 @@ class LogFileProviderTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( testLogFileStreamPositionerFileRotateSize );
     CPPUNIT_TEST( testLogFileStreamPositionerFileRotateInode );
     CPPUNIT_TEST( testLogFileStreamPositionerFileDisappearsAndReappears );
+    CPPUNIT_TEST( testLogFileLineScanner );
+    CPPUNIT_TEST( testLogFileLineScannerStartPos );
+    CPPUNIT_TEST( testLogFileLineDecoderInvalidBytes );
+    CPPUNIT_TEST( testLogFileMatcherRequiredLiteral );
+    CPPUNIT_TEST( testLogFileMatcherCandidates );
+    CPPUNIT_TEST( testLogFileMatcherCache );
+    CPPUNIT_TEST( testSharedReadAcrossQids );
+    CPPUNIT_TEST( testReadLogFileThroughput );
     CPPUNIT_TEST( testDoInvokeMethod );
     CPPUNIT_TEST( testDoInvokeMethodWithNonexistantLogfile );
+    CPPUNIT_TEST( testDoInvokeMethodWithRowLimits );
     CPPUNIT_TEST( testInvokeResetStateFile );
     CPPUNIT_TEST( testInvokeResetStateFileWithResetFlag );
     CPPUNIT_TEST( testInvokeResetAllStateFiles );
     CPPUNIT_TEST( testInvokeResetAllStateFilesWithResetFlag );
     CPPUNIT_TEST( testLocale8859_1 );
+    CPPUNIT_TEST( testInProcessAndPerRequestReadersShareState );
+    CPPUNIT_TEST( testLogFileReaderServer );
+    CPPUNIT_TEST( testLogFileReaderServerTimeout );
 
     SCXUNIT_TEST_ATTRIBUTE(testLogFilePositionRecordPersistable, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testLogFilePositionRecordUnpersist, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testLogFileStateStorePersistable, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testLogFileStateStoreMovesPersistedRecord, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testLogFileStateStoreCompaction, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testReadLogFileThroughput, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testSharedReadAcrossQids, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testDoInvokeMethod, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testDoInvokeMethodWithNonexistantLogfile, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testDoInvokeMethodWithRowLimits, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testInvokeResetStateFile, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testInvokeResetStateFileWithResetFlag, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testInvokeResetAllStateFiles, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testInvokeResetAllStateFilesWithResetFlag, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(testLocale8859_1, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testInProcessAndPerRequestReadersShareState, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testLogFileReaderServer, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(testLogFileReaderServerTimeout, SLOW);
     CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -127,6 +160,7 @@ public:
         SCXHandle<LogFileReader::LogFilePositionRecord> r2(
             new LogFileReader::LogFilePositionRecord(testlogfilename, testQID2, m_pmedia) );
         r2->UnPersist();
+        SCXCoreLib::SelfDeletingFilePath journal( LogFileStateStore::GetJournalPath(L"./") );
 
         m_logFileProv = new TestableLogfileProvider(m_pReader);
         m_logFileProv->TestSetPersistMedia(m_pmedia);
@@ -148,6 +182,7 @@ public:
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, false, context.WasRefuseUnloadCalled() );
 
         m_logFileProv = 0;
+        g_LogFileProvider.SetRunReaderPerRequest(false);
         SCXHandle<LogFileReader::LogFilePositionRecord> r(
             new LogFileReader::LogFilePositionRecord(testlogfilename, testQID, m_pmedia) );
         r->UnPersist();
@@ -155,6 +190,7 @@ public:
         SCXHandle<LogFileReader::LogFilePositionRecord> r2( 
             new LogFileReader::LogFilePositionRecord(testlogfilename, testQID2, m_pmedia) );
         r2->UnPersist();
+        SCXCoreLib::SelfDeletingFilePath journal( LogFileStateStore::GetJournalPath(L"./") );
 
         // Delete the locale file if it exists
         SCXCoreLib::SelfDeletingFilePath localeFile( testlocalefilename );
@@ -245,6 +281,118 @@ public:
         CPPUNIT_ASSERT(r2.UnPersist());
     }
 
+    void testLogFileStateStorePersistable()
+    {
+        const SCXFilePath journalPath(LogFileStateStore::GetJournalPath(L"./"));
+
+        pid_t pid = fork();
+        CPPUNIT_ASSERT(-1 != pid);
+        if (0 == pid)
+        {
+            // Child process will do the writing (and exit without syncing the journal).
+            SCXHandle<LogFileStateStore> store(new LogFileStateStore(journalPath));
+            store->Open();
+            LogFileReader::LogFilePositionRecord r(L"/This/is/a/file\tpath.log", testQID, m_pmedia, store);
+            r.SetPos(1337);
+            r.SetStatStIno(17);
+            r.SetStatStSize(4711);
+            CPPUNIT_ASSERT_NO_THROW(r.Persist());
+            _exit(0);
+        }
+
+        // Parent process will do the reading after child has finished.
+        waitpid(pid, 0, 0);
+
+        SCXHandle<LogFileStateStore> store(new LogFileStateStore(journalPath));
+        CPPUNIT_ASSERT_NO_THROW(store->Open());
+        LogFileReader::LogFilePositionRecord r(L"/This/is/a/file\tpath.log", testQID, m_pmedia, store);
+        CPPUNIT_ASSERT(r.Recover());
+        CPPUNIT_ASSERT(1337 == r.GetPos());
+        CPPUNIT_ASSERT(17 == r.GetStatStIno());
+        CPPUNIT_ASSERT(4711 == r.GetStatStSize());
+
+        // Other qids are kept apart
+        LogFileReader::LogFilePositionRecord r2(L"/This/is/a/file\tpath.log", testQID2, m_pmedia, store);
+        CPPUNIT_ASSERT( ! r2.Recover() );
+
+        CPPUNIT_ASSERT(r.UnPersist());
+        CPPUNIT_ASSERT( ! r.UnPersist() );
+
+        // Removal is seen by other stores on the same journal
+        LogFileStateStore other(journalPath);
+        other.Open();
+        LogFileStateStore::Entry entry;
+        CPPUNIT_ASSERT( ! other.Get(L"/This/is/a/file\tpath.log", testQID, entry) );
+    }
+
+    void testLogFileStateStoreMovesPersistedRecord()
+    {
+        // Record persisted by an earlier version
+        {
+            LogFileReader::LogFilePositionRecord r(L"/This/is/a/file/path.log", testQID, m_pmedia);
+            r.SetPos(1337);
+            r.SetStatStIno(17);
+            r.SetStatStSize(4711);
+            CPPUNIT_ASSERT_NO_THROW(r.Persist());
+        }
+
+        SCXHandle<LogFileStateStore> store(new LogFileStateStore(LogFileStateStore::GetJournalPath(L"./")));
+        store->Open();
+        LogFileReader::LogFilePositionRecord r(L"/This/is/a/file/path.log", testQID, m_pmedia, store);
+        CPPUNIT_ASSERT(r.Recover());
+        CPPUNIT_ASSERT(1337 == r.GetPos());
+        CPPUNIT_ASSERT(17 == r.GetStatStIno());
+        CPPUNIT_ASSERT(4711 == r.GetStatStSize());
+
+        // The record is now only in the state store
+        LogFileReader::LogFilePositionRecord persisted(L"/This/is/a/file/path.log", testQID, m_pmedia);
+        CPPUNIT_ASSERT( ! persisted.Recover() );
+        LogFileStateStore::Entry entry;
+        CPPUNIT_ASSERT(store->Get(L"/This/is/a/file/path.log", testQID, entry));
+        CPPUNIT_ASSERT(1337 == entry.pos);
+
+        CPPUNIT_ASSERT(r.UnPersist());
+        CPPUNIT_ASSERT( ! r.Recover() );
+    }
+
+    void testLogFileStateStoreCompaction()
+    {
+        const SCXFilePath journalPath(LogFileStateStore::GetJournalPath(L"./"));
+        LogFileStateStore store(journalPath);
+        store.Open();
+
+        LogFileStateStore::Entry entry;
+        for (int i = 1; i <= 20000; i++)
+        {
+            entry.pos = i;
+            entry.stSize = i;
+            store.Put(testlogfilename, (i % 2) ? testQID : testQID2, entry);
+        }
+
+        // The journal is compacted as it grows, so it stays small
+        SCXFileSystem::SCXStatStruct statstruct;
+        SCXFileSystem::Stat(journalPath, &statstruct);
+        CPPUNIT_ASSERT(statstruct.st_size < LogFileStateStore::cCompactMinSize * LogFileStateStore::cCompactFactor);
+
+        LogFileStateStore other(journalPath);
+        other.Open();
+        CPPUNIT_ASSERT(other.Get(testlogfilename, testQID, entry));
+        CPPUNIT_ASSERT(19999 == entry.pos);
+        CPPUNIT_ASSERT(other.Get(testlogfilename, testQID2, entry));
+        CPPUNIT_ASSERT(20000 == entry.pos);
+
+        std::vector<LogFileStateStore::Key> keys;
+        other.GetKeys(keys);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), keys.size());
+
+        // Compacting keeps all entries
+        CPPUNIT_ASSERT_NO_THROW(other.Compact());
+        CPPUNIT_ASSERT(store.Get(testlogfilename, testQID2, entry));
+        CPPUNIT_ASSERT(20000 == entry.pos);
+        CPPUNIT_ASSERT(store.Remove(testlogfilename, testQID));
+        CPPUNIT_ASSERT( ! other.Get(testlogfilename, testQID, entry) );
+    }
+
     void testLogFileStreamPositionerOpenNew()
     {
         std::wstring firstRow(L"This is the first row.");
@@ -538,6 +686,347 @@ public:
         return SCXCoreLib::StrToMultibyte(ret.str());
     }
 
+    void testLogFileLineScanner()
+    {
+        // Terminators are stripped, empty lines kept, and a last line without
+        // terminator is returned. A tiny block size forces refills and growth.
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+            out << "first\r\n" << "\n" << "a line longer than the block size\n" << "last";
+        }
+
+        LogFileReader::LogFileLineScanner scanner(testlogfilename, 0, 4);
+        const char* line;
+        size_t length;
+
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string("first"), std::string(line, length));
+        CPPUNIT_ASSERT_EQUAL(static_cast<std::streamoff>(7), scanner.GetPos());
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), std::string(line, length));
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string("a line longer than the block size"), std::string(line, length));
+        CPPUNIT_ASSERT( ! scanner.AtEnd());
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string("last"), std::string(line, length));
+        CPPUNIT_ASSERT(scanner.AtEnd());
+        CPPUNIT_ASSERT( ! scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(static_cast<std::streamoff>(46), scanner.GetPos());
+    }
+
+    void testLogFileLineScannerStartPos()
+    {
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+            out << "This is the first row.\n" << "This is the second row.\n";
+        }
+
+        LogFileReader::LogFileLineScanner scanner(testlogfilename, 23);
+        const char* line;
+        size_t length;
+
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string("This is the second row."), std::string(line, length));
+        CPPUNIT_ASSERT( ! scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(static_cast<std::streamoff>(47), scanner.GetPos());
+
+        // The file keeps being read as it was opened, even once it is replaced
+        SCXFile::Delete(testlogfilename);
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+            out << "Another file.\n";
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(47), scanner.GetStatStSize());
+        scanner.Seek(0);
+        CPPUNIT_ASSERT(scanner.NextLine(line, length));
+        CPPUNIT_ASSERT_EQUAL(std::string("This is the first row."), std::string(line, length));
+        CPPUNIT_ASSERT_EQUAL(static_cast<std::streamoff>(23), scanner.GetPos());
+
+        CPPUNIT_ASSERT_THROW(LogFileReader::LogFileLineScanner(L"./logfileproviderTest.nosuchfile", 0),
+                             SCXFilePathNotFoundException);
+    }
+
+    void testLogFileLineDecoderInvalidBytes()
+    {
+        // 0xFF is invalid in UTF-8 and ASCII, and is U+00FF in ISO-8859-1;
+        // either way it must not stop the conversion of the rest of the line.
+        const char bytes[] = { 'a', 'b', static_cast<char>(0xFF), 'c', 'd' };
+        LogFileReader::LogFileLineDecoder decoder;
+        std::wstring line;
+
+        decoder.Decode(bytes, sizeof(bytes), line);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), line.size());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"ab"), line.substr(0, 2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<wchar_t>(0xFF), line[2]);
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"cd"), line.substr(3));
+
+        decoder.Decode("plain", 5, line);
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"plain"), line);
+    }
+
+    void testLogFileMatcherRequiredLiteral()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::string("ERROR"), LogFileMatcher::GetRequiredLiteral(L"ERROR"));
+        CPPUNIT_ASSERT_EQUAL(std::string("disk full"), LogFileMatcher::GetRequiredLiteral(L"^.*disk full.*$"));
+        // Optional items end the literal; the longest literal is used
+        CPPUNIT_ASSERT_EQUAL(std::string("ab"), LogFileMatcher::GetRequiredLiteral(L"abc*d"));
+        CPPUNIT_ASSERT_EQUAL(std::string("yz"), LogFileMatcher::GetRequiredLiteral(L"x?yz"));
+        CPPUNIT_ASSERT_EQUAL(std::string("bc"), LogFileMatcher::GetRequiredLiteral(L"a{2}bc"));
+        CPPUNIT_ASSERT_EQUAL(std::string("bar"), LogFileMatcher::GetRequiredLiteral(L"fo+bar"));
+        // Brackets and groups are skipped, escaped punctuation is literal
+        CPPUNIT_ASSERT_EQUAL(std::string("fgh"), LogFileMatcher::GetRequiredLiteral(L"[abc]de.fgh"));
+        CPPUNIT_ASSERT_EQUAL(std::string("zz"), LogFileMatcher::GetRequiredLiteral(L"[[:alpha:]]zz"));
+        CPPUNIT_ASSERT_EQUAL(std::string("hello"), LogFileMatcher::GetRequiredLiteral(L"(x|y)hello"));
+        CPPUNIT_ASSERT_EQUAL(std::string(".conf"), LogFileMatcher::GetRequiredLiteral(L"\\.conf$"));
+        // No literal: top level alternation, wildcards, unbalanced expressions
+        CPPUNIT_ASSERT_EQUAL(std::string(""), LogFileMatcher::GetRequiredLiteral(L"warning|error"));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), LogFileMatcher::GetRequiredLiteral(L".*"));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), LogFileMatcher::GetRequiredLiteral(L"(unbalanced"));
+    }
+
+    void testLogFileMatcherCandidates()
+    {
+        const wchar_t* expressions[] = { L"disk full", L".*", L"ERROR [0-9]+", L"full" };
+        std::vector<SCXRegexWithIndex> regexps;
+        for (size_t i = 0; i < sizeof(expressions) / sizeof(expressions[0]); i++)
+        {
+            SCXRegexWithIndex regind;
+            regind.regex = new SCXRegex(expressions[i]);
+            regind.index = i + 10;
+            regexps.push_back(regind);
+        }
+        std::vector<size_t> matches;
+
+        // Only ".*" is evaluated for lines without any of the literals
+        LogFileMatcher matcher(regexps, true);
+        CPPUNIT_ASSERT(matcher.Prefilter("nothing here", 12));
+        matcher.Match(L"nothing here", matches);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matches.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matches[0]);
+
+        // Matches are in rule set order, whatever order the literals are found in
+        std::string line("ERROR 42: disk full");
+        CPPUNIT_ASSERT(matcher.Prefilter(line.c_str(), line.size()));
+        matcher.Match(L"ERROR 42: disk full", matches);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), matches.size());
+        for (size_t i = 0; i < matches.size(); i++)
+        {
+            CPPUNIT_ASSERT_EQUAL(i, matches[i]);
+        }
+
+        // A candidate is still confirmed by its expression
+        line = "ERROR none";
+        CPPUNIT_ASSERT(matcher.Prefilter(line.c_str(), line.size()));
+        matcher.Match(L"ERROR none", matches);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matches.size());
+
+        // Without ".*", lines without any literal are filtered out
+        regexps.erase(regexps.begin() + 1);
+        LogFileMatcher filtering(regexps, true);
+        CPPUNIT_ASSERT( ! filtering.Prefilter("nothing here", 12));
+        CPPUNIT_ASSERT(filtering.Prefilter("full", 4));
+
+        // Nothing is filtered out if the encoding isn't ASCII compatible
+        LogFileMatcher unfiltered(regexps, false);
+        CPPUNIT_ASSERT_EQUAL(std::string(""), unfiltered.GetLiteral(0));
+        CPPUNIT_ASSERT(unfiltered.Prefilter("nothing here", 12));
+        unfiltered.Match(L"nothing here", matches);
+        CPPUNIT_ASSERT(matches.empty());
+    }
+
+    void testLogFileMatcherCache()
+    {
+        std::vector<SCXRegexWithIndex> regexps;
+        SCXRegexWithIndex regind;
+        regind.regex = new SCXRegex(L"ERROR");
+        regind.index = 0;
+        regexps.push_back(regind);
+
+        LogFileReader reader;
+        SCXHandle<LogFileMatcher> matcher = reader.GetMatcher(testlogfilename, testQID, regexps, true);
+
+        // Same rule set (even if compiled again) gives the same matcher
+        std::vector<SCXRegexWithIndex> same;
+        regind.regex = new SCXRegex(L"ERROR");
+        same.push_back(regind);
+        CPPUNIT_ASSERT(matcher.GetData() == reader.GetMatcher(testlogfilename, testQID, same, true).GetData());
+
+        // Other qid, or changed rule set, gives a new matcher
+        CPPUNIT_ASSERT(matcher.GetData() != reader.GetMatcher(testlogfilename, testQID2, regexps, true).GetData());
+        regind.regex = new SCXRegex(L"WARNING");
+        regind.index = 1;
+        regexps.push_back(regind);
+        SCXHandle<LogFileMatcher> changed = reader.GetMatcher(testlogfilename, testQID, regexps, true);
+        CPPUNIT_ASSERT(matcher.GetData() != changed.GetData());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), changed->GetRegexps().size());
+        CPPUNIT_ASSERT(changed.GetData() == reader.GetMatcher(testlogfilename, testQID, regexps, true).GetData());
+    }
+
+    void testSharedReadAcrossQids()
+    {
+        std::vector<SCXRegexWithIndex> regexps;
+        SCXRegexWithIndex regind;
+        regind.regex = new SCXRegex(L"ERROR");
+        regind.index = 0;
+        regexps.push_back(regind);
+
+        std::vector<SCXRegexWithIndex> otherRegexps;
+        regind.regex = new SCXRegex(L"row");
+        regind.index = 7;
+        otherRegexps.push_back(regind);
+
+        // Establish state for both qids at the end of the log
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+            out << "first row" << std::endl;
+        }
+        std::vector<std::wstring> matchedLines;
+        m_pReader->SetPersistMedia(m_pmedia);
+        m_pReader->ReadLogFile(testlogfilename, testQID, regexps, matchedLines);
+        m_pReader->ReadLogFile(testlogfilename, testQID2, otherRegexps, matchedLines);
+        CPPUNIT_ASSERT(matchedLines.empty());
+
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary | std::ios_base::app);
+            out << "ERROR second row" << std::endl << "third row" << std::endl;
+        }
+
+        // The first qid reads the new rows, and matches them for the other qid too
+        m_pReader->ReadLogFile(testlogfilename, testQID, regexps, matchedLines);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matchedLines.size());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"0;ERROR second row"), matchedLines[0]);
+
+        // Overwrite the rows already read (same size and inode): the other qid
+        // gets the rows as they were read, rather than reading them again
+        {
+            std::fstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+            out.seekp(10);
+            out << "XXXXX second XXX" << std::endl << "third XXX";
+        }
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary | std::ios_base::app);
+            out << "fourth row" << std::endl;
+        }
+
+        matchedLines.clear();
+        m_pReader->ReadLogFile(testlogfilename, testQID2, otherRegexps, matchedLines);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), matchedLines.size());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"7;ERROR second row"), matchedLines[0]);
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"7;third row"), matchedLines[1]);
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"7;fourth row"), matchedLines[2]);
+
+        // A changed rule set doesn't use rows matched with the old one
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary | std::ios_base::app);
+            out << "ERROR fifth row" << std::endl;
+        }
+        matchedLines.clear();
+        m_pReader->ReadLogFile(testlogfilename, testQID, regexps, matchedLines);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matchedLines.size());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"0;ERROR fifth row"), matchedLines[0]);
+
+        matchedLines.clear();
+        m_pReader->ReadLogFile(testlogfilename, testQID2, regexps, matchedLines);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matchedLines.size());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"0;ERROR fifth row"), matchedLines[0]);
+    }
+
+    static double GetSeconds()
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1000000.0;
+    }
+
+    void testReadLogFileThroughput()
+    {
+        // Size of the synthetic log, default kept small for regular test runs;
+        // set SCX_LOGFILE_BENCHMARK_MB to measure with multi-GB logs.
+        scxulong megabytes = 16;
+        const char* sizeEnv = getenv("SCX_LOGFILE_BENCHMARK_MB");
+        if (NULL != sizeEnv && atoi(sizeEnv) > 0)
+        {
+            megabytes = static_cast<scxulong>(atoi(sizeEnv));
+        }
+
+        std::vector<SCXRegexWithIndex> regexps;
+        SCXRegexWithIndex regind;
+        regind.regex = new SCXRegex(L"ERROR");
+        regind.index = 0;
+        regexps.push_back(regind);
+
+        // Establish state at the start of the (empty) log
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+        }
+        std::vector<std::wstring> matchedLines;
+        m_pReader->SetPersistMedia(m_pmedia);
+        m_pReader->ReadLogFile(testlogfilename, testQID, regexps, matchedLines);
+
+        // (scxulong, since multi-GB sizes overflow a 32-bit size_t)
+        const scxulong targetBytes = megabytes * 1024 * 1024;
+        scxulong bytes = 0;
+        size_t expectedMatches = 0;
+        {
+            std::ofstream out(SCXCoreLib::StrToMultibyte(testlogfilename).c_str(), std::ios_base::binary);
+            for (scxulong i = 0; bytes < targetBytes; i++)
+            {
+                std::ostringstream row;
+                row << "2026-10-17 12:00:" << (i % 60) << " host app[" << i << "]: "
+                    << (0 == i % 100000 ? "ERROR" : "INFO") << " synthetic log row number " << i << std::endl;
+                out << row.str();
+                bytes += row.str().size();
+                expectedMatches += (0 == i % 100000 ? 1 : 0);
+            }
+        }
+
+        // Before: wfstream and SCXStream::ReadLine, widening every line
+        double start = GetSeconds();
+        size_t baselineMatches = 0;
+        {
+            SCXHandle<std::wfstream> stream = SCXFile::OpenWFstream(testlogfilename, std::ios_base::in);
+            try {
+                stream->imbue(std::locale(""));
+            }
+            catch (...)
+            {
+            }
+            while (SCXStream::IsGood(*stream))
+            {
+                std::wstring line;
+                SCXStream::NLF nlf;
+                SCXStream::ReadLine(*stream, line, nlf);
+                if (regexps[0].regex->IsMatch(line))
+                {
+                    baselineMatches++;
+                }
+            }
+        }
+        double baselineSeconds = GetSeconds() - start;
+
+        // After: LogFileReader::ReadLogFile, continuing as long as reads are
+        // partial, so the whole file is scanned whatever the row limit of a read
+        start = GetSeconds();
+        size_t matches = 0;
+        bool wasPartialRead = true;
+        while (wasPartialRead)
+        {
+            matchedLines.clear();
+            wasPartialRead = m_pReader->ReadLogFile(testlogfilename, testQID, regexps, matchedLines);
+            matches += matchedLines.size();
+        }
+        double seconds = GetSeconds() - start;
+
+        CPPUNIT_ASSERT_EQUAL(expectedMatches, baselineMatches);
+        CPPUNIT_ASSERT_EQUAL(expectedMatches, matches);
+
+        double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+        std::cout << std::endl
+                  << "ReadLogFile throughput over " << mb << " MB: "
+                  << "wfstream " << (baselineSeconds > 0 ? mb / baselineSeconds : 0) << " MB/s, "
+                  << "block scanner " << (seconds > 0 ? mb / seconds : 0) << " MB/s" << std::endl;
+    }
+
     void testDoInvokeMethod ()
     {
         // This test is a little convoluted, but it's a very useful test, so it remains.
@@ -698,7 +1187,8 @@ public:
         agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
         CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
         CPPUNIT_ASSERT_EQUAL(1u, context.Size());
-        CPPUNIT_ASSERT_EQUAL(2u, context[0].GetNumberOfProperties());
+        // The position to resume at is returned along with a partial read
+        CPPUNIT_ASSERT_EQUAL(3u, context[0].GetNumberOfProperties());
         rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
         // Should get first 500 rows and two status rows.
         CPPUNIT_ASSERT_EQUAL(502u, rowCnt);
@@ -784,6 +1274,105 @@ public:
             GetValue_MIStringA(CALL_LOCATION(errMsg)).size());
     }
 
+    void testDoInvokeMethodWithRowLimits()
+    {
+        const std::wstring moreRowsStr = L"MoreRowsAvailable;true";
+
+        std::wstring errMsg;
+        TestableContext context;
+        mi::SCX_LogFile_Class instanceName;
+        mi::StringA regexps;
+        regexps.PushBack(".*");
+        mi::Module Module;
+        mi::SCX_LogFile_Class_Provider agent(&Module);
+
+        // Create a log file with one row in it.
+        SCXHandle<std::wfstream> stream = SCXFile::OpenWFstream(testlogfilename, std::ios_base::out);
+        *stream << L"This is the first row." << std::endl;
+
+        mi::SCX_LogFile_GetMatchedRows_Class param;
+        param.filename_value(SCXCoreLib::StrToMultibyte(testlogfilename).c_str());
+        param.regexps_value(regexps);
+        param.qid_value(SCXCoreLib::StrToMultibyte(testQID).c_str());
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+
+        // Add 700 rows to the log file.
+        for (int i=0; i<700; i++)
+        {
+            *stream << L"This is another row." << std::endl;
+        }
+
+        // A larger page (up to the cap) returns all of them in one call
+        param.maxRows_value(static_cast<MI_Uint32>(SCXCore::LogFileReader::cMaxRowsLimit));
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL(1u, context.Size());
+        size_t rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(700u, rowCnt);
+        CPPUNIT_ASSERT(moreRowsStr !=
+            context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg))[rowCnt - 1]);
+
+        for (int i=0; i<800; i++)
+        {
+            *stream << L"This is another row." << std::endl;
+        }
+
+        // A smaller page (also through scxlogfilereader) stops early
+        g_LogFileProvider.SetRunReaderPerRequest(true);
+        param.maxRows_value(300);
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(301u, rowCnt);
+        CPPUNIT_ASSERT_EQUAL(moreRowsStr,
+            context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg))[rowCnt - 1]);
+        g_LogFileProvider.SetRunReaderPerRequest(false);
+
+        // The byte limit applies too ("0;This is another row." is 22 characters)
+        param.maxRows_value(0);
+        param.maxBytes_value(220);
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(11u, rowCnt);
+        CPPUNIT_ASSERT_EQUAL(moreRowsStr,
+            context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg))[rowCnt - 1]);
+        std::wstring resumePosition = context[0].GetProperty("resumePosition", CALL_LOCATION(errMsg)).GetValue_MIString(CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT(!resumePosition.empty());
+
+        // Defaults (500 rows) for the rest
+        param.maxBytes_clear();
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL(2u, context[0].GetNumberOfProperties());
+        rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(490u, rowCnt);
+
+        // Passing the resume position back reads the same rows again (also through scxlogfilereader)
+        g_LogFileProvider.SetRunReaderPerRequest(true);
+        param.resumePosition_value(SCXCoreLib::StrToMultibyte(resumePosition).c_str());
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(490u, rowCnt);
+        g_LogFileProvider.SetRunReaderPerRequest(false);
+
+        // A resume position of another file is ignored
+        param.resumePosition_value("0:0:0");
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        rowCnt = context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg)).size();
+        CPPUNIT_ASSERT_EQUAL(0u, rowCnt);
+    }
+
     void testInvokeResetStateFile()
     {
         std::wstring errMsg;
@@ -1110,6 +1699,9 @@ public:
             return;
         }
 
+        // The locale is set up for the scxlogfilereader process
+        g_LogFileProvider.SetRunReaderPerRequest(true);
+
         // Tell scxlogfilereader to deal with en_US.iso88591 locale
         {
             std::fstream localeFile( SCXCoreLib::StrToMultibyte(testlocalefilename).c_str(), std::fstream::out );
@@ -1225,6 +1817,129 @@ public:
         CPPUNIT_ASSERT_EQUAL(SCXCoreLib::StrAppend(regexpStr, wide_utf32_Row), rows[0]);
         CPPUNIT_ASSERT_EQUAL(SCXCoreLib::StrAppend(regexpStr, SCXCoreLib::StrFromMultibyte(addl_Row)), rows[1]);
     }
+
+    void testInProcessAndPerRequestReadersShareState()
+    {
+        std::wstring errMsg;
+        TestableContext context;
+        mi::SCX_LogFile_Class instanceName;
+        mi::StringA regexps;
+        regexps.PushBack(".*");
+        mi::Module Module;
+        mi::SCX_LogFile_Class_Provider agent(&Module);
+
+        // Create a log file with one row in it.
+        SCXHandle<std::wfstream> stream = SCXFile::OpenWFstream(testlogfilename, std::ios_base::out);
+        *stream << L"This is the first row." << std::endl;
+
+        mi::SCX_LogFile_GetMatchedRows_Class param;
+        param.filename_value(SCXCoreLib::StrToMultibyte(testlogfilename).c_str());
+        param.regexps_value(regexps);
+        param.qid_value(SCXCoreLib::StrToMultibyte(testQID).c_str());
+
+        // First call (read in-process) should not return any rows (no state file)
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL(1u, context.Size());
+        CPPUNIT_ASSERT_EQUAL(0u, context[0].GetProperty("rows", CALL_LOCATION(errMsg)).
+            GetValue_MIStringA(CALL_LOCATION(errMsg)).size());
+
+        // scxlogfilereader should continue where the in-process read stopped
+        const std::wstring secondRow(L"This is the second row.");
+        *stream << secondRow << std::endl;
+        g_LogFileProvider.SetRunReaderPerRequest(true);
+
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL(1u, context.Size());
+        CPPUNIT_ASSERT_EQUAL(1u, context[0].GetProperty("rows", CALL_LOCATION(errMsg)).
+            GetValue_MIStringA(CALL_LOCATION(errMsg)).size());
+        CPPUNIT_ASSERT_EQUAL(StrAppend(L"0;", secondRow),
+            context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg))[0]);
+
+        // ... and the other way around
+        const std::wstring thirdRow(L"This is the third row.");
+        *stream << thirdRow << std::endl;
+        g_LogFileProvider.SetRunReaderPerRequest(false);
+
+        context.Reset();
+        agent.Invoke_GetMatchedRows(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL(MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL(1u, context.Size());
+        CPPUNIT_ASSERT_EQUAL(1u, context[0].GetProperty("rows", CALL_LOCATION(errMsg)).
+            GetValue_MIStringA(CALL_LOCATION(errMsg)).size());
+        CPPUNIT_ASSERT_EQUAL(StrAppend(L"0;", thirdRow),
+            context[0].GetProperty("rows", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg))[0]);
+    }
+
+    void testLogFileReaderServer()
+    {
+        std::vector<SCXRegexWithIndex> regexps;
+        SCXRegexWithIndex regind;
+        regind.regex = new SCXRegex(L".*");
+        regind.index = 0;
+        regexps.push_back(regind);
+
+        LogFileReaderClient client(L"testfiles/scxlogfilereader-test -t -d");
+        CPPUNIT_ASSERT( ! client.IsRunning());
+
+        // Create a log file with one row in it.
+        SCXHandle<std::wfstream> stream = SCXFile::OpenWFstream(testlogfilename, std::ios_base::out);
+        *stream << L"This is the first row." << std::endl;
+
+        // First request starts the server; no rows since there is no state file
+        bool wasPartialRead = true;
+        std::vector<std::wstring> matchedLines;
+        CPPUNIT_ASSERT_EQUAL(0, client.ReadLogFile(testlogfilename, testQID, regexps, wasPartialRead, matchedLines));
+        CPPUNIT_ASSERT( ! wasPartialRead);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), matchedLines.size());
+        CPPUNIT_ASSERT(client.IsRunning());
+        pid_t pid = client.GetPid();
+
+        // Later requests are served by the same server
+        const std::wstring secondRow(L"This is the second row.");
+        *stream << secondRow << std::endl;
+        matchedLines.clear();
+        CPPUNIT_ASSERT_EQUAL(0, client.ReadLogFile(testlogfilename, testQID, regexps, wasPartialRead, matchedLines));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), matchedLines.size());
+        CPPUNIT_ASSERT_EQUAL(StrAppend(L"0;", secondRow), matchedLines[0]);
+        CPPUNIT_ASSERT_EQUAL(pid, client.GetPid());
+
+        CPPUNIT_ASSERT_EQUAL(0, client.ResetLogFileState(testlogfilename, testQID, 0));
+        CPPUNIT_ASSERT_EQUAL(ENOENT, client.ReadLogFile(L".wyzzy.nosuchfile", testQID, regexps, wasPartialRead, matchedLines));
+        CPPUNIT_ASSERT_EQUAL(pid, client.GetPid());
+
+        client.Stop();
+        CPPUNIT_ASSERT( ! client.IsRunning());
+    }
+
+    void testLogFileReaderServerTimeout()
+    {
+        std::vector<SCXRegexWithIndex> regexps;
+        SCXRegexWithIndex regind;
+        regind.regex = new SCXRegex(L".*");
+        regind.index = 0;
+        regexps.push_back(regind);
+
+        // A server that never responds fails the request once the timeout has passed
+        LogFileReaderClient client(L"exec sleep 3", 1);
+        bool wasPartialRead = false;
+        std::vector<std::wstring> matchedLines;
+        CPPUNIT_ASSERT_THROW(client.ReadLogFile(testlogfilename, testQID, regexps, wasPartialRead, matchedLines),
+                             SCXCoreLib::SCXException);
+
+        // ... and is stopped, so that the next request starts a new one; stopping
+        // doesn't wait for it to exit, it is reaped by a later call once it has
+        CPPUNIT_ASSERT( ! client.IsRunning());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), client.GetStoppedServerCount());
+        for (int i = 0; i < 50 && 0 != client.GetStoppedServerCount(); i++)
+        {
+            SCXCoreLib::SCXThread::Sleep(100);
+            client.ReapStoppedServers();
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), client.GetStoppedServerCount());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( LogFileProviderTest );
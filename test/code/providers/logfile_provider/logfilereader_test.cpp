@@ -102,6 +102,7 @@ public:
         expectedHelpText << "Usage: scxlogfilereader" << endl << endl
                          << "Options:" << endl
                          << "  -h:\tDisplay detailed help information" << endl
+                         << "  -d:\tProvider server interface (for internal use only)" << endl
                          << "  -g:\tReset all log file states (for internal use only)" << endl
                          << "     \t(Requires parameter for ResetOnRead: 1/true/0/false)" << endl
                          << "  -i:\tInteractive use (for debugging purposes only)" << endl
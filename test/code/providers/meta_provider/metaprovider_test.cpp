@@ -14,11 +14,13 @@
 
 #include <scxcorelib/scxcmn.h>
 #include <scxcorelib/scxexception.h>
+#include <scxcorelib/stringaid.h>
 #include <scxsystemlib/scxostypeinfo.h>
 #include <testutils/scxunit.h>
 #include <testutils/providertestutils.h>
 
 #include "metaprovider.h"
+#include "providerstatistics.h"
 #include "SCX_Agent.h"
 #include "SCX_Agent_Class_Provider.h"
 
@@ -36,6 +38,8 @@ class SCXMetaProviderTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( TestEnumerateKeysOnly );
     CPPUNIT_TEST( VerifyKeyCompletePartial );
     CPPUNIT_TEST( TestLowestLogLevel );
+    CPPUNIT_TEST( TestProviderStatistics );
+    CPPUNIT_TEST( TestProviderStatisticsHistogram );
 //    CPPUNIT_TEST( PrintAsEnumeration ); /* For debug printouts */
 
     CPPUNIT_TEST_SUITE_END();
@@ -194,6 +198,89 @@ public:
         CPPUNIT_ASSERT_EQUAL(std::string("TRACE"), lowestLogThreshold);
     }
 
+    void TestProviderStatistics()
+    {
+        std::wstring errMsg;
+        mi::Module Module;
+        mi::SCX_Agent_Class_Provider agent(&Module);
+        TestableContext context;
+
+        // Calls are recorded when they end, so the first enumeration is only seen by the second
+        agent.EnumerateInstances(context, NULL, context.GetPropertySet(), false, NULL);
+        CPPUNIT_ASSERT_EQUAL( MI_RESULT_OK, context.GetResult() );
+
+        context.Reset();
+        agent.EnumerateInstances(context, NULL, context.GetPropertySet(), false, NULL);
+        CPPUNIT_ASSERT_EQUAL( MI_RESULT_OK, context.GetResult() );
+        CPPUNIT_ASSERT_EQUAL(1u, context.Size());
+
+        std::vector<std::wstring> statistics =
+            context[0].GetProperty("ProviderStatistics", CALL_LOCATION(errMsg)).GetValue_MIStringA(CALL_LOCATION(errMsg));
+
+        std::wstring entry;
+        for (std::vector<std::wstring>::const_iterator it = statistics.begin(); it != statistics.end(); ++it)
+        {
+            if (0 == it->find(L"SCX_Agent.EnumerateInstances "))
+            {
+                entry = *it;
+            }
+        }
+        CPPUNIT_ASSERT_MESSAGE("No statistics for SCX_Agent.EnumerateInstances", !entry.empty());
+
+        // Earlier tests enumerate too, so only lower bounds are known
+        size_t pos = entry.find(L" Calls=");
+        CPPUNIT_ASSERT(std::wstring::npos != pos);
+        CPPUNIT_ASSERT(StrToUInt(entry.substr(pos + 7, entry.find(L' ', pos + 1) - pos - 7)) >= 1);
+        pos = entry.find(L" Instances=");
+        CPPUNIT_ASSERT(std::wstring::npos != pos);
+        CPPUNIT_ASSERT(StrToUInt(entry.substr(pos + 11, entry.find(L' ', pos + 1) - pos - 11)) >= 1);
+        CPPUNIT_ASSERT(std::wstring::npos != entry.find(L" LockWaitMicroseconds="));
+        CPPUNIT_ASSERT(std::wstring::npos != entry.find(L" Histogram="));
+
+        // Followed by the counters of the RunAs command pool
+        CPPUNIT_ASSERT(0 == statistics.back().find(L"CommandPool "));
+        CPPUNIT_ASSERT(std::wstring::npos != statistics.back().find(L" Rejected="));
+    }
+
+    void TestProviderStatisticsHistogram()
+    {
+        ProviderStatistics statistics;
+        statistics.Record("SCX_Test", "GetInstance", 500, 10, 1, 0);
+        statistics.Record("SCX_Test", "GetInstance", 2000000, 1500, 1, 100);
+        statistics.Record("SCX_Test", "Invoke_Test", 20000000, 0, 0, 0);
+
+        std::map<std::string, ProviderStatistics::Counters> counters;
+        statistics.GetCounters(counters);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t> (2), counters.size());
+
+        const ProviderStatistics::Counters& get = counters["SCX_Test.GetInstance"];
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (2), get.calls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (2000500), get.totalMicroseconds);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (2000000), get.maxMicroseconds);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (1510), get.lockWaitMicroseconds);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (1500), get.maxLockWaitMicroseconds);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (2), get.instances);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (100), get.bytes);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (1), get.histogram[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (1), get.histogram[4]);
+
+        // Calls longer than the last limit fall in the last bucket
+        const ProviderStatistics::Counters& invoke = counters["SCX_Test.Invoke_Test"];
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (0), ProviderStatistics::GetBucketLimit(ProviderStatistics::cHistogramBuckets - 1));
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong> (1), invoke.histogram[ProviderStatistics::cHistogramBuckets - 1]);
+
+        std::vector<std::string> lines;
+        statistics.Format(lines);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t> (2), lines.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("SCX_Test.GetInstance Calls=2 TotalMicroseconds=2000500 MaxMicroseconds=2000000 "
+                                         "LockWaitMicroseconds=1510 MaxLockWaitMicroseconds=1500 Instances=2 Bytes=100 "
+                                         "Histogram=1,0,0,0,1,0"), lines[0]);
+
+        statistics.Reset();
+        statistics.Format(lines);
+        CPPUNIT_ASSERT(lines.empty());
+    }
+
     /** Print the same output that an enumeration would. */
     void PrintAsEnumeration()
     {
@@ -0,0 +1,205 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the probing of mount points with a deadline
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthread.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <testutils/scxunit.h>
+#include <mountprobe.h>
+#include <snapshotpublisher.h>
+
+using namespace SCXCoreLib;
+using namespace SCXCore;
+
+namespace
+{
+    //! Number of probes started and returned, guarded by the lock below
+    unsigned int s_started = 0;
+    unsigned int s_returned = 0;
+    //! Time (in milliseconds) the probes of "/slow" take
+    scxulong s_slowTime = 0;
+    //! Do the probes of "/hung" keep hanging?
+    bool s_hung = false;
+
+    SCXThreadLockHandle GetTestLock()
+    {
+        return ThreadLockHandleGet(L"MountProbeTest");
+    }
+
+    //! Probe of the tests: "/hung" hangs until released, "/slow" takes a while, others return at once
+    void TestProbe(const std::string& path)
+    {
+        {
+            SCXThreadLock lock(GetTestLock());
+            s_started++;
+        }
+
+        if ("/slow" == path)
+        {
+            SCXThread::Sleep(s_slowTime);
+        }
+        for (;;)
+        {
+            {
+                SCXThreadLock lock(GetTestLock());
+                if ("/hung" != path || !s_hung)
+                {
+                    s_returned++;
+                    return;
+                }
+            }
+            SCXThread::Sleep(10);
+        }
+    }
+
+    unsigned int GetStarted()
+    {
+        SCXThreadLock lock(GetTestLock());
+        return s_started;
+    }
+
+    void SetHung(bool hung)
+    {
+        SCXThreadLock lock(GetTestLock());
+        s_hung = hung;
+    }
+
+    //! Wait for the probe threads to return: they refer to the MountProbe of the test
+    void WaitForProbes()
+    {
+        for (int i = 0; i < 500; i++)
+        {
+            {
+                SCXThreadLock lock(GetTestLock());
+                if (s_returned == s_started)
+                {
+                    break;
+                }
+            }
+            SCXThread::Sleep(10);
+        }
+        // Let the threads report to the MountProbe
+        SCXThread::Sleep(50);
+    }
+}
+
+class MountProbeTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( MountProbeTest );
+    CPPUNIT_TEST( TestResponsiveMountIsAvailable );
+    CPPUNIT_TEST( TestResponseIsTrusted );
+    CPPUNIT_TEST( TestHungMountDoesNotBlock );
+    CPPUNIT_TEST( TestSlowMountIsQuarantined );
+    SCXUNIT_TEST_ATTRIBUTE(TestSlowMountIsQuarantined, SLOW);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void)
+    {
+        s_started = 0;
+        s_returned = 0;
+        s_slowTime = 0;
+        s_hung = false;
+    }
+
+    void tearDown(void)
+    {
+        SetHung(false);
+        WaitForProbes();
+    }
+
+    void TestResponsiveMountIsAvailable()
+    {
+        MountProbe probe;
+        probe.SetProbeFunction(TestProbe);
+
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/"));
+        CPPUNIT_ASSERT_EQUAL(1u, GetStarted());
+        CPPUNIT_ASSERT_EQUAL(std::string("Available"), std::string(MountProbe::GetStatusName(MountProbe::eAvailable)));
+    }
+
+    void TestResponseIsTrusted()
+    {
+        MountProbe probe;
+        probe.SetProbeFunction(TestProbe);
+        probe.SetLimits(MountProbe::cDefaultTimeout, MountProbe::cDefaultMaxTimeouts, MountProbe::cDefaultQuarantine, 60000);
+
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/"));
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/"));
+        CPPUNIT_ASSERT_EQUAL(1u, GetStarted());
+
+        // Without trust, every request probes
+        probe.SetLimits(MountProbe::cDefaultTimeout, MountProbe::cDefaultMaxTimeouts, MountProbe::cDefaultQuarantine, 0);
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/"));
+        CPPUNIT_ASSERT_EQUAL(2u, GetStarted());
+    }
+
+    void TestHungMountDoesNotBlock()
+    {
+        MountProbe probe;
+        probe.SetProbeFunction(TestProbe);
+        probe.SetLimits(200, 0, MountProbe::cDefaultQuarantine, 0);
+        SetHung(true);
+
+        std::vector<std::wstring> mountPoints;
+        mountPoints.push_back(L"/");
+        mountPoints.push_back(L"/hung");
+        std::vector<MountProbe::Status> statuses;
+
+        // The request waits for the deadline only
+        scxulong start = GetSnapshotTime();
+        probe.Probe(mountPoints, statuses);
+        CPPUNIT_ASSERT(GetSnapshotTime() - start < 1000);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), statuses.size());
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, statuses[0]);
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eUnresponsive, statuses[1]);
+
+        // The next request doesn't wait at all, nor starts another probe of the hung mount point
+        start = GetSnapshotTime();
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eUnresponsive, probe.Probe(L"/hung"));
+        CPPUNIT_ASSERT(GetSnapshotTime() - start < 150);
+        CPPUNIT_ASSERT_EQUAL(2u, GetStarted());
+
+        // Once the probe returns, the mount point is probed again
+        SetHung(false);
+        WaitForProbes();
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/hung"));
+        CPPUNIT_ASSERT_EQUAL(3u, GetStarted());
+    }
+
+    void TestSlowMountIsQuarantined()
+    {
+        MountProbe probe;
+        probe.SetProbeFunction(TestProbe);
+        probe.SetLimits(100, 2, 60000, 0);
+        s_slowTime = 300;
+
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eUnresponsive, probe.Probe(L"/slow"));
+        WaitForProbes();
+
+        // A late response doesn't end the series of missed deadlines
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eQuarantined, probe.Probe(L"/slow"));
+        WaitForProbes();
+
+        // Not probed while quarantined
+        scxulong start = GetSnapshotTime();
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eQuarantined, probe.Probe(L"/slow"));
+        CPPUNIT_ASSERT(GetSnapshotTime() - start < 50);
+        CPPUNIT_ASSERT_EQUAL(2u, GetStarted());
+
+        // Other mount points are not affected
+        CPPUNIT_ASSERT_EQUAL(MountProbe::eAvailable, probe.Probe(L"/"));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MountProbeTest );
@@ -16,14 +16,20 @@
 /*----------------------------------------------------------------------------*/
 
 #include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthreadlock.h>
 #include <scxsystemlib/scxostypeinfo.h>
 #include <testutils/scxunit.h>
 #include <testutils/providertestutils.h>
 #include "SCX_UnixProcess_Class_Provider.h"
 #include "SCX_UnixProcessStatisticalInformation_Class_Provider.h"
+#include "SCX_UnixProcessGroupStatisticalInformation_Class_Provider.h"
+#include "processaggregation.h"
+#include "processprovider.h"
 
 #include "testutilities.h"
 
+#include <algorithm>
+
 //WI567597: Property ModulePath not returned during pbuild on ostcdev64-sles11-01, ostcdev-sles10-01, ostcdev64-rhel4-01 and ostcdev-rhel4-10.
 //WI567598: Property Parameters not returned on ostcdev-sles9-10.
 static bool brokenProvider = true;
@@ -45,6 +51,19 @@ class SCXProcessProviderTest : public CPPUNIT_NS::TestFixture
 
     CPPUNIT_TEST( TestUnixProcessInvokeTopResourceConsumers );
     CPPUNIT_TEST( TestUnixProcessInvokeTopResourceConsumersFail );
+    CPPUNIT_TEST( TestUnixProcessInvokeTopResourceConsumersSeveralResources );
+
+    CPPUNIT_TEST( TestSnapshotIsShared );
+    CPPUNIT_TEST( TestSnapshotIsRefreshedWhenStale );
+    CPPUNIT_TEST( TestSnapshotForSpecificProcess );
+    CPPUNIT_TEST( TestSnapshotLookupByPid );
+    CPPUNIT_TEST( TestSnapshotGenerationsIncrease );
+    CPPUNIT_TEST( TestSnapshotTracksChanges );
+    CPPUNIT_TEST( TestTopResourceConsumersSeveralResources );
+    CPPUNIT_TEST( TestFindProcesses );
+    CPPUNIT_TEST( TestProcessGroupAggregation );
+    CPPUNIT_TEST( TestUnixProcessGroupStatisticalInformationEnumerateInstances );
+    CPPUNIT_TEST( TestUnixProcessGroupStatisticalInformationGetThisInstance );
 
 
     SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessEnumerateInstances, SLOW);
@@ -58,12 +77,26 @@ class SCXProcessProviderTest : public CPPUNIT_NS::TestFixture
 
     SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessInvokeTopResourceConsumers, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessInvokeTopResourceConsumersFail, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessInvokeTopResourceConsumersSeveralResources, SLOW);
+
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotIsShared, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotIsRefreshedWhenStale, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotForSpecificProcess, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotLookupByPid, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotGenerationsIncrease, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestSnapshotTracksChanges, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestTopResourceConsumersSeveralResources, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestFindProcesses, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestProcessGroupAggregation, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessGroupStatisticalInformationEnumerateInstances, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestUnixProcessGroupStatisticalInformationGetThisInstance, SLOW);
 
     CPPUNIT_TEST_SUITE_END();
 
 private:
     std::vector<std::wstring> m_keyNamesUP;// SCX_UnixProcess key names.
     std::vector<std::wstring> m_keyNamesUPS;// SCX_UnixProcessStatisticalInformation key names.
+    std::vector<std::wstring> m_keyNamesUPGS;// SCX_UnixProcessGroupStatisticalInformation key names.
 
 public:
     void setUp(void)
@@ -74,6 +107,8 @@ public:
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, true, context.WasRefuseUnloadCalled() );
         SetUpAgent<mi::SCX_UnixProcessStatisticalInformation_Class_Provider>(context, CALL_LOCATION(errMsg));
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, true, context.WasRefuseUnloadCalled() );
+        SetUpAgent<mi::SCX_UnixProcessGroupStatisticalInformation_Class_Provider>(context, CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, true, context.WasRefuseUnloadCalled() );
         
         m_keyNamesUP.push_back(L"CSCreationClassName");
         m_keyNamesUP.push_back(L"CSName");
@@ -89,6 +124,8 @@ public:
         m_keyNamesUPS.push_back(L"OSName");
         m_keyNamesUPS.push_back(L"Handle");
         m_keyNamesUPS.push_back(L"ProcessCreationClassName");
+
+        m_keyNamesUPGS.push_back(L"Name");
     }
 
     void tearDown(void)
@@ -99,6 +136,8 @@ public:
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, false, context.WasRefuseUnloadCalled() );
         TearDownAgent<mi::SCX_UnixProcessStatisticalInformation_Class_Provider>(context, CALL_LOCATION(errMsg));
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, false, context.WasRefuseUnloadCalled() );
+        TearDownAgent<mi::SCX_UnixProcessGroupStatisticalInformation_Class_Provider>(context, CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, false, context.WasRefuseUnloadCalled() );
     }
 
     void TestUnixProcessEnumerateInstances()
@@ -226,6 +265,359 @@ public:
             GetTopResourceConsumers("InvalidResource", CALL_LOCATION(errMsg)));
     }
 
+    void TestUnixProcessInvokeTopResourceConsumersSeveralResources()
+    {
+        std::wstring errMsg;
+        TestableContext context;
+        mi::SCX_UnixProcess_Class instanceName;
+        mi::SCX_UnixProcess_TopResourceConsumers_Class param;
+        mi::StringA resources;
+        resources.PushBack("UsedMemory");
+        resources.PushBack("CPUTime");
+        param.resources_value(resources);
+        param.count_value(3);
+
+        mi::Module Module;
+        mi::SCX_UnixProcess_Class_Provider agent(&Module);
+        agent.Invoke_TopResourceConsumers(context, NULL, instanceName, param);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, MI_RESULT_OK, context.GetResult());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 1u, context.Size());
+
+        // Three consumers per resource, in the order asked for
+        TestableInstance::PropertyInfo info;
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, MI_RESULT_OK, context[0].FindProperty("consumers", info));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, MI_INSTANCEA, info.type);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 6u, info.value.instancea.size);
+        for (MI_Uint32 i = 0; i < info.value.instancea.size; i++)
+        {
+            mi::SCX_ResourceConsumer_Class consumer(&SCX_ResourceConsumer_rtti, info.value.instancea.data[i], false);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, std::string(i < 3 ? "UsedMemory" : "CPUTime"),
+                std::string(consumer.Resource_value().Str()));
+            CPPUNIT_ASSERT_MESSAGE(ERROR_MESSAGE, consumer.PID_exists() && consumer.Value_exists());
+            CPPUNIT_ASSERT_MESSAGE(ERROR_MESSAGE, consumer.Name_exists());
+        }
+
+        // An unknown resource fails the call
+        TestableContext failed;
+        resources.PushBack("InvalidResource");
+        param.resources_value(resources);
+        agent.Invoke_TopResourceConsumers(failed, NULL, instanceName, param);
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MESSAGE, MI_RESULT_OK != failed.GetResult());
+    }
+
+    void TestSnapshotIsShared()
+    {
+        scxulong oldMaxAge = SCXCore::g_ProcessProvider.GetSnapshotMaxAge();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(60000);
+
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> first = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> second = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        CPPUNIT_ASSERT(first.GetData() == second.GetData());
+        CPPUNIT_ASSERT(first->Size() > 10);
+        CPPUNIT_ASSERT(NULL != first->GetInstance(SCXCoreLib::StrFrom(getpid())));
+    }
+
+    void TestSnapshotIsRefreshedWhenStale()
+    {
+        scxulong oldMaxAge = SCXCore::g_ProcessProvider.GetSnapshotMaxAge();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(0);
+
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> first = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> second = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        CPPUNIT_ASSERT(first.GetData() != second.GetData());
+    }
+
+    void TestSnapshotForSpecificProcess()
+    {
+        scxulong oldMaxAge = SCXCore::g_ProcessProvider.GetSnapshotMaxAge();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(0);
+
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot(getpid());
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), snapshot->Size());
+        scxulong pid = 0;
+        CPPUNIT_ASSERT(snapshot->GetInstance(0).GetPID(pid));
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(getpid()), pid);
+        CPPUNIT_ASSERT(NULL == snapshot->GetInstance(L"not-a-pid"));
+    }
+
+    void TestSnapshotLookupByPid()
+    {
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+
+        // Every process in the snapshot is found by its process ID
+        for (size_t i = 0; i < snapshot->Size(); i++)
+        {
+            scxulong pid = 0;
+            CPPUNIT_ASSERT(snapshot->GetInstance(i).GetPID(pid));
+            CPPUNIT_ASSERT(&snapshot->GetInstance(i) == snapshot->GetInstanceByPid(pid));
+            CPPUNIT_ASSERT(&snapshot->GetInstance(i) == snapshot->GetInstance(SCXCoreLib::StrFrom(pid)));
+        }
+
+        scxulong pid = 0;
+        CPPUNIT_ASSERT(SCXCore::ProcessSnapshot::ParseHandle(L"12345", pid));
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(12345), pid);
+        CPPUNIT_ASSERT(!SCXCore::ProcessSnapshot::ParseHandle(L"", pid));
+        CPPUNIT_ASSERT(!SCXCore::ProcessSnapshot::ParseHandle(L"-1", pid));
+        CPPUNIT_ASSERT(!SCXCore::ProcessSnapshot::ParseHandle(L"12 ", pid));
+        CPPUNIT_ASSERT(NULL == snapshot->GetInstance(L"12abc"));
+    }
+
+    void TestSnapshotGenerationsIncrease()
+    {
+        scxulong oldMaxAge = SCXCore::g_ProcessProvider.GetSnapshotMaxAge();
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(0);
+
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> first = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> second = SCXCore::g_ProcessProvider.GetSnapshot();
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> partial = SCXCore::g_ProcessProvider.GetSnapshot(getpid());
+        SCXCore::g_ProcessProvider.SetSnapshotMaxAge(oldMaxAge);
+
+        CPPUNIT_ASSERT(0 != first->GetGeneration());
+        CPPUNIT_ASSERT(second->GetGeneration() > first->GetGeneration());
+        for (size_t i = 0; i < second->Size(); i++)
+        {
+            CPPUNIT_ASSERT(0 != second->GetInstance(i).GetGeneration());
+            CPPUNIT_ASSERT(second->GetInstance(i).GetGeneration() <= second->GetGeneration());
+        }
+
+        // Snapshots of some processes only can't tell what changed
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(0), partial->GetGeneration());
+    }
+
+    void TestSnapshotTracksChanges()
+    {
+        // Fill in the process enumeration
+        SCXCore::g_ProcessProvider.GetSnapshot();
+
+        // The current snapshot misses this process, as if it had terminated
+        const scxulong self = static_cast<scxulong>(getpid());
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> previous(new SCXCore::ProcessSnapshot(1000));
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> current(new SCXCore::ProcessSnapshot(2000));
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> later(new SCXCore::ProcessSnapshot(3000));
+        {
+            SCXCoreLib::SCXHandle<SCXSystemLib::ProcessEnumeration> processes = SCXCore::g_ProcessProvider.GetProcessEnumerator();
+            SCXCoreLib::SCXThreadLock lock(processes->GetLockHandle());
+            for (size_t i = 0; i < processes->Size(); i++)
+            {
+                scxulong pid = 0;
+                CPPUNIT_ASSERT(processes->GetInstance(i)->GetPID(pid));
+                previous->AddInstance(processes->GetInstance(i), processes->GetLockHandle());
+                later->AddInstance(processes->GetInstance(i), processes->GetLockHandle());
+                if (pid != self)
+                {
+                    current->AddInstance(processes->GetInstance(i), processes->GetLockHandle());
+                }
+            }
+        }
+
+        previous->TrackChanges(NULL, 1000);
+        current->TrackChanges(previous.GetData(), 2000);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(2000), current->GetGeneration());
+        CPPUNIT_ASSERT(previous->GetTerminated().empty());
+
+        // Processes that didn't change keep their generation
+        CPPUNIT_ASSERT(current->Size() > 0);
+        for (size_t i = 0; i < current->Size(); i++)
+        {
+            CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(1000), current->GetInstance(i).GetGeneration());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), current->GetTerminated().size());
+        CPPUNIT_ASSERT_EQUAL(self, current->GetTerminated()[0].pid);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(2000), current->GetTerminated()[0].generation);
+
+        std::string name;
+        CPPUNIT_ASSERT(previous->GetInstanceByPid(self)->GetName(name));
+        CPPUNIT_ASSERT_EQUAL(name, current->GetTerminated()[0].name);
+
+        // A process ID that shows up again is a new process, no longer a terminated one
+        later->TrackChanges(current.GetData(), 3000);
+        CPPUNIT_ASSERT(later->GetTerminated().empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(3000), later->GetInstanceByPid(self)->GetGeneration());
+
+        // Terminated processes are remembered for a while, whatever the generations
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> soon(new SCXCore::ProcessSnapshot(2500));
+        soon->TrackChanges(current.GetData(), 2001);
+        CPPUNIT_ASSERT_EQUAL(current->Size() + 1, soon->GetTerminated().size());
+        CPPUNIT_ASSERT_EQUAL(self, soon->GetTerminated().back().pid);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(2000), soon->GetTerminated().back().generation);
+
+        // ... and forgotten once old enough
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> empty(new SCXCore::ProcessSnapshot(2000 + SCXCore::ProcessSnapshot::cTerminatedMaxAge));
+        empty->TrackChanges(current.GetData(), 2001);
+        CPPUNIT_ASSERT_EQUAL(current->Size(), empty->GetTerminated().size());
+        for (size_t i = 0; i < empty->GetTerminated().size(); i++)
+        {
+            CPPUNIT_ASSERT(self != empty->GetTerminated()[i].pid);
+        }
+    }
+
+    void TestTopResourceConsumersSeveralResources()
+    {
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+        CPPUNIT_ASSERT(snapshot->Size() > 5);
+
+        std::vector<std::wstring> resources;
+        resources.push_back(L"UsedMemory");
+        resources.push_back(L"cputime");
+
+        std::vector<std::vector<SCXCore::ProcessProvider::ResourceConsumer> > consumers;
+        SCXCore::g_ProcessProvider.GetTopResourceConsumers(snapshot, resources, 5, consumers);
+        CPPUNIT_ASSERT_EQUAL(resources.size(), consumers.size());
+
+        // The largest consumer is first, and nobody left out uses more than the last one listed
+        scxulong maxMemory = 0;
+        scxulong minListedMemory = 0;
+        for (size_t i = 0; i < consumers[0].size(); i++)
+        {
+            if (i > 0)
+            {
+                CPPUNIT_ASSERT(consumers[0][i - 1].value >= consumers[0][i].value);
+            }
+            minListedMemory = consumers[0][i].value;
+        }
+        size_t largerThanListed = 0;
+        for (size_t i = 0; i < snapshot->Size(); i++)
+        {
+            scxulong memory = 0;
+            CPPUNIT_ASSERT(snapshot->GetInstance(i).GetUsedMemory(memory));
+            maxMemory = std::max(maxMemory, memory);
+            if (memory > minListedMemory)
+            {
+                largerThanListed++;
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), consumers[0].size());
+        CPPUNIT_ASSERT_EQUAL(maxMemory, consumers[0][0].value);
+        CPPUNIT_ASSERT(largerThanListed < 5);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5), consumers[1].size());
+        for (size_t i = 1; i < consumers[1].size(); i++)
+        {
+            CPPUNIT_ASSERT(consumers[1][i - 1].value >= consumers[1][i].value);
+        }
+
+        resources.push_back(L"NoSuchResource");
+        CPPUNIT_ASSERT_THROW(SCXCore::g_ProcessProvider.GetTopResourceConsumers(snapshot, resources, 5, consumers),
+                             SCXCore::ProcessProvider::UnknownResourceException);
+    }
+
+    void TestFindProcesses()
+    {
+        std::string name;
+        {
+            SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+            const SCXCore::ProcessSnapshotInstance* self = snapshot->GetInstance(SCXCoreLib::StrFrom(getpid()));
+            CPPUNIT_ASSERT(NULL != self);
+            CPPUNIT_ASSERT(self->GetName(name));
+        }
+
+        std::vector<SCXCoreLib::SCXHandle<SCXSystemLib::ProcessInstance> > found =
+            SCXCore::g_ProcessProvider.FindProcesses(SCXCoreLib::StrFromUTF8(name));
+
+        bool foundSelf = false;
+        for (size_t i = 0; i < found.size(); i++)
+        {
+            scxulong pid = 0;
+            std::vector<std::string> params;
+            CPPUNIT_ASSERT(found[i]->GetPID(pid));
+            if (static_cast<scxulong>(getpid()) == pid)
+            {
+                foundSelf = true;
+                CPPUNIT_ASSERT(SCXCore::g_ProcessProvider.GetParameters(found[i], params));
+            }
+        }
+        CPPUNIT_ASSERT(foundSelf);
+    }
+
+    void TestProcessGroupAggregation()
+    {
+        SCXCoreLib::SCXHandle<SCXCore::ProcessSnapshot> snapshot = SCXCore::g_ProcessProvider.GetSnapshot();
+        std::vector<SCXCore::ProcessGroup> groups;
+        SCXCore::ProcessGroup::Aggregate(*snapshot, groups);
+
+        // Each process is in one user group and one name group; trees never overlap.
+        // Every group is found again by name.
+        size_t perKind[3] = { 0, 0, 0 };
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            CPPUNIT_ASSERT(groups[i].GetNumberOfProcesses() > 0);
+            perKind[groups[i].GetType()] += groups[i].GetNumberOfProcesses();
+
+            SCXCore::ProcessGroup same(SCXCore::ProcessGroup::eUser, "");
+            CPPUNIT_ASSERT(SCXCore::ProcessGroup::Aggregate(*snapshot, groups[i].GetName(), same));
+            CPPUNIT_ASSERT_EQUAL(groups[i].GetNumberOfProcesses(), same.GetNumberOfProcesses());
+        }
+        CPPUNIT_ASSERT_EQUAL(snapshot->Size(), perKind[SCXCore::ProcessGroup::eUser]);
+        CPPUNIT_ASSERT_EQUAL(snapshot->Size(), perKind[SCXCore::ProcessGroup::eName]);
+        CPPUNIT_ASSERT(perKind[SCXCore::ProcessGroup::eTree] <= snapshot->Size());
+
+        // Only the trees enumerated are groups: not init's, nor the subtree of a child process
+        SCXCore::ProcessGroup tree(SCXCore::ProcessGroup::eUser, "");
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::Aggregate(*snapshot, "Tree:1", tree));
+        if (getppid() > 1 && NULL != snapshot->GetInstanceByPid(getppid()))
+        {
+            CPPUNIT_ASSERT(!SCXCore::ProcessGroup::Aggregate(*snapshot, SCXCoreLib::StrToUTF8(L"Tree:" + SCXCoreLib::StrFrom(getpid())), tree));
+        }
+
+        // Our user owns at least one process
+
+        SCXCore::ProcessGroup user(SCXCore::ProcessGroup::eUser, "");
+        CPPUNIT_ASSERT(SCXCore::ProcessGroup::Aggregate(*snapshot, SCXCoreLib::StrToUTF8(L"User:" + SCXCoreLib::StrFrom(getuid())), user));
+        CPPUNIT_ASSERT(user.GetNumberOfProcesses() >= 1);
+
+        SCXCore::ProcessGroup::GroupType type = SCXCore::ProcessGroup::eUser;
+        std::string value;
+        CPPUNIT_ASSERT(SCXCore::ProcessGroup::ParseName("Name:my process", type, value));
+        CPPUNIT_ASSERT_EQUAL(SCXCore::ProcessGroup::eName, type);
+        CPPUNIT_ASSERT_EQUAL(std::string("my process"), value);
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::ParseName("Tree:abc", type, value));
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::ParseName("Tree:01", type, value));
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::ParseName("Name:", type, value));
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::ParseName("Group:1", type, value));
+        CPPUNIT_ASSERT(!SCXCore::ProcessGroup::ParseName("1234", type, value));
+    }
+
+    void TestUnixProcessGroupStatisticalInformationEnumerateInstances()
+    {
+        std::wstring errMsg;
+        TestableContext context;
+        StandardTestEnumerateInstances<mi::SCX_UnixProcessGroupStatisticalInformation_Class_Provider>(
+            m_keyNamesUPGS, context, CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MESSAGE, context.Size() > 2);
+
+        ValidateInstanceGroupStatisticalInformation(context, CALL_LOCATION(errMsg));
+    }
+
+    void TestUnixProcessGroupStatisticalInformationGetThisInstance()
+    {
+        std::wstring errMsg;
+        TestableContext context;
+
+        std::vector<std::wstring> keyValues;
+        keyValues.push_back(L"Name:testrunner");// Looking for us.
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, MI_RESULT_OK, (GetInstance<
+            mi::SCX_UnixProcessGroupStatisticalInformation_Class_Provider, mi::SCX_UnixProcessGroupStatisticalInformation_Class>(
+            m_keyNamesUPGS, keyValues, context, CALL_LOCATION(errMsg))));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"testrunner", context[0].GetProperty("GroupValue",
+            CALL_LOCATION(errMsg)).GetValue_MIString(CALL_LOCATION(errMsg)));
+
+        ValidateInstanceGroupStatisticalInformation(context, CALL_LOCATION(errMsg));
+
+        TestableContext notFound;
+        keyValues[0] = L"Tree:abc";
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, MI_RESULT_NOT_FOUND, (GetInstance<
+            mi::SCX_UnixProcessGroupStatisticalInformation_Class_Provider, mi::SCX_UnixProcessGroupStatisticalInformation_Class>(
+            m_keyNamesUPGS, keyValues, notFound, CALL_LOCATION(errMsg))));
+    }
+
     void ValidateInstance(const TestableContext& context, std::wstring errMsg)
     {
         for (size_t n = 0; n < context.Size(); n++)
@@ -342,6 +734,41 @@ public:
             VerifyInstancePropertyNames(instance, tmpExpectedProperties, numprops, CALL_LOCATION(errMsg));
         }
     }
+
+    void ValidateInstanceGroupStatisticalInformation(const TestableContext& context, std::wstring errMsg)
+    {
+        for (size_t n = 0; n < context.Size(); n++)
+        {
+            const TestableInstance &instance = context[n];
+
+            std::wstring tmpExpectedProperties[] = {
+                                                    L"Caption",
+                                                    L"Description",
+                                                    L"Name",
+                                                    L"IsAggregate",
+                                                    L"GroupType",
+                                                    L"GroupValue",
+                                                    L"NumberOfProcesses",
+                                                    L"PercentUserTime",
+                                                    L"PercentPrivilegedTime",
+                                                    L"UsedMemory",
+                                                    L"PercentUsedMemory",
+                                                    };
+
+            // No user name without a password entry; no block counts on some platforms
+            std::wstring tmpPossibleProperties[] = {
+                                                    L"ElementName",
+                                                    L"BlockReadsPerSecond",
+                                                    L"BlockWritesPerSecond",
+                                                    L"BlockTransfersPerSecond",
+                                                    };
+
+            VerifyInstancePropertyNames(instance,
+                tmpExpectedProperties, sizeof(tmpExpectedProperties) / sizeof(tmpExpectedProperties[0]),
+                tmpPossibleProperties, sizeof(tmpPossibleProperties) / sizeof(tmpPossibleProperties[0]),
+                CALL_LOCATION(errMsg));
+        }
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( SCXProcessProviderTest );
@@ -0,0 +1,79 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the set of properties requested by a client
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <testutils/scxunit.h>
+#include <requestedproperties.h>
+
+class RequestedPropertiesTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( RequestedPropertiesTest );
+    CPPUNIT_TEST( TestEmptySetRequestsAll );
+    CPPUNIT_TEST( TestOnlyAddedPropertiesAreRequested );
+    CPPUNIT_TEST( TestNamesAreCaseInsensitive );
+    CPPUNIT_TEST( TestAnyOfTwoRequested );
+    CPPUNIT_TEST( TestEmptyNameIsIgnored );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void TestEmptySetRequestsAll()
+    {
+        SCXCore::RequestedProperties requested;
+        CPPUNIT_ASSERT(requested.AreAllRequested());
+        CPPUNIT_ASSERT(requested.IsRequested("Name"));
+        CPPUNIT_ASSERT(requested.IsRequested("PercentBusyTime"));
+    }
+
+    void TestOnlyAddedPropertiesAreRequested()
+    {
+        SCXCore::RequestedProperties requested;
+        requested.Add("Name");
+        requested.Add("PercentBusyTime");
+
+        CPPUNIT_ASSERT(!requested.AreAllRequested());
+        CPPUNIT_ASSERT(requested.IsRequested("Name"));
+        CPPUNIT_ASSERT(requested.IsRequested("PercentBusyTime"));
+        CPPUNIT_ASSERT(!requested.IsRequested("Parameters"));
+        CPPUNIT_ASSERT(!requested.IsRequested("ModulePath"));
+    }
+
+    void TestNamesAreCaseInsensitive()
+    {
+        SCXCore::RequestedProperties requested;
+        requested.Add("percentbusytime");
+
+        CPPUNIT_ASSERT(requested.IsRequested("PercentBusyTime"));
+        CPPUNIT_ASSERT(requested.IsRequested("PERCENTBUSYTIME"));
+        CPPUNIT_ASSERT(!requested.IsRequested("PercentBusy"));
+    }
+
+    void TestAnyOfTwoRequested()
+    {
+        SCXCore::RequestedProperties requested;
+        requested.Add("FreeInodes");
+
+        CPPUNIT_ASSERT(requested.IsAnyRequested("TotalInodes", "FreeInodes"));
+        CPPUNIT_ASSERT(requested.IsAnyRequested("FreeInodes", "TotalInodes"));
+        CPPUNIT_ASSERT(!requested.IsAnyRequested("TotalInodes", "NumberOfFiles"));
+    }
+
+    void TestEmptyNameIsIgnored()
+    {
+        SCXCore::RequestedProperties requested;
+        requested.Add("");
+
+        CPPUNIT_ASSERT(requested.AreAllRequested());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( RequestedPropertiesTest );
@@ -0,0 +1,139 @@
+/*--------------------------------------------------------------------------------
+  Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+   \file
+
+   \brief       Tests for the cache of the results of the RunAs commands
+
+   \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxthread.h>
+#include <commandresultcache.h>
+#include <testutils/scxunit.h>
+
+using namespace SCXCoreLib;
+using namespace SCXCore;
+
+namespace
+{
+    //! Result of a command
+    CommandResultCache::Result MakeResult(const std::string& out, int returncode)
+    {
+        CommandResultCache::Result result;
+        result.resultOut = out;
+        result.resultErr = "";
+        result.returncode = returncode;
+        return result;
+    }
+}
+
+class CommandResultCacheTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( CommandResultCacheTest );
+    CPPUNIT_TEST( TestKey );
+    CPPUNIT_TEST( TestResultIsServed );
+    CPPUNIT_TEST( TestNoMaxAgeIsNeverServed );
+    CPPUNIT_TEST( TestOldResultIsNotServed );
+    CPPUNIT_TEST( TestOldestIsEvicted );
+    CPPUNIT_TEST( TestDisabledCache );
+    CPPUNIT_TEST_SUITE_END();
+
+    SCXUNIT_TEST_ATTRIBUTE(TestOldResultIsNotServed, SLOW);
+
+public:
+    void TestKey()
+    {
+        std::wstring key = CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 0);
+        CPPUNIT_ASSERT(key == CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 0));
+        CPPUNIT_ASSERT(key != CommandResultCache::Key(L"ExecuteShellCommand", L"df -k", L"", 0));
+        CPPUNIT_ASSERT(key != CommandResultCache::Key(L"ExecuteCommand", L"df -h", L"", 0));
+        CPPUNIT_ASSERT(key != CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"sudo", 0));
+        CPPUNIT_ASSERT(key != CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 1000));
+    }
+
+    void TestResultIsServed()
+    {
+        CommandResultCache cache(L"CommandResultCacheTest");
+        std::wstring key = CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 0);
+        CommandResultCache::Result result;
+
+        CPPUNIT_ASSERT(!cache.Get(key, 60, result));
+        cache.Put(key, MakeResult("output", 3));
+        CPPUNIT_ASSERT(cache.Get(key, 60, result));
+        CPPUNIT_ASSERT_EQUAL(std::string("output"), result.resultOut);
+        CPPUNIT_ASSERT_EQUAL(3, result.returncode);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), cache.Size());
+
+        cache.Clear();
+        CPPUNIT_ASSERT(!cache.Get(key, 60, result));
+    }
+
+    void TestNoMaxAgeIsNeverServed()
+    {
+        CommandResultCache cache(L"CommandResultCacheTest");
+        std::wstring key = CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 0);
+        CommandResultCache::Result result;
+
+        cache.Put(key, MakeResult("output", 0));
+        CPPUNIT_ASSERT(!cache.Get(key, 0, result));
+    }
+
+    void TestOldResultIsNotServed()
+    {
+        CommandResultCache cache(L"CommandResultCacheTest");
+        std::wstring key = CommandResultCache::Key(L"ExecuteCommand", L"df -k", L"", 0);
+        CommandResultCache::Result result;
+
+        cache.Put(key, MakeResult("output", 0));
+        SCXThread::Sleep(1100);
+        CPPUNIT_ASSERT(!cache.Get(key, 1, result));
+        CPPUNIT_ASSERT(cache.Get(key, 60, result));
+
+        // The configured age wins over the one accepted by the caller
+        cache.SetLimits(CommandResultCache::cDefaultMaxResults, CommandResultCache::cDefaultMaxBytes, 1);
+        CPPUNIT_ASSERT(!cache.Get(key, 60, result));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cache.Size());
+    }
+
+    void TestOldestIsEvicted()
+    {
+        CommandResultCache cache(L"CommandResultCacheTest");
+        cache.SetLimits(2, CommandResultCache::cDefaultMaxBytes, CommandResultCache::cDefaultMaxAge);
+        CommandResultCache::Result result;
+
+        cache.Put(L"a", MakeResult("a", 0));
+        SCXThread::Sleep(10);
+        cache.Put(L"b", MakeResult("b", 0));
+        SCXThread::Sleep(10);
+        cache.Put(L"c", MakeResult("c", 0));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), cache.Size());
+        CPPUNIT_ASSERT(!cache.Get(L"a", 60, result));
+        CPPUNIT_ASSERT(cache.Get(L"b", 60, result));
+        CPPUNIT_ASSERT(cache.Get(L"c", 60, result));
+    }
+
+    void TestDisabledCache()
+    {
+        CommandResultCache cache(L"CommandResultCacheTest");
+        CommandResultCache::Result result;
+
+        cache.SetLimits(0, CommandResultCache::cDefaultMaxBytes, CommandResultCache::cDefaultMaxAge);
+        cache.Put(L"a", MakeResult("a", 0));
+        CPPUNIT_ASSERT(!cache.Get(L"a", 60, result));
+
+        // An output larger than a quarter of the cache isn't kept either
+        cache.SetLimits(CommandResultCache::cDefaultMaxResults, 8, CommandResultCache::cDefaultMaxAge);
+        cache.Put(L"a", MakeResult("long output", 0));
+        CPPUNIT_ASSERT(!cache.Get(L"a", 60, result));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cache.Size());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CommandResultCacheTest );
@@ -0,0 +1,127 @@
+/*--------------------------------------------------------------------------------
+  Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+   \file
+
+   \brief       Tests for the bounded capture of the output of the RunAs commands
+
+   \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxprocess.h>
+#include <outputcapture.h>
+#include <testutils/scxunit.h>
+
+#include <locale.h>
+#include <sstream>
+#include <string>
+
+using namespace SCXCore;
+
+class OutputCaptureTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( OutputCaptureTest );
+    CPPUNIT_TEST( TestOutputIsKept );
+    CPPUNIT_TEST( TestOutputBeyondCapacityIsDropped );
+    CPPUNIT_TEST( TestProcessOutputIsBounded );
+    CPPUNIT_TEST( TestTruncateKeepsCharacters );
+    CPPUNIT_TEST( TestUTF8StrConvertsFromLocale );
+    CPPUNIT_TEST_SUITE_END();
+
+    SCXUNIT_TEST_ATTRIBUTE(TestProcessOutputIsBounded, SLOW);
+
+public:
+    void TestOutputIsKept()
+    {
+        OutputCapture capture(16);
+        capture << "abc" << 12 << 'x';
+        capture.write("def", 3);
+
+        CPPUNIT_ASSERT_EQUAL(std::string("abc12xdef"), capture.Str());
+        CPPUNIT_ASSERT(!capture.Truncated());
+        CPPUNIT_ASSERT(capture.good());
+    }
+
+    void TestOutputBeyondCapacityIsDropped()
+    {
+        OutputCapture capture(4);
+        capture << "abc";
+        capture.write("defgh", 5);
+        capture << 'x';
+
+        CPPUNIT_ASSERT_EQUAL(std::string("abcd"), capture.Str());
+        CPPUNIT_ASSERT(capture.Truncated());
+
+        // Writers never see an error: the child must be read to the end
+        CPPUNIT_ASSERT(capture.good());
+    }
+
+    void TestProcessOutputIsBounded()
+    {
+        std::istringstream input;
+        OutputCapture output(1000);
+        OutputCapture error(1000);
+        int code = SCXCoreLib::SCXProcess::Run(L"dd if=/dev/zero bs=1024 count=1024", input, output, error);
+
+        CPPUNIT_ASSERT_EQUAL(0, code);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1000), output.Str().size());
+        CPPUNIT_ASSERT(output.Truncated());
+    }
+
+    void TestTruncateKeepsCharacters()
+    {
+        // "a", "e" with acute accent (2 bytes), "z"
+        std::string str("a\xc3\xa9z");
+        CPPUNIT_ASSERT(OutputCapture::Truncate(str, 2));
+        CPPUNIT_ASSERT_EQUAL(std::string("a"), str);
+
+        str = "a\xc3\xa9z";
+        CPPUNIT_ASSERT(OutputCapture::Truncate(str, 3));
+        CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9"), str);
+
+        str = "ab";
+        CPPUNIT_ASSERT(!OutputCapture::Truncate(str, 2));
+        CPPUNIT_ASSERT_EQUAL(std::string("ab"), str);
+
+        // A character already split at the end (capture dropped the rest) goes too
+        str = "a\xc3\xa9z\xe2\x82";
+        CPPUNIT_ASSERT(OutputCapture::Truncate(str, str.size()));
+        CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9z"), str);
+
+        str = "a\xc3\xa9";
+        CPPUNIT_ASSERT(!OutputCapture::Truncate(str, str.size()));
+        CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9"), str);
+    }
+
+    void TestUTF8StrConvertsFromLocale()
+    {
+        std::string oldLocale(setlocale(LC_CTYPE, NULL));
+
+        // Output in a UTF-8 locale is passed through
+        if (NULL != setlocale(LC_CTYPE, "en_US.UTF-8"))
+        {
+            OutputCapture capture(16);
+            capture << "a\xc3\xa9z";
+            CPPUNIT_ASSERT(OutputCapture::IsUTF8Locale());
+            CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9z"), capture.UTF8Str());
+        }
+
+        // ... and converted from other encodings
+        if (NULL != setlocale(LC_CTYPE, "en_US.ISO-8859-1"))
+        {
+            OutputCapture capture(16);
+            capture << "a\xe9z";
+            CPPUNIT_ASSERT(!OutputCapture::IsUTF8Locale());
+            CPPUNIT_ASSERT_EQUAL(std::string("a\xc3\xa9z"), capture.UTF8Str());
+        }
+
+        setlocale(LC_CTYPE, oldLocale.c_str());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( OutputCaptureTest );
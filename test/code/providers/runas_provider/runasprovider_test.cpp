@@ -54,6 +54,7 @@ class SCXRunAsProviderTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST( TestDoInvokeMethodShellCommandOKWithSudoElevationType );
     CPPUNIT_TEST( TestDoInvokeMethodShellCommandOKWithEmptyElevationType );
     CPPUNIT_TEST( TestDoInvokeMethodShellCommandOKWithInvalidElevationType );
+    CPPUNIT_TEST( TestDoInvokeMethodShellCommandWithMaxAge );
     CPPUNIT_TEST( TestDoInvokeMethodScriptOK );
     CPPUNIT_TEST( TestDoInvokeMethodScriptOKWithBase64 );
     CPPUNIT_TEST( TestDoInvokeMethodScriptOKWithSudoElevation );
@@ -79,6 +80,7 @@ class SCXRunAsProviderTest : public CPPUNIT_NS::TestFixture
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodShellCommandOKWithSudoElevationType, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodShellCommandOKWithEmptyElevationType, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodShellCommandOKWithInvalidElevationType, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodShellCommandWithMaxAge, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodScriptOK, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodScriptOKWithBase64, SLOW);
     SCXUNIT_TEST_ATTRIBUTE(TestDoInvokeMethodScriptOKWithSudoElevation, SLOW);
@@ -397,6 +399,26 @@ public:
             "exit 0\n";
     }
 
+    void TestDoInvokeMethodShellCommandWithMaxAge()
+    {
+        std::wstring errMsg;
+        mi::SCX_OperatingSystem_ExecuteShellCommand_Class param;
+        // Each shell prints its own PID
+        param.Command_value("echo $$");
+        param.timeout_value(0);
+        param.MaxAge_value(600);
+        InvokeReturnData first, second, third;
+        ExecuteShellCommand(param, MI_RESULT_OK, first, CALL_LOCATION(errMsg));
+        ExecuteShellCommand(param, MI_RESULT_OK, second, CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 0, second.returnCode);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, first.stdOut, second.stdOut);
+
+        // Without MaxAge, the command always runs
+        param.MaxAge_clear();
+        ExecuteShellCommand(param, MI_RESULT_OK, third, CALL_LOCATION(errMsg));
+        CPPUNIT_ASSERT_MESSAGE(ERROR_MESSAGE, first.stdOut != third.stdOut);
+    }
+
     void TestDoInvokeMethodScriptOK()
     {
         std::wstring errMsg;
@@ -562,7 +584,8 @@ public:
         SCXCore::g_RunAsProvider.SetTemporaryDirectory(L"/some/random/directory/");
         ExecuteScript(param, MI_RESULT_OK, returnData, CALL_LOCATION(errMsg));
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 0, returnData.returnCode);
-        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"/tmp\n", returnData.stdOut);
+        // Scripts are cached in a private subdirectory of the temporary directory
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"/tmp/scripts\n", returnData.stdOut);
     }
     
     void TestDoInvokeMethodScriptDefaultTmpDir()
@@ -581,7 +604,7 @@ public:
         SCXCore::g_RunAsProvider.SetTemporaryDirectory(L"/tmp/");
         ExecuteScript(param, MI_RESULT_OK, returnData, CALL_LOCATION(errMsg));
         CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 0, returnData.returnCode);
-        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"/tmp\n", returnData.stdOut);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"/tmp/scripts\n", returnData.stdOut);
     }
     
     void TestDoInvokeMethodScriptNonDefaultTmpDir()
@@ -605,7 +628,7 @@ public:
     	
     	ExecuteScript(param, MI_RESULT_OK, returnData, CALL_LOCATION(errMsg));
     	CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, 0, returnData.returnCode);
-    	CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"./testTmpDir\n", returnData.stdOut);
+    	CPPUNIT_ASSERT_EQUAL_MESSAGE(ERROR_MESSAGE, L"./testTmpDir/scripts\n", returnData.stdOut);
     }
 
     void TestChRoot()
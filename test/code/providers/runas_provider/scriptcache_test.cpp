@@ -0,0 +1,220 @@
+/*--------------------------------------------------------------------------------
+  Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+   \file
+
+   \brief       Tests for the cache of the script files run by ExecuteScript
+
+   \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/stringaid.h>
+#include <scriptcache.h>
+#include <testutils/scxunit.h>
+
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SCXCoreLib;
+using namespace SCXCore;
+
+namespace
+{
+    //! Temporary directory used by the tests
+    const std::wstring cTmpDir = L"./testScriptCache/";
+
+    //! Read a whole file
+    std::string ReadFile(const SCXFilePath& path)
+    {
+        std::ifstream ifs(StrToMultibyte(path.Get()).c_str());
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+}
+
+class ScriptCacheTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( ScriptCacheTest );
+    CPPUNIT_TEST( TestHash );
+    CPPUNIT_TEST( TestScriptIsReused );
+    CPPUNIT_TEST( TestFileIsPrivate );
+    CPPUNIT_TEST( TestModifiedFileIsRewritten );
+    CPPUNIT_TEST( TestStaleFilesAreRemoved );
+    CPPUNIT_TEST( TestLeastRecentlyUsedIsEvicted );
+    CPPUNIT_TEST( TestRunningScriptIsNotEvicted );
+    CPPUNIT_TEST( TestDisabledCache );
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void)
+    {
+        mkdir(StrToMultibyte(cTmpDir).c_str(), S_IRWXU);
+    }
+
+    void tearDown(void)
+    {
+        // Files left by a failed test
+        std::string directory = StrToMultibyte(ScriptCache::Directory(cTmpDir));
+        system(("rm -rf " + directory).c_str());
+        rmdir(StrToMultibyte(cTmpDir).c_str());
+    }
+
+    void TestHash()
+    {
+        CPPUNIT_ASSERT_EQUAL(std::string("cbf29ce484222325"), ScriptCache::Hash(""));
+        CPPUNIT_ASSERT_EQUAL(std::string("af63dc4c8601ec8c"), ScriptCache::Hash("a"));
+        CPPUNIT_ASSERT(ScriptCache::Hash("echo a\n") != ScriptCache::Hash("echo b\n"));
+    }
+
+    void TestScriptIsReused()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        SCXFilePath first, second, other;
+
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", first));
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", second));
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo b\n", other));
+        CPPUNIT_ASSERT(first.Get() == second.Get());
+        CPPUNIT_ASSERT(first.Get() != other.Get());
+        CPPUNIT_ASSERT_EQUAL(std::string("echo a\n"), ReadFile(first));
+        CPPUNIT_ASSERT_EQUAL(std::string("echo b\n"), ReadFile(other));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), cache.Size());
+
+        cache.Release(first);
+        cache.Release(second);
+        cache.Release(other);
+        cache.Clear();
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cache.Size());
+        CPPUNIT_ASSERT(0 != access(StrToMultibyte(first.Get()).c_str(), F_OK));
+    }
+
+    void TestFileIsPrivate()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        SCXFilePath path;
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", path));
+
+        struct stat st;
+        CPPUNIT_ASSERT_EQUAL(0, stat(StrToMultibyte(path.Get()).c_str(), &st));
+        CPPUNIT_ASSERT_EQUAL(static_cast<mode_t>(S_IRWXU), st.st_mode & 07777);
+        CPPUNIT_ASSERT_EQUAL(geteuid(), st.st_uid);
+
+        std::string directory = StrToMultibyte(ScriptCache::Directory(cTmpDir));
+        CPPUNIT_ASSERT_EQUAL(0, stat(directory.c_str(), &st));
+        CPPUNIT_ASSERT_EQUAL(static_cast<mode_t>(S_IRWXU), st.st_mode & 07777);
+
+        cache.Release(path);
+        cache.Clear();
+    }
+
+    void TestModifiedFileIsRewritten()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        SCXFilePath path;
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", path));
+        cache.Release(path);
+
+        // Replace the file behind the back of the cache
+        std::string file = StrToMultibyte(path.Get());
+        CPPUNIT_ASSERT_EQUAL(0, unlink(file.c_str()));
+        {
+            std::ofstream ofs(file.c_str());
+            ofs << "echo x\n";
+        }
+        chmod(file.c_str(), S_IRWXU);
+
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", path));
+        CPPUNIT_ASSERT_EQUAL(std::string("echo a\n"), ReadFile(path));
+        cache.Release(path);
+        cache.Clear();
+    }
+
+    void TestStaleFilesAreRemoved()
+    {
+        SCXFilePath path;
+        {
+            // An earlier agent process, gone without clearing its cache
+            ScriptCache cache(L"ScriptCacheTest");
+            CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", path));
+        }
+        std::string stale = StrToMultibyte(path.Get());
+        std::string other = StrToMultibyte(ScriptCache::Directory(cTmpDir)) + "other";
+        {
+            std::ofstream ofs(other.c_str());
+        }
+
+        ScriptCache cache(L"ScriptCacheTest");
+        SCXFilePath b;
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo b\n", b));
+        CPPUNIT_ASSERT(0 != access(stale.c_str(), F_OK));
+        // Only script files are removed
+        CPPUNIT_ASSERT_EQUAL(0, access(other.c_str(), F_OK));
+        cache.Release(b);
+        cache.Clear();
+        unlink(other.c_str());
+    }
+
+    void TestLeastRecentlyUsedIsEvicted()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        cache.SetLimits(2, ScriptCache::cDefaultMaxBytes);
+        SCXFilePath a, b, c;
+
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", a));
+        cache.Release(a);
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo b\n", b));
+        cache.Release(b);
+
+        // Use "a" again: "b" is now the least recently used
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", a));
+        cache.Release(a);
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo c\n", c));
+        cache.Release(c);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), cache.Size());
+        CPPUNIT_ASSERT_EQUAL(0, access(StrToMultibyte(a.Get()).c_str(), F_OK));
+        CPPUNIT_ASSERT(0 != access(StrToMultibyte(b.Get()).c_str(), F_OK));
+        CPPUNIT_ASSERT_EQUAL(0, access(StrToMultibyte(c.Get()).c_str(), F_OK));
+        cache.Clear();
+    }
+
+    void TestRunningScriptIsNotEvicted()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        cache.SetLimits(1, ScriptCache::cDefaultMaxBytes);
+        SCXFilePath a, b;
+
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo a\n", a));
+        CPPUNIT_ASSERT(cache.Acquire(cTmpDir, "echo b\n", b));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), cache.Size());
+        CPPUNIT_ASSERT_EQUAL(0, access(StrToMultibyte(a.Get()).c_str(), F_OK));
+
+        // Once done, the cache gets back within its limits
+        cache.Release(a);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), cache.Size());
+        CPPUNIT_ASSERT(0 != access(StrToMultibyte(a.Get()).c_str(), F_OK));
+        cache.Release(b);
+        cache.Clear();
+    }
+
+    void TestDisabledCache()
+    {
+        ScriptCache cache(L"ScriptCacheTest");
+        SCXFilePath path;
+
+        cache.SetLimits(0, ScriptCache::cDefaultMaxBytes);
+        CPPUNIT_ASSERT(!cache.Acquire(cTmpDir, "echo a\n", path));
+
+        // A script larger than a quarter of the cache isn't cached either
+        cache.SetLimits(ScriptCache::cDefaultMaxScripts, 16);
+        CPPUNIT_ASSERT(!cache.Acquire(cTmpDir, "echo a long script\n", path));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cache.Size());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScriptCacheTest );
@@ -0,0 +1,286 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the background sampling of provider data
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <scxcorelib/scxthread.h>
+#include <scxcorelib/scxthreadlock.h>
+#include <testutils/scxunit.h>
+#include <samplingscheduler.h>
+#include <snapshotpublisher.h>
+
+namespace
+{
+    //! Number of calls of the samplers below
+    unsigned int s_firstSamples = 0;
+    unsigned int s_secondSamples = 0;
+
+    void SampleFirst()
+    {
+        ++s_firstSamples;
+    }
+
+    void SampleSecond()
+    {
+        ++s_secondSamples;
+    }
+
+    void SampleFailing()
+    {
+        throw SCXCoreLib::SCXInternalErrorException(L"Injected failure", SCXSRCLOCATION);
+    }
+
+    //! Snapshot with a settable sample time
+    class TestSnapshot
+    {
+    public:
+        explicit TestSnapshot(scxulong sampleTime) : m_sampleTime(sampleTime) { }
+
+        bool IsStale(scxulong now, scxulong maxAge) const
+        {
+            return now < m_sampleTime || now - m_sampleTime >= maxAge;
+        }
+
+    private:
+        scxulong m_sampleTime;
+    };
+
+    //! Takes snapshots of a given sample time, counting them
+    class TestSnapshotTaker
+    {
+    public:
+        TestSnapshotTaker(scxulong sampleTime, unsigned int& taken) : m_sampleTime(sampleTime), m_taken(taken) { }
+
+        SCXCoreLib::SCXHandle<TestSnapshot> operator()() const
+        {
+            ++m_taken;
+            return SCXCoreLib::SCXHandle<TestSnapshot>(new TestSnapshot(m_sampleTime));
+        }
+
+    private:
+        scxulong m_sampleTime;
+        unsigned int& m_taken;
+    };
+
+    //! Number of snapshots taken by SlowSnapshotTaker
+    unsigned int s_slowTaken = 0;
+
+    //! Takes snapshots slowly, at the time they are done, counting them
+    class SlowSnapshotTaker
+    {
+    public:
+        SCXCoreLib::SCXHandle<TestSnapshot> operator()() const
+        {
+            SCXCoreLib::SCXThread::Sleep(300);
+            SCXCoreLib::SCXThreadLock lock(SCXCoreLib::ThreadLockHandleGet(L"SamplingSchedulerTest::SlowTaken"));
+            ++s_slowTaken;
+            return SCXCoreLib::SCXHandle<TestSnapshot>(new TestSnapshot(SCXCore::GetSnapshotTime()));
+        }
+    };
+
+    //! Publisher shared by the threads of RequestSnapshot()
+    SCXCore::SnapshotPublisher<TestSnapshot> s_sharedPublisher(L"SamplingSchedulerTest::Concurrent");
+
+    //! Body of a thread requesting a snapshot at most 10 s old
+    void RequestSnapshot(SCXCoreLib::SCXThreadParamHandle&)
+    {
+        s_sharedPublisher.GetOrRefresh(SCXCore::GetSnapshotTime(), 10000, SlowSnapshotTaker());
+    }
+}
+
+class SamplingSchedulerTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( SamplingSchedulerTest );
+    CPPUNIT_TEST( TestSamplerRunsWhenDue );
+    CPPUNIT_TEST( TestSamplersDueTogetherRunInOnePass );
+    CPPUNIT_TEST( TestUnregisteredSamplerDoesNotRun );
+    CPPUNIT_TEST( TestFailingSamplerDoesNotStopOthers );
+    CPPUNIT_TEST( TestThreadRunsSamplers );
+    CPPUNIT_TEST( TestNoRefreshWithoutDemand );
+    CPPUNIT_TEST( TestRefreshBeforeSnapshotGetsStale );
+    CPPUNIT_TEST( TestGetOrRefreshSharesRecentSnapshot );
+    CPPUNIT_TEST( TestSampleIfNeededOnlyRefreshesOnDemand );
+    CPPUNIT_TEST( TestConcurrentRequestsShareOneRefresh );
+    SCXUNIT_TEST_ATTRIBUTE(TestThreadRunsSamplers, SLOW);
+    SCXUNIT_TEST_ATTRIBUTE(TestConcurrentRequestsShareOneRefresh, SLOW);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void)
+    {
+        s_firstSamples = 0;
+        s_secondSamples = 0;
+    }
+
+    void TestSamplerRunsWhenDue()
+    {
+        SCXCore::SamplingScheduler scheduler(false);
+        scxulong start = SCXCore::GetSnapshotTime();
+        scheduler.Register(L"First", SampleFirst, 1000);
+        CPPUNIT_ASSERT(scheduler.IsRegistered(L"First"));
+
+        // Not due before one interval has passed
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), scheduler.RunDue(start));
+        CPPUNIT_ASSERT_EQUAL(0u, s_firstSamples);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), scheduler.RunDue(start + 5000));
+        CPPUNIT_ASSERT_EQUAL(1u, s_firstSamples);
+
+        // Overrunning several intervals doesn't make the sampler run several times
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), scheduler.RunDue(start + 5500));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), scheduler.RunDue(start + 6000));
+        CPPUNIT_ASSERT_EQUAL(2u, s_firstSamples);
+
+        scheduler.Unregister(L"First");
+    }
+
+    void TestSamplersDueTogetherRunInOnePass()
+    {
+        SCXCore::SamplingScheduler scheduler(false);
+        scxulong start = SCXCore::GetSnapshotTime();
+        scheduler.Register(L"First", SampleFirst, 1000);
+        scheduler.Register(L"Second", SampleSecond, 3000);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), scheduler.RunDue(start + 3000));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), scheduler.RunDue(start + 4000));
+        CPPUNIT_ASSERT_EQUAL(2u, s_firstSamples);
+        CPPUNIT_ASSERT_EQUAL(1u, s_secondSamples);
+
+        scheduler.Unregister(L"First");
+        scheduler.Unregister(L"Second");
+    }
+
+    void TestUnregisteredSamplerDoesNotRun()
+    {
+        SCXCore::SamplingScheduler scheduler(false);
+        scxulong start = SCXCore::GetSnapshotTime();
+        scheduler.Register(L"First", SampleFirst, 1000);
+        scheduler.Unregister(L"First");
+        CPPUNIT_ASSERT(!scheduler.IsRegistered(L"First"));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), scheduler.RunDue(start + 5000));
+        CPPUNIT_ASSERT_EQUAL(0u, s_firstSamples);
+    }
+
+    void TestFailingSamplerDoesNotStopOthers()
+    {
+        SCXCore::SamplingScheduler scheduler(false);
+        scxulong start = SCXCore::GetSnapshotTime();
+        scheduler.Register(L"A-Failing", SampleFailing, 1000);
+        scheduler.Register(L"B-First", SampleFirst, 1000);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), scheduler.RunDue(start + 1000));
+        CPPUNIT_ASSERT_EQUAL(1u, s_firstSamples);
+
+        scheduler.Unregister(L"A-Failing");
+        scheduler.Unregister(L"B-First");
+    }
+
+    void TestThreadRunsSamplers()
+    {
+        SCXCore::SamplingScheduler scheduler;
+        scheduler.Register(L"First", SampleFirst, SCXCore::SamplingScheduler::cTick);
+
+        for (int i = 0; i < 100 && 0 == s_firstSamples; i++)
+        {
+            SCXCoreLib::SCXThread::Sleep(100);
+        }
+
+        // Once unregistered, the sampler isn't called anymore
+        scheduler.Unregister(L"First");
+        unsigned int samples = s_firstSamples;
+        SCXCoreLib::SCXThread::Sleep(3 * SCXCore::SamplingScheduler::cTick);
+
+        CPPUNIT_ASSERT(0 < samples);
+        CPPUNIT_ASSERT_EQUAL(samples, s_firstSamples);
+    }
+
+    void TestNoRefreshWithoutDemand()
+    {
+        SCXCore::SnapshotPublisher<TestSnapshot> publisher(L"SamplingSchedulerTest::NoDemand");
+
+        // Never requested: nothing to keep fresh
+        CPPUNIT_ASSERT(!publisher.NeedsRefresh(10000, 1000, 500, 60000));
+
+        // Requested, but too long ago
+        CPPUNIT_ASSERT(NULL == publisher.Get(10000, 1000));
+        CPPUNIT_ASSERT(publisher.NeedsRefresh(10000, 1000, 500, 60000));
+        CPPUNIT_ASSERT(!publisher.NeedsRefresh(70000, 1000, 500, 60000));
+    }
+
+    void TestRefreshBeforeSnapshotGetsStale()
+    {
+        SCXCore::SnapshotPublisher<TestSnapshot> publisher(L"SamplingSchedulerTest::Stale");
+        publisher.Publish(SCXCoreLib::SCXHandle<TestSnapshot>(new TestSnapshot(10000)));
+        CPPUNIT_ASSERT(NULL != publisher.Get(10000, 1000));
+
+        // Still fresh at the next run of the sampler: no refresh yet
+        CPPUNIT_ASSERT(!publisher.NeedsRefresh(10400, 1000, 500, 60000));
+        // Would be stale at the next run of the sampler: refresh now
+        CPPUNIT_ASSERT(publisher.NeedsRefresh(10500, 1000, 500, 60000));
+    }
+
+    void TestGetOrRefreshSharesRecentSnapshot()
+    {
+        SCXCore::SnapshotPublisher<TestSnapshot> publisher(L"SamplingSchedulerTest::GetOrRefresh");
+        unsigned int taken = 0;
+
+        SCXCoreLib::SCXHandle<TestSnapshot> first = publisher.GetOrRefresh(10000, 1000, TestSnapshotTaker(10000, taken));
+        CPPUNIT_ASSERT_EQUAL(1u, taken);
+        CPPUNIT_ASSERT(first == publisher.GetOrRefresh(10500, 1000, TestSnapshotTaker(10500, taken)));
+        CPPUNIT_ASSERT_EQUAL(1u, taken);
+
+        // Too old: a new snapshot is taken and published
+        SCXCoreLib::SCXHandle<TestSnapshot> second = publisher.GetOrRefresh(11000, 1000, TestSnapshotTaker(11000, taken));
+        CPPUNIT_ASSERT_EQUAL(2u, taken);
+        CPPUNIT_ASSERT(first != second);
+        CPPUNIT_ASSERT(second == publisher.Get(11000, 1000));
+    }
+
+    void TestSampleIfNeededOnlyRefreshesOnDemand()
+    {
+        SCXCore::SnapshotPublisher<TestSnapshot> publisher(L"SamplingSchedulerTest::SampleIfNeeded");
+        unsigned int taken = 0;
+
+        // Never requested: nothing to take
+        CPPUNIT_ASSERT(!publisher.SampleIfNeeded(1000, 500, 60000, TestSnapshotTaker(SCXCore::GetSnapshotTime(), taken)));
+        CPPUNIT_ASSERT_EQUAL(0u, taken);
+
+        // Requested, and no snapshot yet
+        CPPUNIT_ASSERT(NULL == publisher.Get(SCXCore::GetSnapshotTime(), 1000));
+        CPPUNIT_ASSERT(publisher.SampleIfNeeded(1000, 500, 60000, TestSnapshotTaker(SCXCore::GetSnapshotTime(), taken)));
+        CPPUNIT_ASSERT_EQUAL(1u, taken);
+
+        // Fresh enough until the next run of the sampler
+        CPPUNIT_ASSERT(!publisher.SampleIfNeeded(60000, 500, 60000, TestSnapshotTaker(SCXCore::GetSnapshotTime(), taken)));
+        CPPUNIT_ASSERT_EQUAL(1u, taken);
+    }
+
+    void TestConcurrentRequestsShareOneRefresh()
+    {
+        // A stale snapshot: both requests need a new one
+        s_sharedPublisher.Publish(SCXCoreLib::SCXHandle<TestSnapshot>(new TestSnapshot(1)));
+        s_slowTaken = 0;
+
+        // The second request waits for the refresh of the first one, and shares it
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXThread> first(new SCXCoreLib::SCXThread(RequestSnapshot, NULL));
+        SCXCoreLib::SCXThread::Sleep(100);
+        SCXCoreLib::SCXHandle<SCXCoreLib::SCXThread> second(new SCXCoreLib::SCXThread(RequestSnapshot, NULL));
+        first->Wait();
+        second->Wait();
+
+        CPPUNIT_ASSERT_EQUAL(1u, s_slowTaken);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SamplingSchedulerTest );
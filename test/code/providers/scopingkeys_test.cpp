@@ -0,0 +1,150 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the cache of CIM scoping keys
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxexception.h>
+#include <testutils/scxunit.h>
+#include <scopingkeys.h>
+
+//! Simulates name resolution so that the number of lookups and the
+//! passage of time can be controlled by the tests.
+class InjectedScopingKeysDependencies : public SCXCore::ScopingKeysDependencies
+{
+public:
+    InjectedScopingKeysDependencies() :
+        m_hostName(L"host.example.com"), m_osName(L"Linux Distribution"),
+        m_now(1000), m_lookups(0), m_failHostLookup(false) { }
+
+    std::wstring GetHostDomainname() const
+    {
+        ++m_lookups;
+        if (m_failHostLookup)
+        {
+            throw SCXCoreLib::SCXInternalErrorException(L"Injected failure", SCXSRCLOCATION);
+        }
+        return m_hostName;
+    }
+
+    std::wstring GetOSName() const
+    {
+        return m_osName;
+    }
+
+    time_t GetCurrentTime() const
+    {
+        return m_now;
+    }
+
+    std::wstring m_hostName;
+    std::wstring m_osName;
+    time_t m_now;
+    mutable unsigned int m_lookups;
+    bool m_failHostLookup;
+};
+
+class ScopingKeysTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( ScopingKeysTest );
+    CPPUNIT_TEST( TestValuesAreResolved );
+    CPPUNIT_TEST( TestValuesAreCached );
+    CPPUNIT_TEST( TestRefreshAfterMaxAge );
+    CPPUNIT_TEST( TestRefreshAfterInvalidate );
+    CPPUNIT_TEST( TestFailedLookupIsRetried );
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    SCXCoreLib::SCXHandle<InjectedScopingKeysDependencies> m_deps;
+
+public:
+    void setUp(void)
+    {
+        m_deps = new InjectedScopingKeysDependencies();
+    }
+
+    void tearDown(void)
+    {
+        m_deps = NULL;
+    }
+
+    void TestValuesAreResolved()
+    {
+        SCXCore::ScopingKeys keys(m_deps);
+        std::string csName, osName;
+
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        CPPUNIT_ASSERT_EQUAL(std::string("host.example.com"), csName);
+        CPPUNIT_ASSERT(keys.GetOSName(osName));
+        CPPUNIT_ASSERT_EQUAL(std::string("Linux Distribution"), osName);
+    }
+
+    void TestValuesAreCached()
+    {
+        SCXCore::ScopingKeys keys(m_deps);
+        std::string csName;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            CPPUNIT_ASSERT(keys.GetCSName(csName));
+        }
+        CPPUNIT_ASSERT_EQUAL(1u, m_deps->m_lookups);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(1), keys.GetRefreshCount());
+        CPPUNIT_ASSERT_EQUAL(std::string("ScopingKeys Refreshes=1"), keys.Format());
+    }
+
+    void TestRefreshAfterMaxAge()
+    {
+        SCXCore::ScopingKeys keys(m_deps);
+        keys.SetMaxAge(60);
+        std::string csName;
+
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        m_deps->m_hostName = L"renamed.example.com";
+        m_deps->m_now += 59;
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        CPPUNIT_ASSERT_EQUAL(std::string("host.example.com"), csName);
+
+        m_deps->m_now += 1;
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        CPPUNIT_ASSERT_EQUAL(std::string("renamed.example.com"), csName);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxulong>(2), keys.GetRefreshCount());
+    }
+
+    void TestRefreshAfterInvalidate()
+    {
+        SCXCore::ScopingKeys keys(m_deps);
+        std::string csName;
+
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        m_deps->m_hostName = L"renamed.example.com";
+        keys.Invalidate();
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        CPPUNIT_ASSERT_EQUAL(std::string("renamed.example.com"), csName);
+        CPPUNIT_ASSERT_EQUAL(2u, m_deps->m_lookups);
+    }
+
+    void TestFailedLookupIsRetried()
+    {
+        SCXCore::ScopingKeys keys(m_deps);
+        std::string csName, osName;
+
+        m_deps->m_failHostLookup = true;
+        CPPUNIT_ASSERT( ! keys.GetCSName(csName));
+        CPPUNIT_ASSERT(keys.GetOSName(osName));
+
+        m_deps->m_failHostLookup = false;
+        CPPUNIT_ASSERT(keys.GetCSName(csName));
+        CPPUNIT_ASSERT_EQUAL(std::string("host.example.com"), csName);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ScopingKeysTest );
@@ -0,0 +1,174 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the analysis of WQL filters
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/stringaid.h>
+#include <testutils/scxunit.h>
+#include <wqlfilter.h>
+
+class WqlFilterTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( WqlFilterTest );
+    CPPUNIT_TEST( TestSingleEquality );
+    CPPUNIT_TEST( TestInListAndOr );
+    CPPUNIT_TEST( TestContradictionMatchesNothing );
+    CPPUNIT_TEST( TestOrWithOtherPropertyIsUnconstrained );
+    CPPUNIT_TEST( TestUnsupportedConditionsAreUnconstrained );
+    CPPUNIT_TEST( TestQuotedStringEscapes );
+    CPPUNIT_TEST( TestParseFailure );
+    CPPUNIT_TEST( TestNoWhereClause );
+    CPPUNIT_TEST( TestRange );
+    CPPUNIT_TEST( TestTargetValuesAreLimited );
+    CPPUNIT_TEST( TestPropertiesOfWhereClause );
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    std::wstring Join(const std::set<std::wstring>& values)
+    {
+        std::wstring result;
+        for (std::set<std::wstring>::const_iterator it = values.begin(); it != values.end(); ++it)
+        {
+            result += *it;
+            result += L",";
+        }
+        return result;
+    }
+
+public:
+    void TestSingleEquality()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from SCX_UnixProcess where Handle='123'");
+
+        CPPUNIT_ASSERT(filter.IsValid());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"SCX_UnixProcess"), filter.GetClassName());
+        CPPUNIT_ASSERT(filter.GetValues(L"handle", values));
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"123,"), Join(values));
+    }
+
+    void TestInListAndOr()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"SELECT Name FROM SCX_UnixProcess WHERE Handle IN ('1', \"2\") OR (Handle = 3 AND Name='x')");
+
+        CPPUNIT_ASSERT(filter.IsValid());
+        CPPUNIT_ASSERT(filter.GetValues(L"Handle", values));
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"1,2,3,"), Join(values));
+        CPPUNIT_ASSERT(!filter.GetValues(L"Name", values));
+    }
+
+    void TestContradictionMatchesNothing()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from X where Handle='1' and Handle='2'");
+
+        CPPUNIT_ASSERT(filter.GetValues(L"Handle", values));
+        CPPUNIT_ASSERT(values.empty());
+    }
+
+    void TestOrWithOtherPropertyIsUnconstrained()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from X where Handle='1' or Name='2'");
+
+        CPPUNIT_ASSERT(!filter.GetValues(L"Handle", values));
+    }
+
+    void TestUnsupportedConditionsAreUnconstrained()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter notFilter(L"select * from X where not Handle='1'");
+        CPPUNIT_ASSERT(notFilter.IsValid());
+        CPPUNIT_ASSERT(!notFilter.GetValues(L"Handle", values));
+
+        SCXCore::WqlFilter mixed(L"select * from X where Name like 'a%' and Handle <> '3' and Size is not null and Handle not in ('1')");
+        CPPUNIT_ASSERT(mixed.IsValid());
+        CPPUNIT_ASSERT(!mixed.GetValues(L"Handle", values));
+        CPPUNIT_ASSERT(!mixed.GetValues(L"Name", values));
+    }
+
+    void TestQuotedStringEscapes()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from X where Name = 'it\\'s'");
+
+        CPPUNIT_ASSERT(filter.GetValues(L"Name", values));
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"it's,"), Join(values));
+    }
+
+    void TestParseFailure()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from X where (Name = 'a'");
+
+        CPPUNIT_ASSERT(!filter.IsValid());
+        CPPUNIT_ASSERT(!filter.GetValues(L"Name", values));
+    }
+
+    void TestNoWhereClause()
+    {
+        std::set<std::wstring> values;
+        SCXCore::WqlFilter filter(L"select * from X");
+
+        CPPUNIT_ASSERT(filter.IsValid());
+        CPPUNIT_ASSERT(!filter.GetValues(L"Name", values));
+    }
+
+    void TestRange()
+    {
+        scxlong low = 0, high = 0;
+        SCXCore::WqlFilter between(L"select * from X where Pid >= 10 and 20 > Pid");
+        CPPUNIT_ASSERT(between.GetRange(L"pid", low, high));
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxlong>(10), low);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxlong>(19), high);
+
+        SCXCore::WqlFilter inList(L"select * from X where Pid in (5, -2, 9)");
+        CPPUNIT_ASSERT(inList.GetRange(L"Pid", low, high));
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxlong>(-2), low);
+        CPPUNIT_ASSERT_EQUAL(static_cast<scxlong>(9), high);
+
+        SCXCore::WqlFilter either(L"select * from X where Pid < 3 or Pid > 10");
+        CPPUNIT_ASSERT(either.GetRange(L"Pid", low, high));
+        CPPUNIT_ASSERT(high > 10);
+    }
+
+    void TestTargetValuesAreLimited()
+    {
+        std::set<std::wstring> values;
+        std::wstring query(L"select * from X where Handle in (");
+        for (size_t i = 0; i <= SCXCore::WqlFilter::cMaxTargetedValues; i++)
+        {
+            query += (i == 0 ? L"" : L", ") + SCXCoreLib::StrFrom(i);
+        }
+        query += L")";
+
+        SCXCore::WqlFilter filter(query);
+        CPPUNIT_ASSERT(filter.GetValues(L"Handle", values));
+        CPPUNIT_ASSERT_EQUAL(SCXCore::WqlFilter::cMaxTargetedValues + 1, values.size());
+        CPPUNIT_ASSERT(!filter.GetTargetValues(L"Handle", values));
+        CPPUNIT_ASSERT(values.empty());
+    }
+
+    void TestPropertiesOfWhereClause()
+    {
+        // Every property compared, even in conditions that constrain nothing, but not the selected ones
+        SCXCore::WqlFilter filter(L"select Name from X where Handle = '1' or not (PercentUserTime > 5) or Path like 'a%' or A = B");
+        CPPUNIT_ASSERT(filter.IsValid());
+        CPPUNIT_ASSERT_EQUAL(std::wstring(L"A,B,Handle,Path,PercentUserTime,"), Join(filter.GetProperties()));
+
+        SCXCore::WqlFilter noWhere(L"select Name from X");
+        CPPUNIT_ASSERT(noWhere.GetProperties().empty());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( WqlFilterTest );
@@ -0,0 +1,141 @@
+/*--------------------------------------------------------------------------------
+    Copyright (c) Microsoft Corporation.  All rights reserved.
+
+*/
+/**
+    \file
+
+    \brief       Tests for the registry of parsed WQL filters, and a benchmark
+                 of the filter analysis done by each filtered enumeration
+
+    \date        2026-10-17 10:00
+
+*/
+/*----------------------------------------------------------------------------*/
+#include <scxcorelib/scxcmn.h>
+#include <scxcorelib/scxpatternfinder.h>
+#include <scxcorelib/stringaid.h>
+#include <testutils/scxunit.h>
+#include <snapshotpublisher.h>
+#include <wqlfiltercache.h>
+
+#include <iostream>
+
+class WqlFilterCacheTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE( WqlFilterCacheTest );
+    CPPUNIT_TEST( TestSameQueryIsParsedOnce );
+    CPPUNIT_TEST( TestDifferentQueriesAreKeptApart );
+    CPPUNIT_TEST( TestInvalidQueryIsCached );
+    CPPUNIT_TEST( TestSizeIsBounded );
+    CPPUNIT_TEST( BenchmarkFilteredEnumeration );
+    SCXUNIT_TEST_ATTRIBUTE(BenchmarkFilteredEnumeration, SLOW);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    //! Number of requests timed by the benchmark
+    static const size_t cBenchmarkCalls = 20000;
+
+    //! Filter of a typical targeted enumeration
+    static const char* Query()
+    {
+        return "select * from SCX_FileSystemStatisticalInformation where Name='/var'";
+    }
+
+public:
+    void TestSameQueryIsParsedOnce()
+    {
+        SCXCore::WqlFilterCache cache(L"WqlFilterCacheTest::Same");
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> first = cache.Get(Query());
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> second = cache.Get(Query());
+
+        CPPUNIT_ASSERT(first.GetData() == second.GetData());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), cache.Size());
+
+        std::set<std::wstring> names;
+        CPPUNIT_ASSERT(second->GetTargetValues(L"Name", names));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), names.size());
+        CPPUNIT_ASSERT(names.end() != names.find(L"/var"));
+    }
+
+    void TestDifferentQueriesAreKeptApart()
+    {
+        SCXCore::WqlFilterCache cache(L"WqlFilterCacheTest::Different");
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> var = cache.Get("select * from X where Name='/var'");
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> tmp = cache.Get("select * from X where Name='/tmp'");
+
+        CPPUNIT_ASSERT(var.GetData() != tmp.GetData());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), cache.Size());
+
+        std::set<std::wstring> names;
+        CPPUNIT_ASSERT(tmp->GetTargetValues(L"Name", names));
+        CPPUNIT_ASSERT(names.end() != names.find(L"/tmp"));
+    }
+
+    void TestInvalidQueryIsCached()
+    {
+        SCXCore::WqlFilterCache cache(L"WqlFilterCacheTest::Invalid");
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> first = cache.Get("select * from X where (");
+        SCXCoreLib::SCXHandle<SCXCore::WqlFilter> second = cache.Get("select * from X where (");
+
+        CPPUNIT_ASSERT(!first->IsValid());
+        CPPUNIT_ASSERT(first.GetData() == second.GetData());
+    }
+
+    void TestSizeIsBounded()
+    {
+        SCXCore::WqlFilterCache cache(L"WqlFilterCacheTest::Bounded");
+        for (size_t i = 0; i < 3 * SCXCore::WqlFilterCache::cMaxFilters; i++)
+        {
+            cache.Get(SCXCoreLib::StrToUTF8(SCXCoreLib::StrAppend(L"select * from X where Name=", i)));
+            CPPUNIT_ASSERT(cache.Size() <= SCXCore::WqlFilterCache::cMaxFilters);
+        }
+    }
+
+    /*
+      Time the filter analysis of a filtered EnumerateInstances, the way the
+      providers used to do it (registering a SCXPatternFinder pattern on each
+      request), parsing the query on each request, and through the registry.
+    */
+    void BenchmarkFilteredEnumeration()
+    {
+        const std::string query(Query());
+
+        scxulong start = SCXCore::GetSnapshotTime();
+        for (size_t i = 0; i < cBenchmarkCalls; i++)
+        {
+            std::wstring filterQuery(SCXCoreLib::StrFromUTF8(query));
+            SCXCoreLib::SCXPatternFinder::SCXPatternCookie patternID = 0, id = 0;
+            SCXCoreLib::SCXPatternFinder::SCXPatternMatch param;
+            SCXCoreLib::SCXPatternFinder patternFinder;
+            patternFinder.RegisterPattern(patternID, L"select * from SCX_FileSystemStatisticalInformation where Name=%name");
+            CPPUNIT_ASSERT(patternFinder.Match(filterQuery, id, param));
+        }
+        scxulong patternTime = SCXCore::GetSnapshotTime() - start;
+
+        start = SCXCore::GetSnapshotTime();
+        for (size_t i = 0; i < cBenchmarkCalls; i++)
+        {
+            std::set<std::wstring> names;
+            SCXCore::WqlFilter filter(SCXCoreLib::StrFromUTF8(query));
+            CPPUNIT_ASSERT(filter.GetTargetValues(L"Name", names));
+        }
+        scxulong parseTime = SCXCore::GetSnapshotTime() - start;
+
+        SCXCore::WqlFilterCache cache(L"WqlFilterCacheTest::Benchmark");
+        start = SCXCore::GetSnapshotTime();
+        for (size_t i = 0; i < cBenchmarkCalls; i++)
+        {
+            std::set<std::wstring> names;
+            CPPUNIT_ASSERT(cache.Get(query)->GetTargetValues(L"Name", names));
+        }
+        scxulong cachedTime = SCXCore::GetSnapshotTime() - start;
+
+        std::cout << std::endl << "Filter analysis of " << cBenchmarkCalls << " filtered enumerations (ms): "
+                  << "pattern per call " << patternTime
+                  << ", parse per call " << parseTime
+                  << ", registry " << cachedTime << std::endl;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( WqlFilterCacheTest );